@@ -0,0 +1,311 @@
+//
+//  JMapGMAttributeBenchmarks.c
+//  JMapOutdoorIndoorKit Benchmarks
+//
+//  Copyright © 2026 Jibestream. All rights reserved.
+//
+
+#include "JMapGMBenchmark.h"
+
+#include "JMapGMAttributeTable.h"
+#include "JMapGMShapeQuery.h"
+#include "JMapGMSyntheticVenue.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Units of 5 floors, three in five occupied by a destination.
+static JMapGMSyntheticVenue JMapGMBenchmarkAttributeVenue(size_t units)
+{
+    JMapGMSyntheticConfig config = JMapGMSyntheticConfigDefault;
+    config.floors = 5;
+    config.unitsPerFloor = (uint32_t)((units + 4) / 5);
+    config.destinationsPerFloor = config.unitsPerFloor * 3 / 5;
+    JMapGMSyntheticVenue venue;
+    JMapGMSyntheticVenueGenerate(&venue, &config);
+    return venue;
+}
+
+static uint32_t JMapGMBenchmarkIntern(JMapGMAttributeTable *table, const char *string)
+{
+    return JMapGMAttributeTableIntern(table, string, strlen(string));
+}
+
+// The properties a unit carries in map data: id, floor, layer and, when occupied, category and name.
+static JMapGMAttributeTable *JMapGMBenchmarkAttributeTable(const JMapGMSyntheticVenue *venue)
+{
+    JMapGMAttributeTable *table = JMapGMAttributeTableCreate();
+    uint32_t idKey = JMapGMBenchmarkIntern(table, "id");
+    uint32_t floorKey = JMapGMBenchmarkIntern(table, "floor");
+    uint32_t layerKey = JMapGMBenchmarkIntern(table, "layer");
+    uint32_t categoryKey = JMapGMBenchmarkIntern(table, "category");
+    uint32_t nameKey = JMapGMBenchmarkIntern(table, "name");
+    uint32_t occupiedKey = JMapGMBenchmarkIntern(table, "occupied");
+    uint32_t units = JMapGMBenchmarkIntern(table, "Units");
+    for (size_t i = 0; i < venue->unitCount; i++) {
+        uint32_t row = JMapGMAttributeTableAddRow(table);
+        JMapGMAttributeTableSetNumber(table, row, idKey, JMapGMAttributeNumber, (double)i);
+        JMapGMAttributeTableSetNumber(table, row, floorKey, JMapGMAttributeNumber, venue->floorLevels[venue->unitFloors[i]]);
+        JMapGMAttributeTableSetString(table, row, layerKey, units);
+        JMapGMAttributeTableSetNumber(table, row, occupiedKey, JMapGMAttributeBoolean, 0);
+    }
+    for (size_t d = 0; d < venue->destinationCount; d++) {
+        uint32_t row = venue->destinationUnits[d];
+        const char *category = JMapGMSyntheticCategories[venue->destinationCategories[d]];
+        JMapGMAttributeTableSetString(table, row, categoryKey, JMapGMBenchmarkIntern(table, category));
+        JMapGMAttributeTableSetString(table, row, nameKey, JMapGMBenchmarkIntern(table, JMapGMSyntheticVenueGetDestinationName(venue, d)));
+        JMapGMAttributeTableSetNumber(table, row, occupiedKey, JMapGMAttributeBoolean, 1);
+    }
+    return table;
+}
+
+static void JMapGMBenchmarkAttributeBuild(JMapGMBenchmark *benchmark)
+{
+    size_t count = (size_t)JMapGMBenchmarkArg(benchmark);
+    JMapGMSyntheticVenue venue = JMapGMBenchmarkAttributeVenue(count);
+    size_t bytes = 0, strings = 0;
+    while (JMapGMBenchmarkKeepRunning(benchmark)) {
+        JMapGMAttributeTable *table = JMapGMBenchmarkAttributeTable(&venue);
+        bytes = JMapGMAttributeTableGetMemoryUsage(table);
+        strings = JMapGMAttributeTableGetStringCount(table);
+        JMapGMAttributeTableRelease(table);
+    }
+    JMapGMBenchmarkSetItemsPerIteration(benchmark, (int64_t)venue.unitCount);
+    JMapGMBenchmarkSetCounter(benchmark, "bytes/row", (double)bytes / venue.unitCount);
+    JMapGMBenchmarkSetCounter(benchmark, "strings", (double)strings);
+    if (JMapGMBenchmarkIsSmoke(benchmark)) {
+        JMapGMAttributeTable *table = JMapGMBenchmarkAttributeTable(&venue);
+        uint32_t category = JMapGMAttributeTableGetColumn(table, JMapGMAttributeTableFindString(table, "category", 8), JMapGMAttributeString);
+        uint32_t floor = JMapGMAttributeTableGetColumn(table, JMapGMAttributeTableFindString(table, "floor", 5), JMapGMAttributeNumber);
+        size_t mismatches = 0;
+        for (size_t d = 0; d < venue.destinationCount; d++) {
+            size_t length = 0;
+            const char *name = JMapGMAttributeTableGetString(table, JMapGMAttributeTableGetStringValue(table, category, venue.destinationUnits[d]), &length);
+            mismatches += !name || strcmp(name, JMapGMSyntheticCategories[venue.destinationCategories[d]]) != 0;
+        }
+        for (size_t i = 0; i < venue.unitCount; i++) {
+            mismatches += JMapGMAttributeTableGetNumber(table, floor, (uint32_t)i) != venue.floorLevels[venue.unitFloors[i]];
+        }
+        JMapGMBenchmarkCheck(benchmark, mismatches == 0, "columns read back what was set");
+        JMapGMBenchmarkCheck(benchmark, JMapGMAttributeTableGetColumnCount(table) == 6, "one column per key and type");
+        JMapGMBenchmarkCheck(benchmark, JMapGMBenchmarkIntern(table, "Food") == JMapGMAttributeTableFindString(table, "Food", 4), "strings are interned once");
+        JMapGMAttributeTableRelease(table);
+    }
+    JMapGMSyntheticVenueFree(&venue);
+}
+
+// category == "Food", the filter behind a category tab.
+static void JMapGMBenchmarkAttributeMatch(JMapGMBenchmark *benchmark)
+{
+    size_t count = (size_t)JMapGMBenchmarkArg(benchmark);
+    JMapGMSyntheticVenue venue = JMapGMBenchmarkAttributeVenue(count);
+    JMapGMAttributeTable *table = JMapGMBenchmarkAttributeTable(&venue);
+    size_t rowCount = JMapGMAttributeTableGetRowCount(table);
+    uint32_t column = JMapGMAttributeTableGetColumn(table, JMapGMAttributeTableFindString(table, "category", 8), JMapGMAttributeString);
+    uint32_t food = JMapGMAttributeTableFindString(table, "Food", 4);
+    uint64_t *bitmap = malloc(JMapGMBitmapWordCount(rowCount) * sizeof(uint64_t));
+    uint32_t *rows = malloc(rowCount * sizeof(uint32_t));
+    size_t matches = 0;
+    while (JMapGMBenchmarkKeepRunning(benchmark)) {
+        JMapGMAttributeTableMatchString(table, column, food, bitmap);
+        matches = JMapGMBitmapGetRows(bitmap, rowCount, rows);
+        JMapGMBenchmarkUse(rows);
+    }
+    JMapGMBenchmarkSetItemsPerIteration(benchmark, (int64_t)rowCount);
+    JMapGMBenchmarkSetCounter(benchmark, "matches", (double)matches);
+    if (JMapGMBenchmarkIsSmoke(benchmark)) {
+        size_t mismatches = 0, expected = 0;
+        for (size_t d = 0; d < venue.destinationCount; d++) expected += venue.destinationCategories[d] == 0;
+        for (size_t i = 0; i < matches; i++) {
+            mismatches += JMapGMAttributeTableGetStringValue(table, column, rows[i]) != food;
+        }
+        JMapGMBenchmarkCheck(benchmark, mismatches == 0 && matches == expected, "string match finds every food unit");
+
+        uint32_t floor = JMapGMAttributeTableGetColumn(table, JMapGMAttributeTableFindString(table, "floor", 5), JMapGMAttributeNumber);
+        JMapGMAttributeTableMatchRange(table, floor, 1, 2, bitmap);
+        size_t inRange = JMapGMBitmapGetRows(bitmap, rowCount, rows);
+        expected = 0;
+        for (size_t i = 0; i < venue.unitCount; i++) {
+            uint32_t level = venue.floorLevels[venue.unitFloors[i]];
+            expected += level >= 1 && level <= 2;
+        }
+        JMapGMBenchmarkCheck(benchmark, inRange == expected, "range match finds floors 1 and 2");
+        JMapGMAttributeTableMatchString(table, floor, food, bitmap);
+        JMapGMBenchmarkCheck(benchmark, JMapGMBitmapGetRows(bitmap, rowCount, rows) == 0, "string match on a number column is empty");
+    }
+    free(rows);
+    free(bitmap);
+    JMapGMAttributeTableRelease(table);
+    JMapGMSyntheticVenueFree(&venue);
+}
+
+// The same filter as a row by row loop, the cost of inspecting each shape's properties.
+static void JMapGMBenchmarkAttributeScan(JMapGMBenchmark *benchmark)
+{
+    size_t count = (size_t)JMapGMBenchmarkArg(benchmark);
+    JMapGMSyntheticVenue venue = JMapGMBenchmarkAttributeVenue(count);
+    JMapGMAttributeTable *table = JMapGMBenchmarkAttributeTable(&venue);
+    size_t rowCount = JMapGMAttributeTableGetRowCount(table);
+    uint32_t categoryKey = JMapGMAttributeTableFindString(table, "category", 8);
+    uint32_t *rows = malloc(rowCount * sizeof(uint32_t));
+    size_t matches = 0;
+    while (JMapGMBenchmarkKeepRunning(benchmark)) {
+        matches = 0;
+        uint32_t column = JMapGMAttributeTableGetColumn(table, categoryKey, JMapGMAttributeString);
+        for (uint32_t row = 0; row < rowCount; row++) {
+            const char *category = JMapGMAttributeTableGetString(table, JMapGMAttributeTableGetStringValue(table, column, row), NULL);
+            if (category && strcmp(category, "Food") == 0) rows[matches++] = row;
+        }
+        JMapGMBenchmarkUse(rows);
+    }
+    JMapGMBenchmarkSetItemsPerIteration(benchmark, (int64_t)rowCount);
+    JMapGMBenchmarkSetCounter(benchmark, "matches", (double)matches);
+    free(rows);
+    JMapGMAttributeTableRelease(table);
+    JMapGMSyntheticVenueFree(&venue);
+}
+
+typedef struct {
+    JMapGMSyntheticVenue venue;
+    JMapGMAttributeTable *table;
+    uint32_t *layers;
+    JMapGMRect *bounds;
+    JMapGMRTree *tree;
+    JMapGMShapeSource source;
+} JMapGMBenchmarkShapes;
+
+// The units of JMapGMBenchmarkAttributeVenue as a query source, preceded by a floor outline per floor.
+static JMapGMBenchmarkShapes JMapGMBenchmarkShapesCreate(size_t units)
+{
+    JMapGMBenchmarkShapes shapes;
+    shapes.venue = JMapGMBenchmarkAttributeVenue(units);
+    shapes.table = JMapGMBenchmarkAttributeTable(&shapes.venue);
+    size_t count = JMapGMAttributeTableGetRowCount(shapes.table);
+    uint32_t unitLayer = JMapGMBenchmarkIntern(shapes.table, "Units");
+    uint32_t otherLayer = JMapGMBenchmarkIntern(shapes.table, "Walls");
+    shapes.layers = malloc(count * sizeof(uint32_t));
+    shapes.bounds = malloc(count * sizeof(JMapGMRect));
+    for (size_t i = 0; i < count; i++) {
+        JMapGMPolygon polygon = JMapGMSyntheticVenueGetUnit(&shapes.venue, i);
+        shapes.bounds[i] = JMapGMPolygonGetBounds(&polygon);
+        // Every tenth shape stands in for another layer sharing the table.
+        shapes.layers[i] = i % 10 == 9 ? otherLayer : unitLayer;
+    }
+    shapes.tree = JMapGMRTreeCreate(shapes.bounds, count, 0);
+    shapes.source = (JMapGMShapeSource){ shapes.table, shapes.layers, shapes.bounds, shapes.tree, count };
+    return shapes;
+}
+
+static void JMapGMBenchmarkShapesFree(JMapGMBenchmarkShapes *shapes)
+{
+    JMapGMRTreeRelease(shapes->tree);
+    free(shapes->bounds);
+    free(shapes->layers);
+    JMapGMAttributeTableRelease(shapes->table);
+    JMapGMSyntheticVenueFree(&shapes->venue);
+}
+
+static uint32_t JMapGMBenchmarkColumn(const JMapGMAttributeTable *table, const char *key, JMapGMAttributeType type)
+{
+    return JMapGMAttributeTableGetColumn(table, JMapGMAttributeTableFindString(table, key, strlen(key)), type);
+}
+
+// Units, food, floors 1 to 2, not yet occupied or occupied: layer and three attribute terms.
+static void JMapGMBenchmarkQueryAttributes(JMapGMBenchmark *benchmark)
+{
+    JMapGMBenchmarkShapes shapes = JMapGMBenchmarkShapesCreate((size_t)JMapGMBenchmarkArg(benchmark));
+    const JMapGMAttributeTable *table = shapes.table;
+    size_t rowCount = shapes.source.rowCount;
+    uint32_t units = JMapGMAttributeTableFindString(table, "Units", 5);
+    uint32_t food = JMapGMAttributeTableFindString(table, "Food", 4);
+    uint32_t category = JMapGMBenchmarkColumn(table, "category", JMapGMAttributeString);
+    uint32_t floor = JMapGMBenchmarkColumn(table, "floor", JMapGMAttributeNumber);
+    uint32_t occupied = JMapGMBenchmarkColumn(table, "occupied", JMapGMAttributeBoolean);
+    JMapGMQueryTerm terms[] = {
+        { .op = JMapGMQueryLayer, .string = units },
+        { .op = JMapGMQueryEqual, .column = category, .string = food },
+        { .op = JMapGMQueryAnd },
+        { .op = JMapGMQueryRange, .column = floor, .min = 1, .max = 2 },
+        { .op = JMapGMQueryAnd },
+        { .op = JMapGMQueryRange, .column = occupied, .min = 0, .max = 0 },
+        { .op = JMapGMQueryNot },
+        { .op = JMapGMQueryAnd },
+    };
+    size_t termCount = sizeof(terms) / sizeof(terms[0]);
+    uint64_t *bitmap = malloc(JMapGMBitmapWordCount(rowCount) * sizeof(uint64_t));
+    size_t matches = 0;
+    while (JMapGMBenchmarkKeepRunning(benchmark)) {
+        matches = JMapGMShapeQueryEvaluate(&shapes.source, terms, termCount, bitmap);
+        JMapGMBenchmarkUse(bitmap);
+    }
+    JMapGMBenchmarkSetItemsPerIteration(benchmark, (int64_t)rowCount);
+    JMapGMBenchmarkSetCounter(benchmark, "matches", (double)matches);
+    if (JMapGMBenchmarkIsSmoke(benchmark)) {
+        size_t mismatches = 0, expected = 0;
+        for (uint32_t row = 0; row < rowCount; row++) {
+            double level = JMapGMAttributeTableGetNumber(table, floor, row);
+            bool match = shapes.layers[row] == units
+                && JMapGMAttributeTableGetStringValue(table, category, row) == food
+                && level >= 1 && level <= 2
+                && !(JMapGMAttributeTableGetNumber(table, occupied, row) == 0);
+            expected += match;
+            mismatches += match != (bool)(bitmap[row / 64] >> (row % 64) & 1);
+        }
+        JMapGMBenchmarkCheck(benchmark, matches == expected && mismatches == 0, "compound query matches a row by row check");
+        JMapGMQueryTerm unbalanced[] = { { .op = JMapGMQueryAll }, { .op = JMapGMQueryAll } };
+        JMapGMBenchmarkCheck(benchmark, JMapGMShapeQueryEvaluate(&shapes.source, unbalanced, 2, bitmap) == JMAPGM_QUERY_INVALID, "queries leave one result");
+        JMapGMBenchmarkCheck(benchmark, JMapGMShapeQueryEvaluate(&shapes.source, terms + 2, 1, bitmap) == JMAPGM_QUERY_INVALID, "operators need operands");
+        JMapGMQueryTerm none[] = { { .op = JMapGMQueryAll }, { .op = JMapGMQueryNot } };
+        JMapGMBenchmarkCheck(benchmark, JMapGMShapeQueryEvaluate(&shapes.source, none, 2, bitmap) == 0, "not all is nothing");
+    }
+    free(bitmap);
+    JMapGMBenchmarkShapesFree(&shapes);
+}
+
+// Units within 10 metres of a point, the query behind "what is near me".
+static void JMapGMBenchmarkQueryNear(JMapGMBenchmark *benchmark)
+{
+    JMapGMBenchmarkShapes shapes = JMapGMBenchmarkShapesCreate((size_t)JMapGMBenchmarkArg(benchmark));
+    size_t rowCount = shapes.source.rowCount;
+    uint32_t units = JMapGMAttributeTableFindString(shapes.table, "Units", 5);
+    JMapGMRect floorBounds = JMapGMRectsGetUnion(shapes.bounds, rowCount / 5);
+    JMapGMPoint centre = { (floorBounds.minX + floorBounds.maxX) / 2, (floorBounds.minY + floorBounds.maxY) / 2 };
+    JMapGMQueryTerm terms[] = {
+        { .op = JMapGMQueryLayer, .string = units },
+        { .op = JMapGMQueryNear, .point = centre, .radius = 10 },
+        { .op = JMapGMQueryAnd },
+    };
+    uint64_t *bitmap = malloc(JMapGMBitmapWordCount(rowCount) * sizeof(uint64_t));
+    size_t matches = 0;
+    while (JMapGMBenchmarkKeepRunning(benchmark)) {
+        matches = JMapGMShapeQueryEvaluate(&shapes.source, terms, 3, bitmap);
+        JMapGMBenchmarkUse(bitmap);
+    }
+    JMapGMBenchmarkSetItemsPerIteration(benchmark, (int64_t)rowCount);
+    JMapGMBenchmarkSetCounter(benchmark, "matches", (double)matches);
+    if (JMapGMBenchmarkIsSmoke(benchmark)) {
+        // Scanning the bounds without the R-tree must agree.
+        JMapGMShapeSource scan = shapes.source;
+        scan.index = NULL;
+        uint64_t *expected = malloc(JMapGMBitmapWordCount(rowCount) * sizeof(uint64_t));
+        size_t scanned = JMapGMShapeQueryEvaluate(&scan, terms, 3, expected);
+        bool same = scanned == matches && memcmp(expected, bitmap, JMapGMBitmapWordCount(rowCount) * sizeof(uint64_t)) == 0;
+        JMapGMBenchmarkCheck(benchmark, same && matches > 0, "near query matches a scan of the bounds");
+        JMapGMQueryTerm within[] = { { .op = JMapGMQueryWithin, .rect = floorBounds } };
+        JMapGMBenchmarkCheck(benchmark, JMapGMShapeQueryEvaluate(&shapes.source, within, 1, bitmap) >= rowCount / 5, "within finds every unit of the floor");
+        free(expected);
+    }
+    free(bitmap);
+    JMapGMBenchmarkShapesFree(&shapes);
+}
+
+const JMapGMBenchmarkEntry JMapGMAttributeBenchmarks[] = {
+    /** Units across 5 floors */
+    { "AttributeBuild", JMapGMBenchmarkAttributeBuild, { 1000, 10000, 100000 } },
+    { "AttributeMatch", JMapGMBenchmarkAttributeMatch, { 1000, 10000, 100000 } },
+    { "AttributeScan", JMapGMBenchmarkAttributeScan, { 1000, 10000, 100000 } },
+    { "QueryAttributes", JMapGMBenchmarkQueryAttributes, { 1000, 10000, 100000 } },
+    { "QueryNear", JMapGMBenchmarkQueryNear, { 1000, 10000, 100000 } },
+    { NULL, NULL, { 0 } },
+};
@@ -0,0 +1,195 @@
+//
+//  JMapGMBenchmark.c
+//  JMapOutdoorIndoorKit Benchmarks
+//
+//  Copyright © 2026 Jibestream. All rights reserved.
+//
+
+#include "JMapGMBenchmark.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define JMAPGM_BENCHMARK_MAX_COUNTERS 4
+
+struct JMapGMBenchmark {
+    int64_t arg;
+    bool smoke;
+    uint64_t iterations;
+    uint64_t remaining;
+    bool started;
+    int64_t start;
+    int64_t elapsed;
+    int64_t items;
+    size_t counterCount;
+    const char *counterNames[JMAPGM_BENCHMARK_MAX_COUNTERS];
+    double counterValues[JMAPGM_BENCHMARK_MAX_COUNTERS];
+    bool failed;
+};
+
+static const JMapGMBenchmarkEntry *JMapGMBenchmarkSuites[] = {
+    JMapGMCoreBenchmarks,
+    JMapGMVisibilityBenchmarks,
+    JMapGMClusterBenchmarks,
+    JMapGMAttributeBenchmarks,
+    JMapGMSearchBenchmarks,
+    JMapGMSchedulerBenchmarks,
+    JMapGMSnapshotBenchmarks,
+    JMapGMRouteBenchmarks,
+};
+
+static volatile const void *JMapGMBenchmarkSink;
+
+static int64_t JMapGMBenchmarkNow(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (int64_t)now.tv_sec * 1000000000 + now.tv_nsec;
+}
+
+bool JMapGMBenchmarkKeepRunning(JMapGMBenchmark *benchmark)
+{
+    if (!benchmark->started) {
+        benchmark->started = true;
+        benchmark->start = JMapGMBenchmarkNow();
+    }
+    if (benchmark->remaining > 0 && !benchmark->failed) {
+        benchmark->remaining--;
+        return true;
+    }
+    benchmark->elapsed = JMapGMBenchmarkNow() - benchmark->start;
+    return false;
+}
+
+int64_t JMapGMBenchmarkArg(const JMapGMBenchmark *benchmark)
+{
+    return benchmark->arg;
+}
+
+bool JMapGMBenchmarkIsSmoke(const JMapGMBenchmark *benchmark)
+{
+    return benchmark->smoke;
+}
+
+void JMapGMBenchmarkSetItemsPerIteration(JMapGMBenchmark *benchmark, int64_t items)
+{
+    benchmark->items = items;
+}
+
+void JMapGMBenchmarkSetCounter(JMapGMBenchmark *benchmark, const char *name, double value)
+{
+    for (size_t i = 0; i < benchmark->counterCount; i++) {
+        if (strcmp(benchmark->counterNames[i], name) == 0) {
+            benchmark->counterValues[i] = value;
+            return;
+        }
+    }
+    if (benchmark->counterCount == JMAPGM_BENCHMARK_MAX_COUNTERS) return;
+    benchmark->counterNames[benchmark->counterCount] = name;
+    benchmark->counterValues[benchmark->counterCount++] = value;
+}
+
+void JMapGMBenchmarkCheck(JMapGMBenchmark *benchmark, bool condition, const char *message)
+{
+    if (condition) return;
+    if (!benchmark->failed) fprintf(stderr, "  check failed: %s\n", message);
+    benchmark->failed = true;
+}
+
+void JMapGMBenchmarkUse(const void *value)
+{
+    JMapGMBenchmarkSink = value;
+}
+
+static void JMapGMBenchmarkPrintTime(double nanoseconds)
+{
+    if (nanoseconds < 1e3) printf("%10.1f ns", nanoseconds);
+    else if (nanoseconds < 1e6) printf("%10.2f us", nanoseconds / 1e3);
+    else if (nanoseconds < 1e9) printf("%10.2f ms", nanoseconds / 1e6);
+    else printf("%10.2f s ", nanoseconds / 1e9);
+}
+
+static bool JMapGMBenchmarkRun(const JMapGMBenchmarkEntry *entry, int64_t arg, bool smoke, double minTime)
+{
+    JMapGMBenchmark benchmark;
+    uint64_t iterations = 1;
+    for (;;) {
+        memset(&benchmark, 0, sizeof(benchmark));
+        benchmark.arg = arg;
+        benchmark.smoke = smoke;
+        benchmark.iterations = iterations;
+        benchmark.remaining = iterations;
+        entry->function(&benchmark);
+        if (benchmark.failed || smoke) break;
+        double seconds = benchmark.elapsed / 1e9;
+        if (seconds >= minTime || iterations >= (1ull << 40)) break;
+        // Aim past the minimum time, growing at most 10x per round like Google Benchmark.
+        double scale = seconds > 0 ? 1.4 * minTime / seconds : 10;
+        if (scale > 10) scale = 10;
+        if (scale < 2) scale = 2;
+        iterations = (uint64_t)(iterations * scale);
+    }
+
+    char name[128];
+    if (arg) snprintf(name, sizeof(name), "%s/%lld", entry->name, (long long)arg);
+    else snprintf(name, sizeof(name), "%s", entry->name);
+    printf("%-44s", name);
+    double perIteration = benchmark.iterations ? (double)benchmark.elapsed / benchmark.iterations : 0;
+    JMapGMBenchmarkPrintTime(perIteration);
+    printf(" %12llu", (unsigned long long)benchmark.iterations);
+    if (benchmark.items && perIteration > 0) {
+        printf("  items/s=%.4g", benchmark.items * 1e9 / perIteration);
+    }
+    for (size_t i = 0; i < benchmark.counterCount; i++) {
+        printf("  %s=%.4g", benchmark.counterNames[i], benchmark.counterValues[i]);
+    }
+    printf("%s\n", benchmark.failed ? "  FAILED" : "");
+    fflush(stdout);
+    return !benchmark.failed;
+}
+
+static void JMapGMBenchmarkUsage(const char *program)
+{
+    fprintf(stderr,
+            "usage: %s [--filter=SUBSTRING] [--min-time=SECONDS] [--smoke]\n"
+            "  --smoke runs every benchmark once and only checks results\n",
+            program);
+}
+
+int main(int argc, char **argv)
+{
+    const char *filter = NULL;
+    bool smoke = false;
+    double minTime = 0.5;
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "--filter=", 9) == 0) filter = argv[i] + 9;
+        else if (strncmp(argv[i], "--min-time=", 11) == 0) minTime = atof(argv[i] + 11);
+        else if (strcmp(argv[i], "--smoke") == 0) smoke = true;
+        else {
+            JMapGMBenchmarkUsage(argv[0]);
+            return 2;
+        }
+    }
+
+    printf("%-44s%13s %12s\n", "Benchmark", "Time", "Iterations");
+    printf("--------------------------------------------------------------------------------\n");
+    int failures = 0;
+    for (size_t s = 0; s < sizeof(JMapGMBenchmarkSuites) / sizeof(JMapGMBenchmarkSuites[0]); s++) {
+        for (const JMapGMBenchmarkEntry *entry = JMapGMBenchmarkSuites[s]; entry->name; entry++) {
+            if (filter && !strstr(entry->name, filter)) continue;
+            if (!entry->args[0]) {
+                failures += !JMapGMBenchmarkRun(entry, 0, smoke, minTime);
+                continue;
+            }
+            for (size_t a = 0; a < JMAPGM_BENCHMARK_MAX_ARGS && entry->args[a]; a++) {
+                // Smoke runs only need the smallest size to exercise the checks.
+                if (smoke && a > 0) break;
+                failures += !JMapGMBenchmarkRun(entry, entry->args[a], smoke, minTime);
+            }
+        }
+    }
+    if (failures) fprintf(stderr, "%d benchmark(s) failed\n", failures);
+    return failures ? 1 : 0;
+}
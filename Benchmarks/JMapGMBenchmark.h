@@ -0,0 +1,84 @@
+//
+//  JMapGMBenchmark.h
+//  JMapOutdoorIndoorKit Benchmarks
+//
+//  Copyright © 2026 Jibestream. All rights reserved.
+//
+
+#ifndef JMapGMBenchmark_h
+#define JMapGMBenchmark_h
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ *  Minimal Google Benchmark style harness for the portable C cores.
+ *
+ *  A benchmark function does its setup, then loops on JMapGMBenchmarkKeepRunning.
+ *  Only the loop is timed. The harness calls the function with growing iteration
+ *  counts until the loop runs for the minimum time.
+ */
+typedef struct JMapGMBenchmark JMapGMBenchmark;
+
+typedef void (*JMapGMBenchmarkFunction)(JMapGMBenchmark *benchmark);
+
+#define JMAPGM_BENCHMARK_MAX_ARGS 8
+
+/**
+ *  One registered benchmark, run once per non-zero argument (or once if there are none)
+ */
+typedef struct {
+    const char *name;
+    JMapGMBenchmarkFunction function;
+    int64_t args[JMAPGM_BENCHMARK_MAX_ARGS];
+} JMapGMBenchmarkEntry;
+
+/**
+ *  Returns true while the timed loop should run another iteration.
+ */
+bool JMapGMBenchmarkKeepRunning(JMapGMBenchmark *benchmark);
+
+/**
+ *  The argument of the current run, 0 if the benchmark has none
+ */
+int64_t JMapGMBenchmarkArg(const JMapGMBenchmark *benchmark);
+
+/**
+ *  Whether this is a smoke run: a single iteration used as a test
+ */
+bool JMapGMBenchmarkIsSmoke(const JMapGMBenchmark *benchmark);
+
+/**
+ *  Sets how many items one iteration processes, reported as items per second.
+ */
+void JMapGMBenchmarkSetItemsPerIteration(JMapGMBenchmark *benchmark, int64_t items);
+
+/**
+ *  Reports a named value next to the timing. At most 4 counters per run.
+ */
+void JMapGMBenchmarkSetCounter(JMapGMBenchmark *benchmark, const char *name, double value);
+
+/**
+ *  Fails the run when a result check does not hold. Failures make the process exit non-zero.
+ */
+void JMapGMBenchmarkCheck(JMapGMBenchmark *benchmark, bool condition, const char *message);
+
+/**
+ *  Keeps a computed value alive so the compiler cannot remove the work producing it.
+ */
+void JMapGMBenchmarkUse(const void *value);
+
+/**
+ *  Suites, each terminated by an entry with a NULL name
+ */
+extern const JMapGMBenchmarkEntry JMapGMCoreBenchmarks[];
+extern const JMapGMBenchmarkEntry JMapGMVisibilityBenchmarks[];
+extern const JMapGMBenchmarkEntry JMapGMClusterBenchmarks[];
+extern const JMapGMBenchmarkEntry JMapGMAttributeBenchmarks[];
+extern const JMapGMBenchmarkEntry JMapGMSearchBenchmarks[];
+extern const JMapGMBenchmarkEntry JMapGMSchedulerBenchmarks[];
+extern const JMapGMBenchmarkEntry JMapGMSnapshotBenchmarks[];
+extern const JMapGMBenchmarkEntry JMapGMRouteBenchmarks[];
+
+#endif /* JMapGMBenchmark_h */
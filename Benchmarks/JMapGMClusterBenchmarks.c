@@ -0,0 +1,112 @@
+//
+//  JMapGMClusterBenchmarks.c
+//  JMapOutdoorIndoorKit Benchmarks
+//
+//  Copyright © 2026 Jibestream. All rights reserved.
+//
+
+#include "JMapGMBenchmark.h"
+
+#include "JMapGMClusterIndex.h"
+#include "JMapGMSyntheticVenue.h"
+
+#include <stdlib.h>
+
+// Amenity positions of a venue of 2 x 2 buildings of 5 floors seen from above.
+static JMapGMPoint *JMapGMBenchmarkAmenityPoints(size_t count, JMapGMRect *bounds)
+{
+    JMapGMSyntheticConfig config = JMapGMSyntheticConfigDefault;
+    config.venues = 2;
+    config.buildingsPerVenue = 2;
+    config.floors = 5;
+    config.unitsPerFloor = 2000;
+    config.waypointsPerFloor = 4000;
+    config.amenitiesPerFloor = (uint32_t)((count + 19) / 20);
+    JMapGMSyntheticVenue venue;
+    JMapGMSyntheticVenueGenerate(&venue, &config);
+    JMapGMPoint *points = malloc((count + 1) * sizeof(JMapGMPoint));
+    *bounds = JMapGMRectNull;
+    for (size_t i = 0; i < count; i++) {
+        points[i] = venue.waypoints[venue.amenityWaypoints[i]];
+        *bounds = JMapGMRectUnion(*bounds, (JMapGMRect){ points[i].x, points[i].y, points[i].x, points[i].y });
+    }
+    JMapGMSyntheticVenueFree(&venue);
+    return points;
+}
+
+static void JMapGMBenchmarkClusterBuild(JMapGMBenchmark *benchmark)
+{
+    size_t count = (size_t)JMapGMBenchmarkArg(benchmark);
+    JMapGMRect bounds;
+    JMapGMPoint *points = JMapGMBenchmarkAmenityPoints(count, &bounds);
+    while (JMapGMBenchmarkKeepRunning(benchmark)) {
+        JMapGMClusterIndex *index = JMapGMClusterIndexCreate(points, count, NULL);
+        JMapGMBenchmarkCheck(benchmark, index != NULL, "index builds");
+        JMapGMClusterIndexRelease(index);
+    }
+    JMapGMBenchmarkSetItemsPerIteration(benchmark, (int64_t)count);
+    free(points);
+}
+
+typedef struct {
+    const JMapGMClusterIndex *index;
+    size_t points;
+    size_t markers;
+    bool valid;
+} JMapGMBenchmarkClusterCheck;
+
+static bool JMapGMBenchmarkClusterCount(const JMapGMCluster *cluster, void *context)
+{
+    JMapGMBenchmarkClusterCheck *check = context;
+    check->markers++;
+    check->points += cluster->count;
+    return true;
+}
+
+static bool JMapGMBenchmarkClusterValidate(const JMapGMCluster *cluster, void *context)
+{
+    JMapGMBenchmarkClusterCheck *check = context;
+    JMapGMBenchmarkClusterCount(cluster, context);
+    uint32_t *leaves = malloc(cluster->count * sizeof(uint32_t));
+    size_t count = JMapGMClusterIndexGetLeaves(check->index, cluster, leaves, cluster->count);
+    uint32_t expansion = JMapGMClusterIndexGetExpansionZoom(check->index, cluster);
+    check->valid = check->valid && count == cluster->count && expansion >= cluster->zoom &&
+                   (cluster->count == 1 ? leaves[0] == cluster->identifier : expansion > cluster->zoom);
+    free(leaves);
+    return true;
+}
+
+// Markers and update cost by zoom for a whole venue in view, 20,000 amenities.
+static void JMapGMBenchmarkClusterZoom(JMapGMBenchmark *benchmark)
+{
+    const size_t count = 20000;
+    double zoom = (double)JMapGMBenchmarkArg(benchmark);
+    JMapGMRect bounds;
+    JMapGMPoint *points = JMapGMBenchmarkAmenityPoints(count, &bounds);
+    JMapGMClusterIndex *index = JMapGMClusterIndexCreate(points, count, NULL);
+    JMapGMBenchmarkClusterCheck check = { index, 0, 0, true };
+    while (JMapGMBenchmarkKeepRunning(benchmark)) {
+        check.markers = check.points = 0;
+        JMapGMClusterIndexGetClusters(index, bounds, zoom, JMapGMBenchmarkClusterCount, &check);
+    }
+    JMapGMBenchmarkSetCounter(benchmark, "markers", (double)check.markers);
+    JMapGMBenchmarkCheck(benchmark, check.points == count, "clusters cover every point once");
+    if (JMapGMBenchmarkIsSmoke(benchmark)) {
+        for (double z = 0; z <= 22; z++) {
+            check.markers = check.points = 0;
+            JMapGMClusterIndexGetClusters(index, bounds, z, JMapGMBenchmarkClusterValidate, &check);
+            JMapGMBenchmarkCheck(benchmark, check.points == count, "every level covers every point once");
+        }
+        JMapGMBenchmarkCheck(benchmark, check.valid, "leaves and expansion zooms are consistent");
+    }
+    JMapGMClusterIndexRelease(index);
+    free(points);
+}
+
+const JMapGMBenchmarkEntry JMapGMClusterBenchmarks[] = {
+    /** Points */
+    { "ClusterBuild", JMapGMBenchmarkClusterBuild, { 1000, 10000, 100000 } },
+    /** Camera zoom */
+    { "ClusterZoom", JMapGMBenchmarkClusterZoom, { 14, 16, 17, 18, 19, 20, 21 } },
+    { NULL, NULL, { 0 } },
+};
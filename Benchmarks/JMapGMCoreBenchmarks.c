@@ -0,0 +1,793 @@
+//
+//  JMapGMCoreBenchmarks.c
+//  JMapOutdoorIndoorKit Benchmarks
+//
+//  Copyright © 2026 Jibestream. All rights reserved.
+//
+
+#include "JMapGMBenchmark.h"
+
+#include "JMapGMLocationFilter.h"
+#include "JMapGMPolygon.h"
+#include "JMapGMRouteMatcher.h"
+#include "JMapGMSimplify.h"
+#include "JMapGMTriangulate.h"
+#include "JMapGMSpatialIndex.h"
+#include "JMapGMSyntheticVenue.h"
+#include "JMapGMTrace.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+static JMapGMSyntheticVenue JMapGMBenchmarkVenue(int64_t units)
+{
+    JMapGMSyntheticConfig config = JMapGMSyntheticConfigDefault;
+    config.floors = 1;
+    config.unitsPerFloor = (uint32_t)units;
+    JMapGMSyntheticVenue venue;
+    JMapGMSyntheticVenueGenerate(&venue, &config);
+    return venue;
+}
+
+static JMapGMRect *JMapGMBenchmarkUnitBounds(const JMapGMSyntheticVenue *venue)
+{
+    JMapGMRect *rects = malloc(venue->unitCount * sizeof(JMapGMRect));
+    for (size_t i = 0; i < venue->unitCount; i++) {
+        JMapGMPolygon polygon = JMapGMSyntheticVenueGetUnit(venue, i);
+        rects[i] = JMapGMPolygonGetBounds(&polygon);
+    }
+    return rects;
+}
+
+static JMapGMRect JMapGMBenchmarkVenueBounds(const JMapGMRect *rects, size_t count)
+{
+    JMapGMRect bounds = JMapGMRectNull;
+    for (size_t i = 0; i < count; i++) bounds = JMapGMRectUnion(bounds, rects[i]);
+    return bounds;
+}
+
+static JMapGMPoint JMapGMBenchmarkRandomPoint(JMapGMRect bounds, uint64_t *random)
+{
+    JMapGMPoint point = {
+        bounds.minX + (bounds.maxX - bounds.minX) * JMapGMSyntheticRandomUnit(random),
+        bounds.minY + (bounds.maxY - bounds.minY) * JMapGMSyntheticRandomUnit(random),
+    };
+    return point;
+}
+
+#pragma mark - Indexing
+
+static bool JMapGMBenchmarkCountItem(uint32_t item, void *context)
+{
+    (void)item;
+    (*(size_t *)context)++;
+    return true;
+}
+
+static void JMapGMBenchmarkRTreeBuild(JMapGMBenchmark *benchmark)
+{
+    JMapGMSyntheticVenue venue = JMapGMBenchmarkVenue(JMapGMBenchmarkArg(benchmark));
+    JMapGMRect *rects = JMapGMBenchmarkUnitBounds(&venue);
+    if (JMapGMBenchmarkIsSmoke(benchmark)) {
+        // Small capacities make the upper levels as large as the leaves, e.g. 5 + 3 + 2 + 1 nodes for 9 rects at capacity 2.
+        bool complete = true;
+        for (size_t capacity = 2; capacity <= 4; capacity++) {
+            for (size_t count = 1; count <= 40 && count <= venue.unitCount; count++) {
+                JMapGMRTree *tree = JMapGMRTreeCreate(rects, count, capacity);
+                size_t visited = 0;
+                if (tree) JMapGMRTreeQuery(tree, JMapGMBenchmarkVenueBounds(rects, count), JMapGMBenchmarkCountItem, &visited);
+                complete &= visited == count;
+                JMapGMRTreeRelease(tree);
+            }
+        }
+        JMapGMBenchmarkCheck(benchmark, complete, "trees of small capacity hold every rect");
+    }
+    while (JMapGMBenchmarkKeepRunning(benchmark)) {
+        JMapGMRTree *tree = JMapGMRTreeCreate(rects, venue.unitCount, 0);
+        JMapGMBenchmarkCheck(benchmark, tree && !JMapGMRectIsNull(JMapGMRTreeGetBounds(tree)), "tree has bounds");
+        JMapGMRTreeRelease(tree);
+    }
+    JMapGMBenchmarkSetItemsPerIteration(benchmark, (int64_t)venue.unitCount);
+    free(rects);
+    JMapGMSyntheticVenueFree(&venue);
+}
+
+typedef struct {
+    const JMapGMSyntheticVenue *venue;
+    JMapGMPoint point;
+    int64_t hit;
+} JMapGMHitTest;
+
+static bool JMapGMBenchmarkVisitHit(uint32_t item, void *context)
+{
+    JMapGMHitTest *test = context;
+    JMapGMPolygon polygon = JMapGMSyntheticVenueGetUnit(test->venue, item);
+    if (!JMapGMPolygonContainsPoint(&polygon, test->point)) return true;
+    test->hit = item;
+    return false;
+}
+
+static int64_t JMapGMBenchmarkHitTestLinear(const JMapGMSyntheticVenue *venue, JMapGMPoint point)
+{
+    for (size_t i = 0; i < venue->unitCount; i++) {
+        JMapGMPolygon polygon = JMapGMSyntheticVenueGetUnit(venue, i);
+        if (JMapGMPolygonContainsPoint(&polygon, point)) return (int64_t)i;
+    }
+    return -1;
+}
+
+static void JMapGMBenchmarkHitTest(JMapGMBenchmark *benchmark)
+{
+    JMapGMSyntheticVenue venue = JMapGMBenchmarkVenue(JMapGMBenchmarkArg(benchmark));
+    JMapGMRect *rects = JMapGMBenchmarkUnitBounds(&venue);
+    JMapGMRect bounds = JMapGMBenchmarkVenueBounds(rects, venue.unitCount);
+    JMapGMRTree *tree = JMapGMRTreeCreate(rects, venue.unitCount, 0);
+    uint64_t random = 7;
+
+    if (JMapGMBenchmarkIsSmoke(benchmark)) {
+        for (int i = 0; i < 500; i++) {
+            JMapGMHitTest test = { &venue, JMapGMBenchmarkRandomPoint(bounds, &random), -1 };
+            JMapGMRTreeQueryPoint(tree, test.point, JMapGMBenchmarkVisitHit, &test);
+            JMapGMBenchmarkCheck(benchmark, test.hit == JMapGMBenchmarkHitTestLinear(&venue, test.point), "indexed hit matches linear scan");
+        }
+    }
+
+    int64_t hits = 0;
+    while (JMapGMBenchmarkKeepRunning(benchmark)) {
+        JMapGMHitTest test = { &venue, JMapGMBenchmarkRandomPoint(bounds, &random), -1 };
+        JMapGMRTreeQueryPoint(tree, test.point, JMapGMBenchmarkVisitHit, &test);
+        hits += test.hit >= 0;
+    }
+    JMapGMBenchmarkUse(&hits);
+    JMapGMRTreeRelease(tree);
+    free(rects);
+    JMapGMSyntheticVenueFree(&venue);
+}
+
+static void JMapGMBenchmarkBounds(JMapGMBenchmark *benchmark)
+{
+    JMapGMSyntheticVenue venue = JMapGMBenchmarkVenue(JMapGMBenchmarkArg(benchmark));
+    JMapGMRect bounds = JMapGMRectNull;
+    while (JMapGMBenchmarkKeepRunning(benchmark)) {
+        bounds = JMapGMRectNull;
+        for (size_t i = 0; i < venue.unitCount; i++) {
+            JMapGMPolygon polygon = JMapGMSyntheticVenueGetUnit(&venue, i);
+            bounds = JMapGMRectUnion(bounds, JMapGMPolygonGetBounds(&polygon));
+        }
+        JMapGMBenchmarkUse(&bounds);
+    }
+    JMapGMBenchmarkCheck(benchmark, !JMapGMRectIsNull(bounds), "venue has bounds");
+    JMapGMBenchmarkSetItemsPerIteration(benchmark, (int64_t)venue.unitStarts[venue.unitCount]);
+    JMapGMSyntheticVenueFree(&venue);
+}
+
+static JMapGMRect JMapGMBenchmarkScalarBounds(const JMapGMPoint *points, size_t count)
+{
+    JMapGMRect rect = JMapGMRectNull;
+    for (size_t i = 0; i < count; i++) {
+        JMapGMRect point = { points[i].x, points[i].y, points[i].x, points[i].y };
+        rect = JMapGMRectUnion(rect, point);
+    }
+    return rect;
+}
+
+static bool JMapGMBenchmarkRectEqual(JMapGMRect a, JMapGMRect b)
+{
+    return a.minX == b.minX && a.minY == b.minY && a.maxX == b.maxX && a.maxY == b.maxY;
+}
+
+static void JMapGMBenchmarkPackedBounds(JMapGMBenchmark *benchmark)
+{
+    JMapGMSyntheticVenue venue = JMapGMBenchmarkVenue(JMapGMBenchmarkArg(benchmark));
+    size_t count = venue.unitStarts[venue.unitCount];
+    JMapGMRect bounds = JMapGMRectNull;
+    while (JMapGMBenchmarkKeepRunning(benchmark)) {
+        bounds = JMapGMPointsGetBounds(venue.unitPoints, count);
+        JMapGMBenchmarkUse(&bounds);
+    }
+    JMapGMBenchmarkSetItemsPerIteration(benchmark, (int64_t)count);
+    if (JMapGMBenchmarkIsSmoke(benchmark)) {
+        JMapGMBenchmarkCheck(benchmark, JMapGMBenchmarkRectEqual(bounds, JMapGMBenchmarkScalarBounds(venue.unitPoints, count)),
+                             "vector bounds match scalar");
+        // Odd lengths and offsets exercise the scalar tail.
+        for (size_t n = 0; n < 7; n++) {
+            JMapGMRect vector = JMapGMPointsGetBounds(venue.unitPoints + 1, n);
+            JMapGMBenchmarkCheck(benchmark, JMapGMBenchmarkRectEqual(vector, JMapGMBenchmarkScalarBounds(venue.unitPoints + 1, n)),
+                                 "vector bounds match scalar on short buffers");
+        }
+        JMapGMPoint gap[3] = { { 1, 2 }, { NAN, NAN }, { -1, 5 } };
+        JMapGMRect expected = { -1, 2, 1, 5 };
+        JMapGMBenchmarkCheck(benchmark, JMapGMBenchmarkRectEqual(JMapGMPointsGetBounds(gap, 3), expected), "NaN points are skipped");
+        // Units share one point buffer, so every unit after the first starts part way into it.
+        bool own = true;
+        for (size_t i = 0; i < venue.unitCount; i++) {
+            JMapGMPolygon polygon = JMapGMSyntheticVenueGetUnit(&venue, i);
+            uint32_t start = venue.unitStarts[i], end = venue.unitStarts[i + 1];
+            own &= JMapGMBenchmarkRectEqual(JMapGMPolygonGetBounds(&polygon), JMapGMBenchmarkScalarBounds(venue.unitPoints + start, end - start));
+        }
+        JMapGMBenchmarkCheck(benchmark, own, "polygon bounds cover only the polygon's rings");
+    }
+    JMapGMSyntheticVenueFree(&venue);
+}
+
+// Zooming to a search result: the union of cached per-shape bounds.
+static void JMapGMBenchmarkShapeSetBounds(JMapGMBenchmark *benchmark)
+{
+    JMapGMSyntheticVenue venue = JMapGMBenchmarkVenue(JMapGMBenchmarkArg(benchmark));
+    JMapGMRect *rects = JMapGMBenchmarkUnitBounds(&venue);
+    JMapGMRect bounds = JMapGMRectNull;
+    while (JMapGMBenchmarkKeepRunning(benchmark)) {
+        bounds = JMapGMRectsGetUnion(rects, venue.unitCount);
+        JMapGMBenchmarkUse(&bounds);
+    }
+    JMapGMBenchmarkSetItemsPerIteration(benchmark, (int64_t)venue.unitCount);
+    JMapGMRect expected = JMapGMRectNull;
+    for (size_t i = 0; i < venue.unitCount; i++) expected = JMapGMRectUnion(expected, rects[i]);
+    JMapGMBenchmarkCheck(benchmark, JMapGMBenchmarkRectEqual(bounds, expected), "vector union matches scalar");
+    JMapGMBenchmarkCheck(benchmark, JMapGMRectIsNull(JMapGMRectsGetUnion(rects, 0)), "empty union is null");
+    free(rects);
+    JMapGMSyntheticVenueFree(&venue);
+}
+
+#pragma mark - Containment
+
+// A 64 point star with a 16 point hole, about the outline of a large anchor store.
+static JMapGMPoint JMapGMBenchmarkStarPoints[80];
+static const uint32_t JMapGMBenchmarkStarRings[] = { 0, 64, 80 };
+
+static JMapGMPolygon JMapGMBenchmarkStar(void)
+{
+    for (int i = 0; i < 64; i++) {
+        double angle = 2 * M_PI * i / 64, radius = i % 2 ? 60 : 100;
+        JMapGMBenchmarkStarPoints[i] = (JMapGMPoint){ radius * cos(angle), radius * sin(angle) };
+    }
+    for (int i = 0; i < 16; i++) {
+        double angle = 2 * M_PI * i / 16;
+        JMapGMBenchmarkStarPoints[64 + i] = (JMapGMPoint){ 20 * cos(angle), 20 * sin(angle) };
+    }
+    return (JMapGMPolygon){ JMapGMBenchmarkStarPoints, JMapGMBenchmarkStarRings, 2 };
+}
+
+static JMapGMPoint *JMapGMBenchmarkScatter(size_t count, double extent, uint64_t seed)
+{
+    JMapGMPoint *points = malloc(count * sizeof(JMapGMPoint));
+    for (size_t i = 0; i < count; i++) {
+        points[i].x = (JMapGMSyntheticRandomUnit(&seed) * 2 - 1) * extent;
+        points[i].y = (JMapGMSyntheticRandomUnit(&seed) * 2 - 1) * extent;
+    }
+    // Vertices and an edge midpoint probe the boundary rules.
+    if (count > 3) {
+        points[0] = JMapGMBenchmarkStarPoints[0];
+        points[1] = JMapGMBenchmarkStarPoints[65];
+        points[2] = (JMapGMPoint){ (JMapGMBenchmarkStarPoints[3].x + JMapGMBenchmarkStarPoints[4].x) / 2,
+                                   (JMapGMBenchmarkStarPoints[3].y + JMapGMBenchmarkStarPoints[4].y) / 2 };
+    }
+    return points;
+}
+
+static void JMapGMBenchmarkContainsScalar(JMapGMBenchmark *benchmark)
+{
+    size_t count = (size_t)JMapGMBenchmarkArg(benchmark);
+    JMapGMPolygon star = JMapGMBenchmarkStar();
+    JMapGMPoint *points = JMapGMBenchmarkScatter(count, 100, 7);
+    size_t inside = 0;
+    while (JMapGMBenchmarkKeepRunning(benchmark)) {
+        inside = 0;
+        for (size_t i = 0; i < count; i++) inside += JMapGMPolygonContainsPoint(&star, points[i]);
+        JMapGMBenchmarkUse(&inside);
+    }
+    JMapGMBenchmarkSetItemsPerIteration(benchmark, (int64_t)count);
+    JMapGMBenchmarkSetCounter(benchmark, "inside%", 100.0 * inside / count);
+    free(points);
+}
+
+static void JMapGMBenchmarkContainsBatch(JMapGMBenchmark *benchmark)
+{
+    size_t count = (size_t)JMapGMBenchmarkArg(benchmark);
+    JMapGMPolygon star = JMapGMBenchmarkStar();
+    JMapGMPoint *points = JMapGMBenchmarkScatter(count, 100, 7);
+    bool *inside = malloc(count * sizeof(bool));
+    size_t insideCount = 0;
+    while (JMapGMBenchmarkKeepRunning(benchmark)) {
+        insideCount = JMapGMPolygonContainsPoints(&star, points, count, inside);
+        JMapGMBenchmarkUse(inside);
+    }
+    JMapGMBenchmarkSetItemsPerIteration(benchmark, (int64_t)count);
+    JMapGMBenchmarkSetCounter(benchmark, "inside%", 100.0 * insideCount / count);
+    if (JMapGMBenchmarkIsSmoke(benchmark)) {
+        size_t mismatches = 0, expected = 0;
+        for (size_t i = 0; i < count; i++) {
+            bool reference = JMapGMPolygonContainsPoint(&star, points[i]);
+            mismatches += reference != inside[i];
+            expected += reference;
+        }
+        JMapGMBenchmarkCheck(benchmark, mismatches == 0 && expected == insideCount, "batch containment matches scalar");
+        // Every length up to a few blocks exercises the scalar tail.
+        for (size_t n = 0; n < 37; n++) {
+            size_t tailCount = JMapGMPolygonContainsPoints(&star, points + 1, n, inside);
+            size_t tailExpected = 0;
+            for (size_t i = 0; i < n; i++) {
+                tailExpected += JMapGMPolygonContainsPoint(&star, points[1 + i]);
+                mismatches += JMapGMPolygonContainsPoint(&star, points[1 + i]) != inside[i];
+            }
+            JMapGMBenchmarkCheck(benchmark, mismatches == 0 && tailCount == tailExpected, "short batches match scalar");
+        }
+    }
+    free(inside);
+    free(points);
+}
+
+// One tap against every unit of a floor, as after a coarse candidate lookup.
+static void JMapGMBenchmarkPolygonsContainingPoint(JMapGMBenchmark *benchmark)
+{
+    JMapGMSyntheticConfig config = JMapGMSyntheticConfigDefault;
+    config.floors = 1;
+    config.unitsPerFloor = 64;
+    config.verticesPerUnit = (uint32_t)JMapGMBenchmarkArg(benchmark);
+    JMapGMSyntheticVenue venue;
+    JMapGMSyntheticVenueGenerate(&venue, &config);
+    JMapGMPolygon *polygons = malloc(venue.unitCount * sizeof(JMapGMPolygon));
+    for (size_t i = 0; i < venue.unitCount; i++) polygons[i] = JMapGMSyntheticVenueGetUnit(&venue, i);
+    JMapGMRect *rects = JMapGMBenchmarkUnitBounds(&venue);
+    JMapGMRect bounds = JMapGMBenchmarkVenueBounds(rects, venue.unitCount);
+    uint32_t *indices = malloc(venue.unitCount * sizeof(uint32_t));
+    uint64_t random = 11;
+    size_t hits = 0, queries = 0;
+    while (JMapGMBenchmarkKeepRunning(benchmark)) {
+        JMapGMPoint point = JMapGMBenchmarkRandomPoint(bounds, &random);
+        hits += JMapGMPolygonsContainingPoint(polygons, venue.unitCount, point, indices);
+        queries++;
+    }
+    JMapGMBenchmarkSetItemsPerIteration(benchmark, (int64_t)venue.unitCount);
+    JMapGMBenchmarkSetCounter(benchmark, "hit%", queries ? 100.0 * hits / queries : 0);
+    if (JMapGMBenchmarkIsSmoke(benchmark)) {
+        bool same = true;
+        for (int q = 0; q < 2000 && same; q++) {
+            JMapGMPoint point = JMapGMBenchmarkRandomPoint(bounds, &random);
+            size_t found = JMapGMPolygonsContainingPoint(polygons, venue.unitCount, point, indices), expected = 0;
+            for (size_t i = 0; i < venue.unitCount; i++) {
+                if (!JMapGMPolygonContainsPoint(&polygons[i], point)) continue;
+                same = same && expected < found && indices[expected] == i;
+                expected++;
+            }
+            same = same && expected == found;
+        }
+        JMapGMBenchmarkCheck(benchmark, same, "edge lanes match scalar");
+    }
+    free(indices);
+    free(rects);
+    free(polygons);
+    JMapGMSyntheticVenueFree(&venue);
+}
+
+#pragma mark - Synthetic data
+
+// Every index points inside its buffer and every link stays on the right floor or building.
+static bool JMapGMBenchmarkVenueIsConsistent(const JMapGMSyntheticVenue *venue)
+{
+    const JMapGMSyntheticConfig *c = &venue->config;
+    if (venue->floorCount != (size_t)c->venues * c->buildingsPerVenue * c->floors) return false;
+    if (venue->unitCount != venue->floorCount * c->unitsPerFloor) return false;
+    for (size_t i = 0; i < venue->unitCount; i++) {
+        if (venue->unitStarts[i + 1] - venue->unitStarts[i] != c->verticesPerUnit) return false;
+        uint32_t waypoint = venue->unitWaypoints[i];
+        if (waypoint >= venue->waypointCount || venue->waypointFloors[waypoint] != venue->unitFloors[i]) return false;
+        JMapGMPolygon polygon = JMapGMSyntheticVenueGetUnit(venue, i);
+        JMapGMRect rect = JMapGMPolygonGetBounds(&polygon);
+        JMapGMPoint centre = { (rect.minX + rect.maxX) / 2, (rect.minY + rect.maxY) / 2 };
+        if (!JMapGMPolygonContainsPoint(&polygon, centre)) return false;
+    }
+    for (size_t i = 0; i < venue->edgeCount; i++) {
+        uint32_t from = venue->edgeFrom[i], to = venue->edgeTo[i];
+        if (from >= venue->waypointCount || to >= venue->waypointCount) return false;
+        uint32_t a = venue->waypointFloors[from], b = venue->waypointFloors[to];
+        bool connector = venue->edgePathTypes[i] != JMAPGM_SYNTHETIC_CORRIDOR;
+        if (connector != (a != b) || venue->edgePathTypes[i] > c->pathTypes) return false;
+        if (connector && (venue->floorVenues[a] != venue->floorVenues[b] ||
+                          venue->floorBuildings[a] != venue->floorBuildings[b] ||
+                          venue->floorLevels[b] != venue->floorLevels[a] + 1)) return false;
+    }
+    for (size_t i = 0; i < venue->amenityCount; i++) {
+        if (venue->amenityWaypoints[i] >= venue->waypointCount || venue->amenityTypes[i] >= c->amenityTypes) return false;
+    }
+    for (size_t i = 0; i < venue->destinationCount; i++) {
+        if (venue->destinationUnits[i] >= venue->unitCount || (i > 0 && venue->destinationUnits[i] <= venue->destinationUnits[i - 1])) return false;
+        if (venue->destinationCategories[i] >= JMapGMSyntheticCategoryCount) return false;
+        if (JMapGMSyntheticVenueGetDestinationName(venue, i)[0] == '\0') return false;
+    }
+    return true;
+}
+
+static JMapGMSyntheticConfig JMapGMBenchmarkCorpusConfig(int64_t units)
+{
+    JMapGMSyntheticConfig config = JMapGMSyntheticConfigDefault;
+    config.venues = 2;
+    config.buildingsPerVenue = 2;
+    config.unitsPerFloor = (uint32_t)units;
+    config.waypointsPerFloor = (uint32_t)units * 2;
+    config.destinationsPerFloor = (uint32_t)units / 2;
+    return config;
+}
+
+// Unit outlines of one floor simplified to 10 cm, as when preparing overlays.
+static void JMapGMBenchmarkSimplify(JMapGMBenchmark *benchmark)
+{
+    JMapGMSyntheticConfig config = JMapGMSyntheticConfigDefault;
+    config.floors = 1;
+    config.verticesPerUnit = (uint32_t)JMapGMBenchmarkArg(benchmark);
+    JMapGMSyntheticVenue venue;
+    JMapGMSyntheticVenueGenerate(&venue, &config);
+    const double tolerance = 0.1 / 111320.0;
+    const double xScale = cos(venue.unitPoints[0].y * M_PI / 180.0);
+    size_t total = venue.unitStarts[venue.unitCount];
+    JMapGMPoint *output = malloc(total * sizeof(JMapGMPoint));
+    size_t *counts = malloc(venue.unitCount * sizeof(size_t));
+    size_t kept = 0;
+    while (JMapGMBenchmarkKeepRunning(benchmark)) {
+        kept = 0;
+        for (size_t i = 0; i < venue.unitCount; i++) {
+            uint32_t start = venue.unitStarts[i];
+            counts[i] = JMapGMSimplify(venue.unitPoints + start, venue.unitStarts[i + 1] - start, true, tolerance, xScale, output + start);
+            kept += counts[i];
+        }
+        JMapGMBenchmarkUse(output);
+    }
+    JMapGMBenchmarkSetItemsPerIteration(benchmark, (int64_t)total);
+    JMapGMBenchmarkSetCounter(benchmark, "kept%", 100.0 * kept / total);
+    if (JMapGMBenchmarkIsSmoke(benchmark)) {
+        // Every dropped vertex lies within the tolerance of the simplified ring.
+        size_t far = 0, small = 0;
+        for (size_t i = 0; i < venue.unitCount; i++) {
+            uint32_t start = venue.unitStarts[i], end = venue.unitStarts[i + 1];
+            const JMapGMPoint *ring = output + start;
+            small += counts[i] < 3;
+            for (uint32_t v = start; v < end && counts[i] >= 3; v++) {
+                JMapGMPoint p = venue.unitPoints[v];
+                double nearest = INFINITY;
+                for (size_t k = 0; k < counts[i]; k++) {
+                    JMapGMPoint a = ring[k], b = ring[(k + 1) % counts[i]];
+                    double dx = (b.x - a.x) * xScale, dy = b.y - a.y;
+                    double px = (p.x - a.x) * xScale, py = p.y - a.y;
+                    double length = dx * dx + dy * dy;
+                    double t = length > 0 ? (px * dx + py * dy) / length : 0;
+                    t = t < 0 ? 0 : t > 1 ? 1 : t;
+                    double ex = px - t * dx, ey = py - t * dy;
+                    if (ex * ex + ey * ey < nearest) nearest = ex * ex + ey * ey;
+                }
+                far += nearest > tolerance * tolerance * 1.000001;
+            }
+        }
+        JMapGMBenchmarkCheck(benchmark, small == 0, "simplified rings keep at least 3 vertices");
+        JMapGMBenchmarkCheck(benchmark, far == 0, "dropped vertices lie within the tolerance");
+        JMapGMPoint triangle[4] = { { 0, 0 }, { 1, 0 }, { 0, 1 }, { 0, 0 } };
+        JMapGMPoint line[3] = { { 0, 0 }, { 1, 1e-9 }, { 2, 0 } };
+        JMapGMBenchmarkCheck(benchmark, JMapGMSimplify(triangle, 4, true, 10, 1, output) == 3, "triangles are kept whole");
+        JMapGMBenchmarkCheck(benchmark, JMapGMSimplify(line, 3, false, 1e-6, 1, output) == 2, "collinear vertices are dropped");
+    }
+    free(counts);
+    free(output);
+    JMapGMSyntheticVenueFree(&venue);
+}
+
+#pragma mark - Triangulation
+
+// Whether a triangulation covers exactly the polygon: every index lies in the rings, no triangle
+// is empty, and at scattered points the number of triangles containing the point matches the
+// even-odd test.
+static bool JMapGMBenchmarkTrianglesCover(const JMapGMPolygon *polygon, size_t firstRing, size_t ringCount, const uint32_t *indices, size_t count)
+{
+    uint32_t start = polygon->ringStarts[firstRing], end = polygon->ringStarts[firstRing + ringCount];
+    if (count % 3 != 0) return false;
+    for (size_t i = 0; i < count; i++) {
+        if (indices[i] < start || indices[i] >= end) return false;
+    }
+    for (size_t t = 0; t < count; t += 3) {
+        JMapGMPoint a = polygon->points[indices[t]], b = polygon->points[indices[t + 1]], c = polygon->points[indices[t + 2]];
+        if ((b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x) == 0) return false;
+    }
+    JMapGMPolygon part = { polygon->points, polygon->ringStarts + firstRing, ringCount };
+    JMapGMRect bounds = JMapGMPolygonGetBounds(&part);
+    uint64_t random = 7;
+    for (int s = 0; s < 500; s++) {
+        JMapGMPoint p = { bounds.minX + JMapGMSyntheticRandomUnit(&random) * (bounds.maxX - bounds.minX),
+                          bounds.minY + JMapGMSyntheticRandomUnit(&random) * (bounds.maxY - bounds.minY) };
+        int covering = 0;
+        for (size_t t = 0; t < count; t += 3) {
+            JMapGMPoint a = polygon->points[indices[t]], b = polygon->points[indices[t + 1]], c = polygon->points[indices[t + 2]];
+            double d1 = (b.x - a.x) * (p.y - a.y) - (b.y - a.y) * (p.x - a.x);
+            double d2 = (c.x - b.x) * (p.y - b.y) - (c.y - b.y) * (p.x - b.x);
+            double d3 = (a.x - c.x) * (p.y - c.y) - (a.y - c.y) * (p.x - c.x);
+            covering += (d1 > 0 && d2 > 0 && d3 > 0) || (d1 < 0 && d2 < 0 && d3 < 0);
+        }
+        if (covering != (int)JMapGMPolygonContainsPoint(&part, p)) return false;
+    }
+    return JMapGMTriangulationDeviation(polygon, firstRing, ringCount, indices, count) < 1e-6;
+}
+
+#define JMAPGM_BENCHMARK_CASE_CAPACITY 1280
+
+// Triangulates a polygon given as rings of points and checks the result against the reference.
+static bool JMapGMBenchmarkTriangulateCase(const JMapGMPoint *points, const uint32_t *ringStarts, size_t ringCount, size_t expected)
+{
+    JMapGMPolygon polygon = { points, ringStarts, ringCount };
+    uint32_t indices[JMAPGM_BENCHMARK_CASE_CAPACITY];
+    if (JMapGMTriangulationCapacity(ringStarts[ringCount], ringCount) > JMAPGM_BENCHMARK_CASE_CAPACITY) return false;
+    size_t count = JMapGMTriangulate(&polygon, 0, ringCount, indices);
+    if (count == JMAPGM_TRIANGULATE_FAILED) return false;
+    if (expected != SIZE_MAX && count != expected) return false;
+    return JMapGMBenchmarkTrianglesCover(&polygon, 0, ringCount, indices, count);
+}
+
+static void JMapGMBenchmarkTriangulateDegenerate(JMapGMBenchmark *benchmark)
+{
+    static const JMapGMPoint square[] = { { 0, 0 }, { 10, 0 }, { 10, 10 }, { 0, 10 }, { 0, 0 } };
+    static const uint32_t closed[] = { 0, 5 }, open[] = { 0, 4 }, empty[] = { 0, 0 }, two[] = { 0, 2 };
+    JMapGMBenchmarkCheck(benchmark, JMapGMBenchmarkTriangulateCase(square, closed, 1, 6), "a closed square is two triangles");
+    JMapGMBenchmarkCheck(benchmark, JMapGMBenchmarkTriangulateCase(square, open, 1, 6), "an open square is two triangles");
+    JMapGMBenchmarkCheck(benchmark, JMapGMBenchmarkTriangulateCase(square, empty, 1, 0), "an empty ring has no triangles");
+    JMapGMBenchmarkCheck(benchmark, JMapGMBenchmarkTriangulateCase(square, two, 1, 0), "two points have no triangles");
+
+    static const JMapGMPoint line[] = { { 0, 0 }, { 1, 1 }, { 2, 2 }, { 3, 3 } };
+    static const uint32_t lineRing[] = { 0, 4 };
+    JMapGMBenchmarkCheck(benchmark, JMapGMBenchmarkTriangulateCase(line, lineRing, 1, 0), "collinear points have no triangles");
+
+    static const JMapGMPoint repeated[] = { { 0, 0 }, { 0, 0 }, { 5, 0 }, { 10, 0 }, { 10, 0 }, { 10, 10 }, { 0, 10 }, { 0, 5 } };
+    static const uint32_t repeatedRing[] = { 0, 8 };
+    JMapGMBenchmarkCheck(benchmark, JMapGMBenchmarkTriangulateCase(repeated, repeatedRing, 1, SIZE_MAX),
+                         "duplicate and collinear points leave no empty triangles");
+
+    // A hole touching the outline at a vertex, and a hole of a single point.
+    static const JMapGMPoint holes[] = { { 0, 0 }, { 10, 0 }, { 10, 10 }, { 0, 10 },
+                                         { 0, 0 }, { 4, 2 }, { 2, 4 },
+                                         { 7, 7 } };
+    static const uint32_t holeRings[] = { 0, 4, 7, 8 };
+    JMapGMBenchmarkCheck(benchmark, JMapGMBenchmarkTriangulateCase(holes, holeRings, 2, SIZE_MAX), "a hole may touch the outline");
+    JMapGMBenchmarkCheck(benchmark, JMapGMBenchmarkTriangulateCase(holes, holeRings, 3, SIZE_MAX), "a single point hole is a steiner point");
+
+    // A bow tie crosses itself; its triangles must stay in range without covering it exactly.
+    static const JMapGMPoint bowTie[] = { { 0, 0 }, { 10, 10 }, { 10, 0 }, { 0, 10 } };
+    static const uint32_t bowTieRing[] = { 0, 4 };
+    JMapGMPolygon polygon = { bowTie, bowTieRing, 1 };
+    uint32_t indices[32];
+    size_t count = JMapGMTriangulate(&polygon, 0, 1, indices);
+    bool inRange = count != JMAPGM_TRIANGULATE_FAILED && count <= JMapGMTriangulationCapacity(4, 1);
+    for (size_t i = 0; inRange && i < count; i++) inRange = indices[i] < 4;
+    JMapGMBenchmarkCheck(benchmark, inRange, "self-intersecting rings are cut without failing");
+}
+
+// Unit outlines of one floor triangulated as when caching the fills of a map after parsing.
+static void JMapGMBenchmarkTriangulate(JMapGMBenchmark *benchmark)
+{
+    JMapGMSyntheticConfig config = JMapGMSyntheticConfigDefault;
+    config.floors = 1;
+    config.verticesPerUnit = (uint32_t)JMapGMBenchmarkArg(benchmark);
+    JMapGMSyntheticVenue venue;
+    JMapGMSyntheticVenueGenerate(&venue, &config);
+    size_t total = venue.unitStarts[venue.unitCount];
+    uint32_t *indices = malloc(JMapGMTriangulationCapacity(total, venue.unitCount) * sizeof(uint32_t));
+    size_t *offsets = malloc((venue.unitCount + 1) * sizeof(size_t));
+    while (JMapGMBenchmarkKeepRunning(benchmark)) {
+        offsets[0] = 0;
+        for (size_t i = 0; i < venue.unitCount; i++) {
+            JMapGMPolygon unit = JMapGMSyntheticVenueGetUnit(&venue, i);
+            offsets[i + 1] = offsets[i] + JMapGMTriangulate(&unit, 0, unit.ringCount, indices + offsets[i]);
+        }
+        JMapGMBenchmarkUse(indices);
+    }
+    JMapGMBenchmarkSetItemsPerIteration(benchmark, (int64_t)total);
+    JMapGMBenchmarkSetCounter(benchmark, "triangles", (double)offsets[venue.unitCount] / 3);
+    if (JMapGMBenchmarkIsSmoke(benchmark)) {
+        size_t wrong = 0;
+        for (size_t i = 0; i < venue.unitCount; i++) {
+            JMapGMPolygon unit = JMapGMSyntheticVenueGetUnit(&venue, i);
+            wrong += !JMapGMBenchmarkTrianglesCover(&unit, 0, unit.ringCount, indices + offsets[i], offsets[i + 1] - offsets[i]);
+        }
+        JMapGMBenchmarkCheck(benchmark, wrong == 0, "unit triangles cover their outlines exactly");
+        JMapGMPolygon star = JMapGMBenchmarkStar();
+        uint32_t starIndices[3 * 84];
+        size_t count = JMapGMTriangulate(&star, 0, 2, starIndices);
+        JMapGMBenchmarkCheck(benchmark, count == 3 * 80 && JMapGMBenchmarkTrianglesCover(&star, 0, 2, starIndices, count),
+                             "a star with a hole matches the reference");
+        // A 400 point sawtooth is past the hashing threshold.
+        JMapGMPoint saw[402];
+        for (int i = 0; i < 400; i++) saw[i] = (JMapGMPoint){ i, i % 2 ? 3 : 1 };
+        saw[400] = (JMapGMPoint){ 399, 0 };
+        saw[401] = (JMapGMPoint){ 0, 0 };
+        uint32_t sawRing[] = { 0, 402 };
+        JMapGMBenchmarkCheck(benchmark, JMapGMBenchmarkTriangulateCase(saw, sawRing, 1, 3 * 400), "a hashed sawtooth matches the reference");
+        JMapGMBenchmarkTriangulateDegenerate(benchmark);
+    }
+    free(offsets);
+    free(indices);
+    JMapGMSyntheticVenueFree(&venue);
+}
+
+static void JMapGMBenchmarkSyntheticGenerate(JMapGMBenchmark *benchmark)
+{
+    JMapGMSyntheticConfig config = JMapGMBenchmarkCorpusConfig(JMapGMBenchmarkArg(benchmark));
+    JMapGMSyntheticVenue venue = { 0 };
+    while (JMapGMBenchmarkKeepRunning(benchmark)) {
+        JMapGMSyntheticVenueFree(&venue);
+        JMapGMBenchmarkCheck(benchmark, JMapGMSyntheticVenueGenerate(&venue, &config), "corpus generates");
+    }
+    JMapGMBenchmarkSetItemsPerIteration(benchmark, (int64_t)venue.unitStarts[venue.unitCount]);
+    JMapGMBenchmarkSetCounter(benchmark, "floors", (double)venue.floorCount);
+    JMapGMBenchmarkSetCounter(benchmark, "edges", (double)venue.edgeCount);
+    if (JMapGMBenchmarkIsSmoke(benchmark)) {
+        JMapGMBenchmarkCheck(benchmark, JMapGMBenchmarkVenueIsConsistent(&venue), "corpus is consistent");
+        JMapGMSyntheticVenue again;
+        JMapGMSyntheticVenueGenerate(&again, &config);
+        bool same = again.unitCount == venue.unitCount &&
+                    memcmp(again.unitPoints, venue.unitPoints, venue.unitStarts[venue.unitCount] * sizeof(JMapGMPoint)) == 0 &&
+                    memcmp(again.destinationNames, venue.destinationNames,
+                           venue.destinationNameStarts[venue.destinationCount - 1] + 1) == 0;
+        JMapGMBenchmarkCheck(benchmark, same, "corpus is deterministic");
+        JMapGMSyntheticVenueFree(&again);
+    }
+    JMapGMSyntheticVenueFree(&venue);
+}
+
+#pragma mark - User location
+
+// A walk along an L-shaped corridor in meters, sampled at 15 Hz at 1.3 m/s.
+static JMapGMPoint JMapGMBenchmarkWalk(double t)
+{
+    double distance = 1.3 * t;
+    JMapGMPoint point = distance < 60 ? (JMapGMPoint){ distance, 0 } : (JMapGMPoint){ 60, distance - 60 };
+    return point;
+}
+
+static double JMapGMBenchmarkNoise(uint64_t *random, double sigma)
+{
+    // Sum of uniforms, close enough to gaussian for positioning noise.
+    double sum = 0;
+    for (int i = 0; i < 4; i++) sum += JMapGMSyntheticRandomUnit(random) - 0.5;
+    return sum * sigma * 1.7320508;
+}
+
+static void JMapGMBenchmarkLocationReplay(JMapGMBenchmark *benchmark)
+{
+    int64_t fixes = JMapGMBenchmarkArg(benchmark);
+    JMapGMLocationFix *trace = malloc((size_t)fixes * sizeof(JMapGMLocationFix));
+    uint64_t random = 3;
+    static const int map = 1;
+    for (int64_t i = 0; i < fixes; i++) {
+        double t = i / 15.0;
+        JMapGMPoint truth = JMapGMBenchmarkWalk(fmod(t, 120));
+        trace[i] = (JMapGMLocationFix){
+            truth.x + JMapGMBenchmarkNoise(&random, 1.5), truth.y + JMapGMBenchmarkNoise(&random, 1.5),
+            NAN, 2, t, &map,
+        };
+    }
+
+    double rawError = 0, filteredError = 0;
+    size_t published = 0, frames = 0;
+    while (JMapGMBenchmarkKeepRunning(benchmark)) {
+        JMapGMLocationQueue *queue = JMapGMLocationQueueCreate(64);
+        JMapGMLocationFilter filter;
+        JMapGMLocationFilterInit(&filter, NULL);
+        rawError = filteredError = 0;
+        published = frames = 0;
+        int64_t next = 0;
+        // Drain at 60 Hz as a display link would.
+        for (double now = 0; next < fixes; now += 1.0 / 60) {
+            while (next < fixes && trace[next].timestamp <= now) JMapGMLocationQueuePush(queue, &trace[next++]);
+            JMapGMLocationFix fix, out;
+            while (JMapGMLocationQueuePop(queue, &fix)) {
+                JMapGMPoint truth = JMapGMBenchmarkWalk(fmod(fix.timestamp, 120));
+                rawError += hypot(fix.x - truth.x, fix.y - truth.y);
+                JMapGMLocationFilterAddFix(&filter, &fix);
+                filteredError += hypot(filter.x - truth.x, filter.y - truth.y);
+            }
+            frames++;
+            published += JMapGMLocationFilterPublish(&filter, now, &out);
+        }
+        JMapGMLocationQueueRelease(queue);
+    }
+    JMapGMBenchmarkSetItemsPerIteration(benchmark, fixes);
+    JMapGMBenchmarkSetCounter(benchmark, "rawErr_m", rawError / fixes);
+    JMapGMBenchmarkSetCounter(benchmark, "filteredErr_m", filteredError / fixes);
+    JMapGMBenchmarkSetCounter(benchmark, "published/frame", frames ? (double)published / frames : 0);
+    JMapGMBenchmarkCheck(benchmark, filteredError < rawError, "filter reduces position error");
+    JMapGMBenchmarkCheck(benchmark, published < frames, "unchanged frames are not published");
+    free(trace);
+}
+
+static void JMapGMBenchmarkRouteReplay(JMapGMBenchmark *benchmark)
+{
+    int64_t fixes = JMapGMBenchmarkArg(benchmark);
+    JMapGMPoint route[] = { { 0, 0 }, { 60, 0 }, { 60, 96 } };
+    JMapGMSegmentIndex *index = JMapGMSegmentIndexCreate(8);
+    JMapGMSegmentIndexAddPolyline(index, route, 3, 0);
+    JMapGMSegmentIndexBuild(index);
+
+    if (JMapGMBenchmarkIsSmoke(benchmark)) {
+        // Two floors stacked on the same footprint, the lower one numbered 0 to 1 and the upper one 2.
+        JMapGMPoint lower[] = { { 0, 0 }, { 10, 0 } };
+        JMapGMPoint upper[] = { { 0, 1 }, { 10, 1 } };
+        JMapGMSegmentIndex *floors = JMapGMSegmentIndexCreate(8);
+        JMapGMSegmentIndexAddPolyline(floors, lower, 2, 0);
+        JMapGMSegmentIndexAddPolyline(floors, lower, 2, 1);
+        JMapGMSegmentIndexAddPolyline(floors, upper, 2, 2);
+        JMapGMSegmentIndexBuild(floors);
+        JMapGMRouteMatcher matcher;
+        JMapGMRouteMatcherInit(&matcher, floors, (JMapGMRouteMatcherConfig){ 3, 8, 1 });
+        JMapGMSnapResult result;
+        JMapGMPoint nearUpper = { 5, 1.2 };
+        bool lowerOnly = JMapGMRouteMatcherMatchGroups(&matcher, nearUpper, 0, 1, &result) == JMapGMMatchStateSnapped && result.group <= 1;
+        bool upperOnly = JMapGMRouteMatcherMatchGroups(&matcher, nearUpper, 2, 2, &result) == JMapGMMatchStateSnapped && result.group == 2;
+        bool noFloor = JMapGMRouteMatcherMatchGroups(&matcher, nearUpper, 3, 2, &result) == JMapGMMatchStateReroute;
+        JMapGMBenchmarkCheck(benchmark, lowerOnly && upperOnly, "matching stays within the given floor");
+        JMapGMBenchmarkCheck(benchmark, noFloor, "a floor without route is off route");
+        JMapGMSegmentIndexRelease(floors);
+    }
+
+    // Noisy fixes with occasional 12m outliers, and one sustained detour per lap.
+    JMapGMPoint *trace = malloc((size_t)fixes * sizeof(JMapGMPoint));
+    uint64_t random = 5;
+    for (int64_t i = 0; i < fixes; i++) {
+        double t = fmod(i / 15.0, 120);
+        JMapGMPoint point = JMapGMBenchmarkWalk(t);
+        point.x += JMapGMBenchmarkNoise(&random, 2);
+        point.y += JMapGMBenchmarkNoise(&random, 2);
+        if (JMapGMSyntheticRandomUnit(&random) < 0.03) point.y += 12;
+        if (t > 20 && t < 25) point.y += 20;
+        trace[i] = point;
+    }
+
+    JMapGMRouteMatcherStats stats = { 0 };
+    while (JMapGMBenchmarkKeepRunning(benchmark)) {
+        JMapGMRouteMatcher matcher;
+        JMapGMRouteMatcherInit(&matcher, index, (JMapGMRouteMatcherConfig){ 3, 8, 3 });
+        JMapGMSnapResult result;
+        for (int64_t i = 0; i < fixes; i++) {
+            JMapGMRouteMatcherMatch(&matcher, trace[i], -1, &result);
+        }
+        stats = matcher.stats;
+    }
+    JMapGMBenchmarkSetItemsPerIteration(benchmark, fixes);
+    JMapGMBenchmarkSetCounter(benchmark, "snapped%", 100.0 * stats.snapped / stats.fixes);
+    JMapGMBenchmarkSetCounter(benchmark, "reroutes", (double)stats.reroutes);
+    JMapGMBenchmarkSetCounter(benchmark, "avoided", (double)(stats.offRoute - stats.reroutes));
+    JMapGMBenchmarkCheck(benchmark, stats.reroutes > 0, "sustained detour re-routes");
+    JMapGMBenchmarkCheck(benchmark, stats.offRoute > stats.reroutes, "outliers do not all re-route");
+    free(trace);
+    JMapGMSegmentIndexRelease(index);
+}
+
+#pragma mark - Tracing
+
+static void JMapGMBenchmarkTraceScope(JMapGMBenchmark *benchmark)
+{
+    bool enabled = JMapGMBenchmarkArg(benchmark) == 2;
+    JMapGMTraceSetEnabled(enabled);
+    while (JMapGMBenchmarkKeepRunning(benchmark)) {
+        JMAPGM_TRACE_SCOPE("benchmark.scope");
+    }
+    JMapGMTraceSetEnabled(false);
+    JMapGMTraceReset();
+}
+
+const JMapGMBenchmarkEntry JMapGMCoreBenchmarks[] = {
+    { "RTreeBuild", JMapGMBenchmarkRTreeBuild, { 1000, 10000, 100000 } },
+    { "HitTest", JMapGMBenchmarkHitTest, { 1000, 10000, 100000 } },
+    { "Bounds", JMapGMBenchmarkBounds, { 1000, 10000, 100000 } },
+    { "PackedBounds", JMapGMBenchmarkPackedBounds, { 1000, 10000, 100000 } },
+    { "ShapeSetBounds", JMapGMBenchmarkShapeSetBounds, { 3000, 30000 } },
+    { "ContainsScalar", JMapGMBenchmarkContainsScalar, { 100000, 10000000 } },
+    { "ContainsBatch", JMapGMBenchmarkContainsBatch, { 100000, 10000000 } },
+    /** Vertices per unit */
+    { "PolygonsContainingPoint", JMapGMBenchmarkPolygonsContainingPoint, { 8, 64, 512 } },
+    /** Vertices per unit */
+    { "Simplify", JMapGMBenchmarkSimplify, { 64, 512 } },
+    /** Vertices per unit */
+    { "Triangulate", JMapGMBenchmarkTriangulate, { 8, 64, 512 } },
+    /** Units per floor, 12 floors across 2 venues of 2 buildings */
+    { "SyntheticGenerate", JMapGMBenchmarkSyntheticGenerate, { 1000, 10000, 100000 } },
+    { "LocationReplay", JMapGMBenchmarkLocationReplay, { 1800, 18000 } },
+    { "RouteReplay", JMapGMBenchmarkRouteReplay, { 1800, 18000 } },
+    /** 1 = disabled, 2 = enabled */
+    { "TraceScope", JMapGMBenchmarkTraceScope, { 1, 2 } },
+    { NULL, NULL, { 0 } },
+};
@@ -0,0 +1,513 @@
+//
+//  JMapGMRouteBenchmarks.c
+//  JMapOutdoorIndoorKit Benchmarks
+//
+//  Copyright © 2026 Jibestream. All rights reserved.
+//
+
+#include "JMapGMBenchmark.h"
+
+#include "JMapGMPolygon.h"
+#include "JMapGMRoute.h"
+#include "JMapGMSyntheticVenue.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define JMAPGM_BENCHMARK_ROUTE_PAIRS 64
+
+static JMapGMRouteGraph *JMapGMBenchmarkRouteGraph(const JMapGMSyntheticVenue *venue)
+{
+    int32_t *floors = malloc((venue->waypointCount + 1) * sizeof(int32_t));
+    for (size_t i = 0; i < venue->waypointCount; i++) floors[i] = (int32_t)venue->waypointFloors[i];
+    JMapGMRouteGraph *graph = JMapGMRouteGraphCreate(venue->waypoints, floors, venue->waypointCount,
+                                                     venue->edgeFrom, venue->edgeTo, venue->edgePathTypes, venue->edgeCount);
+    free(floors);
+    return graph;
+}
+
+static JMapGMSyntheticConfig JMapGMBenchmarkRouteConfig(int64_t waypointsPerFloor)
+{
+    JMapGMSyntheticConfig config = JMapGMSyntheticConfigDefault;
+    config.floors = 4;
+    config.waypointsPerFloor = (uint32_t)waypointsPerFloor;
+    config.unitsPerFloor = (uint32_t)(waypointsPerFloor / 2);
+    config.destinationsPerFloor = config.unitsPerFloor / 2;
+    return config;
+}
+
+// Whether consecutive nodes of a route are joined by an edge of the venue.
+static bool JMapGMBenchmarkRouteIsConnected(const JMapGMSyntheticVenue *venue, const JMapGMRoute *route)
+{
+    for (size_t i = 0; i + 1 < route->nodeCount; i++) {
+        uint32_t a = route->nodes[i], b = route->nodes[i + 1];
+        bool found = false;
+        for (size_t e = 0; e < venue->edgeCount && !found; e++) {
+            found = (venue->edgeFrom[e] == a && venue->edgeTo[e] == b) || (venue->edgeFrom[e] == b && venue->edgeTo[e] == a);
+        }
+        if (!found) return false;
+    }
+    return true;
+}
+
+// Packing, segments and search edge cases on a hand built two floor network.
+static void JMapGMBenchmarkRouteCheckRules(JMapGMBenchmark *benchmark)
+{
+    // Floor 1: 0 - 1 - 2 east along the equator; floor 2: 3 above 2, then 4; 5 is unconnected.
+    const JMapGMPoint points[] = { { 0, 0 }, { 0.001, 0 }, { 0.002, 0 }, { 0.002, 0 }, { 0.002, 0.001 }, { 1, 1 } };
+    const int32_t floors[] = { 1, 1, 1, 2, 2, 1 };
+    const uint32_t from[] = { 0, 1, 2, 3, 0, 9 };
+    const uint32_t to[] = { 1, 2, 3, 4, 2, 0 };
+    while (JMapGMBenchmarkKeepRunning(benchmark)) {
+        JMapGMRouteGraph *graph = JMapGMRouteGraphCreate(points, floors, 6, from, to, NULL, 6);
+        JMapGMBenchmarkCheck(benchmark, JMapGMRouteGraphGetEdgeCount(graph) == 10, "edges out of range are skipped");
+        JMapGMRouteSearch *search = JMapGMRouteSearchCreate(graph);
+
+        JMapGMRoute *route = JMapGMRouteSearchFind(search, 0, 4);
+        // The direct edge 0 - 2 is as long as 0 - 1 - 2, so either is cheapest.
+        JMapGMBenchmarkCheck(benchmark, route && route->nodes[0] == 0 && route->nodes[route->nodeCount - 1] == 4, "a route runs from start to end");
+        JMapGMBenchmarkCheck(benchmark, route && route->segmentCount == 2 && route->segmentFloors[0] == 1 && route->segmentFloors[1] == 2, "one segment per floor");
+        JMapGMBenchmarkCheck(benchmark, route && route->segmentStarts[1] == route->nodeCount - 2 && route->segmentStarts[2] == route->nodeCount, "segments split at the connector");
+        JMapGMBenchmarkCheck(benchmark, route && fabs(route->cost - 333.96) < 0.1, "the cost is the length in metres");
+        JMapGMBenchmarkCheck(benchmark, route && fabs(route->segmentCosts[0] - 222.64) < 0.1 && fabs(route->segmentCosts[0] + route->segmentCosts[1] - route->cost) < 1e-9,
+                             "the segment costs add up to the cost");
+        JMapGMBenchmarkCheck(benchmark, route && JMapGMRouteGetSegment(route, 0) == 0 && JMapGMRouteGetSegment(route, route->nodeCount - 1) == 1, "nodes map to their segment");
+        JMapGMBenchmarkCheck(benchmark, route && route->points[route->nodeCount - 1].y == 0.001, "points are the waypoint coordinates");
+        JMapGMBenchmarkCheck(benchmark, route && fabs(JMapGMRouteSearchCost(search, 0, 4) - route->cost) < 1e-9, "the cost alone matches the route");
+        JMapGMRouteRelease(route);
+
+        route = JMapGMRouteSearchFind(search, 2, 2);
+        JMapGMBenchmarkCheck(benchmark, route && route->nodeCount == 1 && route->segmentCount == 1 && route->cost == 0, "a route to the start is one node");
+        JMapGMRouteRelease(route);
+        JMapGMBenchmarkCheck(benchmark, JMapGMRouteSearchFind(search, 0, 5) == NULL && isinf(JMapGMRouteSearchCost(search, 0, 5)), "unreachable waypoints have no route");
+        JMapGMBenchmarkCheck(benchmark, JMapGMRouteSearchFind(search, 0, 6) == NULL, "waypoints out of range have no route");
+
+        const uint32_t targets[] = { 4, 5, 1, 4, 7 };
+        double costs[5];
+        JMapGMBenchmarkCheck(benchmark, JMapGMRouteSearchCosts(search, 0, targets, 5, costs) == 3, "the sweep reaches the reachable targets");
+        JMapGMBenchmarkCheck(benchmark, fabs(costs[0] - 333.96) < 0.1 && isinf(costs[1]) && fabs(costs[2] - 111.32) < 0.1 && costs[3] == costs[0] && isinf(costs[4]),
+                             "the sweep costs each target");
+
+        const uint32_t nodes[] = { 7, 8, 9 };
+        const int32_t packedFloors[] = { 3, 3, 3 };
+        const double packedCosts[] = { 5, 7 };
+        route = JMapGMRouteCreate(nodes, points, packedFloors, packedCosts, 3);
+        JMapGMBenchmarkCheck(benchmark, route && route->cost == 12 && route->segmentCount == 1 && route->nodes[2] == 9, "a precomputed route is packed as given");
+        JMapGMRouteRelease(route);
+        route = JMapGMRouteCreate(nodes, points, packedFloors, NULL, 3);
+        JMapGMBenchmarkCheck(benchmark, route && fabs(route->cost - 222.64) < 0.1, "a precomputed route without costs is measured");
+        JMapGMRouteRelease(route);
+
+        JMapGMRouteSearchRelease(search);
+        JMapGMRouteGraphRelease(graph);
+    }
+}
+
+// Travel times on a hand built three floor network with an elevator and a stair.
+static void JMapGMBenchmarkRouteCheckEtaRules(JMapGMBenchmark *benchmark)
+{
+    // 0 on floor 1 and 1 on floor 3, 11.132 m apart; elevator 2 - 3 - 4 east of 0 and stair 5 - 6 - 7 north of it.
+    const JMapGMPoint points[] = { { 0, 0 }, { 0.0001, 0.0001 }, { 0.0001, 0 }, { 0.0001, 0 }, { 0.0001, 0 }, { 0, 0.0001 }, { 0, 0.0001 }, { 0, 0.0001 } };
+    const int32_t floors[] = { 1, 3, 1, 2, 3, 1, 2, 3 };
+    const uint32_t from[] = { 0, 2, 3, 4, 0, 5, 6, 7 };
+    const uint32_t to[] = { 2, 3, 4, 1, 5, 6, 7, 1 };
+    const uint8_t pathTypes[] = { JMapGMPathTypeCorridor, JMapGMPathTypeElevator, JMapGMPathTypeElevator, JMapGMPathTypeCorridor,
+                                  JMapGMPathTypeCorridor, JMapGMPathTypeStairs, JMapGMPathTypeStairs, JMapGMPathTypeCorridor };
+    while (JMapGMBenchmarkKeepRunning(benchmark)) {
+        JMapGMRouteGraph *graph = JMapGMRouteGraphCreate(points, floors, 8, from, to, pathTypes, 8);
+        JMapGMRouteSearch *search = JMapGMRouteSearchCreate(graph);
+
+        JMapGMTravelModel model = JMapGMTravelModelMake(0);
+        JMapGMBenchmarkCheck(benchmark, model.walkingSpeed == 1.3 && JMapGMTravelModelMake(100).walkingSpeed == 0.9, "walking slows as accessibility rises");
+        JMapGMRouteSearchSetModel(search, &model);
+        JMapGMRoute *route = JMapGMRouteSearchFind(search, 0, 1);
+        // 22.264 m at 1.3 m/s plus 2 floors of stairs at 15 s, against 40 s for the elevator.
+        JMapGMBenchmarkCheck(benchmark, route && route->nodeCount == 5 && route->nodes[2] == 6, "the stairs are quicker");
+        JMapGMBenchmarkCheck(benchmark, route && fabs(route->cost - 47.126) < 0.01, "the cost is the time in seconds");
+        JMapGMRouteRelease(route);
+
+        model = JMapGMTravelModelMake(100);
+        JMapGMRouteSearchSetModel(search, &model);
+        route = JMapGMRouteSearchFind(search, 0, 1);
+        // 22.264 m at 0.9 m/s plus one 30 s wait and 2 floors at 5 s.
+        JMapGMBenchmarkCheck(benchmark, route && route->nodeCount == 5 && route->nodes[2] == 3, "accessible routes avoid stairs");
+        JMapGMBenchmarkCheck(benchmark, route && fabs(route->cost - 64.738) < 0.01, "the elevator is boarded once for two floors");
+        double sum = 0;
+        for (size_t s = 0; route && s < route->segmentCount; s++) sum += route->segmentCosts[s];
+        JMapGMBenchmarkCheck(benchmark, route && route->segmentCount == 3 && fabs(sum - route->cost) < 1e-9 && fabs(route->segmentCosts[2] - 12.369) < 0.01,
+                             "the segment times add up to the time");
+        JMapGMBenchmarkCheck(benchmark, route && fabs(JMapGMRouteSearchCost(search, 0, 1) - route->cost) < 1e-9, "the time alone matches the route");
+        JMapGMRouteRelease(route);
+
+        const uint32_t targets[] = { 1, 6, 3 };
+        double costs[3];
+        JMapGMBenchmarkCheck(benchmark, JMapGMRouteSearchCosts(search, 0, targets, 3, costs) == 2 && isinf(costs[1]), "the sweep leaves out waypoints only reached by stairs");
+        JMapGMBenchmarkCheck(benchmark, fabs(costs[0] - 64.738) < 0.01 && fabs(costs[2] - (11.132 / 0.9 + 35)) < 0.01, "the sweep times each target");
+
+        JMapGMRouteTree *tree = JMapGMRouteSearchTree(search, 1);
+        route = tree ? JMapGMRouteTreeFind(tree, 0) : NULL;
+        JMapGMBenchmarkCheck(benchmark, tree && fabs(JMapGMRouteTreeGetCost(tree, 0) - 64.738) < 0.01 && isinf(JMapGMRouteTreeGetCost(tree, 6)),
+                             "a tree to the destination times routes as a search does");
+        JMapGMBenchmarkCheck(benchmark, route && route->nodeCount == 5 && route->nodes[2] == 3 && fabs(route->cost - 64.738) < 0.01 && route->nodes[4] == 1,
+                             "a route read off the tree boards the elevator once");
+        JMapGMRouteRelease(route);
+        JMapGMRouteTreeRelease(tree);
+
+        JMapGMRouteSearchSetModel(search, NULL);
+        JMapGMBenchmarkCheck(benchmark, fabs(JMapGMRouteSearchCost(search, 0, 1) - 22.264) < 0.01, "without a model the cost is the length again");
+
+        JMapGMRouteSearchRelease(search);
+        JMapGMRouteGraphRelease(graph);
+
+        const uint8_t unknownPathTypes[] = { JMapGMPathTypeCorridor, JMAPGM_ROUTE_PATH_TYPES };
+        graph = JMapGMRouteGraphCreate(points, floors, 8, from, to, unknownPathTypes, 2);
+        JMapGMBenchmarkCheck(benchmark, graph && JMapGMRouteGraphGetEdgeCount(graph) == 2, "edges without a cost entry are skipped");
+        JMapGMRouteGraphRelease(graph);
+    }
+}
+
+// Bounded sweeps, their frontier and outline on a hand built two floor network.
+static void JMapGMBenchmarkRouteCheckReachRules(JMapGMBenchmark *benchmark)
+{
+    // Floor 1: 0 - 1 - 2 - 3 east along the equator, 111.32 m apart, and 4 north of 1; 5 above 1 by elevator.
+    const JMapGMPoint points[] = { { 0, 0 }, { 0.001, 0 }, { 0.002, 0 }, { 0.003, 0 }, { 0.001, 0.001 }, { 0.001, 0 } };
+    const int32_t floors[] = { 1, 1, 1, 1, 1, 2 };
+    const uint32_t from[] = { 0, 1, 2, 1, 1 };
+    const uint32_t to[] = { 1, 2, 3, 4, 5 };
+    const uint8_t pathTypes[] = { JMapGMPathTypeCorridor, JMapGMPathTypeCorridor, JMapGMPathTypeCorridor, JMapGMPathTypeCorridor, JMapGMPathTypeElevator };
+    while (JMapGMBenchmarkKeepRunning(benchmark)) {
+        JMapGMRouteGraph *graph = JMapGMRouteGraphCreate(points, floors, 6, from, to, pathTypes, 5);
+        JMapGMRouteSearch *search = JMapGMRouteSearchCreate(graph);
+
+        JMapGMRouteReach reach = JMapGMRouteSearchReach(search, 0, 250);
+        bool sorted = true;
+        for (size_t i = 1; i < reach.count; i++) sorted &= reach.costs[i] >= reach.costs[i - 1];
+        JMapGMBenchmarkCheck(benchmark, reach.count == 5 && reach.nodes[0] == 0 && reach.costs[0] == 0 && sorted, "the sweep reaches every waypoint within the limit in order");
+        JMapGMBenchmarkCheck(benchmark, fabs(reach.costs[reach.count - 1] - 222.64) < 0.01, "the sweep stops at the limit");
+        JMapGMBenchmarkCheck(benchmark, reach.frontierCount == 1 && reach.frontierFloors[0] == 1 && fabs(reach.frontier[0].x - 0.0022458) < 1e-6,
+                             "the frontier is where the limit falls along the edge out");
+        JMapGMBenchmarkCheck(benchmark, JMapGMRouteSearchReach(search, 0, 0).count == 1, "a limit of 0 reaches the start");
+        JMapGMBenchmarkCheck(benchmark, JMapGMRouteSearchReach(search, 6, 250).count == 0, "waypoints out of range reach nothing");
+
+        JMapGMTravelModel model = JMapGMTravelModelMake(100);
+        JMapGMRouteSearchSetModel(search, &model);
+        // 123.69 s to 1 at 0.9 m/s, then 35 s up the elevator.
+        reach = JMapGMRouteSearchReach(search, 0, 200);
+        JMapGMBenchmarkCheck(benchmark, reach.count == 3 && reach.nodes[2] == 5 && fabs(reach.costs[2] - 158.69) < 0.01, "the sweep crosses floors in seconds");
+        JMapGMBenchmarkCheck(benchmark, reach.frontierCount == 2, "every edge out of the reach on a floor has a frontier point");
+
+        JMapGMPoint outline[2 * 5], hull[2 * 5];
+        size_t outlineCount = 0;
+        for (size_t i = 0; i < reach.count; i++) {
+            if (floors[reach.nodes[i]] == 1) outline[outlineCount++] = points[reach.nodes[i]];
+        }
+        for (size_t i = 0; i < reach.frontierCount; i++) outline[outlineCount++] = reach.frontier[i];
+        size_t hullCount = JMapGMPointsGetConvexHull(outline, outlineCount, hull);
+        double area = 0;
+        for (size_t i = 0; i < hullCount; i++) {
+            JMapGMPoint a = hull[i], b = hull[(i + 1) % hullCount];
+            area += a.x * b.y - b.x * a.y;
+        }
+        JMapGMBenchmarkCheck(benchmark, hullCount == 3 && area > 0, "the outline is counterclockwise without collinear points");
+        const JMapGMPoint line[] = { { 2, 0 }, { 0, 0 }, { 1, 0 }, { 1, 0 } };
+        memcpy(outline, line, sizeof(line));
+        JMapGMBenchmarkCheck(benchmark, JMapGMPointsGetConvexHull(outline, 4, hull) == 2, "collinear points outline as a line");
+
+        JMapGMRouteSearchRelease(search);
+        JMapGMRouteGraphRelease(graph);
+    }
+}
+
+// Point to point routes across a 4 floor building, checked against a plain Dijkstra sweep.
+static void JMapGMBenchmarkRouteFind(JMapGMBenchmark *benchmark)
+{
+    JMapGMSyntheticConfig config = JMapGMBenchmarkRouteConfig(JMapGMBenchmarkArg(benchmark));
+    JMapGMSyntheticVenue venue;
+    JMapGMSyntheticVenueGenerate(&venue, &config);
+    JMapGMRouteGraph *graph = JMapGMBenchmarkRouteGraph(&venue);
+    JMapGMRouteSearch *search = JMapGMRouteSearchCreate(graph);
+
+    uint32_t starts[JMAPGM_BENCHMARK_ROUTE_PAIRS], ends[JMAPGM_BENCHMARK_ROUTE_PAIRS];
+    uint64_t seed = 7;
+    for (size_t i = 0; i < JMAPGM_BENCHMARK_ROUTE_PAIRS; i++) {
+        starts[i] = (uint32_t)(JMapGMSyntheticRandom(&seed) % venue.waypointCount);
+        ends[i] = (uint32_t)(JMapGMSyntheticRandom(&seed) % venue.waypointCount);
+    }
+
+    bool optimal = true, connected = true, summed = true;
+    for (size_t i = 0; i < JMAPGM_BENCHMARK_ROUTE_PAIRS; i++) {
+        JMapGMRoute *route = JMapGMRouteSearchFind(search, starts[i], ends[i]);
+        double reference;
+        JMapGMRouteSearchCosts(search, starts[i], &ends[i], 1, &reference);
+        if (!route) {
+            optimal &= isinf(reference);
+            continue;
+        }
+        optimal &= fabs(route->cost - reference) < 1e-6;
+        if (i < 8) connected &= JMapGMBenchmarkRouteIsConnected(&venue, route);
+        double sum = 0;
+        for (size_t s = 0; s < route->segmentCount; s++) sum += route->segmentCosts[s];
+        summed &= fabs(sum - route->cost) < 1e-6;
+        for (size_t s = 1; s < route->segmentCount; s++) summed &= route->segmentFloors[s] != route->segmentFloors[s - 1];
+        JMapGMRouteRelease(route);
+    }
+    JMapGMBenchmarkCheck(benchmark, optimal, "A* routes cost as much as the cheapest found by Dijkstra");
+    JMapGMBenchmarkCheck(benchmark, connected, "routes only follow edges");
+    JMapGMBenchmarkCheck(benchmark, summed, "segments change floor and their costs add up");
+
+    size_t settled = 0, bytes = 0, routes = 0, pair = 0;
+    while (JMapGMBenchmarkKeepRunning(benchmark)) {
+        JMapGMRoute *route = JMapGMRouteSearchFind(search, starts[pair], ends[pair]);
+        settled += JMapGMRouteSearchGetSettledCount(search);
+        if (route) {
+            bytes += route->size;
+            routes++;
+        }
+        JMapGMRouteRelease(route);
+        pair = (pair + 1) % JMAPGM_BENCHMARK_ROUTE_PAIRS;
+    }
+    JMapGMBenchmarkSetItemsPerIteration(benchmark, 1);
+    JMapGMBenchmarkSetCounter(benchmark, "waypoints", (double)venue.waypointCount);
+    JMapGMBenchmarkSetCounter(benchmark, "settled", (double)settled / (double)(routes ? routes : 1));
+    JMapGMBenchmarkSetCounter(benchmark, "routeBytes", (double)bytes / (double)(routes ? routes : 1));
+    JMapGMBenchmarkSetCounter(benchmark, "graphBytes", (double)JMapGMRouteGraphGetMemoryUsage(graph));
+
+    JMapGMRouteSearchRelease(search);
+    JMapGMRouteGraphRelease(graph);
+    JMapGMSyntheticVenueFree(&venue);
+}
+
+// Distances from one waypoint to every destination of the building in one sweep, as for sorting
+// search results, against one cost query per destination.
+static void JMapGMBenchmarkRouteCosts(JMapGMBenchmark *benchmark)
+{
+    JMapGMSyntheticConfig config = JMapGMBenchmarkRouteConfig(JMapGMBenchmarkArg(benchmark));
+    JMapGMSyntheticVenue venue;
+    JMapGMSyntheticVenueGenerate(&venue, &config);
+    JMapGMRouteGraph *graph = JMapGMBenchmarkRouteGraph(&venue);
+    JMapGMRouteSearch *search = JMapGMRouteSearchCreate(graph);
+
+    size_t count = venue.destinationCount;
+    uint32_t *targets = malloc((count + 1) * sizeof(uint32_t));
+    double *costs = malloc((count + 1) * sizeof(double));
+    for (size_t i = 0; i < count; i++) targets[i] = venue.unitWaypoints[venue.destinationUnits[i]];
+
+    size_t reached = JMapGMRouteSearchCosts(search, 0, targets, count, costs);
+    bool matches = true;
+    for (size_t i = 0; i < count; i += count / 16 + 1) matches &= fabs(JMapGMRouteSearchCost(search, 0, targets[i]) - costs[i]) < 1e-6;
+    JMapGMBenchmarkCheck(benchmark, reached == count, "every destination of the building is reached");
+    JMapGMBenchmarkCheck(benchmark, matches, "the sweep matches point to point costs");
+
+    while (JMapGMBenchmarkKeepRunning(benchmark)) {
+        JMapGMRouteSearchCosts(search, 0, targets, count, costs);
+        JMapGMBenchmarkUse(costs);
+    }
+    JMapGMBenchmarkSetItemsPerIteration(benchmark, (int64_t)count);
+    JMapGMBenchmarkSetCounter(benchmark, "destinations", (double)count);
+
+    free(targets);
+    free(costs);
+    JMapGMRouteSearchRelease(search);
+    JMapGMRouteGraphRelease(graph);
+    JMapGMSyntheticVenueFree(&venue);
+}
+
+// Walking times from one waypoint to every destination of the building in one sweep, as for
+// annotating search results with an ETA, with A* routes checked against the sweep.
+static void JMapGMBenchmarkRouteEta(JMapGMBenchmark *benchmark)
+{
+    JMapGMSyntheticConfig config = JMapGMBenchmarkRouteConfig(JMapGMBenchmarkArg(benchmark));
+    JMapGMSyntheticVenue venue;
+    JMapGMSyntheticVenueGenerate(&venue, &config);
+    JMapGMRouteGraph *graph = JMapGMBenchmarkRouteGraph(&venue);
+    JMapGMRouteSearch *search = JMapGMRouteSearchCreate(graph);
+    JMapGMTravelModel model = JMapGMTravelModelMake(50);
+    JMapGMRouteSearchSetModel(search, &model);
+
+    size_t count = venue.destinationCount;
+    uint32_t *targets = malloc((count + 1) * sizeof(uint32_t));
+    double *costs = malloc((count + 1) * sizeof(double));
+    for (size_t i = 0; i < count; i++) targets[i] = venue.unitWaypoints[venue.destinationUnits[i]];
+
+    size_t reached = JMapGMRouteSearchCosts(search, 0, targets, count, costs);
+    bool optimal = true;
+    for (size_t i = 0; i < count; i += count / 16 + 1) {
+        JMapGMRoute *route = JMapGMRouteSearchFind(search, 0, targets[i]);
+        optimal &= route ? fabs(route->cost - costs[i]) < 1e-6 : isinf(costs[i]);
+        JMapGMRouteRelease(route);
+    }
+    JMapGMBenchmarkCheck(benchmark, reached == count, "every destination of the building is reached without stairs");
+    JMapGMBenchmarkCheck(benchmark, optimal, "A* routes take as long as the quickest found by Dijkstra");
+
+    size_t settled = 0, sweeps = 0;
+    while (JMapGMBenchmarkKeepRunning(benchmark)) {
+        JMapGMRouteSearchCosts(search, 0, targets, count, costs);
+        JMapGMBenchmarkUse(costs);
+        settled += JMapGMRouteSearchGetSettledCount(search);
+        sweeps++;
+    }
+    JMapGMBenchmarkSetItemsPerIteration(benchmark, (int64_t)count);
+    JMapGMBenchmarkSetCounter(benchmark, "destinations", (double)count);
+    JMapGMBenchmarkSetCounter(benchmark, "settled", (double)settled / (double)(sweeps ? sweeps : 1));
+
+    free(targets);
+    free(costs);
+    JMapGMRouteSearchRelease(search);
+    JMapGMRouteGraphRelease(graph);
+    JMapGMSyntheticVenueFree(&venue);
+}
+
+// Everything within a 5 minute walk of a user walking through the building, recomputed at each
+// location update: the sweep, the destinations reached and an outline of the user's floor.
+static void JMapGMBenchmarkRouteReach(JMapGMBenchmark *benchmark)
+{
+    JMapGMSyntheticConfig config = JMapGMBenchmarkRouteConfig(JMapGMBenchmarkArg(benchmark));
+    JMapGMSyntheticVenue venue;
+    JMapGMSyntheticVenueGenerate(&venue, &config);
+    JMapGMRouteGraph *graph = JMapGMBenchmarkRouteGraph(&venue);
+    JMapGMRouteSearch *search = JMapGMRouteSearchCreate(graph);
+    JMapGMTravelModel model = JMapGMTravelModelMake(0);
+    JMapGMRouteSearchSetModel(search, &model);
+    const double limit = 300;
+
+    size_t count = venue.waypointCount;
+    uint32_t *targets = malloc((count + 1) * sizeof(uint32_t));
+    double *costs = malloc((count + 1) * sizeof(double));
+    for (size_t i = 0; i < count; i++) targets[i] = (uint32_t)i;
+    JMapGMRouteSearchCosts(search, 0, targets, count, costs);
+    // A minute's walk as well, which stops short of the edge of even the smallest building.
+    bool partial = false, matches = true;
+    JMapGMRouteReach reach;
+    for (double checked = 60; checked <= limit; checked += limit - 60) {
+        size_t within = 0;
+        for (size_t i = 0; i < count; i++) within += costs[i] <= checked;
+        reach = JMapGMRouteSearchReach(search, 0, checked);
+        partial |= reach.count > 1 && reach.count < count;
+        matches &= reach.count == within;
+        for (size_t i = 0; i < reach.count && matches; i++) {
+            matches &= reach.costs[i] <= checked && fabs(costs[reach.nodes[i]] - reach.costs[i]) < 1e-6 && (i == 0 || reach.costs[i] >= reach.costs[i - 1]);
+        }
+    }
+    JMapGMBenchmarkCheck(benchmark, partial, "a walk reaches part of the building");
+    JMapGMBenchmarkCheck(benchmark, matches, "the sweep reaches exactly the waypoints within the limit at their cheapest");
+
+    // Destinations by the waypoint at their door, and a scratch mark per waypoint.
+    uint8_t *reached = calloc(count + 1, 1);
+    size_t outlineCapacity = count + JMapGMRouteGraphGetEdgeCount(graph) + 1;
+    JMapGMPoint *outline = malloc(outlineCapacity * sizeof(JMapGMPoint));
+    JMapGMPoint *hull = malloc(2 * outlineCapacity * sizeof(JMapGMPoint));
+    size_t settled = 0, destinations = 0, frontier = 0, hullPoints = 0, updates = 0;
+    uint32_t step = (uint32_t)(config.waypointsPerFloor / 64 + 1);
+    while (JMapGMBenchmarkKeepRunning(benchmark)) {
+        uint32_t start = (uint32_t)((updates * step) % config.waypointsPerFloor);
+        reach = JMapGMRouteSearchReach(search, start, limit);
+        settled += JMapGMRouteSearchGetSettledCount(search);
+        for (size_t i = 0; i < reach.count; i++) reached[reach.nodes[i]] = 1;
+        for (size_t d = 0; d < venue.destinationCount; d++) destinations += reached[venue.unitWaypoints[venue.destinationUnits[d]]];
+        for (size_t i = 0; i < reach.count; i++) reached[reach.nodes[i]] = 0;
+
+        int32_t floor = (int32_t)venue.waypointFloors[start];
+        size_t outlineCount = 0;
+        for (size_t i = 0; i < reach.count; i++) {
+            if ((int32_t)venue.waypointFloors[reach.nodes[i]] == floor) outline[outlineCount++] = venue.waypoints[reach.nodes[i]];
+        }
+        for (size_t i = 0; i < reach.frontierCount; i++) {
+            if (reach.frontierFloors[i] == floor) outline[outlineCount++] = reach.frontier[i];
+        }
+        hullPoints += JMapGMPointsGetConvexHull(outline, outlineCount, hull);
+        frontier += reach.frontierCount;
+        updates++;
+    }
+    double perUpdate = 1.0 / (double)(updates ? updates : 1);
+    JMapGMBenchmarkSetItemsPerIteration(benchmark, 1);
+    JMapGMBenchmarkSetCounter(benchmark, "settled", (double)settled * perUpdate);
+    JMapGMBenchmarkSetCounter(benchmark, "destinations", (double)destinations * perUpdate);
+    JMapGMBenchmarkSetCounter(benchmark, "frontier", (double)frontier * perUpdate);
+    JMapGMBenchmarkSetCounter(benchmark, "outline", (double)hullPoints * perUpdate);
+
+    free(reached);
+    free(outline);
+    free(hull);
+    free(targets);
+    free(costs);
+    JMapGMRouteSearchRelease(search);
+    JMapGMRouteGraphRelease(graph);
+    JMapGMSyntheticVenueFree(&venue);
+}
+
+// Re-routing a user who left their route to one destination: the waypoint to rejoin at and the
+// route from it, read off one tree instead of a new search each time, checked against A* routes.
+static void JMapGMBenchmarkRouteReroute(JMapGMBenchmark *benchmark)
+{
+    JMapGMSyntheticConfig config = JMapGMBenchmarkRouteConfig(JMapGMBenchmarkArg(benchmark));
+    JMapGMSyntheticVenue venue;
+    JMapGMSyntheticVenueGenerate(&venue, &config);
+    JMapGMRouteGraph *graph = JMapGMBenchmarkRouteGraph(&venue);
+    JMapGMRouteSearch *search = JMapGMRouteSearchCreate(graph);
+    JMapGMTravelModel model = JMapGMTravelModelMake(50);
+    JMapGMRouteSearchSetModel(search, &model);
+    uint32_t destination = (uint32_t)(venue.waypointCount - 1);
+    JMapGMRouteTree *tree = JMapGMRouteSearchTree(search, destination);
+    size_t treeSettled = JMapGMRouteSearchGetSettledCount(search);
+
+    uint32_t starts[JMAPGM_BENCHMARK_ROUTE_PAIRS];
+    uint64_t seed = 11;
+    for (size_t i = 0; i < JMAPGM_BENCHMARK_ROUTE_PAIRS; i++) starts[i] = (uint32_t)(JMapGMSyntheticRandom(&seed) % venue.waypointCount);
+
+    bool optimal = tree != NULL, connected = tree != NULL, entered = tree != NULL;
+    size_t searchSettled = 0;
+    for (size_t i = 0; i < JMAPGM_BENCHMARK_ROUTE_PAIRS && tree; i++) {
+        double reference = JMapGMRouteSearchCost(search, starts[i], destination);
+        searchSettled += JMapGMRouteSearchGetSettledCount(search);
+        JMapGMRoute *route = JMapGMRouteTreeFind(tree, starts[i]);
+        if (!route) {
+            optimal &= isinf(reference) && isinf(JMapGMRouteTreeGetCost(tree, starts[i]));
+            continue;
+        }
+        optimal &= fabs(route->cost - reference) < 1e-6 && fabs(JMapGMRouteTreeGetCost(tree, starts[i]) - reference) < 1e-6;
+        if (i < 8) connected &= JMapGMBenchmarkRouteIsConnected(&venue, route) && route->nodes[route->nodeCount - 1] == destination;
+        JMapGMRouteRelease(route);
+        double entryCost;
+        uint32_t entry = JMapGMRouteTreeFindEntry(tree, venue.waypoints[starts[i]], (int32_t)venue.waypointFloors[starts[i]], &entryCost);
+        entered &= entry != UINT32_MAX && entryCost <= reference + 1e-6 && (int32_t)venue.waypointFloors[entry] == (int32_t)venue.waypointFloors[starts[i]];
+    }
+    JMapGMBenchmarkCheck(benchmark, optimal, "routes off the tree take as long as A* routes");
+    JMapGMBenchmarkCheck(benchmark, connected, "routes off the tree follow edges to the destination");
+    JMapGMBenchmarkCheck(benchmark, entered, "users rejoin on their floor no later than from where they stand");
+
+    // Users drift up to 10 m off the waypoint they last passed.
+    size_t reroutes = 0, waypoints = 0;
+    while (JMapGMBenchmarkKeepRunning(benchmark) && tree) {
+        uint32_t start = starts[reroutes % JMAPGM_BENCHMARK_ROUTE_PAIRS];
+        JMapGMPoint point = venue.waypoints[start];
+        point.x += JMapGMSyntheticRandomUnit(&seed) * 0.0001;
+        point.y += JMapGMSyntheticRandomUnit(&seed) * 0.0001;
+        uint32_t entry = JMapGMRouteTreeFindEntry(tree, point, (int32_t)venue.waypointFloors[start], NULL);
+        JMapGMRoute *route = entry != UINT32_MAX ? JMapGMRouteTreeFind(tree, entry) : NULL;
+        if (route) waypoints += route->nodeCount;
+        JMapGMRouteRelease(route);
+        reroutes++;
+    }
+    JMapGMBenchmarkSetItemsPerIteration(benchmark, 1);
+    JMapGMBenchmarkSetCounter(benchmark, "waypoints", (double)venue.waypointCount);
+    JMapGMBenchmarkSetCounter(benchmark, "treeSettled", (double)treeSettled);
+    JMapGMBenchmarkSetCounter(benchmark, "searchSettled", (double)searchSettled / JMAPGM_BENCHMARK_ROUTE_PAIRS);
+    JMapGMBenchmarkSetCounter(benchmark, "routeWaypoints", (double)waypoints / (double)(reroutes ? reroutes : 1));
+
+    JMapGMRouteTreeRelease(tree);
+    JMapGMRouteSearchRelease(search);
+    JMapGMRouteGraphRelease(graph);
+    JMapGMSyntheticVenueFree(&venue);
+}
+
+const JMapGMBenchmarkEntry JMapGMRouteBenchmarks[] = {
+    { "RouteRules", JMapGMBenchmarkRouteCheckRules, { 0 } },
+    { "RouteFind", JMapGMBenchmarkRouteFind, { 400, 4000, 40000 } },
+    { "RouteCosts", JMapGMBenchmarkRouteCosts, { 400, 4000, 40000 } },
+    { "RouteEtaRules", JMapGMBenchmarkRouteCheckEtaRules, { 0 } },
+    { "RouteEta", JMapGMBenchmarkRouteEta, { 400, 4000, 40000 } },
+    { "RouteReachRules", JMapGMBenchmarkRouteCheckReachRules, { 0 } },
+    { "RouteReach", JMapGMBenchmarkRouteReach, { 400, 4000, 40000 } },
+    { "RouteReroute", JMapGMBenchmarkRouteReroute, { 400, 4000, 40000 } },
+    { NULL, NULL, { 0 } },
+};
@@ -0,0 +1,242 @@
+//
+//  JMapGMSchedulerBenchmarks.c
+//  JMapOutdoorIndoorKit Benchmarks
+//
+//  Copyright © 2026 Jibestream. All rights reserved.
+//
+
+#include "JMapGMBenchmark.h"
+
+#include "JMapGMScheduler.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define JMAPGM_BENCHMARK_MS 1000000
+
+// A clock that only advances when a step says it did work.
+typedef struct {
+    int64_t now;
+} JMapGMSimulatedClock;
+
+static int64_t JMapGMSimulatedClockNow(void *context)
+{
+    return ((JMapGMSimulatedClock *)context)->now;
+}
+
+#define JMAPGM_BENCHMARK_LOG_CAPACITY 64
+
+// A task of a number of equal steps, logging each step's name.
+typedef struct {
+    JMapGMSimulatedClock *clock;
+    int64_t cost;
+    int remaining;
+    char name;
+    char *log;
+    size_t *logLength;
+    bool finished;
+    bool cancelled;
+    /** When set, the task cancels itself, or adds an urgent task, from its first step */
+    JMapGMScheduler *scheduler;
+    uint64_t *self;
+    bool addsUrgent;
+} JMapGMBenchmarkTask;
+
+static bool JMapGMBenchmarkTaskStep(void *context)
+{
+    JMapGMBenchmarkTask *task = context;
+    task->clock->now += task->cost;
+    if (*task->logLength < JMAPGM_BENCHMARK_LOG_CAPACITY) task->log[(*task->logLength)++] = task->name;
+    if (task->scheduler && task->self) JMapGMSchedulerCancel(task->scheduler, *task->self);
+    if (task->scheduler && task->addsUrgent) {
+        task->addsUrgent = false;
+        task[1].clock = task->clock;
+        JMapGMSchedulerAdd(task->scheduler, JMapGMTaskPriorityInteraction, JMapGMBenchmarkTaskStep, NULL, &task[1]);
+    }
+    return --task->remaining > 0;
+}
+
+static void JMapGMBenchmarkTaskFinish(void *context, bool cancelled)
+{
+    JMapGMBenchmarkTask *task = context;
+    task->finished = true;
+    task->cancelled = cancelled;
+}
+
+static JMapGMBenchmarkTask JMapGMBenchmarkTaskMake(JMapGMSimulatedClock *clock, char name, int steps, int64_t cost, char *log, size_t *logLength)
+{
+    JMapGMBenchmarkTask task = { clock, cost, steps, name, log, logLength, false, false, NULL, NULL, false };
+    return task;
+}
+
+// The scheduling rules, checked on a simulated clock.
+static void JMapGMBenchmarkSchedulerCheckRules(JMapGMBenchmark *benchmark)
+{
+    JMapGMSimulatedClock clock = { 0 };
+    char log[JMAPGM_BENCHMARK_LOG_CAPACITY + 1];
+    size_t logLength = 0;
+    JMapGMScheduler *scheduler = JMapGMSchedulerCreate(JMapGMSimulatedClockNow, &clock);
+
+    // Added lowest priority first, run highest priority first, 4 one-millisecond steps a frame.
+    JMapGMBenchmarkTask background = JMapGMBenchmarkTaskMake(&clock, 'b', 3, JMAPGM_BENCHMARK_MS, log, &logLength);
+    JMapGMBenchmarkTask visible = JMapGMBenchmarkTaskMake(&clock, 'v', 3, JMAPGM_BENCHMARK_MS, log, &logLength);
+    JMapGMBenchmarkTask touch = JMapGMBenchmarkTaskMake(&clock, 't', 1, JMAPGM_BENCHMARK_MS, log, &logLength);
+    JMapGMSchedulerAdd(scheduler, JMapGMTaskPriorityBackground, JMapGMBenchmarkTaskStep, JMapGMBenchmarkTaskFinish, &background);
+    JMapGMSchedulerAdd(scheduler, JMapGMTaskPriorityVisible, JMapGMBenchmarkTaskStep, JMapGMBenchmarkTaskFinish, &visible);
+    JMapGMSchedulerAdd(scheduler, JMapGMTaskPriorityInteraction, JMapGMBenchmarkTaskStep, JMapGMBenchmarkTaskFinish, &touch);
+    JMapGMFrameStats first = JMapGMSchedulerRunFrame(scheduler, 4 * JMAPGM_BENCHMARK_MS);
+    JMapGMFrameStats second = JMapGMSchedulerRunFrame(scheduler, 4 * JMAPGM_BENCHMARK_MS);
+    log[logLength] = '\0';
+    JMapGMBenchmarkCheck(benchmark, strcmp(log, "tvvvbbb") == 0, "interaction runs before the visible floor, which runs before background floors");
+    JMapGMBenchmarkCheck(benchmark, first.steps == 4 && first.elapsed == 4 * JMAPGM_BENCHMARK_MS && first.pending == 1, "a frame stops once its budget is spent");
+    JMapGMBenchmarkCheck(benchmark, first.stepsByPriority[JMapGMTaskPriorityInteraction] == 1 && first.completed == 2, "frame statistics count steps by priority");
+    JMapGMBenchmarkCheck(benchmark, second.steps == 3 && second.completed == 1 && second.pending == 0, "unfinished tasks resume on the next frame");
+    JMapGMBenchmarkCheck(benchmark, visible.finished && !visible.cancelled && background.finished, "finished tasks are told so");
+
+    // A budget of zero still runs one step, and a step longer than the budget is an overrun.
+    logLength = 0;
+    JMapGMBenchmarkTask slow = JMapGMBenchmarkTaskMake(&clock, 's', 2, 10 * JMAPGM_BENCHMARK_MS, log, &logLength);
+    JMapGMSchedulerAdd(scheduler, JMapGMTaskPriorityVisible, JMapGMBenchmarkTaskStep, NULL, &slow);
+    JMapGMFrameStats starved = JMapGMSchedulerRunFrame(scheduler, 0);
+    JMapGMBenchmarkCheck(benchmark, starved.steps == 1 && JMapGMSchedulerGetStats(scheduler).overruns == 1, "every frame makes progress");
+    JMapGMSchedulerRunFrame(scheduler, 0);
+
+    // Cancelling a pending task, a running task, and promoting a background task.
+    logLength = 0;
+    JMapGMBenchmarkTask dropped = JMapGMBenchmarkTaskMake(&clock, 'd', 5, JMAPGM_BENCHMARK_MS, log, &logLength);
+    JMapGMBenchmarkTask quitter = JMapGMBenchmarkTaskMake(&clock, 'q', 5, JMAPGM_BENCHMARK_MS, log, &logLength);
+    JMapGMBenchmarkTask floor = JMapGMBenchmarkTaskMake(&clock, 'f', 1, JMAPGM_BENCHMARK_MS, log, &logLength);
+    JMapGMBenchmarkTask other = JMapGMBenchmarkTaskMake(&clock, 'o', 1, JMAPGM_BENCHMARK_MS, log, &logLength);
+    uint64_t droppedId = JMapGMSchedulerAdd(scheduler, JMapGMTaskPriorityVisible, JMapGMBenchmarkTaskStep, JMapGMBenchmarkTaskFinish, &dropped);
+    uint64_t quitterId = JMapGMSchedulerAdd(scheduler, JMapGMTaskPriorityVisible, JMapGMBenchmarkTaskStep, JMapGMBenchmarkTaskFinish, &quitter);
+    quitter.scheduler = scheduler;
+    quitter.self = &quitterId;
+    JMapGMSchedulerAdd(scheduler, JMapGMTaskPriorityVisible, JMapGMBenchmarkTaskStep, NULL, &other);
+    uint64_t floorId = JMapGMSchedulerAdd(scheduler, JMapGMTaskPriorityBackground, JMapGMBenchmarkTaskStep, NULL, &floor);
+    JMapGMBenchmarkCheck(benchmark, JMapGMSchedulerCancel(scheduler, droppedId) && dropped.finished && dropped.cancelled, "cancelled tasks are finished at once");
+    JMapGMBenchmarkCheck(benchmark, !JMapGMSchedulerCancel(scheduler, droppedId), "tasks are cancelled once");
+    JMapGMBenchmarkCheck(benchmark, JMapGMSchedulerSetPriority(scheduler, floorId, JMapGMTaskPriorityInteraction), "pending tasks can be promoted");
+    JMapGMSchedulerRunFrame(scheduler, 10 * JMAPGM_BENCHMARK_MS);
+    log[logLength] = '\0';
+    JMapGMBenchmarkCheck(benchmark, strcmp(log, "fqo") == 0, "promoted tasks run first and tasks cancelling themselves stop");
+    JMapGMBenchmarkCheck(benchmark, quitter.finished && quitter.cancelled && JMapGMSchedulerGetStats(scheduler).cancelled == 2, "self-cancelled tasks are finished after their step");
+
+    // A step adding an interaction task yields to it before its own next step.
+    logLength = 0;
+    JMapGMBenchmarkTask pair[2] = {
+        JMapGMBenchmarkTaskMake(&clock, 'p', 2, JMAPGM_BENCHMARK_MS, log, &logLength),
+        JMapGMBenchmarkTaskMake(&clock, 'u', 1, JMAPGM_BENCHMARK_MS, log, &logLength),
+    };
+    pair[0].scheduler = scheduler;
+    pair[0].addsUrgent = true;
+    JMapGMSchedulerAdd(scheduler, JMapGMTaskPriorityBackground, JMapGMBenchmarkTaskStep, NULL, &pair[0]);
+    JMapGMSchedulerRunFrame(scheduler, 10 * JMAPGM_BENCHMARK_MS);
+    log[logLength] = '\0';
+    JMapGMBenchmarkCheck(benchmark, strcmp(log, "pup") == 0, "tasks added by a step run in the same frame by priority");
+    JMapGMBenchmarkCheck(benchmark, JMapGMSchedulerGetPendingCount(scheduler) == 0, "the scheduler drains");
+
+    JMapGMBenchmarkTask leftover = JMapGMBenchmarkTaskMake(&clock, 'l', 1, 0, log, &logLength);
+    JMapGMSchedulerAdd(scheduler, JMapGMTaskPriorityBackground, JMapGMBenchmarkTaskStep, JMapGMBenchmarkTaskFinish, &leftover);
+    JMapGMSchedulerRelease(scheduler);
+    JMapGMBenchmarkCheck(benchmark, leftover.finished && leftover.cancelled, "releasing cancels pending tasks");
+}
+
+static void JMapGMBenchmarkSchedulerRules(JMapGMBenchmark *benchmark)
+{
+    while (JMapGMBenchmarkKeepRunning(benchmark)) JMapGMBenchmarkSchedulerCheckRules(benchmark);
+}
+
+// Showing a floor of 1000 units styled 20 per step while 3 other floors prepare in the background
+// and a tap arrives every 10 frames, at 4 ms a frame. Each step costs 0.1 ms on the simulated clock.
+static void JMapGMBenchmarkSchedulerShowMap(JMapGMBenchmark *benchmark)
+{
+    const int64_t stepCost = JMAPGM_BENCHMARK_MS / 10, budget = 4 * JMAPGM_BENCHMARK_MS;
+    const int floorSteps = (int)JMapGMBenchmarkArg(benchmark) / 20;
+    char log[JMAPGM_BENCHMARK_LOG_CAPACITY + 1];
+    size_t logLength = 0;
+    uint64_t visibleFrames = 0, allFrames = 0, tapLatency = 0;
+    int64_t maxElapsed = 0;
+    while (JMapGMBenchmarkKeepRunning(benchmark)) {
+        JMapGMSimulatedClock clock = { 0 };
+        JMapGMScheduler *scheduler = JMapGMSchedulerCreate(JMapGMSimulatedClockNow, &clock);
+        JMapGMBenchmarkTask floors[4], taps[64];
+        for (int f = 0; f < 4; f++) {
+            floors[f] = JMapGMBenchmarkTaskMake(&clock, 'f', floorSteps, stepCost, log, &logLength);
+            JMapGMSchedulerAdd(scheduler, f == 0 ? JMapGMTaskPriorityVisible : JMapGMTaskPriorityBackground, JMapGMBenchmarkTaskStep,
+                               JMapGMBenchmarkTaskFinish, &floors[f]);
+        }
+        uint64_t frame = 0;
+        int tapCount = 0;
+        visibleFrames = 0;
+        tapLatency = 0;
+        while (JMapGMSchedulerGetPendingCount(scheduler) > 0) {
+            int tap = -1;
+            if (frame % 10 == 0 && tapCount < 64) {
+                tap = tapCount++;
+                taps[tap] = JMapGMBenchmarkTaskMake(&clock, 't', 1, stepCost, log, &logLength);
+                JMapGMSchedulerAdd(scheduler, JMapGMTaskPriorityInteraction, JMapGMBenchmarkTaskStep, JMapGMBenchmarkTaskFinish, &taps[tap]);
+            }
+            logLength = 0;
+            JMapGMFrameStats stats = JMapGMSchedulerRunFrame(scheduler, budget);
+            if (tap >= 0 && !taps[tap].finished) tapLatency++;
+            if (stats.elapsed > maxElapsed) maxElapsed = stats.elapsed;
+            if (floors[0].finished && visibleFrames == 0) visibleFrames = frame + 1;
+            frame++;
+        }
+        allFrames = frame;
+        JMapGMSchedulerRelease(scheduler);
+    }
+    JMapGMBenchmarkSetItemsPerIteration(benchmark, (int64_t)floorSteps * 4);
+    JMapGMBenchmarkSetCounter(benchmark, "visibleFrames", (double)visibleFrames);
+    JMapGMBenchmarkSetCounter(benchmark, "allFrames", (double)allFrames);
+    JMapGMBenchmarkSetCounter(benchmark, "maxFrameMs", (double)maxElapsed / JMAPGM_BENCHMARK_MS);
+    if (JMapGMBenchmarkIsSmoke(benchmark)) {
+        // 40 steps fit a frame, one of which may go to a tap.
+        JMapGMBenchmarkCheck(benchmark, visibleFrames == (uint64_t)(floorSteps + 38) / 39 || visibleFrames == (uint64_t)(floorSteps + 39) / 40,
+                             "the visible floor finishes before background floors take frames");
+        JMapGMBenchmarkCheck(benchmark, tapLatency == 0, "taps run in the frame they arrive");
+        JMapGMBenchmarkCheck(benchmark, maxElapsed <= budget, "no frame runs past its budget");
+    }
+}
+
+static bool JMapGMBenchmarkCountStep(void *context)
+{
+    return --*(int *)context > 0;
+}
+
+// Scheduling overhead per step with the real clock: many tasks of 8 empty steps.
+static void JMapGMBenchmarkSchedulerOverhead(JMapGMBenchmark *benchmark)
+{
+    size_t count = (size_t)JMapGMBenchmarkArg(benchmark);
+    int *remaining = malloc(count * sizeof(int));
+    JMapGMScheduler *scheduler = JMapGMSchedulerCreate(NULL, NULL);
+    uint64_t frames = 0;
+    while (JMapGMBenchmarkKeepRunning(benchmark)) {
+        for (size_t i = 0; i < count; i++) {
+            remaining[i] = 8;
+            JMapGMSchedulerAdd(scheduler, (JMapGMTaskPriority)(i % JMAPGM_TASK_PRIORITY_COUNT), JMapGMBenchmarkCountStep, NULL, &remaining[i]);
+        }
+        frames = 0;
+        while (JMapGMSchedulerGetPendingCount(scheduler) > 0) {
+            JMapGMSchedulerRunFrame(scheduler, 4 * JMAPGM_BENCHMARK_MS);
+            frames++;
+        }
+    }
+    JMapGMBenchmarkSetItemsPerIteration(benchmark, (int64_t)count * 8);
+    JMapGMBenchmarkSetCounter(benchmark, "frames", (double)frames);
+    if (JMapGMBenchmarkIsSmoke(benchmark)) {
+        JMapGMSchedulerStats stats = JMapGMSchedulerGetStats(scheduler);
+        JMapGMBenchmarkCheck(benchmark, stats.completed == count && stats.steps == count * 8, "every step of every task runs once");
+    }
+    JMapGMSchedulerRelease(scheduler);
+    free(remaining);
+}
+
+const JMapGMBenchmarkEntry JMapGMSchedulerBenchmarks[] = {
+    { "SchedulerRules", JMapGMBenchmarkSchedulerRules, { 1 } },
+    /** Units on each of 4 floors */
+    { "SchedulerShowMap", JMapGMBenchmarkSchedulerShowMap, { 1000, 10000 } },
+    /** Tasks */
+    { "SchedulerOverhead", JMapGMBenchmarkSchedulerOverhead, { 100, 10000 } },
+    { NULL, NULL, { 0 } },
+};
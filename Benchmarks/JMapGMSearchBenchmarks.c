@@ -0,0 +1,194 @@
+//
+//  JMapGMSearchBenchmarks.c
+//  JMapOutdoorIndoorKit Benchmarks
+//
+//  Copyright © 2026 Jibestream. All rights reserved.
+//
+
+#include "JMapGMBenchmark.h"
+
+#include "JMapGMSyntheticVenue.h"
+#include "JMapGMTextIndex.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define JMAPGM_BENCHMARK_SEARCH_RESULTS 20
+
+// Destinations across 5 floors, each indexed by its name and category.
+static JMapGMSyntheticVenue JMapGMBenchmarkSearchVenue(size_t destinations)
+{
+    JMapGMSyntheticConfig config = JMapGMSyntheticConfigDefault;
+    config.floors = 5;
+    config.destinationsPerFloor = (uint32_t)((destinations + 4) / 5);
+    config.unitsPerFloor = config.destinationsPerFloor * 5 / 3;
+    JMapGMSyntheticVenue venue;
+    JMapGMSyntheticVenueGenerate(&venue, &config);
+    return venue;
+}
+
+static void JMapGMBenchmarkSearchAdd(JMapGMTextIndex *index, const JMapGMSyntheticVenue *venue, size_t destination)
+{
+    char text[96];
+    int length = snprintf(text, sizeof(text), "%s %s", JMapGMSyntheticVenueGetDestinationName(venue, destination),
+                          JMapGMSyntheticCategories[venue->destinationCategories[destination]]);
+    JMapGMTextIndexAdd(index, (uint32_t)destination, text, (size_t)length);
+}
+
+static JMapGMTextIndex *JMapGMBenchmarkSearchIndex(const JMapGMSyntheticVenue *venue)
+{
+    JMapGMTextIndex *index = JMapGMTextIndexCreate();
+    for (size_t d = 0; d < venue->destinationCount; d++) JMapGMBenchmarkSearchAdd(index, venue, d);
+    return index;
+}
+
+static size_t JMapGMBenchmarkSearch(JMapGMTextIndex *index, const char *query, const JMapGMTextSearchOptions *options, JMapGMTextMatch *matches)
+{
+    return JMapGMTextIndexSearch(index, query, strlen(query), options, matches, JMAPGM_BENCHMARK_SEARCH_RESULTS);
+}
+
+static void JMapGMBenchmarkSearchBuild(JMapGMBenchmark *benchmark)
+{
+    JMapGMSyntheticVenue venue = JMapGMBenchmarkSearchVenue((size_t)JMapGMBenchmarkArg(benchmark));
+    while (JMapGMBenchmarkKeepRunning(benchmark)) {
+        JMapGMTextIndex *index = JMapGMBenchmarkSearchIndex(&venue);
+        JMapGMBenchmarkUse(index);
+        JMapGMTextIndexRelease(index);
+    }
+    JMapGMBenchmarkSetItemsPerIteration(benchmark, (int64_t)venue.destinationCount);
+    JMapGMSyntheticVenueFree(&venue);
+}
+
+// Every keystroke of two searches typed into a search bar.
+static const char *const JMapGMBenchmarkKeystrokes[] = {
+    "b", "ba", "bak", "bake", "baker", "bakery",
+    "g", "go", "gol", "gold", "golde", "golden", "golden ", "golden c", "golden ca", "golden caf", "golden cafe",
+};
+
+static void JMapGMBenchmarkSearchPrefix(JMapGMBenchmark *benchmark)
+{
+    JMapGMSyntheticVenue venue = JMapGMBenchmarkSearchVenue((size_t)JMapGMBenchmarkArg(benchmark));
+    JMapGMTextIndex *index = JMapGMBenchmarkSearchIndex(&venue);
+    size_t keystrokes = sizeof(JMapGMBenchmarkKeystrokes) / sizeof(JMapGMBenchmarkKeystrokes[0]);
+    JMapGMTextMatch matches[JMAPGM_BENCHMARK_SEARCH_RESULTS];
+    while (JMapGMBenchmarkKeepRunning(benchmark)) {
+        for (size_t k = 0; k < keystrokes; k++) {
+            JMapGMBenchmarkSearch(index, JMapGMBenchmarkKeystrokes[k], NULL, matches);
+            JMapGMBenchmarkUse(matches);
+        }
+    }
+    JMapGMBenchmarkSetItemsPerIteration(benchmark, (int64_t)keystrokes);
+    if (JMapGMBenchmarkIsSmoke(benchmark)) {
+        size_t count = JMapGMBenchmarkSearch(index, "golden cafe", NULL, matches);
+        bool named = count > 0;
+        for (size_t i = 0; i < count && named; i++) {
+            named = matches[i].score >= 1 && strcmp(JMapGMSyntheticVenueGetDestinationName(&venue, matches[i].document), "Golden Cafe") == 0;
+        }
+        JMapGMBenchmarkCheck(benchmark, named, "whole words find only the named destination");
+        count = JMapGMBenchmarkSearch(index, "bak", NULL, matches);
+        bool prefixed = count > 0;
+        for (size_t i = 0; i < count && prefixed; i++) {
+            prefixed = strstr(JMapGMSyntheticVenueGetDestinationName(&venue, matches[i].document), "Bakery") != NULL && matches[i].score < 1;
+        }
+        JMapGMBenchmarkCheck(benchmark, prefixed, "prefixes find words they start");
+        bool ordered = true;
+        for (size_t i = 1; i < count; i++) ordered = ordered && matches[i - 1].score >= matches[i].score;
+        JMapGMBenchmarkCheck(benchmark, ordered, "matches are ranked best first");
+        JMapGMBenchmarkCheck(benchmark, JMapGMBenchmarkSearch(index, "zzz", NULL, matches) == 0, "unknown words find nothing");
+        JMapGMBenchmarkCheck(benchmark, JMapGMBenchmarkSearch(index, " ,", NULL, matches) == 0, "empty queries find nothing");
+    }
+    JMapGMTextIndexRelease(index);
+    JMapGMSyntheticVenueFree(&venue);
+}
+
+// Misspelled queries, each needing the edit distance walk.
+static const char *const JMapGMBenchmarkTypos[] = { "bakrey", "jeweller", "pharmcy", "electornics", "golden bistor" };
+
+static void JMapGMBenchmarkSearchTypo(JMapGMBenchmark *benchmark)
+{
+    JMapGMSyntheticVenue venue = JMapGMBenchmarkSearchVenue((size_t)JMapGMBenchmarkArg(benchmark));
+    JMapGMTextIndex *index = JMapGMBenchmarkSearchIndex(&venue);
+    size_t queries = sizeof(JMapGMBenchmarkTypos) / sizeof(JMapGMBenchmarkTypos[0]);
+    JMapGMTextMatch matches[JMAPGM_BENCHMARK_SEARCH_RESULTS];
+    size_t found = 0;
+    while (JMapGMBenchmarkKeepRunning(benchmark)) {
+        found = 0;
+        for (size_t q = 0; q < queries; q++) found += JMapGMBenchmarkSearch(index, JMapGMBenchmarkTypos[q], NULL, matches) > 0;
+    }
+    JMapGMBenchmarkSetItemsPerIteration(benchmark, (int64_t)queries);
+    JMapGMBenchmarkSetCounter(benchmark, "found", (double)found);
+    if (JMapGMBenchmarkIsSmoke(benchmark)) {
+        JMapGMBenchmarkCheck(benchmark, found == queries, "every misspelled query finds a destination");
+        size_t count = JMapGMBenchmarkSearch(index, "bakrey", NULL, matches);
+        JMapGMBenchmarkCheck(benchmark, count > 0 && strstr(JMapGMSyntheticVenueGetDestinationName(&venue, matches[0].document), "Bakery"),
+                             "a transposition finds the word");
+        count = JMapGMBenchmarkSearch(index, "abkery", NULL, matches);
+        JMapGMBenchmarkCheck(benchmark, count > 0 && strstr(JMapGMSyntheticVenueGetDestinationName(&venue, matches[0].document), "Bakery"),
+                             "a transposition of the first two letters finds the word");
+        JMapGMTextSearchOptions exact = JMapGMTextSearchOptionsDefault;
+        exact.typos = false;
+        JMapGMBenchmarkCheck(benchmark, JMapGMBenchmarkSearch(index, "bakrey", &exact, matches) == 0, "typos can be turned off");
+
+        // The closest of the destinations sharing a name ranks first.
+        float *distances = malloc(venue.destinationCount * sizeof(float));
+        for (size_t d = 0; d < venue.destinationCount; d++) distances[d] = 50.0f + (float)(d % 97);
+        size_t nearest = SIZE_MAX;
+        count = JMapGMBenchmarkSearch(index, "golden cafe", NULL, matches);
+        for (size_t i = 0; i < count; i++) {
+            if (nearest == SIZE_MAX || distances[matches[i].document] < distances[nearest]) nearest = matches[i].document;
+        }
+        if (count > 0) distances[nearest] = 0;
+        JMapGMTextSearchOptions near = JMapGMTextSearchOptionsDefault;
+        near.distances = distances;
+        near.distanceCount = venue.destinationCount;
+        count = JMapGMBenchmarkSearch(index, "golden cafe", &near, matches);
+        JMapGMBenchmarkCheck(benchmark, count > 0 && matches[0].document == nearest, "distance breaks ties between equal names");
+        free(distances);
+    }
+    JMapGMTextIndexRelease(index);
+    JMapGMSyntheticVenueFree(&venue);
+}
+
+// Removing and re-adding a tenth of the destinations, as when a venue is unloaded and reloaded.
+static void JMapGMBenchmarkSearchUpdate(JMapGMBenchmark *benchmark)
+{
+    JMapGMSyntheticVenue venue = JMapGMBenchmarkSearchVenue((size_t)JMapGMBenchmarkArg(benchmark));
+    JMapGMTextIndex *index = JMapGMBenchmarkSearchIndex(&venue);
+    size_t changed = venue.destinationCount / 10;
+    while (JMapGMBenchmarkKeepRunning(benchmark)) {
+        for (size_t d = 0; d < changed; d++) JMapGMTextIndexRemove(index, (uint32_t)d);
+        for (size_t d = 0; d < changed; d++) JMapGMBenchmarkSearchAdd(index, &venue, d);
+    }
+    JMapGMBenchmarkSetItemsPerIteration(benchmark, (int64_t)changed);
+    if (JMapGMBenchmarkIsSmoke(benchmark)) {
+        JMapGMTextMatch matches[JMAPGM_BENCHMARK_SEARCH_RESULTS];
+        const char *name = JMapGMSyntheticVenueGetDestinationName(&venue, 0);
+        for (size_t d = 0; d < venue.destinationCount; d++) {
+            if (strcmp(JMapGMSyntheticVenueGetDestinationName(&venue, d), name) == 0) JMapGMTextIndexRemove(index, (uint32_t)d);
+        }
+        JMapGMBenchmarkCheck(benchmark, JMapGMTextIndexGetDocumentCount(index) < venue.destinationCount, "removed destinations leave the index");
+        size_t count = JMapGMBenchmarkSearch(index, name, &(JMapGMTextSearchOptions){ 0 }, matches);
+        bool gone = true;
+        for (size_t i = 0; i < count; i++) gone = gone && strcmp(JMapGMSyntheticVenueGetDestinationName(&venue, matches[i].document), name) != 0;
+        JMapGMBenchmarkCheck(benchmark, gone, "removed destinations are not found");
+        JMapGMTextIndexAdd(index, 0, name, strlen(name));
+        count = JMapGMBenchmarkSearch(index, name, NULL, matches);
+        JMapGMBenchmarkCheck(benchmark, count > 0 && matches[0].document == 0, "added destinations are found");
+        JMapGMTextIndexAdd(index, 0, "Quiet Corner", 12);
+        count = JMapGMBenchmarkSearch(index, "quiet", NULL, matches);
+        JMapGMBenchmarkCheck(benchmark, count == 1 && matches[0].document == 0, "adding again replaces the text");
+    }
+    JMapGMTextIndexRelease(index);
+    JMapGMSyntheticVenueFree(&venue);
+}
+
+const JMapGMBenchmarkEntry JMapGMSearchBenchmarks[] = {
+    /** Destinations across 5 floors */
+    { "SearchBuild", JMapGMBenchmarkSearchBuild, { 1000, 20000 } },
+    { "SearchPrefix", JMapGMBenchmarkSearchPrefix, { 1000, 20000 } },
+    { "SearchTypo", JMapGMBenchmarkSearchTypo, { 1000, 20000 } },
+    { "SearchUpdate", JMapGMBenchmarkSearchUpdate, { 1000, 20000 } },
+    { NULL, NULL, { 0 } },
+};
@@ -0,0 +1,272 @@
+//
+//  JMapGMSnapshotBenchmarks.c
+//  JMapOutdoorIndoorKit Benchmarks
+//
+//  Copyright © 2026 Jibestream. All rights reserved.
+//
+
+#include "JMapGMBenchmark.h"
+
+#include "JMapGMSnapshot.h"
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define JMAPGM_BENCHMARK_SNAPSHOT_MAGIC 0x4a4d4150u
+#define JMAPGM_BENCHMARK_SNAPSHOT_LAYERS 8
+#define JMAPGM_BENCHMARK_SNAPSHOT_SHAPES 2048
+#define JMAPGM_BENCHMARK_SNAPSHOT_PUBLISHES 64
+#define JMAPGM_BENCHMARK_SNAPSHOT_THREADS 16
+
+// A map's shapes by layer, with a checksum over everything a torn or freed snapshot would break.
+typedef struct {
+    uint32_t magic;
+    uint64_t version;
+    uint32_t layerStarts[JMAPGM_BENCHMARK_SNAPSHOT_LAYERS + 1];
+    uint32_t *shapes;
+    uint64_t checksum;
+} JMapGMBenchmarkSnapshot;
+
+static uint64_t JMapGMBenchmarkSnapshotChecksum(const JMapGMBenchmarkSnapshot *snapshot)
+{
+    uint64_t hash = 1469598103934665603ull ^ snapshot->version;
+    uint32_t count = snapshot->layerStarts[JMAPGM_BENCHMARK_SNAPSHOT_LAYERS];
+    for (uint32_t i = 0; i <= JMAPGM_BENCHMARK_SNAPSHOT_LAYERS; i++) hash = (hash ^ snapshot->layerStarts[i]) * 1099511628211ull;
+    for (uint32_t i = 0; i < count; i++) hash = (hash ^ snapshot->shapes[i]) * 1099511628211ull;
+    return hash;
+}
+
+// Copies a snapshot and replaces the shapes of one layer, as an update applied aside would.
+static JMapGMBenchmarkSnapshot *JMapGMBenchmarkSnapshotDerive(const JMapGMBenchmarkSnapshot *previous, uint64_t version)
+{
+    JMapGMBenchmarkSnapshot *snapshot = malloc(sizeof(JMapGMBenchmarkSnapshot));
+    snapshot->magic = JMAPGM_BENCHMARK_SNAPSHOT_MAGIC;
+    snapshot->version = version;
+    uint32_t count = JMAPGM_BENCHMARK_SNAPSHOT_SHAPES;
+    for (uint32_t i = 0; i <= JMAPGM_BENCHMARK_SNAPSHOT_LAYERS; i++) snapshot->layerStarts[i] = i * count / JMAPGM_BENCHMARK_SNAPSHOT_LAYERS;
+    snapshot->shapes = malloc(count * sizeof(uint32_t));
+    if (previous) memcpy(snapshot->shapes, previous->shapes, count * sizeof(uint32_t));
+    else for (uint32_t i = 0; i < count; i++) snapshot->shapes[i] = i;
+    uint32_t layer = (uint32_t)(version % JMAPGM_BENCHMARK_SNAPSHOT_LAYERS);
+    for (uint32_t i = snapshot->layerStarts[layer]; i < snapshot->layerStarts[layer + 1]; i++) snapshot->shapes[i] = snapshot->shapes[i] * 2654435761u + (uint32_t)version;
+    snapshot->checksum = JMapGMBenchmarkSnapshotChecksum(snapshot);
+    return snapshot;
+}
+
+// Overwrites before freeing, so a reader still holding the snapshot fails its checks.
+static void JMapGMBenchmarkSnapshotFree(void *context)
+{
+    JMapGMBenchmarkSnapshot *snapshot = context;
+    memset(snapshot->shapes, 0xdd, JMAPGM_BENCHMARK_SNAPSHOT_SHAPES * sizeof(uint32_t));
+    free(snapshot->shapes);
+    memset(snapshot, 0xdd, sizeof(JMapGMBenchmarkSnapshot));
+    free(snapshot);
+}
+
+static JMapGMBenchmarkSnapshot *JMapGMBenchmarkSnapshotPublishNext(JMapGMSnapshotStore *store, const JMapGMBenchmarkSnapshot *previous)
+{
+    uint64_t version = JMapGMSnapshotStoreGetStats(store).version + 1;
+    JMapGMBenchmarkSnapshot *snapshot = JMapGMBenchmarkSnapshotDerive(previous, version);
+    JMapGMSnapshotStorePublish(store, snapshot);
+    return snapshot;
+}
+
+typedef struct {
+    JMapGMSnapshotStore *store;
+    atomic_bool *stop;
+    atomic_int *started;
+    /** Claims a reader for every read instead of keeping one */
+    bool transient;
+    uint64_t reads;
+    uint64_t errors;
+} JMapGMBenchmarkSnapshotReader;
+
+static void *JMapGMBenchmarkSnapshotRead(void *context)
+{
+    JMapGMBenchmarkSnapshotReader *state = context;
+    int reader = state->transient ? JMAPGM_SNAPSHOT_NO_READER : JMapGMSnapshotStoreAddReader(state->store);
+    uint64_t lastVersion = 0;
+    bool counted = false;
+    while (!atomic_load_explicit(state->stop, memory_order_relaxed)) {
+        if (state->transient) reader = JMapGMSnapshotStoreAddReader(state->store);
+        if (reader == JMAPGM_SNAPSHOT_NO_READER) {
+            state->errors++;
+            break;
+        }
+        uint64_t version;
+        const JMapGMBenchmarkSnapshot *snapshot = JMapGMSnapshotStoreBeginRead(state->store, reader, &version);
+        // Versions only move forward for one reader, and each matches the snapshot it came with.
+        bool valid = snapshot && snapshot->magic == JMAPGM_BENCHMARK_SNAPSHOT_MAGIC && snapshot->version == version &&
+                     version >= lastVersion && JMapGMBenchmarkSnapshotChecksum(snapshot) == snapshot->checksum;
+        JMapGMSnapshotStoreEndRead(state->store, reader);
+        if (state->transient) JMapGMSnapshotStoreRemoveReader(state->store, reader);
+        state->errors += !valid;
+        lastVersion = version;
+        state->reads++;
+        if (!counted) {
+            atomic_fetch_add(state->started, 1);
+            counted = true;
+        }
+    }
+    if (!state->transient) JMapGMSnapshotStoreRemoveReader(state->store, reader);
+    if (!counted) atomic_fetch_add(state->started, 1);
+    return NULL;
+}
+
+// One writer publishes copy-on-write updates while reader threads validate every snapshot they
+// load. Half the readers keep their slot, half claim one per read. Build with JMAPGM_TSAN to have
+// ThreadSanitizer check the same run.
+static void JMapGMBenchmarkSnapshotStress(JMapGMBenchmark *benchmark)
+{
+    int threads = (int)JMapGMBenchmarkArg(benchmark);
+    if (threads > JMAPGM_BENCHMARK_SNAPSHOT_THREADS) threads = JMAPGM_BENCHMARK_SNAPSHOT_THREADS;
+    JMapGMSnapshotStore *store = JMapGMSnapshotStoreCreate(JMapGMBenchmarkSnapshotFree);
+    JMapGMBenchmarkSnapshot *current = JMapGMBenchmarkSnapshotPublishNext(store, NULL);
+    uint64_t published = 1;
+
+    atomic_bool stop;
+    atomic_int started;
+    atomic_init(&stop, false);
+    atomic_init(&started, 0);
+    pthread_t ids[JMAPGM_BENCHMARK_SNAPSHOT_THREADS];
+    JMapGMBenchmarkSnapshotReader readers[JMAPGM_BENCHMARK_SNAPSHOT_THREADS];
+    for (int t = 0; t < threads; t++) {
+        readers[t] = (JMapGMBenchmarkSnapshotReader){ store, &stop, &started, t % 2 == 1, 0, 0 };
+        pthread_create(&ids[t], NULL, JMapGMBenchmarkSnapshotRead, &readers[t]);
+    }
+    while (atomic_load(&started) < threads) {}
+
+    size_t maxRetired = 0;
+    while (JMapGMBenchmarkKeepRunning(benchmark)) {
+        for (int p = 0; p < JMAPGM_BENCHMARK_SNAPSHOT_PUBLISHES; p++) {
+            // The writer reads its own last snapshot, which the store keeps until it is replaced.
+            current = JMapGMBenchmarkSnapshotPublishNext(store, current);
+            published++;
+            size_t retired = JMapGMSnapshotStoreGetStats(store).retired;
+            if (retired > maxRetired) maxRetired = retired;
+        }
+    }
+    atomic_store(&stop, true);
+
+    uint64_t reads = 0, errors = 0;
+    for (int t = 0; t < threads; t++) {
+        pthread_join(ids[t], NULL);
+        reads += readers[t].reads;
+        errors += readers[t].errors;
+    }
+    JMapGMBenchmarkCheck(benchmark, errors == 0, "a reader loaded a torn, freed or older snapshot");
+    JMapGMBenchmarkCheck(benchmark, reads >= (uint64_t)threads, "every reader read");
+
+    // With every read over, each replaced snapshot is freed and only the current one is left.
+    JMapGMSnapshotStoreReclaim(store);
+    JMapGMSnapshotStats stats = JMapGMSnapshotStoreGetStats(store);
+    JMapGMBenchmarkCheck(benchmark, stats.version == published, "one version per publish");
+    JMapGMBenchmarkCheck(benchmark, stats.retired == 0 && stats.freed == published - 1, "replaced snapshots are freed");
+    JMapGMSnapshotStoreRelease(store);
+
+    JMapGMBenchmarkSetItemsPerIteration(benchmark, JMAPGM_BENCHMARK_SNAPSHOT_PUBLISHES);
+    JMapGMBenchmarkSetCounter(benchmark, "reads", (double)reads);
+    JMapGMBenchmarkSetCounter(benchmark, "maxRetired", (double)maxRetired);
+}
+
+// Reclaiming around a reader that holds one snapshot across many publishes.
+static void JMapGMBenchmarkSnapshotCheckReclaim(JMapGMBenchmark *benchmark)
+{
+    while (JMapGMBenchmarkKeepRunning(benchmark)) {
+        JMapGMSnapshotStore *store = JMapGMSnapshotStoreCreate(JMapGMBenchmarkSnapshotFree);
+        int reader = JMapGMSnapshotStoreAddReader(store);
+        uint64_t version;
+        JMapGMBenchmarkCheck(benchmark, JMapGMSnapshotStoreBeginRead(store, reader, &version) == NULL && version == JMAPGM_SNAPSHOT_NONE, "an empty store has no snapshot");
+        JMapGMSnapshotStoreEndRead(store, reader);
+
+        JMapGMBenchmarkSnapshot *first = JMapGMBenchmarkSnapshotPublishNext(store, NULL);
+        const JMapGMBenchmarkSnapshot *held = JMapGMSnapshotStoreBeginRead(store, reader, &version);
+        JMapGMBenchmarkCheck(benchmark, held == first && version == 1, "a read loads the current snapshot");
+        JMapGMBenchmarkSnapshot *current = first;
+        for (int p = 0; p < 3; p++) current = JMapGMBenchmarkSnapshotPublishNext(store, current);
+        JMapGMSnapshotStats stats = JMapGMSnapshotStoreGetStats(store);
+        // The held snapshot and the two replaced after the read started are all kept.
+        JMapGMBenchmarkCheck(benchmark, stats.version == 4 && stats.retired == 3 && stats.freed == 0, "a running read holds back freeing");
+        JMapGMBenchmarkCheck(benchmark, held->checksum == JMapGMBenchmarkSnapshotChecksum(held), "a held snapshot stays intact");
+
+        int other = JMapGMSnapshotStoreAddReader(store);
+        const JMapGMBenchmarkSnapshot *latest = JMapGMSnapshotStoreBeginRead(store, other, &version);
+        JMapGMBenchmarkCheck(benchmark, latest == current && version == 4, "a later read loads the latest snapshot");
+        JMapGMSnapshotStoreEndRead(store, other);
+        JMapGMSnapshotStoreRemoveReader(store, other);
+
+        JMapGMSnapshotStoreEndRead(store, reader);
+        JMapGMBenchmarkCheck(benchmark, JMapGMSnapshotStoreReclaim(store) == 3, "ending the read frees what it held back");
+        stats = JMapGMSnapshotStoreGetStats(store);
+        JMapGMBenchmarkCheck(benchmark, stats.retired == 0 && stats.freed == 3, "only the current snapshot is left");
+
+        // Slots run out, and come back when removed.
+        int claimed[JMAPGM_SNAPSHOT_READERS];
+        claimed[0] = reader;
+        for (int r = 1; r < JMAPGM_SNAPSHOT_READERS; r++) claimed[r] = JMapGMSnapshotStoreAddReader(store);
+        JMapGMBenchmarkCheck(benchmark, claimed[JMAPGM_SNAPSHOT_READERS - 1] != JMAPGM_SNAPSHOT_NO_READER, "every slot can be claimed");
+        JMapGMBenchmarkCheck(benchmark, JMapGMSnapshotStoreAddReader(store) == JMAPGM_SNAPSHOT_NO_READER, "slots run out");
+        JMapGMSnapshotStoreRemoveReader(store, claimed[7]);
+        JMapGMBenchmarkCheck(benchmark, JMapGMSnapshotStoreAddReader(store) == claimed[7], "a removed slot is reused");
+        JMapGMSnapshotStoreRelease(store);
+    }
+}
+
+typedef struct {
+    JMapGMSnapshotStore *store;
+    atomic_bool *stop;
+    JMapGMBenchmarkSnapshot *current;
+    uint64_t published;
+} JMapGMBenchmarkSnapshotWriter;
+
+static void *JMapGMBenchmarkSnapshotWrite(void *context)
+{
+    JMapGMBenchmarkSnapshotWriter *state = context;
+    while (!atomic_load_explicit(state->stop, memory_order_relaxed)) {
+        state->current = JMapGMBenchmarkSnapshotPublishNext(state->store, state->current);
+        state->published++;
+    }
+    return NULL;
+}
+
+// The cost of one read of a small query over the current snapshot, alone (1 thread) and with a
+// writer publishing continuously on another thread (2 threads).
+static void JMapGMBenchmarkSnapshotReadLatency(JMapGMBenchmark *benchmark)
+{
+    bool writing = JMapGMBenchmarkArg(benchmark) > 1;
+    JMapGMSnapshotStore *store = JMapGMSnapshotStoreCreate(JMapGMBenchmarkSnapshotFree);
+    atomic_bool stop;
+    atomic_init(&stop, false);
+    JMapGMBenchmarkSnapshotWriter writer = { store, &stop, NULL, 0 };
+    writer.current = JMapGMBenchmarkSnapshotPublishNext(store, NULL);
+    pthread_t thread;
+    if (writing) pthread_create(&thread, NULL, JMapGMBenchmarkSnapshotWrite, &writer);
+
+    int reader = JMapGMSnapshotStoreAddReader(store);
+    uint64_t sum = 0, reads = 0;
+    while (JMapGMBenchmarkKeepRunning(benchmark)) {
+        uint64_t version;
+        const JMapGMBenchmarkSnapshot *snapshot = JMapGMSnapshotStoreBeginRead(store, reader, &version);
+        uint32_t layer = (uint32_t)(reads % JMAPGM_BENCHMARK_SNAPSHOT_LAYERS);
+        sum += snapshot->shapes[snapshot->layerStarts[layer]] + version;
+        JMapGMSnapshotStoreEndRead(store, reader);
+        reads++;
+    }
+    JMapGMSnapshotStoreRemoveReader(store, reader);
+    atomic_store(&stop, true);
+    if (writing) pthread_join(thread, NULL);
+    JMapGMBenchmarkUse(&sum);
+    JMapGMSnapshotStoreRelease(store);
+
+    JMapGMBenchmarkSetItemsPerIteration(benchmark, 1);
+    JMapGMBenchmarkSetCounter(benchmark, "publishes", (double)writer.published);
+}
+
+const JMapGMBenchmarkEntry JMapGMSnapshotBenchmarks[] = {
+    { "SnapshotReclaim", JMapGMBenchmarkSnapshotCheckReclaim, { 0 } },
+    { "SnapshotStress", JMapGMBenchmarkSnapshotStress, { 4, 8 } },
+    { "SnapshotRead", JMapGMBenchmarkSnapshotReadLatency, { 1, 2 } },
+    { NULL, NULL, { 0 } },
+};
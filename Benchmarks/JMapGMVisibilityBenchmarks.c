@@ -0,0 +1,125 @@
+//
+//  JMapGMVisibilityBenchmarks.c
+//  JMapOutdoorIndoorKit Benchmarks
+//
+//  Copyright © 2026 Jibestream. All rights reserved.
+//
+
+#include "JMapGMBenchmark.h"
+
+#include "JMapGMSyntheticVenue.h"
+#include "JMapGMVisibilityIndex.h"
+
+#include <stdlib.h>
+
+// The icons as the map would show them after the reported calls.
+typedef struct {
+    const JMapGMSyntheticVenue *venue;
+    bool *shown;
+    uint32_t *styles;
+    size_t calls;
+} JMapGMBenchmarkIcons;
+
+static void JMapGMBenchmarkIconsApply(const JMapGMVisibilityChange *change, void *context)
+{
+    JMapGMBenchmarkIcons *icons = context;
+    icons->calls++;
+    if (!icons->shown) return;
+    for (size_t i = 0; i < icons->venue->amenityCount; i++) {
+        if (change->type != JMAPGM_VISIBILITY_ALL && change->type != icons->venue->amenityTypes[i]) continue;
+        if (change->waypoint != JMAPGM_VISIBILITY_ALL && change->waypoint != icons->venue->amenityWaypoints[i]) continue;
+        switch (change->action) {
+            case JMapGMVisibilityShow: icons->shown[i] = true; break;
+            case JMapGMVisibilityHide: icons->shown[i] = false; break;
+            case JMapGMVisibilityStyle: icons->styles[i] = change->style; break;
+            case JMapGMVisibilityResetStyle: icons->styles[i] = JMAPGM_VISIBILITY_DEFAULT_STYLE; break;
+        }
+    }
+}
+
+static JMapGMSyntheticVenue JMapGMBenchmarkAmenityVenue(int64_t amenities)
+{
+    JMapGMSyntheticConfig config = JMapGMSyntheticConfigDefault;
+    config.floors = 1;
+    config.amenitiesPerFloor = (uint32_t)amenities;
+    config.amenityTypes = 40;
+    JMapGMSyntheticVenue venue;
+    JMapGMSyntheticVenueGenerate(&venue, &config);
+    return venue;
+}
+
+// Filter chips: hide 30 of 40 amenity types one by one, then show everything again.
+static void JMapGMBenchmarkIconToggle(JMapGMBenchmark *benchmark)
+{
+    JMapGMSyntheticVenue venue = JMapGMBenchmarkAmenityVenue(JMapGMBenchmarkArg(benchmark));
+    JMapGMVisibilityIndex *index = JMapGMVisibilityIndexCreate(venue.amenityTypes, venue.amenityWaypoints, venue.amenityCount, true);
+    JMapGMBenchmarkIcons icons = { &venue, NULL, NULL, 0 };
+    size_t commits = 0;
+    while (JMapGMBenchmarkKeepRunning(benchmark)) {
+        for (uint32_t type = 0; type < 30; type++) {
+            JMapGMVisibilityIndexSetVisible(index, type, JMAPGM_VISIBILITY_ALL, false);
+        }
+        JMapGMVisibilityIndexCommit(index, JMapGMBenchmarkIconsApply, &icons);
+        JMapGMVisibilityIndexSetVisible(index, JMAPGM_VISIBILITY_ALL, JMAPGM_VISIBILITY_ALL, true);
+        JMapGMVisibilityIndexCommit(index, JMapGMBenchmarkIconsApply, &icons);
+        commits += 2;
+    }
+    JMapGMBenchmarkSetItemsPerIteration(benchmark, 31);
+    JMapGMBenchmarkSetCounter(benchmark, "calls/commit", commits ? (double)icons.calls / commits : 0);
+    // 30 type calls to hide, one showAll to restore.
+    JMapGMBenchmarkCheck(benchmark, commits == 0 || icons.calls * 2 == commits * 31, "toggles collapse to type and global calls");
+    JMapGMVisibilityIndexRelease(index);
+    JMapGMSyntheticVenueFree(&venue);
+}
+
+// Random mixed changes; the calls must always leave the map in the requested state.
+static void JMapGMBenchmarkIconRandomCommits(JMapGMBenchmark *benchmark)
+{
+    JMapGMSyntheticVenue venue = JMapGMBenchmarkAmenityVenue(JMapGMBenchmarkArg(benchmark));
+    JMapGMVisibilityIndex *index = JMapGMVisibilityIndexCreate(venue.amenityTypes, venue.amenityWaypoints, venue.amenityCount, true);
+    bool smoke = JMapGMBenchmarkIsSmoke(benchmark);
+    JMapGMBenchmarkIcons icons = { &venue, NULL, NULL, 0 };
+    if (smoke) {
+        icons.shown = malloc(venue.amenityCount * sizeof(bool));
+        icons.styles = calloc(venue.amenityCount, sizeof(uint32_t));
+        for (size_t i = 0; i < venue.amenityCount; i++) icons.shown[i] = true;
+    }
+    uint64_t random = 5;
+    bool consistent = true;
+    size_t commits = 0;
+    while (JMapGMBenchmarkKeepRunning(benchmark)) {
+        for (int rounds = smoke ? 200 : 1; rounds > 0; rounds--) {
+            int changes = 1 + (int)(JMapGMSyntheticRandom(&random) % 8);
+            for (int c = 0; c < changes; c++) {
+                uint64_t r = JMapGMSyntheticRandom(&random);
+                size_t instance = (size_t)(r >> 8) % venue.amenityCount;
+                uint32_t type = r & 1 ? JMAPGM_VISIBILITY_ALL : venue.amenityTypes[instance];
+                uint32_t waypoint = r & 2 ? JMAPGM_VISIBILITY_ALL : venue.amenityWaypoints[instance];
+                if (r & 4) JMapGMVisibilityIndexSetVisible(index, type, waypoint, r & 8);
+                else JMapGMVisibilityIndexSetStyle(index, type, waypoint, (uint32_t)(r >> 4) % 3);
+            }
+            JMapGMVisibilityIndexCommit(index, JMapGMBenchmarkIconsApply, &icons);
+            commits++;
+            if (!smoke) continue;
+            for (size_t i = 0; i < venue.amenityCount && consistent; i++) {
+                uint32_t type = venue.amenityTypes[i], waypoint = venue.amenityWaypoints[i];
+                consistent = icons.shown[i] == JMapGMVisibilityIndexIsVisible(index, type, waypoint) &&
+                             icons.styles[i] == JMapGMVisibilityIndexGetStyle(index, type, waypoint);
+            }
+            consistent = consistent && !JMapGMVisibilityIndexHasChanges(index);
+        }
+    }
+    JMapGMBenchmarkSetCounter(benchmark, "calls/commit", commits ? (double)icons.calls / commits : 0);
+    JMapGMBenchmarkCheck(benchmark, consistent, "committed calls reproduce the requested visibility and styles");
+    free(icons.shown);
+    free(icons.styles);
+    JMapGMVisibilityIndexRelease(index);
+    JMapGMSyntheticVenueFree(&venue);
+}
+
+const JMapGMBenchmarkEntry JMapGMVisibilityBenchmarks[] = {
+    /** Amenity instances */
+    { "IconToggle", JMapGMBenchmarkIconToggle, { 400, 4000, 40000 } },
+    { "IconRandomCommits", JMapGMBenchmarkIconRandomCommits, { 400, 4000 } },
+    { NULL, NULL, { 0 } },
+};
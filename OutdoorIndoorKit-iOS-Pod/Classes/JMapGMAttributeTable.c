@@ -0,0 +1,409 @@
+//
+//  JMapGMAttributeTable.c
+//  JMapOutdoorIndoorKit
+//
+//  Copyright © 2026 Jibestream. All rights reserved.
+//
+
+#include "JMapGMAttributeTable.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define JMAPGM_SIMD_AVX2 1
+#endif
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define JMAPGM_SIMD_SSE2 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define JMAPGM_SIMD_NEON 1
+#endif
+
+typedef struct {
+    uint32_t key;
+    JMapGMAttributeType type;
+    /** rowCapacity values; rows past rowCount hold NaN or JMAPGM_ATTRIBUTE_NONE */
+    union {
+        double *numbers;
+        uint32_t *strings;
+    };
+} JMapGMAttributeColumn;
+
+struct JMapGMAttributeTable {
+    size_t rowCount;
+    /** A multiple of 64, so filters work on whole bitmap words */
+    size_t rowCapacity;
+    JMapGMAttributeColumn *columns;
+    size_t columnCount;
+    size_t columnCapacity;
+
+    /** NUL terminated strings back to back; string i starts at stringStarts[i] */
+    char *bytes;
+    size_t byteCount;
+    size_t byteCapacity;
+    uint32_t *stringStarts;
+    uint32_t *stringLengths;
+    size_t stringCount;
+    size_t stringCapacity;
+    /** Open addressing on string code + 1, 0 for an empty slot */
+    uint32_t *slots;
+    size_t slotCount;
+};
+
+JMapGMAttributeTable *JMapGMAttributeTableCreate(void)
+{
+    return calloc(1, sizeof(JMapGMAttributeTable));
+}
+
+void JMapGMAttributeTableRelease(JMapGMAttributeTable *table)
+{
+    if (!table) return;
+    for (size_t i = 0; i < table->columnCount; i++) free(table->columns[i].numbers);
+    free(table->columns);
+    free(table->bytes);
+    free(table->stringStarts);
+    free(table->stringLengths);
+    free(table->slots);
+    free(table);
+}
+
+static size_t JMapGMColumnValueSize(JMapGMAttributeType type)
+{
+    return type == JMapGMAttributeString ? sizeof(uint32_t) : sizeof(double);
+}
+
+static void JMapGMColumnClear(JMapGMAttributeColumn *column, size_t from, size_t to)
+{
+    for (size_t i = from; i < to; i++) {
+        if (column->type == JMapGMAttributeString) column->strings[i] = JMAPGM_ATTRIBUTE_NONE;
+        else column->numbers[i] = NAN;
+    }
+}
+
+uint32_t JMapGMAttributeTableAddRow(JMapGMAttributeTable *table)
+{
+    if (table->rowCount >= JMAPGM_ATTRIBUTE_NONE) return JMAPGM_ATTRIBUTE_NONE;
+    if (table->rowCount == table->rowCapacity) {
+        size_t capacity = table->rowCapacity ? table->rowCapacity * 2 : 64;
+        for (size_t i = 0; i < table->columnCount; i++) {
+            JMapGMAttributeColumn *column = &table->columns[i];
+            void *grown = realloc(column->numbers, capacity * JMapGMColumnValueSize(column->type));
+            if (!grown) return JMAPGM_ATTRIBUTE_NONE;
+            column->numbers = grown;
+            JMapGMColumnClear(column, table->rowCapacity, capacity);
+        }
+        table->rowCapacity = capacity;
+    }
+    return (uint32_t)table->rowCount++;
+}
+
+size_t JMapGMAttributeTableGetRowCount(const JMapGMAttributeTable *table)
+{
+    return table->rowCount;
+}
+
+size_t JMapGMAttributeTableGetMemoryUsage(const JMapGMAttributeTable *table)
+{
+    size_t bytes = sizeof(*table) + table->columnCapacity * sizeof(JMapGMAttributeColumn);
+    for (size_t i = 0; i < table->columnCount; i++) {
+        bytes += table->rowCapacity * JMapGMColumnValueSize(table->columns[i].type);
+    }
+    bytes += table->byteCapacity + table->stringCapacity * 2 * sizeof(uint32_t) + table->slotCount * sizeof(uint32_t);
+    return bytes;
+}
+
+#pragma mark - Strings
+
+static uint32_t JMapGMStringHash(const char *string, size_t length)
+{
+    // FNV-1a
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= (uint8_t)string[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static size_t JMapGMStringSlot(const JMapGMAttributeTable *table, const char *string, size_t length, uint32_t hash)
+{
+    size_t mask = table->slotCount - 1;
+    for (size_t slot = hash & mask;; slot = (slot + 1) & mask) {
+        uint32_t entry = table->slots[slot];
+        if (entry == 0) return slot;
+        uint32_t code = entry - 1;
+        if (table->stringLengths[code] == length && memcmp(table->bytes + table->stringStarts[code], string, length) == 0) {
+            return slot;
+        }
+    }
+}
+
+static bool JMapGMStringRehash(JMapGMAttributeTable *table, size_t slotCount)
+{
+    uint32_t *slots = calloc(slotCount, sizeof(uint32_t));
+    if (!slots) return false;
+    free(table->slots);
+    table->slots = slots;
+    table->slotCount = slotCount;
+    for (size_t code = 0; code < table->stringCount; code++) {
+        const char *string = table->bytes + table->stringStarts[code];
+        size_t length = table->stringLengths[code];
+        table->slots[JMapGMStringSlot(table, string, length, JMapGMStringHash(string, length))] = (uint32_t)code + 1;
+    }
+    return true;
+}
+
+uint32_t JMapGMAttributeTableFindString(const JMapGMAttributeTable *table, const char *string, size_t length)
+{
+    if (table->slotCount == 0) return JMAPGM_ATTRIBUTE_NONE;
+    uint32_t entry = table->slots[JMapGMStringSlot(table, string, length, JMapGMStringHash(string, length))];
+    return entry ? entry - 1 : JMAPGM_ATTRIBUTE_NONE;
+}
+
+uint32_t JMapGMAttributeTableIntern(JMapGMAttributeTable *table, const char *string, size_t length)
+{
+    uint32_t found = JMapGMAttributeTableFindString(table, string, length);
+    if (found != JMAPGM_ATTRIBUTE_NONE) return found;
+    if (table->stringCount + 1 >= JMAPGM_ATTRIBUTE_NONE || table->byteCount + length + 1 > UINT32_MAX) {
+        return JMAPGM_ATTRIBUTE_NONE;
+    }
+
+    // Keep the load factor under one half.
+    if ((table->stringCount + 1) * 2 > table->slotCount) {
+        if (!JMapGMStringRehash(table, table->slotCount ? table->slotCount * 2 : 64)) return JMAPGM_ATTRIBUTE_NONE;
+    }
+    if (table->stringCount == table->stringCapacity) {
+        size_t capacity = table->stringCapacity ? table->stringCapacity * 2 : 32;
+        uint32_t *starts = realloc(table->stringStarts, capacity * sizeof(uint32_t));
+        if (!starts) return JMAPGM_ATTRIBUTE_NONE;
+        table->stringStarts = starts;
+        uint32_t *lengths = realloc(table->stringLengths, capacity * sizeof(uint32_t));
+        if (!lengths) return JMAPGM_ATTRIBUTE_NONE;
+        table->stringLengths = lengths;
+        table->stringCapacity = capacity;
+    }
+    if (table->byteCount + length + 1 > table->byteCapacity) {
+        size_t capacity = table->byteCapacity ? table->byteCapacity : 1024;
+        while (capacity < table->byteCount + length + 1) capacity *= 2;
+        char *bytes = realloc(table->bytes, capacity);
+        if (!bytes) return JMAPGM_ATTRIBUTE_NONE;
+        table->bytes = bytes;
+        table->byteCapacity = capacity;
+    }
+
+    uint32_t code = (uint32_t)table->stringCount++;
+    table->stringStarts[code] = (uint32_t)table->byteCount;
+    table->stringLengths[code] = (uint32_t)length;
+    memcpy(table->bytes + table->byteCount, string, length);
+    table->bytes[table->byteCount + length] = '\0';
+    table->byteCount += length + 1;
+    table->slots[JMapGMStringSlot(table, string, length, JMapGMStringHash(string, length))] = code + 1;
+    return code;
+}
+
+const char *JMapGMAttributeTableGetString(const JMapGMAttributeTable *table, uint32_t string, size_t *length)
+{
+    if (string >= table->stringCount) {
+        if (length) *length = 0;
+        return NULL;
+    }
+    if (length) *length = table->stringLengths[string];
+    return table->bytes + table->stringStarts[string];
+}
+
+size_t JMapGMAttributeTableGetStringCount(const JMapGMAttributeTable *table)
+{
+    return table->stringCount;
+}
+
+#pragma mark - Columns
+
+uint32_t JMapGMAttributeTableGetColumn(const JMapGMAttributeTable *table, uint32_t key, JMapGMAttributeType type)
+{
+    // Tables have tens of columns, so a scan beats hashing.
+    for (size_t i = 0; i < table->columnCount; i++) {
+        if (table->columns[i].key == key && table->columns[i].type == type) return (uint32_t)i;
+    }
+    return JMAPGM_ATTRIBUTE_NONE;
+}
+
+size_t JMapGMAttributeTableGetColumnCount(const JMapGMAttributeTable *table)
+{
+    return table->columnCount;
+}
+
+uint32_t JMapGMAttributeTableGetColumnKey(const JMapGMAttributeTable *table, uint32_t column)
+{
+    return column < table->columnCount ? table->columns[column].key : JMAPGM_ATTRIBUTE_NONE;
+}
+
+JMapGMAttributeType JMapGMAttributeTableGetColumnType(const JMapGMAttributeTable *table, uint32_t column)
+{
+    return column < table->columnCount ? table->columns[column].type : JMapGMAttributeNumber;
+}
+
+static JMapGMAttributeColumn *JMapGMAttributeTableColumnForSet(JMapGMAttributeTable *table, uint32_t key, JMapGMAttributeType type)
+{
+    uint32_t index = JMapGMAttributeTableGetColumn(table, key, type);
+    if (index != JMAPGM_ATTRIBUTE_NONE) return &table->columns[index];
+    if (key >= table->stringCount) return NULL;
+
+    if (table->columnCount == table->columnCapacity) {
+        size_t capacity = table->columnCapacity ? table->columnCapacity * 2 : 8;
+        JMapGMAttributeColumn *columns = realloc(table->columns, capacity * sizeof(JMapGMAttributeColumn));
+        if (!columns) return NULL;
+        table->columns = columns;
+        table->columnCapacity = capacity;
+    }
+    JMapGMAttributeColumn column = { .key = key, .type = type };
+    column.numbers = malloc((table->rowCapacity ? table->rowCapacity : 1) * JMapGMColumnValueSize(type));
+    if (!column.numbers) return NULL;
+    JMapGMColumnClear(&column, 0, table->rowCapacity);
+    table->columns[table->columnCount] = column;
+    return &table->columns[table->columnCount++];
+}
+
+bool JMapGMAttributeTableSetNumber(JMapGMAttributeTable *table, uint32_t row, uint32_t key, JMapGMAttributeType type, double value)
+{
+    if (row >= table->rowCount || type == JMapGMAttributeString) return false;
+    JMapGMAttributeColumn *column = JMapGMAttributeTableColumnForSet(table, key, type);
+    if (!column) return false;
+    column->numbers[row] = type == JMapGMAttributeBoolean && !isnan(value) ? (value != 0) : value;
+    return true;
+}
+
+bool JMapGMAttributeTableSetString(JMapGMAttributeTable *table, uint32_t row, uint32_t key, uint32_t string)
+{
+    if (row >= table->rowCount) return false;
+    if (string != JMAPGM_ATTRIBUTE_NONE && string >= table->stringCount) return false;
+    JMapGMAttributeColumn *column = JMapGMAttributeTableColumnForSet(table, key, JMapGMAttributeString);
+    if (!column) return false;
+    column->strings[row] = string;
+    return true;
+}
+
+double JMapGMAttributeTableGetNumber(const JMapGMAttributeTable *table, uint32_t column, uint32_t row)
+{
+    if (column >= table->columnCount || row >= table->rowCount) return NAN;
+    const JMapGMAttributeColumn *c = &table->columns[column];
+    return c->type == JMapGMAttributeString ? NAN : c->numbers[row];
+}
+
+uint32_t JMapGMAttributeTableGetStringValue(const JMapGMAttributeTable *table, uint32_t column, uint32_t row)
+{
+    if (column >= table->columnCount || row >= table->rowCount) return JMAPGM_ATTRIBUTE_NONE;
+    const JMapGMAttributeColumn *c = &table->columns[column];
+    return c->type == JMapGMAttributeString ? c->strings[row] : JMAPGM_ATTRIBUTE_NONE;
+}
+
+#pragma mark - Filters
+
+// Columns are padded to whole words with values that never match, so the kernels have no tails.
+
+static uint64_t JMapGMMatchStringWord(const uint32_t *codes, uint32_t string)
+{
+    uint64_t word = 0;
+#if JMAPGM_SIMD_AVX2
+    __m256i needle = _mm256_set1_epi32((int)string);
+    for (unsigned i = 0; i < 64; i += 8) {
+        __m256i eq = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i *)(codes + i)), needle);
+        word |= (uint64_t)(uint32_t)_mm256_movemask_ps(_mm256_castsi256_ps(eq)) << i;
+    }
+#elif JMAPGM_SIMD_SSE2
+    __m128i needle = _mm_set1_epi32((int)string);
+    for (unsigned i = 0; i < 64; i += 4) {
+        __m128i eq = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *)(codes + i)), needle);
+        word |= (uint64_t)(uint32_t)_mm_movemask_ps(_mm_castsi128_ps(eq)) << i;
+    }
+#elif JMAPGM_SIMD_NEON
+    uint32x4_t needle = vdupq_n_u32(string);
+    const uint32_t weights[4] = { 1, 2, 4, 8 };
+    uint32x4_t lanes = vld1q_u32(weights);
+    for (unsigned i = 0; i < 64; i += 4) {
+        uint32x4_t eq = vceqq_u32(vld1q_u32(codes + i), needle);
+        word |= (uint64_t)vaddvq_u32(vandq_u32(eq, lanes)) << i;
+    }
+#else
+    for (unsigned i = 0; i < 64; i++) word |= (uint64_t)(codes[i] == string) << i;
+#endif
+    return word;
+}
+
+static uint64_t JMapGMMatchRangeWord(const double *values, double min, double max)
+{
+    uint64_t word = 0;
+#if JMAPGM_SIMD_AVX2
+    __m256d lo = _mm256_set1_pd(min), hi = _mm256_set1_pd(max);
+    for (unsigned i = 0; i < 64; i += 4) {
+        __m256d v = _mm256_loadu_pd(values + i);
+        __m256d in = _mm256_and_pd(_mm256_cmp_pd(v, lo, _CMP_GE_OQ), _mm256_cmp_pd(v, hi, _CMP_LE_OQ));
+        word |= (uint64_t)(uint32_t)_mm256_movemask_pd(in) << i;
+    }
+#elif JMAPGM_SIMD_SSE2
+    __m128d lo = _mm_set1_pd(min), hi = _mm_set1_pd(max);
+    for (unsigned i = 0; i < 64; i += 2) {
+        __m128d v = _mm_loadu_pd(values + i);
+        __m128d in = _mm_and_pd(_mm_cmpge_pd(v, lo), _mm_cmple_pd(v, hi));
+        word |= (uint64_t)(uint32_t)_mm_movemask_pd(in) << i;
+    }
+#elif JMAPGM_SIMD_NEON
+    float64x2_t lo = vdupq_n_f64(min), hi = vdupq_n_f64(max);
+    for (unsigned i = 0; i < 64; i += 2) {
+        float64x2_t v = vld1q_f64(values + i);
+        uint64x2_t in = vandq_u64(vcgeq_f64(v, lo), vcleq_f64(v, hi));
+        word |= ((vgetq_lane_u64(in, 0) & 1) | (vgetq_lane_u64(in, 1) & 2)) << i;
+    }
+#else
+    for (unsigned i = 0; i < 64; i++) word |= (uint64_t)(values[i] >= min && values[i] <= max) << i;
+#endif
+    return word;
+}
+
+void JMapGMAttributeTableMatchString(const JMapGMAttributeTable *table, uint32_t column, uint32_t string, uint64_t *bitmap)
+{
+    size_t words = JMapGMBitmapWordCount(table->rowCount);
+    if (column >= table->columnCount || table->columns[column].type != JMapGMAttributeString || string == JMAPGM_ATTRIBUTE_NONE) {
+        memset(bitmap, 0, words * sizeof(uint64_t));
+        return;
+    }
+    const uint32_t *codes = table->columns[column].strings;
+    for (size_t w = 0; w < words; w++) bitmap[w] = JMapGMMatchStringWord(codes + w * 64, string);
+}
+
+void JMapGMAttributeTableMatchRange(const JMapGMAttributeTable *table, uint32_t column, double min, double max, uint64_t *bitmap)
+{
+    size_t words = JMapGMBitmapWordCount(table->rowCount);
+    if (column >= table->columnCount || table->columns[column].type == JMapGMAttributeString) {
+        memset(bitmap, 0, words * sizeof(uint64_t));
+        return;
+    }
+    const double *values = table->columns[column].numbers;
+    for (size_t w = 0; w < words; w++) bitmap[w] = JMapGMMatchRangeWord(values + w * 64, min, max);
+}
+
+void JMapGMBitmapMatchCodes(const uint32_t *codes, size_t count, uint32_t code, uint64_t *bitmap)
+{
+    size_t whole = count / 64;
+    for (size_t w = 0; w < whole; w++) bitmap[w] = JMapGMMatchStringWord(codes + w * 64, code);
+    if (whole * 64 == count) return;
+    uint64_t word = 0;
+    for (size_t i = whole * 64; i < count; i++) word |= (uint64_t)(codes[i] == code) << (i - whole * 64);
+    bitmap[whole] = word;
+}
+
+size_t JMapGMBitmapGetRows(const uint64_t *bitmap, size_t rowCount, uint32_t *rows)
+{
+    size_t count = 0;
+    for (size_t w = 0; w < JMapGMBitmapWordCount(rowCount); w++) {
+        for (uint64_t word = bitmap[w]; word; word &= word - 1) {
+            size_t row = w * 64 + (size_t)__builtin_ctzll(word);
+            if (row >= rowCount) return count;
+            rows[count++] = (uint32_t)row;
+        }
+    }
+    return count;
+}
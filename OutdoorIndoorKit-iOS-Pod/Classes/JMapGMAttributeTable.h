@@ -0,0 +1,174 @@
+//
+//  JMapGMAttributeTable.h
+//  JMapOutdoorIndoorKit
+//
+//  Copyright © 2026 Jibestream. All rights reserved.
+//
+
+#ifndef JMapGMAttributeTable_h
+#define JMapGMAttributeTable_h
+
+#include "JMapGMTypes.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ *  Shape properties stored by column. Each row is one shape. Keys and string values are interned in
+ *  one pool shared by every column, so a repeated layer name or category is stored once and compared
+ *  as an integer. A column holds one key and one type; a key whose values have several types gets
+ *  one column per type. Not thread safe while being modified.
+ */
+typedef struct JMapGMAttributeTable JMapGMAttributeTable;
+
+/**
+ *  No string, column or row; also the value of a string column at a row without one
+ */
+#define JMAPGM_ATTRIBUTE_NONE UINT32_MAX
+
+typedef enum {
+    /** Doubles; NaN marks a row without a value */
+    JMapGMAttributeNumber,
+    /** String codes from the pool */
+    JMapGMAttributeString,
+    /** Stored as the numbers 0 and 1 */
+    JMapGMAttributeBoolean,
+} JMapGMAttributeType;
+
+/**
+ *  Creates an empty table.
+ *
+ *  @return The table, or NULL if allocation failed
+ */
+JMapGMAttributeTable *JMapGMAttributeTableCreate(void);
+
+/**
+ *  Releases a table.
+ */
+void JMapGMAttributeTableRelease(JMapGMAttributeTable *table);
+
+/**
+ *  Appends a row without values.
+ *
+ *  @return The row, or JMAPGM_ATTRIBUTE_NONE if allocation failed
+ */
+uint32_t JMapGMAttributeTableAddRow(JMapGMAttributeTable *table);
+
+size_t JMapGMAttributeTableGetRowCount(const JMapGMAttributeTable *table);
+
+/**
+ *  Bytes allocated by the table, including unused capacity.
+ */
+size_t JMapGMAttributeTableGetMemoryUsage(const JMapGMAttributeTable *table);
+
+#pragma mark - Strings
+
+/**
+ *  Adds a string to the pool, or finds it if already there.
+ *
+ *  @return The code of the string, or JMAPGM_ATTRIBUTE_NONE if allocation failed
+ */
+uint32_t JMapGMAttributeTableIntern(JMapGMAttributeTable *table, const char *string, size_t length);
+
+/**
+ *  Finds a string without adding it.
+ *
+ *  @return The code of the string, or JMAPGM_ATTRIBUTE_NONE if the pool does not hold it
+ */
+uint32_t JMapGMAttributeTableFindString(const JMapGMAttributeTable *table, const char *string, size_t length);
+
+/**
+ *  The NUL terminated bytes of a pooled string, valid until the table is modified.
+ *
+ *  @param length Receives the length without the terminator, may be NULL
+ */
+const char *JMapGMAttributeTableGetString(const JMapGMAttributeTable *table, uint32_t string, size_t *length);
+
+size_t JMapGMAttributeTableGetStringCount(const JMapGMAttributeTable *table);
+
+#pragma mark - Columns
+
+/**
+ *  Finds the column of a key and type.
+ *
+ *  @param key The code of the key
+ *  @return The column, or JMAPGM_ATTRIBUTE_NONE if no row has a value of that key and type
+ */
+uint32_t JMapGMAttributeTableGetColumn(const JMapGMAttributeTable *table, uint32_t key, JMapGMAttributeType type);
+
+size_t JMapGMAttributeTableGetColumnCount(const JMapGMAttributeTable *table);
+uint32_t JMapGMAttributeTableGetColumnKey(const JMapGMAttributeTable *table, uint32_t column);
+JMapGMAttributeType JMapGMAttributeTableGetColumnType(const JMapGMAttributeTable *table, uint32_t column);
+
+/**
+ *  Sets a number or boolean, adding the column on first use. Setting NaN removes the value.
+ *
+ *  @return false if the row does not exist or allocation failed
+ */
+bool JMapGMAttributeTableSetNumber(JMapGMAttributeTable *table, uint32_t row, uint32_t key, JMapGMAttributeType type, double value);
+
+/**
+ *  Sets a string, adding the column on first use. Setting JMAPGM_ATTRIBUTE_NONE removes the value.
+ *
+ *  @param string The code of the value
+ *  @return false if the row does not exist or allocation failed
+ */
+bool JMapGMAttributeTableSetString(JMapGMAttributeTable *table, uint32_t row, uint32_t key, uint32_t string);
+
+/**
+ *  The value of a number or boolean column, NaN if the row has none.
+ */
+double JMapGMAttributeTableGetNumber(const JMapGMAttributeTable *table, uint32_t column, uint32_t row);
+
+/**
+ *  The string code of a string column, JMAPGM_ATTRIBUTE_NONE if the row has none.
+ */
+uint32_t JMapGMAttributeTableGetStringValue(const JMapGMAttributeTable *table, uint32_t column, uint32_t row);
+
+#pragma mark - Filters
+
+/**
+ *  Words in a bitmap with one bit per row.
+ */
+static inline size_t JMapGMBitmapWordCount(size_t rowCount)
+{
+    return (rowCount + 63) / 64;
+}
+
+/**
+ *  Marks the rows of a string column equal to a string. Vectorized over whole words of rows.
+ *
+ *  @param column A string column; any other column marks nothing
+ *  @param bitmap Receives JMapGMBitmapWordCount(rowCount) words, bit r of word r / 64 set for a match
+ */
+void JMapGMAttributeTableMatchString(const JMapGMAttributeTable *table, uint32_t column, uint32_t string, uint64_t *bitmap);
+
+/**
+ *  Marks the rows of a number or boolean column within [min, max]. Vectorized over whole words of rows.
+ *
+ *  @param column A number or boolean column; any other column marks nothing
+ *  @param bitmap Receives JMapGMBitmapWordCount(rowCount) words
+ */
+void JMapGMAttributeTableMatchRange(const JMapGMAttributeTable *table, uint32_t column, double min, double max, uint64_t *bitmap);
+
+/**
+ *  Marks the entries of any code array equal to a code, such as per-row layer names.
+ *
+ *  @param bitmap Receives JMapGMBitmapWordCount(count) words
+ */
+void JMapGMBitmapMatchCodes(const uint32_t *codes, size_t count, uint32_t code, uint64_t *bitmap);
+
+/**
+ *  Lists the set bits of a bitmap in ascending order.
+ *
+ *  @param rows Receives at most rowCount rows
+ *  @return The number of rows written
+ */
+size_t JMapGMBitmapGetRows(const uint64_t *bitmap, size_t rowCount, uint32_t *rows);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* JMapGMAttributeTable_h */
@@ -0,0 +1,306 @@
+//
+//  JMapGMClusterIndex.c
+//  JMapOutdoorIndoorKit
+//
+//  Copyright © 2026 Jibestream. All rights reserved.
+//
+
+#include "JMapGMClusterIndex.h"
+#include "JMapGMSpatialIndex.h"
+
+#include <stdlib.h>
+
+const JMapGMClusterConfig JMapGMClusterConfigDefault = {
+    .radius = 60,
+    .tileSize = 256,
+    .minZoom = 0,
+    .maxZoom = 20,
+};
+
+// The clusters of one zoom level, positioned in Web Mercator units of [0, 1].
+typedef struct {
+    size_t count;
+    JMapGMPoint *positions;
+    uint32_t *counts;
+    uint32_t *identifiers;
+    /** count + 1 offsets into children, which index the level above; NULL for the leaf level */
+    uint32_t *childStarts;
+    uint32_t *children;
+    JMapGMRTree *tree;
+} JMapGMClusterLevel;
+
+struct JMapGMClusterIndex {
+    JMapGMClusterConfig config;
+    /** minZoom through maxZoom, then the unclustered points at maxZoom + 1 */
+    JMapGMClusterLevel *levels;
+    size_t levelCount;
+};
+
+#pragma mark - Projection
+
+static JMapGMPoint JMapGMClusterProject(JMapGMPoint point)
+{
+    double latitude = point.y < -85.0511 ? -85.0511 : point.y > 85.0511 ? 85.0511 : point.y;
+    double s = sin(latitude * M_PI / 180);
+    JMapGMPoint projected = { point.x / 360 + 0.5, 0.5 - 0.25 * log((1 + s) / (1 - s)) / M_PI };
+    return projected;
+}
+
+static JMapGMPoint JMapGMClusterUnproject(JMapGMPoint point)
+{
+    JMapGMPoint coordinate = { (point.x - 0.5) * 360, atan(sinh(M_PI * (1 - 2 * point.y))) * 180 / M_PI };
+    return coordinate;
+}
+
+static JMapGMRTree *JMapGMClusterLevelCreateTree(const JMapGMClusterLevel *level)
+{
+    JMapGMRect *rects = malloc((level->count + 1) * sizeof(JMapGMRect));
+    if (!rects) return NULL;
+    for (size_t i = 0; i < level->count; i++) {
+        JMapGMPoint p = level->positions[i];
+        rects[i] = (JMapGMRect){ p.x, p.y, p.x, p.y };
+    }
+    JMapGMRTree *tree = JMapGMRTreeCreate(rects, level->count, 0);
+    free(rects);
+    return tree;
+}
+
+static bool JMapGMClusterLevelAllocate(JMapGMClusterLevel *level, size_t count)
+{
+    level->count = count;
+    level->positions = malloc((count + 1) * sizeof(JMapGMPoint));
+    level->counts = malloc((count + 1) * sizeof(uint32_t));
+    level->identifiers = malloc((count + 1) * sizeof(uint32_t));
+    return level->positions && level->counts && level->identifiers;
+}
+
+#pragma mark - Creation
+
+typedef struct {
+    uint32_t *items;
+    size_t count;
+    size_t capacity;
+} JMapGMClusterNeighbours;
+
+static bool JMapGMClusterCollect(uint32_t item, void *context)
+{
+    JMapGMClusterNeighbours *neighbours = context;
+    if (neighbours->count == neighbours->capacity) {
+        size_t capacity = neighbours->capacity ? neighbours->capacity * 2 : 64;
+        uint32_t *items = realloc(neighbours->items, capacity * sizeof(uint32_t));
+        if (!items) return false;
+        neighbours->items = items;
+        neighbours->capacity = capacity;
+    }
+    neighbours->items[neighbours->count++] = item;
+    return true;
+}
+
+// Merges the clusters of the level above into `level`, at zoom `zoom`.
+static bool JMapGMClusterLevelBuild(JMapGMClusterLevel *level, const JMapGMClusterLevel *above, double radius,
+                                    uint32_t *nextIdentifier, JMapGMClusterNeighbours *neighbours)
+{
+    uint32_t *parents = malloc((above->count + 1) * sizeof(uint32_t));
+    if (!parents || !JMapGMClusterLevelAllocate(level, above->count)) {
+        free(parents);
+        return false;
+    }
+    for (size_t i = 0; i < above->count; i++) parents[i] = UINT32_MAX;
+
+    size_t count = 0;
+    for (size_t i = 0; i < above->count; i++) {
+        if (parents[i] != UINT32_MAX) continue;
+        JMapGMPoint p = above->positions[i];
+        neighbours->count = 0;
+        JMapGMRTreeQuery(above->tree, (JMapGMRect){ p.x - radius, p.y - radius, p.x + radius, p.y + radius },
+                         JMapGMClusterCollect, neighbours);
+
+        uint32_t node = (uint32_t)count++;
+        double weight = above->counts[i];
+        double x = p.x * weight, y = p.y * weight;
+        size_t members = 1;
+        parents[i] = node;
+        for (size_t k = 0; k < neighbours->count; k++) {
+            uint32_t j = neighbours->items[k];
+            if (parents[j] != UINT32_MAX) continue;
+            double dx = above->positions[j].x - p.x, dy = above->positions[j].y - p.y;
+            if (dx * dx + dy * dy > radius * radius) continue;
+            parents[j] = node;
+            weight += above->counts[j];
+            x += above->positions[j].x * above->counts[j];
+            y += above->positions[j].y * above->counts[j];
+            members++;
+        }
+        // A cluster with nothing to merge is carried down unchanged, identity included.
+        level->positions[node] = members == 1 ? p : (JMapGMPoint){ x / weight, y / weight };
+        level->counts[node] = (uint32_t)weight;
+        level->identifiers[node] = members == 1 ? above->identifiers[i] : (*nextIdentifier)++;
+    }
+    level->count = count;
+
+    level->childStarts = calloc(count + 1, sizeof(uint32_t));
+    level->children = malloc((above->count + 1) * sizeof(uint32_t));
+    if (!level->childStarts || !level->children) {
+        free(parents);
+        return false;
+    }
+    for (size_t i = 0; i < above->count; i++) level->childStarts[parents[i] + 1]++;
+    for (size_t n = 0; n < count; n++) level->childStarts[n + 1] += level->childStarts[n];
+    uint32_t *cursor = malloc((count + 1) * sizeof(uint32_t));
+    if (!cursor) {
+        free(parents);
+        return false;
+    }
+    for (size_t n = 0; n < count; n++) cursor[n] = level->childStarts[n];
+    for (size_t i = 0; i < above->count; i++) level->children[cursor[parents[i]]++] = (uint32_t)i;
+    free(cursor);
+    free(parents);
+
+    level->tree = JMapGMClusterLevelCreateTree(level);
+    return level->tree != NULL;
+}
+
+JMapGMClusterIndex *JMapGMClusterIndexCreate(const JMapGMPoint *points, size_t count, const JMapGMClusterConfig *config)
+{
+    JMapGMClusterIndex *index = calloc(1, sizeof(JMapGMClusterIndex));
+    if (!index || count >= UINT32_MAX / 2) goto fail;
+    index->config = config ? *config : JMapGMClusterConfigDefault;
+    if (index->config.maxZoom > 30) index->config.maxZoom = 30;
+    if (index->config.minZoom > index->config.maxZoom) index->config.minZoom = index->config.maxZoom;
+    if (index->config.tileSize <= 0) index->config.tileSize = JMapGMClusterConfigDefault.tileSize;
+    index->levelCount = index->config.maxZoom - index->config.minZoom + 2;
+    index->levels = calloc(index->levelCount, sizeof(JMapGMClusterLevel));
+    if (!index->levels) goto fail;
+
+    JMapGMClusterLevel *leaves = &index->levels[index->levelCount - 1];
+    if (!JMapGMClusterLevelAllocate(leaves, count)) goto fail;
+    for (size_t i = 0; i < count; i++) {
+        leaves->positions[i] = JMapGMClusterProject(points[i]);
+        leaves->counts[i] = 1;
+        leaves->identifiers[i] = (uint32_t)i;
+    }
+    leaves->tree = JMapGMClusterLevelCreateTree(leaves);
+    if (!leaves->tree) goto fail;
+
+    uint32_t nextIdentifier = (uint32_t)count;
+    JMapGMClusterNeighbours neighbours = { NULL, 0, 0 };
+    for (size_t l = index->levelCount - 1; l-- > 0;) {
+        uint32_t zoom = index->config.minZoom + (uint32_t)l;
+        double radius = index->config.radius / (index->config.tileSize * ldexp(1, (int)zoom));
+        if (!JMapGMClusterLevelBuild(&index->levels[l], &index->levels[l + 1], radius, &nextIdentifier, &neighbours)) {
+            free(neighbours.items);
+            goto fail;
+        }
+    }
+    free(neighbours.items);
+    return index;
+
+fail:
+    JMapGMClusterIndexRelease(index);
+    return NULL;
+}
+
+void JMapGMClusterIndexRelease(JMapGMClusterIndex *index)
+{
+    if (!index) return;
+    for (size_t l = 0; index->levels && l < index->levelCount; l++) {
+        JMapGMClusterLevel *level = &index->levels[l];
+        free(level->positions);
+        free(level->counts);
+        free(level->identifiers);
+        free(level->childStarts);
+        free(level->children);
+        JMapGMRTreeRelease(level->tree);
+    }
+    free(index->levels);
+    free(index);
+}
+
+#pragma mark - Queries
+
+typedef struct {
+    const JMapGMClusterLevel *level;
+    uint32_t zoom;
+    JMapGMClusterVisitor visitor;
+    void *context;
+    size_t count;
+} JMapGMClusterQuery;
+
+static JMapGMCluster JMapGMClusterMake(const JMapGMClusterLevel *level, uint32_t zoom, uint32_t node)
+{
+    JMapGMCluster cluster = {
+        JMapGMClusterUnproject(level->positions[node]),
+        level->counts[node],
+        level->identifiers[node],
+        zoom,
+        node,
+    };
+    return cluster;
+}
+
+static bool JMapGMClusterVisit(uint32_t item, void *context)
+{
+    JMapGMClusterQuery *query = context;
+    JMapGMCluster cluster = JMapGMClusterMake(query->level, query->zoom, item);
+    query->count++;
+    return query->visitor(&cluster, query->context);
+}
+
+size_t JMapGMClusterIndexGetClusters(const JMapGMClusterIndex *index, JMapGMRect bounds, double zoom,
+                                     JMapGMClusterVisitor visitor, void *context)
+{
+    double z = floor(zoom);
+    if (z < index->config.minZoom) z = index->config.minZoom;
+    if (z > index->config.maxZoom + 1.0) z = index->config.maxZoom + 1.0;
+    uint32_t level = (uint32_t)z - index->config.minZoom;
+    JMapGMPoint northWest = JMapGMClusterProject((JMapGMPoint){ bounds.minX, bounds.maxY });
+    JMapGMPoint southEast = JMapGMClusterProject((JMapGMPoint){ bounds.maxX, bounds.minY });
+    JMapGMClusterQuery query = { &index->levels[level], (uint32_t)z, visitor, context, 0 };
+    JMapGMRTreeQuery(query.level->tree, (JMapGMRect){ northWest.x, northWest.y, southEast.x, southEast.y },
+                     JMapGMClusterVisit, &query);
+    return query.count;
+}
+
+static const JMapGMClusterLevel *JMapGMClusterIndexLevel(const JMapGMClusterIndex *index, const JMapGMCluster *cluster)
+{
+    if (cluster->zoom < index->config.minZoom) return NULL;
+    size_t l = cluster->zoom - index->config.minZoom;
+    if (l >= index->levelCount || cluster->node >= index->levels[l].count) return NULL;
+    return &index->levels[l];
+}
+
+uint32_t JMapGMClusterIndexGetExpansionZoom(const JMapGMClusterIndex *index, const JMapGMCluster *cluster)
+{
+    if (!JMapGMClusterIndexLevel(index, cluster)) return cluster->zoom;
+    size_t l = cluster->zoom - index->config.minZoom;
+    uint32_t node = cluster->node;
+    // Follow single children up until the cluster has several.
+    while (l + 1 < index->levelCount) {
+        const JMapGMClusterLevel *level = &index->levels[l];
+        uint32_t start = level->childStarts[node], end = level->childStarts[node + 1];
+        if (end - start != 1) break;
+        node = level->children[start];
+        l++;
+    }
+    return index->config.minZoom + (uint32_t)(l + 1 < index->levelCount ? l + 1 : l);
+}
+
+static size_t JMapGMClusterCollectLeaves(const JMapGMClusterIndex *index, size_t l, uint32_t node,
+                                         uint32_t *leaves, size_t capacity, size_t found)
+{
+    const JMapGMClusterLevel *level = &index->levels[l];
+    if (l + 1 == index->levelCount) {
+        if (found < capacity) leaves[found] = level->identifiers[node];
+        return found + 1;
+    }
+    for (uint32_t c = level->childStarts[node]; c < level->childStarts[node + 1]; c++) {
+        found = JMapGMClusterCollectLeaves(index, l + 1, level->children[c], leaves, capacity, found);
+    }
+    return found;
+}
+
+size_t JMapGMClusterIndexGetLeaves(const JMapGMClusterIndex *index, const JMapGMCluster *cluster, uint32_t *leaves, size_t capacity)
+{
+    if (!JMapGMClusterIndexLevel(index, cluster)) return 0;
+    return JMapGMClusterCollectLeaves(index, cluster->zoom - index->config.minZoom, cluster->node, leaves, capacity, 0);
+}
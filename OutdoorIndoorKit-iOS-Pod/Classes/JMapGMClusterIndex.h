@@ -0,0 +1,102 @@
+//
+//  JMapGMClusterIndex.h
+//  JMapOutdoorIndoorKit
+//
+//  Copyright © 2026 Jibestream. All rights reserved.
+//
+
+#ifndef JMapGMClusterIndex_h
+#define JMapGMClusterIndex_h
+
+#include "JMapGMTypes.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ *  Hierarchical point clusters for every zoom level, in the manner of supercluster. Each level
+ *  greedily merges the clusters of the level below that lie within radius screen points of each
+ *  other, and indexes the result in an R-tree. Immutable once created, so it can be queried from
+ *  any thread.
+ */
+typedef struct JMapGMClusterIndex JMapGMClusterIndex;
+
+typedef struct {
+    /** Cluster radius in screen points */
+    double radius;
+    /** Tile size of zoom level 0 in screen points, 256 for Google Maps */
+    double tileSize;
+    uint32_t minZoom;
+    /** Points are never clustered above this zoom */
+    uint32_t maxZoom;
+} JMapGMClusterConfig;
+
+/**
+ *  Radius 60, tile size 256, zoom 0 through 20
+ */
+extern const JMapGMClusterConfig JMapGMClusterConfigDefault;
+
+typedef struct {
+    /** Count-weighted centre, x = longitude, y = latitude */
+    JMapGMPoint point;
+    uint32_t count;
+    /**
+     *  Stable identity: the point index for single points, otherwise unique to the cluster. A cluster
+     *  that is unchanged between two zoom levels keeps its identifier, so markers can be reused.
+     */
+    uint32_t identifier;
+    /** Level and position within it, used by the expansion and leaf queries */
+    uint32_t zoom;
+    uint32_t node;
+} JMapGMCluster;
+
+/**
+ *  Visitor called for every cluster of a query.
+ *
+ *  @return false to stop the query
+ */
+typedef bool (*JMapGMClusterVisitor)(const JMapGMCluster *cluster, void *context);
+
+/**
+ *  Builds the clusters of every zoom level.
+ *
+ *  @param points The points, x = longitude, y = latitude
+ *  @param config The configuration, or NULL for JMapGMClusterConfigDefault
+ *  @return A new index, or NULL if allocation failed
+ */
+JMapGMClusterIndex *JMapGMClusterIndexCreate(const JMapGMPoint *points, size_t count, const JMapGMClusterConfig *config);
+
+/**
+ *  Releases an index created with JMapGMClusterIndexCreate.
+ */
+void JMapGMClusterIndexRelease(JMapGMClusterIndex *index);
+
+/**
+ *  Visits the clusters of a zoom level within bounds.
+ *
+ *  @param bounds The visible region, x = longitude, y = latitude
+ *  @param zoom The camera zoom; fractional zooms use the level below
+ *  @return The number of clusters visited
+ */
+size_t JMapGMClusterIndexGetClusters(const JMapGMClusterIndex *index, JMapGMRect bounds, double zoom,
+                                     JMapGMClusterVisitor visitor, void *context);
+
+/**
+ *  The zoom at which a cluster splits into several, for zooming in on a tapped cluster.
+ */
+uint32_t JMapGMClusterIndexGetExpansionZoom(const JMapGMClusterIndex *index, const JMapGMCluster *cluster);
+
+/**
+ *  The point indexes inside a cluster.
+ *
+ *  @param leaves Receives up to capacity point indexes
+ *  @return The number of points in the cluster, which may exceed capacity
+ */
+size_t JMapGMClusterIndexGetLeaves(const JMapGMClusterIndex *index, const JMapGMCluster *cluster, uint32_t *leaves, size_t capacity);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* JMapGMClusterIndex_h */
@@ -0,0 +1,134 @@
+//
+//  JMapGMClusterLayer.h
+//  JMapOutdoorIndoorKit
+//
+//  Copyright © 2026 Jibestream. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import <JMapOutdoorIndoorKit/JMapOutdoorIndoorKit.h>
+#import "JMapGMClusterIndex.h"
+
+/**
+ *  The JMapGMMarkerCluster object
+ *
+ *  One marker's worth of points at a given zoom level.
+ */
+@interface JMapGMMarkerCluster : NSObject
+
+/**
+ *  The count-weighted centre of the points
+ */
+@property (nonatomic, readonly) CLLocationCoordinate2D coordinate;
+/**
+ *  The number of points
+ */
+@property (nonatomic, readonly) NSUInteger count;
+/**
+ *  The point index for a single point, otherwise an identifier unique to the cluster and stable across zoom levels
+ */
+@property (nonatomic, readonly) NSUInteger identifier;
+/**
+ *  Whether the cluster holds more than one point
+ */
+@property (nonatomic, readonly, getter=isCluster) BOOL cluster;
+/**
+ *  The zoom at which the cluster splits
+ */
+@property (nonatomic, readonly) float expansionZoom;
+/**
+ *  The indexes of the points in the cluster, in the order they were passed to the cluster set
+ */
+@property (nonatomic, readonly, nonnull) NSIndexSet *pointIndexes;
+
+@end
+
+/**
+ *  The JMapGMClusterSet object
+ *
+ *  The precomputed clusters of a set of points, typically the amenities of one floor, at every zoom
+ *  level. Immutable, so it can be built on a background queue and shared.
+ */
+@interface JMapGMClusterSet : NSObject
+
+/**
+ *  Clusters points.
+ *
+ *  @param coordinates The lat/lng coordinates of the points
+ *  @param count The number of coordinates
+ *  @param config The clustering configuration, e.g. JMapGMClusterConfigDefault
+ *  @return The cluster set, or nil if allocation failed
+ */
+- (nullable instancetype)initWithCoordinates:(const CLLocationCoordinate2D * _Nonnull)coordinates
+                                       count:(NSUInteger)count
+                                      config:(JMapGMClusterConfig)config;
+
+/**
+ *  The clusters of a zoom level within bounds.
+ *
+ *  @param bounds The region to search
+ *  @param zoom The camera zoom
+ */
+- (nonnull NSArray<JMapGMMarkerCluster *> *)clustersInBounds:(nonnull GMSCoordinateBounds *)bounds zoom:(float)zoom;
+
+@end
+
+/**
+ *  Creates the marker for a cluster or single point, or returns nil to leave it out.
+ */
+typedef GMSMarker * _Nullable (^JMapGMClusterMarkerProvider)(JMapGMMarkerCluster * _Nonnull cluster);
+
+/**
+ *  The JMapGMClusterLayer object
+ *
+ *  Shows a JMapGMClusterSet on a map view instead of one marker per point. Updates only add and
+ *  remove the markers whose cluster changed, and are skipped entirely while the camera stays within
+ *  the last zoom level and the region already covered. Must be used on the main thread.
+ */
+@interface JMapGMClusterLayer : NSObject
+
+/**
+ *  The map view showing the markers
+ */
+@property (nonatomic, readonly, weak, nullable) GMSMapView *mapView;
+
+/**
+ *  The clusters to show, e.g. those of the current floor. Setting it replaces every marker.
+ */
+@property (nonatomic, strong, nullable) JMapGMClusterSet *clusterSet;
+
+/**
+ *  The number of markers on the map
+ */
+@property (nonatomic, readonly) NSUInteger markerCount;
+
+/**
+ *  Creates a layer.
+ *
+ *  @param mapView The map view, e.g. the controller's mapView
+ *  @param markerProvider Creates the marker of each cluster; the layer sets its position, userData and map
+ */
+- (nonnull instancetype)initWithMapView:(nonnull GMSMapView *)mapView markerProvider:(nonnull JMapGMClusterMarkerProvider)markerProvider;
+
+/**
+ *  Brings the markers up to date with the camera. Call from mapView:mapViewDidZoom: and
+ *  mapView:idleAtCameraPosition:.
+ */
+- (void)update;
+
+/**
+ *  Removes every marker from the map.
+ */
+- (void)removeAllMarkers;
+
+/**
+ *  The cluster shown by a marker of this layer, e.g. from mapView:didTapMarker:.
+ */
+- (nullable JMapGMMarkerCluster *)clusterForMarker:(nonnull GMSMarker *)marker;
+
+/**
+ *  Animates the camera to the zoom at which a cluster splits.
+ */
+- (void)zoomToCluster:(nonnull JMapGMMarkerCluster *)cluster;
+
+@end
@@ -0,0 +1,227 @@
+//
+//  JMapGMClusterLayer.m
+//  JMapOutdoorIndoorKit
+//
+//  Copyright © 2026 Jibestream. All rights reserved.
+//
+
+#import "JMapGMClusterLayer.h"
+#import "JMapGMTrace.h"
+
+@interface JMapGMClusterSet ()
+@property (nonatomic, readonly) JMapGMClusterIndex *index;
+@end
+
+@interface JMapGMMarkerCluster ()
+- (instancetype)initWithCluster:(const JMapGMCluster *)cluster set:(JMapGMClusterSet *)set;
+@end
+
+@implementation JMapGMMarkerCluster
+{
+    JMapGMCluster _cluster;
+    JMapGMClusterSet *_set;
+}
+
+- (instancetype)initWithCluster:(const JMapGMCluster *)cluster set:(JMapGMClusterSet *)set
+{
+    self = [super init];
+    if (self) {
+        _cluster = *cluster;
+        _set = set;
+    }
+    return self;
+}
+
+- (CLLocationCoordinate2D)coordinate
+{
+    return CLLocationCoordinate2DMake(_cluster.point.y, _cluster.point.x);
+}
+
+- (NSUInteger)count
+{
+    return _cluster.count;
+}
+
+- (NSUInteger)identifier
+{
+    return _cluster.identifier;
+}
+
+- (BOOL)isCluster
+{
+    return _cluster.count > 1;
+}
+
+- (float)expansionZoom
+{
+    return JMapGMClusterIndexGetExpansionZoom(_set.index, &_cluster);
+}
+
+- (NSIndexSet *)pointIndexes
+{
+    uint32_t *leaves = malloc(MAX(_cluster.count, 1) * sizeof(uint32_t));
+    size_t count = JMapGMClusterIndexGetLeaves(_set.index, &_cluster, leaves, _cluster.count);
+    NSMutableIndexSet *indexes = [NSMutableIndexSet indexSet];
+    for (size_t i = 0; i < MIN(count, (size_t)_cluster.count); i++) [indexes addIndex:leaves[i]];
+    free(leaves);
+    return indexes;
+}
+
+@end
+
+@implementation JMapGMClusterSet
+
+- (instancetype)initWithCoordinates:(const CLLocationCoordinate2D *)coordinates count:(NSUInteger)count config:(JMapGMClusterConfig)config
+{
+    self = [super init];
+    if (self) {
+        JMAPGM_TRACE_SCOPE("cluster.build");
+        JMapGMPoint *points = malloc(MAX(count, 1) * sizeof(JMapGMPoint));
+        if (!points) return nil;
+        for (NSUInteger i = 0; i < count; i++) {
+            points[i] = (JMapGMPoint){ coordinates[i].longitude, coordinates[i].latitude };
+        }
+        _index = JMapGMClusterIndexCreate(points, count, &config);
+        free(points);
+        if (!_index) return nil;
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    JMapGMClusterIndexRelease(_index);
+}
+
+typedef struct {
+    __unsafe_unretained JMapGMClusterSet *set;
+    __unsafe_unretained NSMutableArray *clusters;
+} JMapGMClusterCollector;
+
+static bool JMapGMClusterSetCollect(const JMapGMCluster *cluster, void *context)
+{
+    JMapGMClusterCollector *collector = context;
+    [collector->clusters addObject:[[JMapGMMarkerCluster alloc] initWithCluster:cluster set:collector->set]];
+    return true;
+}
+
+- (NSArray<JMapGMMarkerCluster *> *)clustersInBounds:(GMSCoordinateBounds *)bounds zoom:(float)zoom
+{
+    NSMutableArray *clusters = [NSMutableArray array];
+    JMapGMClusterCollector collector = { self, clusters };
+    // Bounds crossing the antimeridian are widened to the whole longitude range.
+    double west = bounds.southWest.longitude, east = bounds.northEast.longitude;
+    if (west > east) {
+        west = -180;
+        east = 180;
+    }
+    JMapGMRect rect = { west, bounds.southWest.latitude, east, bounds.northEast.latitude };
+    JMapGMClusterIndexGetClusters(_index, rect, zoom, JMapGMClusterSetCollect, &collector);
+    return clusters;
+}
+
+@end
+
+@implementation JMapGMClusterLayer
+{
+    JMapGMClusterMarkerProvider _markerProvider;
+    NSMutableDictionary<NSNumber *, GMSMarker *> *_markers;
+    GMSCoordinateBounds *_coveredBounds;
+    NSInteger _coveredLevel;
+}
+
+- (instancetype)initWithMapView:(GMSMapView *)mapView markerProvider:(JMapGMClusterMarkerProvider)markerProvider
+{
+    self = [super init];
+    if (self) {
+        _mapView = mapView;
+        _markerProvider = [markerProvider copy];
+        _markers = [NSMutableDictionary dictionary];
+        _coveredLevel = NSIntegerMin;
+    }
+    return self;
+}
+
+- (void)setClusterSet:(JMapGMClusterSet *)clusterSet
+{
+    if (clusterSet == _clusterSet) return;
+    [self removeAllMarkers];
+    _clusterSet = clusterSet;
+    [self update];
+}
+
+- (NSUInteger)markerCount
+{
+    return _markers.count;
+}
+
+- (void)removeAllMarkers
+{
+    for (GMSMarker *marker in _markers.allValues) marker.map = nil;
+    [_markers removeAllObjects];
+    _coveredBounds = nil;
+    _coveredLevel = NSIntegerMin;
+}
+
+- (void)update
+{
+    GMSMapView *mapView = _mapView;
+    if (!mapView || !_clusterSet) return;
+    NSInteger level = (NSInteger)floorf(mapView.camera.zoom);
+    GMSCoordinateBounds *visible = [[GMSCoordinateBounds alloc] initWithRegion:mapView.projection.visibleRegion];
+    if (level == _coveredLevel && [_coveredBounds containsCoordinate:visible.northEast] &&
+        [_coveredBounds containsCoordinate:visible.southWest]) {
+        return;
+    }
+    JMAPGM_TRACE_SCOPE("cluster.update");
+
+    // Cover half a screen around the visible region so that small pans need no update.
+    double latitudePadding = (visible.northEast.latitude - visible.southWest.latitude) / 2;
+    double longitudePadding = (visible.northEast.longitude - visible.southWest.longitude) / 2;
+    if (longitudePadding < 0) longitudePadding = 0;
+    GMSCoordinateBounds *covered = [[GMSCoordinateBounds alloc]
+        initWithCoordinate:CLLocationCoordinate2DMake(MIN(visible.northEast.latitude + latitudePadding, 85.0511),
+                                                      MIN(visible.northEast.longitude + longitudePadding, 180))
+                coordinate:CLLocationCoordinate2DMake(MAX(visible.southWest.latitude - latitudePadding, -85.0511),
+                                                      MAX(visible.southWest.longitude - longitudePadding, -180))];
+    NSArray<JMapGMMarkerCluster *> *clusters = [_clusterSet clustersInBounds:covered zoom:mapView.camera.zoom];
+
+    NSMutableDictionary<NSNumber *, GMSMarker *> *markers = [NSMutableDictionary dictionaryWithCapacity:clusters.count];
+    NSUInteger added = 0;
+    for (JMapGMMarkerCluster *cluster in clusters) {
+        NSNumber *key = @(cluster.identifier);
+        GMSMarker *marker = _markers[key];
+        if (marker) {
+            // Same identifier, same points: the marker stays as it is.
+            [_markers removeObjectForKey:key];
+        } else {
+            marker = _markerProvider(cluster);
+            if (!marker) continue;
+            marker.position = cluster.coordinate;
+            marker.userData = cluster;
+            marker.map = mapView;
+            added++;
+        }
+        markers[key] = marker;
+    }
+    for (GMSMarker *marker in _markers.allValues) marker.map = nil;
+    JMAPGM_TRACE_COUNT("cluster.added", (int64_t)added);
+    JMAPGM_TRACE_COUNT("cluster.removed", (int64_t)_markers.count);
+    _markers = markers;
+    _coveredBounds = covered;
+    _coveredLevel = level;
+}
+
+- (JMapGMMarkerCluster *)clusterForMarker:(GMSMarker *)marker
+{
+    if (![marker.userData isKindOfClass:[JMapGMMarkerCluster class]]) return nil;
+    JMapGMMarkerCluster *cluster = marker.userData;
+    return _markers[@(cluster.identifier)] == marker ? cluster : nil;
+}
+
+- (void)zoomToCluster:(JMapGMMarkerCluster *)cluster
+{
+    [_mapView animateWithCameraUpdate:[GMSCameraUpdate setTarget:cluster.coordinate zoom:cluster.expansionZoom]];
+}
+
+@end
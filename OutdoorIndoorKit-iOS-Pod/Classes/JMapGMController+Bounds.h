@@ -0,0 +1,83 @@
+//
+//  JMapGMController+Bounds.h
+//  JMapOutdoorIndoorKit
+//
+//  Copyright © 2026 Jibestream. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import <JMapOutdoorIndoorKit/JMapOutdoorIndoorKit.h>
+#import "JMapGMGeometry+Packed.h"
+
+/**
+ *  Bounds in northeast and southwest lat/lng coordinates. Both corners are
+ *  kCLLocationCoordinate2DInvalid when there is nothing to bound.
+ */
+typedef struct {
+    CLLocationCoordinate2D northEast;
+    CLLocationCoordinate2D southWest;
+} JMapGMCoordinateBounds;
+
+/**
+ *  Whether the bounds contain at least one coordinate
+ */
+static inline BOOL JMapGMCoordinateBoundsIsValid(JMapGMCoordinateBounds bounds)
+{
+    return CLLocationCoordinate2DIsValid(bounds.northEast) && CLLocationCoordinate2DIsValid(bounds.southWest);
+}
+
+/**
+ *  Converts packed bounds, x as longitude and y as latitude, to coordinate bounds
+ */
+JMapGMCoordinateBounds JMapGMCoordinateBoundsFromRect(JMapGMRect rect);
+
+@interface JMapGMController (Bounds)
+
+/**
+ *  Unboxed variant of getBoundsFromShapes:. Uses the cached packedBounds of each shape
+ *  and a vectorized union, so repeated calls over the same shapes do not walk their coordinates.
+ *
+ *  @param shapes The shapes array to generate the bounds
+ *  @return The bounds, invalid if no shape has coordinates
+ */
+- (JMapGMCoordinateBounds)coordinateBoundsFromShapes:(nonnull NSArray<JMapGMGeometry *> *)shapes;
+
+/**
+ *  The bounds of every shape of a map, cached on the map. A cached map returns them without
+ *  walking its layers, so the cache must be dropped with invalidateBoundsOfMap: whenever the map's
+ *  shapes change. Nothing is kept for a map without shapes, e.g. one not parsed yet.
+ *
+ *  @param map A map parsed by the controller
+ *  @return The bounds, invalid if the map has no shapes
+ */
+- (JMapGMCoordinateBounds)coordinateBoundsOfMap:(nonnull JMapMap *)map;
+
+/**
+ *  Drops the bounds cached on a map. Call after parsing the map again or changing its shapes;
+ *  tracedParseMap: and cacheBoundsForMap: do so themselves.
+ *
+ *  @param map A map parsed by the controller
+ */
+- (void)invalidateBoundsOfMap:(nonnull JMapMap *)map;
+
+/**
+ *  Computes and caches the bounds of every shape of a map across all cores, replacing any cached
+ *  before. Call after parseMap: so that later bounds and zoom requests reuse the cached union.
+ *
+ *  @param map A map parsed by the controller
+ */
+- (void)cacheBoundsForMap:(nonnull JMapMap *)map;
+
+/**
+ *  Zooms to the bounds of the given shapes, doing nothing if they have no coordinates.
+ *
+ *  @param shapes The shapes to zoom to, e.g. the units of a search result
+ */
+- (void)zoomToShapes:(nonnull NSArray<JMapGMGeometry *> *)shapes;
+
+/**
+ *  Zooms to the cached bounds of the current map, like zoomToVenue.
+ */
+- (void)zoomToCurrentMap;
+
+@end
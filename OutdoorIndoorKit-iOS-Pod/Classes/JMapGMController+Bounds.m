@@ -0,0 +1,95 @@
+//
+//  JMapGMController+Bounds.m
+//  JMapOutdoorIndoorKit
+//
+//  Copyright © 2026 Jibestream. All rights reserved.
+//
+
+#import "JMapGMController+Bounds.h"
+#import "JMapGMTrace.h"
+#import <objc/runtime.h>
+
+static const void *JMapGMMapBoundsKey = &JMapGMMapBoundsKey;
+
+JMapGMCoordinateBounds JMapGMCoordinateBoundsFromRect(JMapGMRect rect)
+{
+    if (JMapGMRectIsNull(rect)) {
+        return (JMapGMCoordinateBounds){ kCLLocationCoordinate2DInvalid, kCLLocationCoordinate2DInvalid };
+    }
+    return (JMapGMCoordinateBounds){
+        CLLocationCoordinate2DMake(rect.maxY, rect.maxX),
+        CLLocationCoordinate2DMake(rect.minY, rect.minX),
+    };
+}
+
+static JMapGMRect JMapGMShapesGetUnion(NSArray *shapes)
+{
+    NSUInteger count = shapes.count;
+    JMapGMRect *rects = malloc(MAX(count, 1) * sizeof(JMapGMRect));
+    NSUInteger i = 0;
+    for (id shape in shapes) {
+        if ([shape isKindOfClass:[JMapGMGeometry class]]) rects[i++] = [(JMapGMGeometry *)shape packedBounds];
+    }
+    JMapGMRect rect = JMapGMRectsGetUnion(rects, i);
+    free(rects);
+    return rect;
+}
+
+@implementation JMapGMController (Bounds)
+
+- (JMapGMCoordinateBounds)coordinateBoundsFromShapes:(NSArray<JMapGMGeometry *> *)shapes
+{
+    JMAPGM_TRACE_SCOPE("bounds.shapes");
+    return JMapGMCoordinateBoundsFromRect(JMapGMShapesGetUnion(shapes));
+}
+
+- (JMapGMCoordinateBounds)coordinateBoundsOfMap:(JMapMap *)map
+{
+    JMapGMRect rect;
+    NSValue *cached = objc_getAssociatedObject(map, JMapGMMapBoundsKey);
+    if (cached) {
+        [cached getValue:&rect];
+        return JMapGMCoordinateBoundsFromRect(rect);
+    }
+    JMAPGM_TRACE_SCOPE("bounds.map");
+    rect = JMapGMShapesGetUnion([self jmapgm_allShapesInMap:map]);
+    // A map not parsed yet has no bounds to keep.
+    NSValue *value = JMapGMRectIsNull(rect) ? nil : [NSValue valueWithBytes:&rect objCType:@encode(JMapGMRect)];
+    objc_setAssociatedObject(map, JMapGMMapBoundsKey, value, OBJC_ASSOCIATION_RETAIN);
+    return JMapGMCoordinateBoundsFromRect(rect);
+}
+
+- (void)invalidateBoundsOfMap:(JMapMap *)map
+{
+    objc_setAssociatedObject(map, JMapGMMapBoundsKey, nil, OBJC_ASSOCIATION_RETAIN);
+}
+
+- (void)cacheBoundsForMap:(JMapMap *)map
+{
+    JMAPGM_TRACE_SCOPE("bounds.cache");
+    NSArray<JMapGMGeometry *> *shapes = [self jmapgm_allShapesInMap:map];
+    // packedBounds is cached per geometry and safe to build concurrently.
+    dispatch_apply(shapes.count, DISPATCH_APPLY_AUTO, ^(size_t i) {
+        (void)shapes[i].packedBounds;
+    });
+    [self invalidateBoundsOfMap:map];
+    [self coordinateBoundsOfMap:map];
+}
+
+- (void)zoomToShapes:(NSArray<JMapGMGeometry *> *)shapes
+{
+    JMapGMCoordinateBounds bounds = [self coordinateBoundsFromShapes:shapes];
+    if (!JMapGMCoordinateBoundsIsValid(bounds)) return;
+    [self zoomToBoundsNorthEast:bounds.northEast andSouthWest:bounds.southWest];
+}
+
+- (void)zoomToCurrentMap
+{
+    JMapMap *map = self.currentMap;
+    if (!map) return;
+    JMapGMCoordinateBounds bounds = [self coordinateBoundsOfMap:map];
+    if (!JMapGMCoordinateBoundsIsValid(bounds)) return;
+    [self zoomToBoundsNorthEast:bounds.northEast andSouthWest:bounds.southWest];
+}
+
+@end
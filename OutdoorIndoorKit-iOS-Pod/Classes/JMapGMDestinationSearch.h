@@ -0,0 +1,107 @@
+//
+//  JMapGMDestinationSearch.h
+//  JMapOutdoorIndoorKit
+//
+//  Copyright © 2026 Jibestream. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import <CoreLocation/CoreLocation.h>
+#import <JMapOutdoorIndoorKit/JMapOutdoorIndoorKit.h>
+
+/**
+ *  Block returning the destinations of a venue
+ */
+typedef NSArray<JMapDestination *> * _Nonnull (^JMapGMDestinationProvider)(JMapActiveVenue * _Nonnull activeVenue);
+/**
+ *  Block returning the searchable text of a destination, e.g. its name, category and keywords joined
+ */
+typedef NSString * _Nullable (^JMapGMDestinationText)(JMapDestination * _Nonnull destination);
+/**
+ *  Block returning the walking distance to a destination in metres, negative if unknown
+ */
+typedef CLLocationDistance (^JMapGMDestinationDistance)(JMapDestination * _Nonnull destination, JMapActiveVenue * _Nonnull activeVenue);
+
+/**
+ *  The JMapGMDestinationMatch object
+ */
+@interface JMapGMDestinationMatch : NSObject
+
+/**
+ *  The destination found
+ */
+@property (nonatomic, readonly, nonnull) JMapDestination *destination;
+/**
+ *  The venue of the destination
+ */
+@property (nonatomic, readonly, nonnull) JMapActiveVenue *activeVenue;
+/**
+ *  1 for a query matching whole words exactly, less for prefixes, typos and distance
+ */
+@property (nonatomic, readonly) float score;
+
+@end
+
+/**
+ *  The JMapGMDestinationSearch object
+ *
+ *  Search-as-you-type over the destinations of every active venue. Texts are folded for case and
+ *  diacritics and indexed once; each keystroke then walks a prefix trie instead of scanning every
+ *  destination, tolerating a typo in words of 4 or more letters. Venues are added and removed
+ *  incrementally as the set of active venues changes. Safe to use from any thread.
+ */
+@interface JMapGMDestinationSearch : NSObject
+
+/**
+ *  Whether misspelled words match, YES by default
+ */
+@property (nonatomic) BOOL allowsTypos;
+/**
+ *  Score taken off per 100 metres of walking distance, 0.1 by default
+ */
+@property (nonatomic) float distanceWeight;
+/**
+ *  The number of indexed destinations
+ */
+@property (nonatomic, readonly) NSUInteger destinationCount;
+
+/**
+ *  Creates an empty search
+ *
+ *  @param destinations Returns the destinations of a venue, called once per added venue
+ *  @param text Returns the text to index for a destination
+ */
+- (nonnull instancetype)initWithDestinations:(nonnull JMapGMDestinationProvider)destinations text:(nonnull JMapGMDestinationText)text;
+
+/**
+ *  Indexes the destinations of venues not seen before and drops those of venues no longer listed.
+ *  Call after the controller's active venues change; venues are compared by identity.
+ *
+ *  @param activeVenues The venues to search
+ */
+- (void)updateWithVenues:(nonnull NSArray<JMapActiveVenue *> *)activeVenues;
+
+/**
+ *  Re-indexes the destinations of one venue, e.g. after its data was refreshed
+ */
+- (void)reloadVenue:(nonnull JMapActiveVenue *)activeVenue;
+
+/**
+ *  Updates the walking distance of every destination, which then weighs on the ranking. Call when
+ *  the user's position changes, not per keystroke.
+ *
+ *  @param distance Returns the distance to a destination, or nil to rank by text only
+ */
+- (void)updateDistances:(nullable JMapGMDestinationDistance)distance;
+
+/**
+ *  Finds the best matching destinations. Every word of the query must match a word of a
+ *  destination, whole, as a prefix, or misspelled.
+ *
+ *  @param query The text typed so far
+ *  @param limit The maximum number of matches
+ *  @return The matches, best first
+ */
+- (nonnull NSArray<JMapGMDestinationMatch *> *)searchForText:(nonnull NSString *)query limit:(NSUInteger)limit;
+
+@end
@@ -0,0 +1,208 @@
+//
+//  JMapGMDestinationSearch.m
+//  JMapOutdoorIndoorKit
+//
+//  Copyright © 2026 Jibestream. All rights reserved.
+//
+
+#import "JMapGMDestinationSearch.h"
+#import "JMapGMTextIndex.h"
+#import "JMapGMTrace.h"
+
+@interface JMapGMDestinationMatch ()
+- (instancetype)initWithDestination:(JMapDestination *)destination activeVenue:(JMapActiveVenue *)activeVenue score:(float)score;
+@end
+
+@implementation JMapGMDestinationMatch
+
+- (instancetype)initWithDestination:(JMapDestination *)destination activeVenue:(JMapActiveVenue *)activeVenue score:(float)score
+{
+    self = [super init];
+    if (self) {
+        _destination = destination;
+        _activeVenue = activeVenue;
+        _score = score;
+    }
+    return self;
+}
+
+@end
+
+@implementation JMapGMDestinationSearch
+{
+    JMapGMDestinationProvider _provider;
+    JMapGMDestinationText _text;
+    JMapGMTextIndex *_index;
+    // Indexed by document; NSNull marks a free slot, reused before the arrays grow.
+    NSMutableArray *_destinations;
+    NSMutableArray *_destinationVenues;
+    NSMutableIndexSet *_freeSlots;
+    NSMapTable<JMapActiveVenue *, NSMutableIndexSet *> *_venueSlots;
+    JMapGMDestinationDistance _distance;
+    // Float metres per document, NaN for unknown; empty when ranking by text only.
+    NSMutableData *_distances;
+}
+
+- (instancetype)initWithDestinations:(JMapGMDestinationProvider)destinations text:(JMapGMDestinationText)text
+{
+    self = [super init];
+    if (self) {
+        _provider = [destinations copy];
+        _text = [text copy];
+        _index = JMapGMTextIndexCreate();
+        _destinations = [NSMutableArray array];
+        _destinationVenues = [NSMutableArray array];
+        _freeSlots = [NSMutableIndexSet indexSet];
+        _venueSlots = [NSMapTable mapTableWithKeyOptions:NSPointerFunctionsStrongMemory | NSPointerFunctionsObjectPointerPersonality
+                                            valueOptions:NSPointerFunctionsStrongMemory];
+        _distances = [NSMutableData data];
+        _allowsTypos = YES;
+        _distanceWeight = JMapGMTextSearchOptionsDefault.distanceWeight;
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    JMapGMTextIndexRelease(_index);
+}
+
+- (NSUInteger)destinationCount
+{
+    @synchronized (self) {
+        return JMapGMTextIndexGetDocumentCount(_index);
+    }
+}
+
++ (NSString *)foldedText:(NSString *)text
+{
+    return [text stringByFoldingWithOptions:NSCaseInsensitiveSearch | NSDiacriticInsensitiveSearch locale:nil];
+}
+
+#pragma mark - Venues
+
+- (float)distanceToDestination:(JMapDestination *)destination activeVenue:(JMapActiveVenue *)activeVenue
+{
+    CLLocationDistance distance = _distance(destination, activeVenue);
+    return distance < 0 ? NAN : (float)distance;
+}
+
+- (void)addVenue:(JMapActiveVenue *)activeVenue
+{
+    NSMutableIndexSet *slots = [NSMutableIndexSet indexSet];
+    for (JMapDestination *destination in _provider(activeVenue)) {
+        NSString *text = _text(destination);
+        if (text.length == 0) continue;
+        NSUInteger slot = _freeSlots.firstIndex;
+        if (slot == NSNotFound) {
+            slot = _destinations.count;
+            [_destinations addObject:destination];
+            [_destinationVenues addObject:activeVenue];
+            if (_distance) {
+                float unknown = NAN;
+                [_distances appendBytes:&unknown length:sizeof(float)];
+            }
+        } else {
+            [_freeSlots removeIndex:slot];
+            _destinations[slot] = destination;
+            _destinationVenues[slot] = activeVenue;
+        }
+        if (_distance) ((float *)_distances.mutableBytes)[slot] = [self distanceToDestination:destination activeVenue:activeVenue];
+        const char *folded = [JMapGMDestinationSearch foldedText:text].UTF8String;
+        if (!JMapGMTextIndexAdd(_index, (uint32_t)slot, folded, strlen(folded))) {
+            [self freeSlot:slot];
+            continue;
+        }
+        [slots addIndex:slot];
+    }
+    [_venueSlots setObject:slots forKey:activeVenue];
+}
+
+- (void)freeSlot:(NSUInteger)slot
+{
+    _destinations[slot] = [NSNull null];
+    _destinationVenues[slot] = [NSNull null];
+    [_freeSlots addIndex:slot];
+}
+
+- (void)removeVenue:(JMapActiveVenue *)activeVenue
+{
+    NSIndexSet *slots = [_venueSlots objectForKey:activeVenue];
+    [slots enumerateIndexesUsingBlock:^(NSUInteger slot, BOOL *stop) {
+        JMapGMTextIndexRemove(self->_index, (uint32_t)slot);
+        [self freeSlot:slot];
+    }];
+    [_venueSlots removeObjectForKey:activeVenue];
+}
+
+- (void)updateWithVenues:(NSArray<JMapActiveVenue *> *)activeVenues
+{
+    JMAPGM_TRACE_SCOPE("search.update");
+    @synchronized (self) {
+        NSHashTable<JMapActiveVenue *> *listed = [NSHashTable hashTableWithOptions:NSPointerFunctionsObjectPointerPersonality];
+        for (JMapActiveVenue *activeVenue in activeVenues) [listed addObject:activeVenue];
+        for (JMapActiveVenue *activeVenue in _venueSlots.keyEnumerator.allObjects) {
+            if (![listed containsObject:activeVenue]) [self removeVenue:activeVenue];
+        }
+        for (JMapActiveVenue *activeVenue in activeVenues) {
+            if (![_venueSlots objectForKey:activeVenue]) [self addVenue:activeVenue];
+        }
+        JMAPGM_TRACE_COUNT("search.destinations", (int64_t)JMapGMTextIndexGetDocumentCount(_index));
+    }
+}
+
+- (void)reloadVenue:(JMapActiveVenue *)activeVenue
+{
+    @synchronized (self) {
+        if (![_venueSlots objectForKey:activeVenue]) return;
+        [self removeVenue:activeVenue];
+        [self addVenue:activeVenue];
+    }
+}
+
+- (void)updateDistances:(JMapGMDestinationDistance)distance
+{
+    @synchronized (self) {
+        _distance = [distance copy];
+        if (!distance) {
+            _distances.length = 0;
+            return;
+        }
+        _distances.length = _destinations.count * sizeof(float);
+        float *distances = _distances.mutableBytes;
+        for (NSUInteger slot = 0; slot < _destinations.count; slot++) {
+            id destination = _destinations[slot];
+            distances[slot] = destination == [NSNull null] ? NAN : [self distanceToDestination:destination activeVenue:_destinationVenues[slot]];
+        }
+    }
+}
+
+#pragma mark - Search
+
+- (NSArray<JMapGMDestinationMatch *> *)searchForText:(NSString *)query limit:(NSUInteger)limit
+{
+    JMAPGM_TRACE_SCOPE("search.query");
+    if (limit == 0) return @[];
+    const char *folded = [JMapGMDestinationSearch foldedText:query].UTF8String;
+    JMapGMTextMatch *matches = malloc(limit * sizeof(JMapGMTextMatch));
+    if (!matches) return @[];
+    NSMutableArray<JMapGMDestinationMatch *> *results = [NSMutableArray array];
+    @synchronized (self) {
+        JMapGMTextSearchOptions options = JMapGMTextSearchOptionsDefault;
+        options.typos = _allowsTypos;
+        options.distanceWeight = _distanceWeight;
+        options.distances = _distances.bytes;
+        options.distanceCount = _distances.length / sizeof(float);
+        size_t count = JMapGMTextIndexSearch(_index, folded, strlen(folded), &options, matches, limit);
+        for (size_t i = 0; i < count; i++) {
+            NSUInteger slot = matches[i].document;
+            [results addObject:[[JMapGMDestinationMatch alloc] initWithDestination:_destinations[slot]
+                                                                       activeVenue:_destinationVenues[slot]
+                                                                             score:matches[i].score]];
+        }
+    }
+    free(matches);
+    return results;
+}
+
+@end
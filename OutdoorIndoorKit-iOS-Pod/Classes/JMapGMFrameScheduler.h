@@ -0,0 +1,130 @@
+//
+//  JMapGMFrameScheduler.h
+//  JMapOutdoorIndoorKit
+//
+//  Copyright © 2026 Jibestream. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import <JMapOutdoorIndoorKit/JMapOutdoorIndoorKit.h>
+#import "JMapGMScheduler.h"
+
+/**
+ *  The JMapGMFrameScheduler object
+ *
+ *  Runs resumable main-thread tasks a frame's budget at a time from a display link, so that long
+ *  work such as restyling every unit of a floor never holds a frame. Interaction tasks run before
+ *  work on the visible floor, which runs before background floors. The display link only runs
+ *  while tasks are pending. Must be used on the main thread.
+ */
+@interface JMapGMFrameScheduler : NSObject
+
+/**
+ *  The scheduler shared by the kit's main-thread work
+ */
++ (nonnull instancetype)mainScheduler;
+
+/**
+ *  Seconds of work allowed per frame. Defaults to 4 ms, a quarter of a 60 Hz frame.
+ */
+@property (nonatomic) CFTimeInterval frameBudget;
+/**
+ *  Called after every frame that ran work, with what it ran
+ */
+@property (nonatomic, copy, nullable) void (^frameObserver)(JMapGMFrameStats stats);
+/**
+ *  What the last frame ran
+ */
+@property (nonatomic, readonly) JMapGMFrameStats lastFrame;
+/**
+ *  Totals since the scheduler was created
+ */
+@property (nonatomic, readonly) JMapGMSchedulerStats statistics;
+/**
+ *  The number of pending tasks
+ */
+@property (nonatomic, readonly) NSUInteger pendingCount;
+
+/**
+ *  Schedules a task.
+ *
+ *  @param priority The priority
+ *  @param step Runs one short step and returns YES while there are more
+ *  @param completion Called once the task finished or was cancelled, or nil
+ *  @return The task, for cancelTask: and setPriority:ofTask:
+ */
+- (uint64_t)scheduleWithPriority:(JMapGMTaskPriority)priority step:(nonnull BOOL (^)(void))step completion:(nullable void (^)(BOOL cancelled))completion;
+
+/**
+ *  Schedules a task working through objects a chunk per step.
+ *
+ *  @param objects The objects
+ *  @param chunkSize The number of objects per step
+ *  @param block Called with each chunk in order
+ *  @return The task
+ */
+- (uint64_t)scheduleObjects:(nonnull NSArray *)objects
+                  chunkSize:(NSUInteger)chunkSize
+                   priority:(JMapGMTaskPriority)priority
+                      block:(nonnull void (^)(NSArray * _Nonnull chunk))block
+                 completion:(nullable void (^)(BOOL cancelled))completion;
+
+/**
+ *  Cancels a pending task, calling its completion.
+ *
+ *  @return NO if the task already finished
+ */
+- (BOOL)cancelTask:(uint64_t)task;
+
+/**
+ *  Moves a pending task to another priority, e.g. when its floor is shown.
+ *
+ *  @return NO if the task already finished
+ */
+- (BOOL)setPriority:(JMapGMTaskPriority)priority ofTask:(uint64_t)task;
+
+/**
+ *  Runs one frame's budget of work now, as the display link would.
+ */
+- (JMapGMFrameStats)runFrame;
+
+@end
+
+@interface JMapGMController (Scheduling)
+
+/**
+ *  Time-sliced styleShapes:withStyling:, styling a chunk of shapes per step on the main scheduler.
+ *
+ *  @return The task
+ */
+- (uint64_t)scheduleStyleShapes:(nonnull NSArray<JMapGMGeometry *> *)shapes
+                    withStyling:(nonnull JMapStyle *)style
+                       priority:(JMapGMTaskPriority)priority
+                     completion:(nullable void (^)(BOOL cancelled))completion;
+
+/**
+ *  Time-sliced resetStyleForShapes:.
+ *
+ *  @return The task
+ */
+- (uint64_t)scheduleResetStyleForShapes:(nonnull NSArray<JMapGMGeometry *> *)shapes
+                               priority:(JMapGMTaskPriority)priority
+                             completion:(nullable void (^)(BOOL cancelled))completion;
+
+/**
+ *  Time-sliced resetMapStyle for one map: resets the style of every shape of the map, the visible
+ *  priority for the current map and the background priority for others. The priority is chosen
+ *  when scheduling; call updatePriorityOfMapTasks once another map is shown.
+ *
+ *  @return The task
+ */
+- (uint64_t)scheduleResetStyleOfMap:(nonnull JMapMap *)map completion:(nullable void (^)(BOOL cancelled))completion;
+
+/**
+ *  Moves the pending tasks of scheduleResetStyleOfMap: to the visible priority for the current map
+ *  and to the background priority for others. Call from the completion of showMap: or any other
+ *  call that changes currentMap, which the scheduler cannot observe.
+ */
+- (void)updatePriorityOfMapTasks;
+
+@end
@@ -0,0 +1,241 @@
+//
+//  JMapGMFrameScheduler.m
+//  JMapOutdoorIndoorKit
+//
+//  Copyright © 2026 Jibestream. All rights reserved.
+//
+
+#import "JMapGMFrameScheduler.h"
+#import "JMapGMGeometry+Packed.h"
+#import "JMapGMTrace.h"
+#import <QuartzCore/QuartzCore.h>
+#import <objc/runtime.h>
+
+// Shapes styled per step by the controller's scheduled calls.
+static const NSUInteger JMapGMSchedulingChunk = 32;
+
+static const void *JMapGMMapTasksKey = &JMapGMMapTasksKey;
+
+/**
+ *  Holds the blocks of one task while the C scheduler holds its context.
+ */
+@interface JMapGMFrameTask : NSObject
+@property (nonatomic, copy) BOOL (^step)(void);
+@property (nonatomic, copy) void (^completion)(BOOL cancelled);
+@end
+
+@implementation JMapGMFrameTask
+@end
+
+static bool JMapGMFrameTaskStep(void *context)
+{
+    JMapGMFrameTask *task = (__bridge JMapGMFrameTask *)context;
+    return task.step();
+}
+
+static void JMapGMFrameTaskFinish(void *context, bool cancelled)
+{
+    JMapGMFrameTask *task = (__bridge_transfer JMapGMFrameTask *)context;
+    if (task.completion) task.completion(cancelled);
+}
+
+/**
+ *  Display link target that does not retain the scheduler.
+ */
+@interface JMapGMFrameSchedulerProxy : NSObject
+@property (nonatomic, weak) JMapGMFrameScheduler *scheduler;
+@end
+
+@implementation JMapGMFrameSchedulerProxy
+
+- (void)tick:(CADisplayLink *)displayLink
+{
+    JMapGMFrameScheduler *scheduler = self.scheduler;
+    if (!scheduler) {
+        [displayLink invalidate];
+        return;
+    }
+    [scheduler runFrame];
+}
+
+@end
+
+@implementation JMapGMFrameScheduler
+{
+    JMapGMScheduler *_scheduler;
+    CADisplayLink *_displayLink;
+}
+
++ (instancetype)mainScheduler
+{
+    static JMapGMFrameScheduler *scheduler;
+    static dispatch_once_t once;
+    dispatch_once(&once, ^{
+        scheduler = [[JMapGMFrameScheduler alloc] init];
+    });
+    return scheduler;
+}
+
+- (instancetype)init
+{
+    self = [super init];
+    if (self) {
+        _scheduler = JMapGMSchedulerCreate(NULL, NULL);
+        _frameBudget = 0.004;
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    [_displayLink invalidate];
+    JMapGMSchedulerRelease(_scheduler);
+}
+
+- (JMapGMSchedulerStats)statistics
+{
+    return JMapGMSchedulerGetStats(_scheduler);
+}
+
+- (NSUInteger)pendingCount
+{
+    return JMapGMSchedulerGetPendingCount(_scheduler);
+}
+
+#pragma mark - Tasks
+
+- (uint64_t)scheduleWithPriority:(JMapGMTaskPriority)priority step:(BOOL (^)(void))step completion:(void (^)(BOOL))completion
+{
+    JMapGMFrameTask *task = [[JMapGMFrameTask alloc] init];
+    task.step = step;
+    task.completion = completion;
+    void *context = (__bridge_retained void *)task;
+    uint64_t identifier = JMapGMSchedulerAdd(_scheduler, priority, JMapGMFrameTaskStep, JMapGMFrameTaskFinish, context);
+    if (identifier == JMAPGM_TASK_NONE) {
+        (void)(__bridge_transfer JMapGMFrameTask *)context;
+        return JMAPGM_TASK_NONE;
+    }
+    [self resumeDisplayLink];
+    return identifier;
+}
+
+- (uint64_t)scheduleObjects:(NSArray *)objects
+                  chunkSize:(NSUInteger)chunkSize
+                   priority:(JMapGMTaskPriority)priority
+                      block:(void (^)(NSArray *))block
+                 completion:(void (^)(BOOL))completion
+{
+    NSArray *items = [objects copy];
+    NSUInteger size = MAX(chunkSize, (NSUInteger)1);
+    __block NSUInteger next = 0;
+    return [self scheduleWithPriority:priority step:^BOOL{
+        NSUInteger length = MIN(size, items.count - next);
+        if (length > 0) block([items subarrayWithRange:NSMakeRange(next, length)]);
+        next += length;
+        return next < items.count;
+    } completion:completion];
+}
+
+- (BOOL)cancelTask:(uint64_t)task
+{
+    return JMapGMSchedulerCancel(_scheduler, task);
+}
+
+- (BOOL)setPriority:(JMapGMTaskPriority)priority ofTask:(uint64_t)task
+{
+    return JMapGMSchedulerSetPriority(_scheduler, task, priority);
+}
+
+#pragma mark - Frames
+
+- (void)resumeDisplayLink
+{
+    if (!_displayLink) {
+        JMapGMFrameSchedulerProxy *proxy = [[JMapGMFrameSchedulerProxy alloc] init];
+        proxy.scheduler = self;
+        _displayLink = [CADisplayLink displayLinkWithTarget:proxy selector:@selector(tick:)];
+        [_displayLink addToRunLoop:[NSRunLoop mainRunLoop] forMode:NSRunLoopCommonModes];
+    }
+    _displayLink.paused = NO;
+}
+
+- (JMapGMFrameStats)runFrame
+{
+    JMAPGM_TRACE_SCOPE("scheduler.frame");
+    JMapGMFrameStats stats = JMapGMSchedulerRunFrame(_scheduler, (int64_t)(_frameBudget * 1e9));
+    _lastFrame = stats;
+    if (stats.pending == 0) _displayLink.paused = YES;
+    if (stats.steps > 0 && _frameObserver) _frameObserver(stats);
+    return stats;
+}
+
+@end
+
+@implementation JMapGMController (Scheduling)
+
+- (uint64_t)scheduleStyleShapes:(NSArray<JMapGMGeometry *> *)shapes
+                    withStyling:(JMapStyle *)style
+                       priority:(JMapGMTaskPriority)priority
+                     completion:(void (^)(BOOL))completion
+{
+    __weak JMapGMController *weakSelf = self;
+    return [[JMapGMFrameScheduler mainScheduler] scheduleObjects:shapes chunkSize:JMapGMSchedulingChunk priority:priority block:^(NSArray *chunk) {
+        [weakSelf styleShapes:chunk withStyling:style];
+    } completion:completion];
+}
+
+- (uint64_t)scheduleResetStyleForShapes:(NSArray<JMapGMGeometry *> *)shapes
+                               priority:(JMapGMTaskPriority)priority
+                             completion:(void (^)(BOOL))completion
+{
+    __weak JMapGMController *weakSelf = self;
+    return [[JMapGMFrameScheduler mainScheduler] scheduleObjects:shapes chunkSize:JMapGMSchedulingChunk priority:priority block:^(NSArray *chunk) {
+        [weakSelf resetStyleForShapes:chunk];
+    } completion:completion];
+}
+
+// The pending tasks of scheduleResetStyleOfMap:, by map, so that their priority can follow the current map.
+- (NSMapTable<JMapMap *, NSMutableSet<NSNumber *> *> *)jmapgm_mapTasks
+{
+    NSMapTable *mapTasks = objc_getAssociatedObject(self, JMapGMMapTasksKey);
+    if (!mapTasks) {
+        mapTasks = [NSMapTable strongToStrongObjectsMapTable];
+        objc_setAssociatedObject(self, JMapGMMapTasksKey, mapTasks, OBJC_ASSOCIATION_RETAIN);
+    }
+    return mapTasks;
+}
+
+- (uint64_t)scheduleResetStyleOfMap:(JMapMap *)map completion:(void (^)(BOOL))completion
+{
+    NSArray<JMapGMGeometry *> *shapes = [self jmapgm_allShapesInMap:map];
+    JMapGMTaskPriority priority = self.currentMap == map ? JMapGMTaskPriorityVisible : JMapGMTaskPriorityBackground;
+    NSMapTable<JMapMap *, NSMutableSet<NSNumber *> *> *mapTasks = [self jmapgm_mapTasks];
+    NSMutableSet<NSNumber *> *tasks = [mapTasks objectForKey:map];
+    if (!tasks) {
+        tasks = [NSMutableSet set];
+        [mapTasks setObject:tasks forKey:map];
+    }
+    // Tasks only finish from a later frame, after the identifier below is assigned.
+    __block uint64_t task = JMAPGM_TASK_NONE;
+    task = [self scheduleResetStyleForShapes:shapes priority:priority completion:^(BOOL cancelled) {
+        [tasks removeObject:@(task)];
+        if (tasks.count == 0 && [mapTasks objectForKey:map] == tasks) [mapTasks removeObjectForKey:map];
+        if (completion) completion(cancelled);
+    }];
+    if (task != JMAPGM_TASK_NONE) [tasks addObject:@(task)];
+    else if (tasks.count == 0) [mapTasks removeObjectForKey:map];
+    return task;
+}
+
+- (void)updatePriorityOfMapTasks
+{
+    NSMapTable<JMapMap *, NSMutableSet<NSNumber *> *> *mapTasks = objc_getAssociatedObject(self, JMapGMMapTasksKey);
+    JMapGMFrameScheduler *scheduler = [JMapGMFrameScheduler mainScheduler];
+    JMapMap *current = self.currentMap;
+    for (JMapMap *map in mapTasks) {
+        JMapGMTaskPriority priority = map == current ? JMapGMTaskPriorityVisible : JMapGMTaskPriorityBackground;
+        for (NSNumber *task in [mapTasks objectForKey:map]) [scheduler setPriority:priority ofTask:task.unsignedLongLongValue];
+    }
+}
+
+@end
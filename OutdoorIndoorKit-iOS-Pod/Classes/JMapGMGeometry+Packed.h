@@ -0,0 +1,53 @@
+//
+//  JMapGMGeometry+Packed.h
+//  JMapOutdoorIndoorKit
+//
+//  Copyright © 2026 Jibestream. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import <JMapOutdoorIndoorKit/JMapOutdoorIndoorKit.h>
+#import "JMapGMPolygon.h"
+
+@interface JMapGMGeometry (Packed)
+
+/**
+ *  The coordinates of the geometry as rings in one flat buffer, with x as longitude and y as latitude.
+ *  Built on first access and cached for the lifetime of the geometry. Lines and points are stored as
+ *  single rings. The buffers are owned by the geometry.
+ */
+@property (nonatomic, readonly) JMapGMPolygon packedPolygon;
+
+/**
+ *  The bounding box of packedPolygon, JMapGMRectNull for a geometry without coordinates
+ */
+@property (nonatomic, readonly) JMapGMRect packedBounds;
+
+/**
+ *  Enumerates the parts of packedPolygon as runs of rings: the whole Polygon, each polygon of a
+ *  MultiPolygon as its outline then its holes, or each line of other types on its own.
+ *
+ *  @param block Called with the first ring and the number of rings of each part
+ */
+- (void)enumeratePackedPartsUsingBlock:(void (NS_NOESCAPE ^ _Nonnull)(size_t firstRing, size_t ringCount, BOOL * _Nonnull stop))block;
+
+@end
+
+@interface JMapGMController (PackedShapes)
+
+/**
+ *  Enumerates every JMapGMGeometry of a map, layer by layer in getAllLayerNamesInMap: order.
+ *
+ *  @param map A map parsed by the controller
+ *  @param block Called with each shape and the name of its layer
+ */
+- (void)jmapgm_enumerateShapesInMap:(nonnull JMapMap *)map usingBlock:(void (NS_NOESCAPE ^ _Nonnull)(JMapGMGeometry * _Nonnull shape, NSString * _Nonnull layerName, BOOL * _Nonnull stop))block;
+
+/**
+ *  Every JMapGMGeometry of a map, layer by layer in getAllLayerNamesInMap: order.
+ *
+ *  @param map A map parsed by the controller
+ */
+- (nonnull NSArray<JMapGMGeometry *> *)jmapgm_allShapesInMap:(nonnull JMapMap *)map;
+
+@end
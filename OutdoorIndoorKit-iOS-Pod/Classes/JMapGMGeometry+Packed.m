@@ -0,0 +1,158 @@
+//
+//  JMapGMGeometry+Packed.m
+//  JMapOutdoorIndoorKit
+//
+//  Copyright © 2026 Jibestream. All rights reserved.
+//
+
+#import "JMapGMGeometry+Packed.h"
+#import <objc/runtime.h>
+
+/**
+ *  Owns the packed buffers of one geometry.
+ */
+@interface JMapGMPackedStorage : NSObject
+@property (nonatomic, readonly) NSData *points;
+@property (nonatomic, readonly) NSData *ringStarts;
+@property (nonatomic, readonly) JMapGMPolygon polygon;
+@property (nonatomic, readonly) JMapGMRect bounds;
+@end
+
+@implementation JMapGMPackedStorage
+
+- (instancetype)initWithPoints:(NSData *)points ringStarts:(NSData *)ringStarts
+{
+    self = [super init];
+    if (self) {
+        _points = points;
+        _ringStarts = ringStarts;
+        _polygon.points = points.bytes;
+        _polygon.ringStarts = ringStarts.bytes;
+        _polygon.ringCount = ringStarts.length / sizeof(uint32_t) - 1;
+        _bounds = JMapGMPolygonGetBounds(&_polygon);
+    }
+    return self;
+}
+
+@end
+
+static const void *JMapGMPackedStorageKey = &JMapGMPackedStorageKey;
+
+static BOOL JMapGMIsPosition(id value)
+{
+    return [value isKindOfClass:[NSArray class]] && [value count] >= 2 && [[value firstObject] isKindOfClass:[NSNumber class]];
+}
+
+static void JMapGMAppendPosition(NSArray *position, NSMutableData *points)
+{
+    // JMapGMGeometry coordinates are ordered lat,long.
+    JMapGMPoint point = { [position[1] doubleValue], [position[0] doubleValue] };
+    [points appendBytes:&point length:sizeof(point)];
+}
+
+static void JMapGMCloseRing(NSMutableData *points, NSMutableData *ringStarts)
+{
+    uint32_t end = (uint32_t)(points.length / sizeof(JMapGMPoint));
+    [ringStarts appendBytes:&end length:sizeof(end)];
+}
+
+static void JMapGMCollectRings(id value, NSMutableData *points, NSMutableData *ringStarts)
+{
+    if (![value isKindOfClass:[NSArray class]] || [value count] == 0) return;
+    if (JMapGMIsPosition(value)) {
+        JMapGMAppendPosition(value, points);
+        JMapGMCloseRing(points, ringStarts);
+        return;
+    }
+    if (JMapGMIsPosition([value firstObject])) {
+        for (id position in value) {
+            if (JMapGMIsPosition(position)) JMapGMAppendPosition(position, points);
+        }
+        JMapGMCloseRing(points, ringStarts);
+        return;
+    }
+    for (id child in value) {
+        JMapGMCollectRings(child, points, ringStarts);
+    }
+}
+
+@implementation JMapGMGeometry (Packed)
+
+- (JMapGMPackedStorage *)packedStorage
+{
+    JMapGMPackedStorage *storage = objc_getAssociatedObject(self, JMapGMPackedStorageKey);
+    if (storage) return storage;
+
+    @synchronized (self) {
+        storage = objc_getAssociatedObject(self, JMapGMPackedStorageKey);
+        if (!storage) {
+            NSMutableData *points = [NSMutableData data];
+            NSMutableData *ringStarts = [NSMutableData data];
+            uint32_t start = 0;
+            [ringStarts appendBytes:&start length:sizeof(start)];
+            JMapGMCollectRings(self.coordinates, points, ringStarts);
+            storage = [[JMapGMPackedStorage alloc] initWithPoints:points ringStarts:ringStarts];
+            objc_setAssociatedObject(self, JMapGMPackedStorageKey, storage, OBJC_ASSOCIATION_RETAIN);
+        }
+    }
+    return storage;
+}
+
+- (JMapGMPolygon)packedPolygon
+{
+    return [self packedStorage].polygon;
+}
+
+- (JMapGMRect)packedBounds
+{
+    return [self packedStorage].bounds;
+}
+
+- (void)enumeratePackedPartsUsingBlock:(void (NS_NOESCAPE ^)(size_t, size_t, BOOL *))block
+{
+    JMapGMPolygon polygon = self.packedPolygon;
+    NSString *type = self.type;
+    BOOL isPolygon = [type isEqualToString:@"Polygon"];
+    NSArray *parts = [type isEqualToString:@"MultiPolygon"] ? self.coordinates : nil;
+    size_t ring = 0, part = 0;
+    BOOL stop = NO;
+    while (ring < polygon.ringCount && !stop) {
+        size_t rings = 1;
+        if (isPolygon) {
+            rings = polygon.ringCount;
+        } else if (part < parts.count && [parts[part] isKindOfClass:[NSArray class]]) {
+            rings = MAX([parts[part] count], (NSUInteger)1);
+        }
+        rings = MIN(rings, polygon.ringCount - ring);
+        part++;
+        block(ring, rings, &stop);
+        ring += rings;
+    }
+}
+
+@end
+
+@implementation JMapGMController (PackedShapes)
+
+- (void)jmapgm_enumerateShapesInMap:(JMapMap *)map usingBlock:(void (NS_NOESCAPE ^)(JMapGMGeometry *, NSString *, BOOL *))block
+{
+    BOOL stop = NO;
+    for (NSString *layerName in [self getAllLayerNamesInMap:map]) {
+        for (id shape in [self getShapesInLayerWithName:layerName fromMap:map]) {
+            if (![shape isKindOfClass:[JMapGMGeometry class]]) continue;
+            block(shape, layerName, &stop);
+            if (stop) return;
+        }
+    }
+}
+
+- (NSArray<JMapGMGeometry *> *)jmapgm_allShapesInMap:(JMapMap *)map
+{
+    NSMutableArray<JMapGMGeometry *> *shapes = [NSMutableArray array];
+    [self jmapgm_enumerateShapesInMap:map usingBlock:^(JMapGMGeometry *shape, NSString *layerName, BOOL *stop) {
+        [shapes addObject:shape];
+    }];
+    return shapes;
+}
+
+@end
@@ -0,0 +1,37 @@
+//
+//  JMapGMGeometry+Triangles.h
+//  JMapOutdoorIndoorKit
+//
+//  Copyright © 2026 Jibestream. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import <JMapOutdoorIndoorKit/JMapOutdoorIndoorKit.h>
+#import "JMapGMGeometry+Packed.h"
+#import "JMapGMTriangulate.h"
+
+@interface JMapGMGeometry (Triangles)
+
+/**
+ *  The triangulation of a Polygon or MultiPolygon geometry, three indices into packedPolygon.points
+ *  per triangle, holes left open. Built on first access and cached beside the packed coordinates.
+ *  Empty for other geometry types. The buffer is owned by the geometry. Thread safe.
+ *
+ *  Neither the map nor the pod's overlays draw from it: GMSPolygon tessellates its own paths. It is
+ *  for callers with a renderer that takes index buffers, or that need areas or point sampling.
+ */
+@property (nonatomic, readonly) JMapGMTriangles packedTriangles;
+
+@end
+
+@interface JMapGMController (Triangles)
+
+/**
+ *  Triangulates every filled shape of a map across all cores, so later reads of packedTriangles
+ *  are cached. Only useful to callers that read packedTriangles; the map itself never does.
+ *
+ *  @param map A map parsed by the controller
+ */
+- (void)cacheTrianglesForMap:(nonnull JMapMap *)map;
+
+@end
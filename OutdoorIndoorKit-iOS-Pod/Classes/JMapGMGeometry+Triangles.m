@@ -0,0 +1,72 @@
+//
+//  JMapGMGeometry+Triangles.m
+//  JMapOutdoorIndoorKit
+//
+//  Copyright © 2026 Jibestream. All rights reserved.
+//
+
+#import "JMapGMGeometry+Triangles.h"
+#import "JMapGMTrace.h"
+#import <objc/runtime.h>
+
+static const void *JMapGMTrianglesKey = &JMapGMTrianglesKey;
+
+// Triangulates each part of a polygon geometry: its outline, then its holes.
+static NSData *JMapGMTriangulateGeometry(JMapGMGeometry *geometry)
+{
+    NSString *type = geometry.type;
+    if (![type isEqualToString:@"Polygon"] && ![type isEqualToString:@"MultiPolygon"]) return [NSData data];
+    JMapGMPolygon polygon = geometry.packedPolygon;
+    if (polygon.ringCount == 0) return [NSData data];
+
+    size_t capacity = JMapGMTriangulationCapacity(polygon.ringStarts[polygon.ringCount], polygon.ringCount);
+    NSMutableData *indices = [NSMutableData dataWithLength:capacity * sizeof(uint32_t)];
+    uint32_t *output = indices.mutableBytes;
+    __block size_t count = 0;
+    __block BOOL failed = NO;
+    [geometry enumeratePackedPartsUsingBlock:^(size_t ring, size_t rings, BOOL *stop) {
+        size_t written = JMapGMTriangulate(&polygon, ring, rings, output + count);
+        if (written == JMAPGM_TRIANGULATE_FAILED) {
+            failed = *stop = YES;
+            return;
+        }
+        count += written;
+    }];
+    if (failed) return [NSData data];
+    indices.length = count * sizeof(uint32_t);
+    return indices;
+}
+
+@implementation JMapGMGeometry (Triangles)
+
+- (JMapGMTriangles)packedTriangles
+{
+    NSData *indices = objc_getAssociatedObject(self, JMapGMTrianglesKey);
+    if (!indices) {
+        @synchronized (self) {
+            indices = objc_getAssociatedObject(self, JMapGMTrianglesKey);
+            if (!indices) {
+                indices = JMapGMTriangulateGeometry(self);
+                objc_setAssociatedObject(self, JMapGMTrianglesKey, indices, OBJC_ASSOCIATION_RETAIN);
+            }
+        }
+    }
+    return (JMapGMTriangles){ indices.bytes, indices.length / sizeof(uint32_t) };
+}
+
+@end
+
+@implementation JMapGMController (Triangles)
+
+- (void)cacheTrianglesForMap:(JMapMap *)map
+{
+    JMAPGM_TRACE_SCOPE("triangles.cache");
+    NSArray<JMapGMGeometry *> *shapes = [self jmapgm_allShapesInMap:map];
+    // Each geometry triangulates under its own lock, so shapes can be spread across cores.
+    dispatch_apply(shapes.count, DISPATCH_APPLY_AUTO, ^(size_t i) {
+        (void)shapes[i].packedTriangles;
+    });
+    JMAPGM_TRACE_COUNT("triangles.shapes", (int64_t)shapes.count);
+}
+
+@end
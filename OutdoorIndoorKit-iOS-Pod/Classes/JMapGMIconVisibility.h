@@ -0,0 +1,131 @@
+//
+//  JMapGMIconVisibility.h
+//  JMapOutdoorIndoorKit
+//
+//  Copyright © 2026 Jibestream. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import <JMapOutdoorIndoorKit/JMapOutdoorIndoorKit.h>
+#import "JMapGMVisibilityIndex.h"
+
+/**
+ *  The icons a JMapGMIconVisibility drives
+ */
+typedef NS_ENUM(NSInteger, JMapGMIconKind) {
+    /** Types are JMapAmenity objects */
+    JMapGMIconKindAmenity,
+    /** Types are JMapPathType objects */
+    JMapGMIconKindPathType,
+};
+
+/**
+ *  The JMapGMIconVisibility object
+ *
+ *  Batches the show, hide and style calls of JMapGMController for amenities or path types. Toggles
+ *  only update a JMapGMVisibilityIndex; commit then makes the fewest controller calls that reach the
+ *  net result, e.g. one hideAmenity:atWaypoint: per type instead of one per icon.
+ *  Must be used on the main thread.
+ */
+@interface JMapGMIconVisibility : NSObject
+
+/**
+ *  The controller receiving the batched calls
+ */
+@property (nonatomic, readonly, weak, nullable) JMapGMController *controller;
+
+/**
+ *  Whether changes are committed automatically on the next main queue turn. Defaults to YES.
+ */
+@property (nonatomic) BOOL automaticallyCommits;
+
+/**
+ *  Whether the types and waypoints given at creation are every icon of the kind the map shows.
+ *  Only then does a change to every icon commit as one call such as hideAllAmenities; otherwise it
+ *  commits as one call per type, leaving icons outside the index alone. Defaults to NO.
+ */
+@property (nonatomic) BOOL coversAllIcons;
+
+/**
+ *  Creates the index of icon instances.
+ *
+ *  @param controller The controller showing the icons
+ *  @param kind Whether the types are amenities or path types
+ *  @param types The type of each icon instance
+ *  @param waypoints The waypoint of each icon instance, the same count as types
+ *  @param visible Whether the icons are currently shown
+ */
+- (nonnull instancetype)initWithController:(nonnull JMapGMController *)controller
+                                      kind:(JMapGMIconKind)kind
+                                     types:(nonnull NSArray *)types
+                                 waypoints:(nonnull NSArray<JMapWaypoint *> *)waypoints
+                                   visible:(BOOL)visible;
+
+/**
+ *  Shows the icons of a type.
+ *
+ *  @param type A JMapAmenity or JMapPathType, matching kind
+ *  @param waypoint The waypoint of the icon, or nil for every icon of the type
+ */
+- (void)showType:(nonnull id)type atWaypoint:(nullable JMapWaypoint *)waypoint;
+
+/**
+ *  Hides the icons of a type.
+ *
+ *  @param type A JMapAmenity or JMapPathType, matching kind
+ *  @param waypoint The waypoint of the icon, or nil for every icon of the type
+ */
+- (void)hideType:(nonnull id)type atWaypoint:(nullable JMapWaypoint *)waypoint;
+
+/**
+ *  Shows every icon.
+ */
+- (void)showAll;
+
+/**
+ *  Hides every icon.
+ */
+- (void)hideAll;
+
+/**
+ *  Styles the icons of a type.
+ *
+ *  @param type A JMapAmenity or JMapPathType, matching kind
+ *  @param waypoint The waypoint of the icon, or nil for every icon of the type
+ *  @param style The style to apply
+ */
+- (void)styleType:(nonnull id)type atWaypoint:(nullable JMapWaypoint *)waypoint withStyling:(nonnull JMapIconStyle *)style;
+
+/**
+ *  Resets the style of the icons of a type.
+ *
+ *  @param type A JMapAmenity or JMapPathType, matching kind
+ *  @param waypoint The waypoint of the icon, or nil for every icon of the type
+ */
+- (void)resetStyleForType:(nonnull id)type atWaypoint:(nullable JMapWaypoint *)waypoint;
+
+/**
+ *  Styles every icon.
+ *
+ *  @param style The style to apply
+ */
+- (void)styleAll:(nonnull JMapIconStyle *)style;
+
+/**
+ *  Resets the style of every icon.
+ */
+- (void)resetAllStyles;
+
+/**
+ *  Whether the icon of a type at a waypoint will be visible after the next commit.
+ */
+- (BOOL)isTypeVisible:(nonnull id)type atWaypoint:(nonnull JMapWaypoint *)waypoint;
+
+/**
+ *  Applies the net changes since the last commit to the controller.
+ *
+ *  @return The number of controller calls made
+ */
+- (NSUInteger)commit;
+
+@end
@@ -0,0 +1,224 @@
+//
+//  JMapGMIconVisibility.m
+//  JMapOutdoorIndoorKit
+//
+//  Copyright © 2026 Jibestream. All rights reserved.
+//
+
+#import "JMapGMIconVisibility.h"
+#import "JMapGMTrace.h"
+
+@implementation JMapGMIconVisibility
+{
+    JMapGMIconKind _kind;
+    JMapGMVisibilityIndex *_index;
+    NSArray *_types;
+    NSArray<JMapWaypoint *> *_waypoints;
+    NSMapTable *_typeIndexes;
+    NSMapTable *_waypointIndexes;
+    /** Style identifiers are positions in _styles plus one, 0 being the default style */
+    NSMutableArray<JMapIconStyle *> *_styles;
+    BOOL _commitScheduled;
+    /** Controller calls made by the commit in progress */
+    NSUInteger _calls;
+}
+
+- (instancetype)initWithController:(JMapGMController *)controller
+                              kind:(JMapGMIconKind)kind
+                             types:(NSArray *)types
+                         waypoints:(NSArray<JMapWaypoint *> *)waypoints
+                           visible:(BOOL)visible
+{
+    self = [super init];
+    if (self) {
+        _controller = controller;
+        _kind = kind;
+        _automaticallyCommits = YES;
+        _styles = [NSMutableArray array];
+        _typeIndexes = [NSMapTable strongToStrongObjectsMapTable];
+        _waypointIndexes = [NSMapTable strongToStrongObjectsMapTable];
+
+        NSUInteger count = MIN(types.count, waypoints.count);
+        NSMutableArray *uniqueTypes = [NSMutableArray array];
+        NSMutableArray *uniqueWaypoints = [NSMutableArray array];
+        uint32_t *typeIndexes = malloc(MAX(count, 1) * sizeof(uint32_t));
+        uint32_t *waypointIndexes = malloc(MAX(count, 1) * sizeof(uint32_t));
+        for (NSUInteger i = 0; i < count; i++) {
+            typeIndexes[i] = [self indexOfObject:types[i] in:_typeIndexes objects:uniqueTypes];
+            waypointIndexes[i] = [self indexOfObject:waypoints[i] in:_waypointIndexes objects:uniqueWaypoints];
+        }
+        _types = uniqueTypes;
+        _waypoints = uniqueWaypoints;
+        _index = JMapGMVisibilityIndexCreate(typeIndexes, waypointIndexes, count, visible);
+        free(typeIndexes);
+        free(waypointIndexes);
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    JMapGMVisibilityIndexRelease(_index);
+}
+
+- (uint32_t)indexOfObject:(id)object in:(NSMapTable *)indexes objects:(NSMutableArray *)objects
+{
+    NSNumber *index = [indexes objectForKey:object];
+    if (!index) {
+        index = @(objects.count);
+        [indexes setObject:index forKey:object];
+        [objects addObject:object];
+    }
+    return index.unsignedIntValue;
+}
+
+#pragma mark - Changes
+
+- (uint32_t)typeIndex:(id)type
+{
+    NSNumber *index = [_typeIndexes objectForKey:type];
+    return index ? index.unsignedIntValue : JMAPGM_VISIBILITY_ALL - 1;
+}
+
+- (uint32_t)waypointIndex:(JMapWaypoint *)waypoint
+{
+    if (!waypoint) return JMAPGM_VISIBILITY_ALL;
+    NSNumber *index = [_waypointIndexes objectForKey:waypoint];
+    return index ? index.unsignedIntValue : JMAPGM_VISIBILITY_ALL - 1;
+}
+
+- (uint32_t)styleIdentifier:(JMapIconStyle *)style
+{
+    NSUInteger position = [_styles indexOfObjectIdenticalTo:style];
+    if (position == NSNotFound) {
+        position = _styles.count;
+        [_styles addObject:style];
+    }
+    return (uint32_t)position + 1;
+}
+
+- (void)didChange:(size_t)matched
+{
+    if (!matched || !_index || !_automaticallyCommits || _commitScheduled) return;
+    _commitScheduled = YES;
+    __weak JMapGMIconVisibility *weakSelf = self;
+    dispatch_async(dispatch_get_main_queue(), ^{
+        [weakSelf commit];
+    });
+}
+
+- (void)showType:(id)type atWaypoint:(JMapWaypoint *)waypoint
+{
+    if (!_index) return;
+    [self didChange:JMapGMVisibilityIndexSetVisible(_index, [self typeIndex:type], [self waypointIndex:waypoint], true)];
+}
+
+- (void)hideType:(id)type atWaypoint:(JMapWaypoint *)waypoint
+{
+    if (!_index) return;
+    [self didChange:JMapGMVisibilityIndexSetVisible(_index, [self typeIndex:type], [self waypointIndex:waypoint], false)];
+}
+
+- (void)showAll
+{
+    if (!_index) return;
+    [self didChange:JMapGMVisibilityIndexSetVisible(_index, JMAPGM_VISIBILITY_ALL, JMAPGM_VISIBILITY_ALL, true)];
+}
+
+- (void)hideAll
+{
+    if (!_index) return;
+    [self didChange:JMapGMVisibilityIndexSetVisible(_index, JMAPGM_VISIBILITY_ALL, JMAPGM_VISIBILITY_ALL, false)];
+}
+
+- (void)styleType:(id)type atWaypoint:(JMapWaypoint *)waypoint withStyling:(JMapIconStyle *)style
+{
+    if (!_index) return;
+    [self didChange:JMapGMVisibilityIndexSetStyle(_index, [self typeIndex:type], [self waypointIndex:waypoint], [self styleIdentifier:style])];
+}
+
+- (void)resetStyleForType:(id)type atWaypoint:(JMapWaypoint *)waypoint
+{
+    if (!_index) return;
+    [self didChange:JMapGMVisibilityIndexSetStyle(_index, [self typeIndex:type], [self waypointIndex:waypoint], JMAPGM_VISIBILITY_DEFAULT_STYLE)];
+}
+
+- (void)styleAll:(JMapIconStyle *)style
+{
+    if (!_index) return;
+    [self didChange:JMapGMVisibilityIndexSetStyle(_index, JMAPGM_VISIBILITY_ALL, JMAPGM_VISIBILITY_ALL, [self styleIdentifier:style])];
+}
+
+- (void)resetAllStyles
+{
+    if (!_index) return;
+    [self didChange:JMapGMVisibilityIndexSetStyle(_index, JMAPGM_VISIBILITY_ALL, JMAPGM_VISIBILITY_ALL, JMAPGM_VISIBILITY_DEFAULT_STYLE)];
+}
+
+- (BOOL)isTypeVisible:(id)type atWaypoint:(JMapWaypoint *)waypoint
+{
+    return _index && JMapGMVisibilityIndexIsVisible(_index, [self typeIndex:type], [self waypointIndex:waypoint]);
+}
+
+#pragma mark - Commit
+
+static void JMapGMIconVisibilityApply(const JMapGMVisibilityChange *change, void *context)
+{
+    [(__bridge JMapGMIconVisibility *)context applyChange:change];
+}
+
+- (NSUInteger)commit
+{
+    _commitScheduled = NO;
+    if (!_index || !_controller) return 0;
+    JMAPGM_TRACE_SCOPE("icons.commit");
+    _calls = 0;
+    JMapGMVisibilityIndexCommit(_index, JMapGMIconVisibilityApply, (__bridge void *)self);
+    JMAPGM_TRACE_COUNT("icons.calls", (int64_t)_calls);
+    return _calls;
+}
+
+- (void)applyChange:(const JMapGMVisibilityChange *)change
+{
+    // A change to every type only becomes an *All* call when no icon outside the index would follow it.
+    if (change->type == JMAPGM_VISIBILITY_ALL && !_coversAllIcons) {
+        JMapGMVisibilityChange typeChange = *change;
+        for (uint32_t t = 0; t < _types.count; t++) {
+            typeChange.type = t;
+            [self applyChange:&typeChange];
+        }
+        return;
+    }
+    JMapGMController *controller = _controller;
+    BOOL all = change->type == JMAPGM_VISIBILITY_ALL;
+    id type = all ? nil : _types[change->type];
+    JMapWaypoint *waypoint = change->waypoint == JMAPGM_VISIBILITY_ALL ? nil : _waypoints[change->waypoint];
+    JMapIconStyle *style = change->action == JMapGMVisibilityStyle ? _styles[change->style - 1] : nil;
+    BOOL amenity = _kind == JMapGMIconKindAmenity;
+    _calls++;
+
+    switch (change->action) {
+        case JMapGMVisibilityShow:
+            if (all) amenity ? [controller showAllAmenities] : [controller showAllPathTypes];
+            else if (amenity) [controller showAmenity:type atWaypoint:waypoint];
+            else [controller showPathType:type atWaypoint:waypoint];
+            break;
+        case JMapGMVisibilityHide:
+            if (all) amenity ? [controller hideAllAmenities] : [controller hideAllPathTypes];
+            else if (amenity) [controller hideAmenity:type atWaypoint:waypoint];
+            else [controller hidePathType:type atWaypoint:waypoint];
+            break;
+        case JMapGMVisibilityStyle:
+            if (all) amenity ? [controller styleAllAmenities:style] : [controller styleAllPathTypes:style];
+            else if (amenity) [controller styleAmenity:type atWaypoint:waypoint withStyling:style];
+            else [controller stylePathType:type atWaypoint:waypoint withStyling:style];
+            break;
+        case JMapGMVisibilityResetStyle:
+            if (all) amenity ? [controller resetAllAmenityStyle] : [controller resetAllPathTypeStyle];
+            else if (amenity) [controller resetAmenityStyle:type atWaypoint:waypoint];
+            else [controller resetPathTypeStyle:type atWaypoint:waypoint];
+            break;
+    }
+}
+
+@end
@@ -0,0 +1,205 @@
+//
+//  JMapGMLocationFilter.c
+//  JMapOutdoorIndoorKit
+//
+//  Copyright © 2026 Jibestream. All rights reserved.
+//
+
+#include "JMapGMLocationFilter.h"
+
+#include <math.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#pragma mark - Queue
+
+typedef struct {
+    atomic_size_t sequence;
+    JMapGMLocationFix fix;
+} JMapGMLocationSlot;
+
+struct JMapGMLocationQueue {
+    size_t mask;
+    JMapGMLocationSlot *slots;
+    // Producers and the consumer touch different cache lines.
+    _Alignas(64) atomic_size_t tail;
+    _Alignas(64) size_t head;
+};
+
+JMapGMLocationQueue *JMapGMLocationQueueCreate(size_t capacity)
+{
+    size_t size = 2;
+    while (size < capacity) size <<= 1;
+
+    JMapGMLocationQueue *queue = calloc(1, sizeof(JMapGMLocationQueue));
+    if (!queue) return NULL;
+    queue->slots = calloc(size, sizeof(JMapGMLocationSlot));
+    if (!queue->slots) {
+        free(queue);
+        return NULL;
+    }
+    queue->mask = size - 1;
+    for (size_t i = 0; i < size; i++) {
+        atomic_init(&queue->slots[i].sequence, i);
+    }
+    atomic_init(&queue->tail, 0);
+    queue->head = 0;
+    return queue;
+}
+
+void JMapGMLocationQueueRelease(JMapGMLocationQueue *queue)
+{
+    if (!queue) return;
+    free(queue->slots);
+    free(queue);
+}
+
+bool JMapGMLocationQueuePush(JMapGMLocationQueue *queue, const JMapGMLocationFix *fix)
+{
+    size_t position = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+    JMapGMLocationSlot *slot;
+    for (;;) {
+        slot = &queue->slots[position & queue->mask];
+        size_t sequence = atomic_load_explicit(&slot->sequence, memory_order_acquire);
+        intptr_t difference = (intptr_t)sequence - (intptr_t)position;
+        if (difference == 0) {
+            if (atomic_compare_exchange_weak_explicit(&queue->tail, &position, position + 1, memory_order_relaxed, memory_order_relaxed)) {
+                break;
+            }
+        } else if (difference < 0) {
+            return false;
+        } else {
+            position = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+        }
+    }
+    slot->fix = *fix;
+    atomic_store_explicit(&slot->sequence, position + 1, memory_order_release);
+    return true;
+}
+
+bool JMapGMLocationQueuePop(JMapGMLocationQueue *queue, JMapGMLocationFix *fix)
+{
+    size_t position = queue->head;
+    JMapGMLocationSlot *slot = &queue->slots[position & queue->mask];
+    size_t sequence = atomic_load_explicit(&slot->sequence, memory_order_acquire);
+    if ((intptr_t)sequence - (intptr_t)(position + 1) < 0) return false;
+
+    *fix = slot->fix;
+    queue->head = position + 1;
+    atomic_store_explicit(&slot->sequence, position + queue->mask + 1, memory_order_release);
+    return true;
+}
+
+#pragma mark - Filter
+
+const JMapGMLocationFilterConfig JMapGMLocationFilterConfigDefault = {
+    .alpha = 0.35,
+    .beta = 0.05,
+    .minDistance = 0.5,
+    .minOrientationDelta = 2.0,
+    .maxGap = 3.0,
+};
+
+// Longest time a position is extrapolated past the last fix.
+static const double JMapGMMaxPrediction = 0.25;
+
+static double JMapGMAngleDelta(double from, double to)
+{
+    double delta = fmod(to - from, 360.0);
+    if (delta > 180.0) delta -= 360.0;
+    if (delta < -180.0) delta += 360.0;
+    return delta;
+}
+
+static void JMapGMLocationFilterReset(JMapGMLocationFilter *filter, const JMapGMLocationFix *fix)
+{
+    filter->initialized = true;
+    filter->x = fix->x;
+    filter->y = fix->y;
+    filter->vx = 0;
+    filter->vy = 0;
+    filter->orientation = fix->orientation;
+    filter->confidence = fix->confidence;
+    filter->timestamp = fix->timestamp;
+    filter->map = fix->map;
+}
+
+void JMapGMLocationFilterInit(JMapGMLocationFilter *filter, const JMapGMLocationFilterConfig *config)
+{
+    // Every field starts zeroed, so no state is read before the first fix sets it.
+    *filter = (JMapGMLocationFilter){ .config = config ? *config : JMapGMLocationFilterConfigDefault };
+}
+
+void JMapGMLocationFilterAddFix(JMapGMLocationFilter *filter, const JMapGMLocationFix *fix)
+{
+    if (!filter->initialized || fix->map != filter->map || fix->timestamp - filter->timestamp > filter->config.maxGap) {
+        JMapGMLocationFilterReset(filter, fix);
+        return;
+    }
+    double dt = fix->timestamp - filter->timestamp;
+    // Fixes can arrive out of order when several threads feed the queue.
+    if (dt < 0) return;
+
+    double alpha = filter->config.alpha;
+    double px = filter->x + filter->vx * dt;
+    double py = filter->y + filter->vy * dt;
+    double rx = fix->x - px;
+    double ry = fix->y - py;
+    filter->x = px + alpha * rx;
+    filter->y = py + alpha * ry;
+    if (dt > 0) {
+        filter->vx += filter->config.beta * rx / dt;
+        filter->vy += filter->config.beta * ry / dt;
+    }
+    filter->timestamp = fix->timestamp;
+
+    if (!isnan(fix->orientation)) {
+        if (isnan(filter->orientation)) {
+            filter->orientation = fix->orientation;
+        } else {
+            double orientation = filter->orientation + alpha * JMapGMAngleDelta(filter->orientation, fix->orientation);
+            filter->orientation = fmod(orientation + 360.0, 360.0);
+        }
+    }
+    if (!isnan(fix->confidence)) filter->confidence = fix->confidence;
+}
+
+static bool JMapGMValueChanged(double previous, double current, double threshold, bool angular)
+{
+    if (isnan(previous) || isnan(current)) return isnan(previous) != isnan(current);
+    double delta = angular ? JMapGMAngleDelta(previous, current) : current - previous;
+    return fabs(delta) >= threshold;
+}
+
+bool JMapGMLocationFilterPublish(JMapGMLocationFilter *filter, double now, JMapGMLocationFix *out)
+{
+    if (!filter->initialized) return false;
+
+    double horizon = now - filter->timestamp;
+    if (horizon < 0) horizon = 0;
+    if (horizon > JMapGMMaxPrediction) horizon = JMapGMMaxPrediction;
+
+    JMapGMLocationFix current = {
+        .x = filter->x + filter->vx * horizon,
+        .y = filter->y + filter->vy * horizon,
+        .orientation = filter->orientation,
+        .confidence = filter->confidence,
+        .timestamp = now,
+        .map = filter->map,
+    };
+
+    if (filter->hasPublished && current.map == filter->published.map) {
+        const JMapGMLocationFix *last = &filter->published;
+        const JMapGMLocationFilterConfig *config = &filter->config;
+        bool moved = hypot(current.x - last->x, current.y - last->y) >= config->minDistance;
+        bool turned = JMapGMValueChanged(last->orientation, current.orientation, config->minOrientationDelta, true);
+        bool resized = JMapGMValueChanged(last->confidence, current.confidence, config->minDistance, false);
+        if (!moved && !turned && !resized) return false;
+    }
+
+    filter->published = current;
+    filter->hasPublished = true;
+    *out = current;
+    return true;
+}
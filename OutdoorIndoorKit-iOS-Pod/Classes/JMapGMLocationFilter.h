@@ -0,0 +1,127 @@
+//
+//  JMapGMLocationFilter.h
+//  JMapOutdoorIndoorKit
+//
+//  Copyright © 2026 Jibestream. All rights reserved.
+//
+
+#ifndef JMapGMLocationFilter_h
+#define JMapGMLocationFilter_h
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ *  A single raw position fix in map x,y coordinates
+ */
+typedef struct {
+    double x;
+    double y;
+    /** Degrees relative to true north, NAN when unknown */
+    double orientation;
+    /** Radius of confidence in map units, NAN when unknown */
+    double confidence;
+    /** Fix time in seconds on a monotonic clock */
+    double timestamp;
+    /** Opaque token identifying the floor map, compared by identity only */
+    const void *map;
+} JMapGMLocationFix;
+
+/**
+ *  Bounded multi-producer, single-consumer queue of fixes.
+ *  Any thread may push; only the thread draining the queue may pop.
+ */
+typedef struct JMapGMLocationQueue JMapGMLocationQueue;
+
+/**
+ *  Creates a queue. Capacity is rounded up to a power of two.
+ *
+ *  @param capacity Minimum number of fixes the queue can hold
+ *  @return A new queue, or NULL if allocation failed
+ */
+JMapGMLocationQueue *JMapGMLocationQueueCreate(size_t capacity);
+
+/**
+ *  Releases a queue created with JMapGMLocationQueueCreate.
+ */
+void JMapGMLocationQueueRelease(JMapGMLocationQueue *queue);
+
+/**
+ *  Pushes a fix without blocking.
+ *
+ *  @return false if the queue is full and the fix was not stored
+ */
+bool JMapGMLocationQueuePush(JMapGMLocationQueue *queue, const JMapGMLocationFix *fix);
+
+/**
+ *  Pops the oldest fix.
+ *
+ *  @return false if the queue is empty
+ */
+bool JMapGMLocationQueuePop(JMapGMLocationQueue *queue, JMapGMLocationFix *fix);
+
+/**
+ *  Tuning for JMapGMLocationFilter
+ */
+typedef struct {
+    /** Position gain of the alpha-beta filter, 0-1. Lower is smoother. */
+    double alpha;
+    /** Velocity gain of the alpha-beta filter, 0-1. */
+    double beta;
+    /** Smallest movement in map units that is worth publishing */
+    double minDistance;
+    /** Smallest orientation change in degrees that is worth publishing */
+    double minOrientationDelta;
+    /** Fixes further apart than this many seconds restart the filter */
+    double maxGap;
+} JMapGMLocationFilterConfig;
+
+/**
+ *  Default configuration tuned for 10-20 Hz indoor positioning
+ */
+extern const JMapGMLocationFilterConfig JMapGMLocationFilterConfigDefault;
+
+/**
+ *  Alpha-beta (steady-state Kalman) position filter with change detection.
+ *  Not thread safe; owned by the thread that drains the queue.
+ */
+typedef struct {
+    JMapGMLocationFilterConfig config;
+    bool initialized;
+    double x, y, vx, vy;
+    double orientation;
+    double confidence;
+    double timestamp;
+    const void *map;
+    bool hasPublished;
+    JMapGMLocationFix published;
+} JMapGMLocationFilter;
+
+/**
+ *  Resets a filter with the given configuration.
+ */
+void JMapGMLocationFilterInit(JMapGMLocationFilter *filter, const JMapGMLocationFilterConfig *config);
+
+/**
+ *  Feeds a raw fix into the filter. A fix on a different map restarts it.
+ */
+void JMapGMLocationFilterAddFix(JMapGMLocationFilter *filter, const JMapGMLocationFix *fix);
+
+/**
+ *  Produces the smoothed position at a given time if it differs visibly from the last published one.
+ *
+ *  @param now The display time to predict the position for
+ *  @param out Receives the position to display
+ *  @return true if out was filled and should be shown
+ */
+bool JMapGMLocationFilterPublish(JMapGMLocationFilter *filter, double now, JMapGMLocationFix *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* JMapGMLocationFilter_h */
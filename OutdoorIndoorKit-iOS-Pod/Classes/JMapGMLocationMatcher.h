@@ -0,0 +1,123 @@
+//
+//  JMapGMLocationMatcher.h
+//  JMapOutdoorIndoorKit
+//
+//  Copyright © 2026 Jibestream. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import <GoogleMaps/GoogleMaps.h>
+#import <JMapOutdoorIndoorKit/JMapOutdoorIndoorKit.h>
+#import "JMapGMRouteMatcher.h"
+
+/**
+ *  Type definition of the outcome of matching a location.
+ */
+typedef NS_ENUM(NSInteger, JMapGMLocationMatchState) {
+    JMapGMLocationMatchStateSnapped = JMapGMMatchStateSnapped,
+    JMapGMLocationMatchStateUnmatched = JMapGMMatchStateUnmatched,
+    JMapGMLocationMatchStateReroute = JMapGMMatchStateReroute,
+};
+
+/**
+ *  The JMapGMLocationMatch object
+ */
+@interface JMapGMLocationMatch : NSObject
+
+/**
+ *  Whether the location was snapped, left as is, or should trigger a re-route
+ */
+@property (nonatomic, readonly) JMapGMLocationMatchState state;
+/**
+ *  The location to display; the snapped route point when state is snapped
+ */
+@property (nonatomic, readonly) CLLocationCoordinate2D coordinate;
+/**
+ *  Distance in meters between the raw location and the route, negative if the route is out of range
+ */
+@property (nonatomic, readonly) CLLocationDistance distanceFromRoute;
+/**
+ *  Distance in meters along the matched polyline, useful to show route progress
+ */
+@property (nonatomic, readonly) CLLocationDistance distanceAlongPolyline;
+/**
+ *  The polyline the location was matched against, nil if the route is out of range
+ */
+@property (nonatomic, readonly, nullable) GMSPolyline *polyline;
+
+@end
+
+/**
+ *  The JMapGMLocationMatcher object
+ *
+ *  Snaps user locations onto the wayfinding polylines of a route, or onto a
+ *  walkable path network, and decides when the user has left the route for
+ *  long enough to re-route, which a JMapGMRerouter does without a new search.
+ */
+@interface JMapGMLocationMatcher : NSObject
+
+/**
+ *  The polylines being matched against
+ */
+@property (nonatomic, readonly, nonnull) NSArray<GMSPolyline *> *polylines;
+
+/**
+ *  Replay statistics, including how many off route locations did not cause a re-route
+ */
+@property (nonatomic, readonly) JMapGMRouteMatcherStats stats;
+
+/**
+ *  Initializes a matcher with default thresholds of 3m snap, 8m deviation and 3 consecutive deviations.
+ *  Without floor maps, locations can only be matched with matchCoordinate:onPolyline:.
+ *
+ *  @param polylines The GMSPolyline objects returned by a wayfinding call
+ */
+- (nonnull instancetype)initWithPolylines:(nonnull NSArray<GMSPolyline *> *)polylines;
+
+/**
+ *  Initializes a matcher with default thresholds of 3m snap, 8m deviation and 3 consecutive deviations.
+ *
+ *  @param polylines The GMSPolyline objects returned by a wayfinding call
+ *  @param maps The floor map of each polyline, in the same order
+ */
+- (nonnull instancetype)initWithPolylines:(nonnull NSArray<GMSPolyline *> *)polylines maps:(nullable NSArray<JMapMap *> *)maps;
+
+/**
+ *  Initializes a matcher.
+ *
+ *  @param polylines The GMSPolyline objects returned by a wayfinding call, or the walkable path network
+ *  @param maps The floor map of each polyline, in the same order, or nil to match per polyline only
+ *  @param config Thresholds in meters
+ */
+- (nonnull instancetype)initWithPolylines:(nonnull NSArray<GMSPolyline *> *)polylines maps:(nullable NSArray<JMapMap *> *)maps config:(JMapGMRouteMatcherConfig)config;
+
+/**
+ *  Matches a location against the polylines on the user's floor. Polylines of other floors are
+ *  never matched, even where floors overlap. A floor the route does not visit counts as off route.
+ *
+ *  @param coordinate The raw user location
+ *  @param map The floor map the location was reported on, as passed to updateUserLocation:
+ *  @return The match result
+ */
+- (nonnull JMapGMLocationMatch *)matchCoordinate:(CLLocationCoordinate2D)coordinate onMap:(nonnull JMapMap *)map;
+
+/**
+ *  Matches a location against a single polyline, such as the one drawn on the user's floor.
+ *
+ *  @param coordinate The raw user location
+ *  @param polyline One of the polylines the matcher was initialized with
+ *  @return The match result
+ */
+- (nonnull JMapGMLocationMatch *)matchCoordinate:(CLLocationCoordinate2D)coordinate onPolyline:(nonnull GMSPolyline *)polyline;
+
+/**
+ *  The part of the matched polyline still ahead of the user, starting at the matched route point.
+ *  Assigning it to the polyline's path repairs the drawn route when the user rejoins it further
+ *  along, without a new wayfinding call and without redrawing the other polylines.
+ *
+ *  @param match A result returned by this matcher
+ *  @return The remaining path, or nil if the match has no polyline
+ */
+- (nullable GMSPath *)remainingPathForMatch:(nonnull JMapGMLocationMatch *)match;
+
+@end
@@ -0,0 +1,193 @@
+//
+//  JMapGMLocationMatcher.m
+//  JMapOutdoorIndoorKit
+//
+//  Copyright © 2026 Jibestream. All rights reserved.
+//
+
+#import "JMapGMLocationMatcher.h"
+
+static const double JMapGMEarthRadius = 6378137.0;
+
+@interface JMapGMLocationMatch ()
+@property (nonatomic, readwrite) JMapGMLocationMatchState state;
+@property (nonatomic, readwrite) CLLocationCoordinate2D coordinate;
+@property (nonatomic, readwrite) CLLocationDistance distanceFromRoute;
+@property (nonatomic, readwrite) CLLocationDistance distanceAlongPolyline;
+@property (nonatomic, readwrite, nullable) GMSPolyline *polyline;
+@property (nonatomic) CLLocationCoordinate2D routeCoordinate;
+@property (nonatomic) NSUInteger polylineIndex;
+@property (nonatomic) NSUInteger vertex;
+@end
+
+@implementation JMapGMLocationMatch
+@end
+
+@implementation JMapGMLocationMatcher
+{
+    JMapGMSegmentIndex *_index;
+    JMapGMRouteMatcher _matcher;
+    // Paths as indexed, since callers may trim the drawn polylines.
+    NSMutableArray<GMSPath *> *_paths;
+    NSMutableArray<NSNumber *> *_firstSegments;
+    // Polylines are numbered floor by floor, so a floor is one contiguous range of groups.
+    NSMutableArray<NSNumber *> *_groups;
+    NSMutableArray<NSNumber *> *_polylineIndexes;
+    NSMapTable<JMapMap *, NSValue *> *_groupRangesByMap;
+    CLLocationCoordinate2D _origin;
+    double _metersPerDegreeLongitude;
+}
+
+- (instancetype)initWithPolylines:(NSArray<GMSPolyline *> *)polylines
+{
+    return [self initWithPolylines:polylines maps:nil];
+}
+
+- (instancetype)initWithPolylines:(NSArray<GMSPolyline *> *)polylines maps:(NSArray<JMapMap *> *)maps
+{
+    JMapGMRouteMatcherConfig config = { .snapDistance = 3, .rerouteDistance = 8, .rerouteCount = 3 };
+    return [self initWithPolylines:polylines maps:maps config:config];
+}
+
+- (instancetype)initWithPolylines:(NSArray<GMSPolyline *> *)polylines maps:(NSArray<JMapMap *> *)maps config:(JMapGMRouteMatcherConfig)config
+{
+    NSAssert(!maps || maps.count == polylines.count, @"One floor map is needed per polyline");
+    self = [super init];
+    if (self) {
+        _polylines = [polylines copy];
+        _origin = polylines.firstObject.path.count ? [polylines.firstObject.path coordinateAtIndex:0] : kCLLocationCoordinate2DInvalid;
+        _metersPerDegreeLongitude = cos(_origin.latitude * M_PI / 180.0) * JMapGMEarthRadius * M_PI / 180.0;
+
+        // Order polylines floor by floor, floors in the order they first appear.
+        _polylineIndexes = [NSMutableArray arrayWithCapacity:_polylines.count];
+        _groupRangesByMap = [NSMapTable strongToStrongObjectsMapTable];
+        if (maps.count == _polylines.count) {
+            NSMapTable<JMapMap *, NSMutableArray<NSNumber *> *> *polylinesByMap = [NSMapTable strongToStrongObjectsMapTable];
+            NSMutableArray<JMapMap *> *floors = [NSMutableArray array];
+            [maps enumerateObjectsUsingBlock:^(JMapMap *map, NSUInteger idx, BOOL *stop) {
+                NSMutableArray<NSNumber *> *indexes = [polylinesByMap objectForKey:map];
+                if (!indexes) {
+                    indexes = [NSMutableArray array];
+                    [polylinesByMap setObject:indexes forKey:map];
+                    [floors addObject:map];
+                }
+                [indexes addObject:@(idx)];
+            }];
+            for (JMapMap *map in floors) {
+                NSArray<NSNumber *> *indexes = [polylinesByMap objectForKey:map];
+                [_groupRangesByMap setObject:[NSValue valueWithRange:NSMakeRange(_polylineIndexes.count, indexes.count)] forKey:map];
+                [_polylineIndexes addObjectsFromArray:indexes];
+            }
+        } else {
+            for (NSUInteger i = 0; i < _polylines.count; i++) [_polylineIndexes addObject:@(i)];
+        }
+
+        _index = JMapGMSegmentIndexCreate(MAX(config.rerouteDistance, 1));
+        _paths = [NSMutableArray arrayWithCapacity:_polylines.count];
+        _firstSegments = [NSMutableArray arrayWithCapacity:_polylines.count];
+        _groups = [NSMutableArray arrayWithCapacity:_polylines.count];
+        for (NSUInteger i = 0; i < _polylines.count; i++) {
+            [_paths addObject:_polylines[i].path ?: [GMSPath path]];
+            [_firstSegments addObject:@0];
+            [_groups addObject:@0];
+        }
+        [_polylineIndexes enumerateObjectsUsingBlock:^(NSNumber *polylineIndex, NSUInteger group, BOOL *stop) {
+            NSUInteger idx = polylineIndex.unsignedIntegerValue;
+            GMSPath *path = self->_paths[idx];
+            NSUInteger count = path.count;
+            JMapGMPoint *points = malloc(MAX(count, 1) * sizeof(JMapGMPoint));
+            for (NSUInteger i = 0; i < count; i++) {
+                points[i] = [self pointForCoordinate:[path coordinateAtIndex:i]];
+            }
+            self->_firstSegments[idx] = @(JMapGMSegmentIndexGetSegmentCount(self->_index));
+            self->_groups[idx] = @(group);
+            // Single vertex polylines are skipped but keep the group numbering aligned.
+            JMapGMSegmentIndexAddPolyline(self->_index, points, count, (int32_t)group);
+            free(points);
+        }];
+        JMapGMSegmentIndexBuild(_index);
+        JMapGMRouteMatcherInit(&_matcher, _index, config);
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    JMapGMSegmentIndexRelease(_index);
+}
+
+- (JMapGMRouteMatcherStats)stats
+{
+    return _matcher.stats;
+}
+
+- (JMapGMPoint)pointForCoordinate:(CLLocationCoordinate2D)coordinate
+{
+    JMapGMPoint point = {
+        (coordinate.longitude - _origin.longitude) * _metersPerDegreeLongitude,
+        (coordinate.latitude - _origin.latitude) * JMapGMEarthRadius * M_PI / 180.0,
+    };
+    return point;
+}
+
+- (CLLocationCoordinate2D)coordinateForPoint:(JMapGMPoint)point
+{
+    return CLLocationCoordinate2DMake(_origin.latitude + point.y / (JMapGMEarthRadius * M_PI / 180.0),
+                                      _origin.longitude + point.x / _metersPerDegreeLongitude);
+}
+
+- (JMapGMLocationMatch *)matchCoordinate:(CLLocationCoordinate2D)coordinate onMap:(JMapMap *)map
+{
+    // A floor the route does not visit has an empty range and counts as off route.
+    NSRange range = [[_groupRangesByMap objectForKey:map] rangeValue];
+    return [self matchCoordinate:coordinate firstGroup:(int32_t)range.location lastGroup:(int32_t)range.location + (int32_t)range.length - 1];
+}
+
+- (JMapGMLocationMatch *)matchCoordinate:(CLLocationCoordinate2D)coordinate onPolyline:(GMSPolyline *)polyline
+{
+    NSUInteger polylineIndex = [_polylines indexOfObjectIdenticalTo:polyline];
+    if (polylineIndex == NSNotFound) {
+        JMapGMLocationMatch *match = [JMapGMLocationMatch new];
+        match.state = JMapGMLocationMatchStateUnmatched;
+        match.coordinate = coordinate;
+        match.distanceFromRoute = -1;
+        return match;
+    }
+    int32_t polylineGroup = _groups[polylineIndex].intValue;
+    return [self matchCoordinate:coordinate firstGroup:polylineGroup lastGroup:polylineGroup];
+}
+
+- (JMapGMLocationMatch *)matchCoordinate:(CLLocationCoordinate2D)coordinate firstGroup:(int32_t)firstGroup lastGroup:(int32_t)lastGroup
+{
+    JMapGMSnapResult result;
+    result.distance = -1;
+    JMapGMMatchState state = JMapGMRouteMatcherMatchGroups(&_matcher, [self pointForCoordinate:coordinate], firstGroup, lastGroup, &result);
+
+    JMapGMLocationMatch *match = [JMapGMLocationMatch new];
+    match.state = (JMapGMLocationMatchState)state;
+    match.coordinate = state == JMapGMMatchStateSnapped ? [self coordinateForPoint:result.point] : coordinate;
+    match.distanceFromRoute = result.distance;
+    if (result.distance >= 0) {
+        NSUInteger polylineIndex = _polylineIndexes[(NSUInteger)result.group].unsignedIntegerValue;
+        match.distanceAlongPolyline = result.offset;
+        match.polyline = _polylines[polylineIndex];
+        match.routeCoordinate = [self coordinateForPoint:result.point];
+        match.polylineIndex = polylineIndex;
+        match.vertex = result.segment - _firstSegments[polylineIndex].unsignedIntegerValue;
+    }
+    return match;
+}
+
+- (GMSPath *)remainingPathForMatch:(JMapGMLocationMatch *)match
+{
+    if (!match.polyline) return nil;
+    GMSPath *path = _paths[match.polylineIndex];
+    GMSMutablePath *remaining = [GMSMutablePath path];
+    [remaining addCoordinate:match.routeCoordinate];
+    for (NSUInteger i = match.vertex + 1; i < path.count; i++) {
+        [remaining addCoordinate:[path coordinateAtIndex:i]];
+    }
+    return remaining;
+}
+
+@end
@@ -0,0 +1,67 @@
+//
+//  JMapGMLocationPipeline.h
+//  JMapOutdoorIndoorKit
+//
+//  Copyright © 2026 Jibestream. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import <JMapOutdoorIndoorKit/JMapOutdoorIndoorKit.h>
+#import "JMapGMLocationFilter.h"
+
+/**
+ *  The JMapGMLocationPipeline object
+ *
+ *  Collects raw position fixes from any thread, smooths them and forwards
+ *  at most one update per display frame to
+ *  -updateUserLocation:floorMap:orientation:confidenceRadius:, and only when
+ *  the user location would visibly change.
+ */
+@interface JMapGMLocationPipeline : NSObject
+
+/**
+ *  The controller whose userLocation is updated.
+ */
+@property (nonatomic, weak, readonly, nullable) JMapGMController *controller;
+
+/**
+ *  Number of fixes dropped because they arrived faster than the display could drain them.
+ */
+@property (nonatomic, readonly) NSUInteger droppedFixCount;
+
+/**
+ *  Initializes a pipeline for a controller with the default filter configuration.
+ *
+ *  @param controller The JMapGMController that displays the user location
+ */
+- (nonnull instancetype)initWithController:(nonnull JMapGMController *)controller;
+
+/**
+ *  Initializes a pipeline for a controller.
+ *
+ *  @param controller The JMapGMController that displays the user location
+ *  @param config Smoothing and publishing thresholds
+ */
+- (nonnull instancetype)initWithController:(nonnull JMapGMController *)controller filterConfig:(JMapGMLocationFilterConfig)config;
+
+/**
+ *  Adds a raw fix. Safe to call from any thread at any rate.
+ *
+ *  @param position A CGPoint indicating user's location in x,y coordinates
+ *  @param map A JMapMap object that the location is currently on
+ *  @param orientation Degrees relative to the map's true north, or nil
+ *  @param confidence Radius of confidence measured in pixels, or nil
+ */
+- (void)addFixAtPosition:(CGPoint)position floorMap:(nonnull JMapMap *)map orientation:(nullable NSNumber *)orientation confidenceRadius:(nullable NSNumber *)confidence;
+
+/**
+ *  Starts publishing on every display frame.
+ */
+- (void)start;
+
+/**
+ *  Stops publishing. Fixes added while stopped are kept until the queue fills.
+ */
+- (void)stop;
+
+@end
@@ -0,0 +1,123 @@
+//
+//  JMapGMLocationPipeline.m
+//  JMapOutdoorIndoorKit
+//
+//  Copyright © 2026 Jibestream. All rights reserved.
+//
+
+#import "JMapGMLocationPipeline.h"
+#import <QuartzCore/QuartzCore.h>
+#include <stdatomic.h>
+
+static const size_t JMapGMLocationQueueCapacity = 256;
+
+/**
+ *  Forwards display link ticks without retaining the pipeline.
+ */
+@interface JMapGMLocationPipelineTicker : NSObject
+@property (nonatomic, weak) JMapGMLocationPipeline *pipeline;
+@end
+
+@interface JMapGMLocationPipeline ()
+- (void)displayLinkDidFire:(CADisplayLink *)displayLink;
+@end
+
+@implementation JMapGMLocationPipelineTicker
+- (void)tick:(CADisplayLink *)displayLink
+{
+    [self.pipeline displayLinkDidFire:displayLink];
+}
+@end
+
+@implementation JMapGMLocationPipeline
+{
+    JMapGMLocationQueue *_queue;
+    JMapGMLocationFilter _filter;
+    atomic_ulong _dropped;
+    CADisplayLink *_displayLink;
+    JMapMap *_currentMap;
+}
+
+- (instancetype)initWithController:(JMapGMController *)controller
+{
+    return [self initWithController:controller filterConfig:JMapGMLocationFilterConfigDefault];
+}
+
+- (instancetype)initWithController:(JMapGMController *)controller filterConfig:(JMapGMLocationFilterConfig)config
+{
+    self = [super init];
+    if (self) {
+        _controller = controller;
+        _queue = JMapGMLocationQueueCreate(JMapGMLocationQueueCapacity);
+        JMapGMLocationFilterInit(&_filter, &config);
+        atomic_init(&_dropped, 0);
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    [_displayLink invalidate];
+    JMapGMLocationFix fix;
+    while (JMapGMLocationQueuePop(_queue, &fix)) {
+        CFBridgingRelease(fix.map);
+    }
+    JMapGMLocationQueueRelease(_queue);
+}
+
+- (NSUInteger)droppedFixCount
+{
+    return (NSUInteger)atomic_load(&_dropped);
+}
+
+- (void)addFixAtPosition:(CGPoint)position floorMap:(JMapMap *)map orientation:(NSNumber *)orientation confidenceRadius:(NSNumber *)confidence
+{
+    JMapGMLocationFix fix = {
+        .x = position.x,
+        .y = position.y,
+        .orientation = orientation ? orientation.doubleValue : NAN,
+        .confidence = confidence ? confidence.doubleValue : NAN,
+        .timestamp = CACurrentMediaTime(),
+        // The queue owns a reference until the main thread pops the fix.
+        .map = CFBridgingRetain(map),
+    };
+    if (!JMapGMLocationQueuePush(_queue, &fix)) {
+        CFBridgingRelease(fix.map);
+        atomic_fetch_add(&_dropped, 1);
+    }
+}
+
+- (void)start
+{
+    if (_displayLink) return;
+    JMapGMLocationPipelineTicker *ticker = [JMapGMLocationPipelineTicker new];
+    ticker.pipeline = self;
+    _displayLink = [CADisplayLink displayLinkWithTarget:ticker selector:@selector(tick:)];
+    [_displayLink addToRunLoop:[NSRunLoop mainRunLoop] forMode:NSRunLoopCommonModes];
+}
+
+- (void)stop
+{
+    [_displayLink invalidate];
+    _displayLink = nil;
+}
+
+- (void)displayLinkDidFire:(CADisplayLink *)displayLink
+{
+    JMapGMLocationFix fix;
+    while (JMapGMLocationQueuePop(_queue, &fix)) {
+        JMapMap *map = CFBridgingRelease(fix.map);
+        // Keep the map alive while the filter compares against its address.
+        _currentMap = map;
+        JMapGMLocationFilterAddFix(&_filter, &fix);
+    }
+
+    JMapGMLocationFix published;
+    if (!_currentMap || !JMapGMLocationFilterPublish(&_filter, displayLink.targetTimestamp, &published)) return;
+
+    NSNumber *orientation = isnan(published.orientation) ? nil : @(published.orientation);
+    NSNumber *confidence = isnan(published.confidence) ? nil : @(published.confidence);
+    [self.controller updateUserLocation:CGPointMake(published.x, published.y) floorMap:_currentMap orientation:orientation confidenceRadius:confidence];
+}
+
+@end
@@ -0,0 +1,81 @@
+//
+//  JMapGMLocator.h
+//  JMapOutdoorIndoorKit
+//
+//  Copyright © 2026 Jibestream. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import <JMapOutdoorIndoorKit/JMapOutdoorIndoorKit.h>
+
+/**
+ *  The JMapGMLocation object
+ */
+@interface JMapGMLocation : NSObject
+
+/**
+ *  The venue containing the coordinate
+ */
+@property (nonatomic, readonly, nonnull) JMapActiveVenue *activeVenue;
+/**
+ *  The floor map whose footprint contains the coordinate
+ */
+@property (nonatomic, readonly, nonnull) JMapMap *map;
+/**
+ *  The unit containing the coordinate, nil if it is outside every unit of the floor
+ */
+@property (nonatomic, readonly, nullable) JMapGMGeometry *unit;
+
+@end
+
+/**
+ *  The JMapGMLocator object
+ *
+ *  Resolves geo coordinates to the venue, floor map and unit that contain them. Floor footprints
+ *  are indexed in one R-tree across all added venues, and the units of every floor in their own
+ *  R-tree, so a lookup only runs point in polygon tests against a handful of candidates.
+ *
+ *  Add maps, call build once, then query from any thread.
+ */
+@interface JMapGMLocator : NSObject
+
+/**
+ *  Adds a parsed map to the locator. Has no effect after build.
+ *
+ *  @param map The JMapMap to index, already parsed by the controller
+ *  @param controller The JMapGMController of the venue the map belongs to
+ */
+- (void)addMap:(nonnull JMapMap *)map fromController:(nonnull JMapGMController *)controller;
+
+/**
+ *  Builds the indexes. Queries return no results before this is called.
+ */
+- (void)build;
+
+/**
+ *  Locates a coordinate on every floor that covers it, one result per floor.
+ *
+ *  @param coordinate The lat/lng coordinate to locate
+ *  @return The matching locations, empty if no added floor covers the coordinate
+ */
+- (nonnull NSArray<JMapGMLocation *> *)locateCoordinate:(CLLocationCoordinate2D)coordinate;
+
+/**
+ *  Locates a coordinate on one floor.
+ *
+ *  @param coordinate The lat/lng coordinate to locate
+ *  @param map The floor map to search
+ *  @return The location, or nil if the floor does not cover the coordinate
+ */
+- (nullable JMapGMLocation *)locateCoordinate:(CLLocationCoordinate2D)coordinate onMap:(nonnull JMapMap *)map;
+
+/**
+ *  Locates many coordinates at once, spreading the work across cores.
+ *
+ *  @param coordinates The lat/lng coordinates to locate
+ *  @param count The number of coordinates
+ *  @return One array of locations per coordinate, in the same order
+ */
+- (nonnull NSArray<NSArray<JMapGMLocation *> *> *)locateCoordinates:(const CLLocationCoordinate2D * _Nonnull)coordinates count:(NSUInteger)count;
+
+@end
@@ -0,0 +1,202 @@
+//
+//  JMapGMLocator.m
+//  JMapOutdoorIndoorKit
+//
+//  Copyright © 2026 Jibestream. All rights reserved.
+//
+
+#import "JMapGMLocator.h"
+#import "JMapGMGeometry+Packed.h"
+#import "JMapGMSpatialIndex.h"
+#import "JMapGMTrace.h"
+
+// Coordinates per dispatch_apply iteration in batch lookups.
+static const NSUInteger JMapGMLocatorBatchChunk = 256;
+
+@interface JMapGMLocation ()
+- (instancetype)initWithActiveVenue:(JMapActiveVenue *)activeVenue map:(JMapMap *)map unit:(JMapGMGeometry *)unit;
+@end
+
+@implementation JMapGMLocation
+
+- (instancetype)initWithActiveVenue:(JMapActiveVenue *)activeVenue map:(JMapMap *)map unit:(JMapGMGeometry *)unit
+{
+    self = [super init];
+    if (self) {
+        _activeVenue = activeVenue;
+        _map = map;
+        _unit = unit;
+    }
+    return self;
+}
+
+@end
+
+/**
+ *  One indexed floor map and its units.
+ */
+@interface JMapGMLocatorFloor : NSObject
+@property (nonatomic, strong) JMapActiveVenue *activeVenue;
+@property (nonatomic, strong) JMapMap *map;
+@property (nonatomic, copy) NSArray<JMapGMGeometry *> *units;
+@property (nonatomic) JMapGMRect footprint;
+@property (nonatomic) JMapGMRTree *unitTree;
+@end
+
+@implementation JMapGMLocatorFloor
+
+- (void)dealloc
+{
+    JMapGMRTreeRelease(_unitTree);
+}
+
+@end
+
+typedef struct {
+    __unsafe_unretained NSArray<JMapGMGeometry *> *units;
+    JMapGMPoint point;
+    __unsafe_unretained JMapGMGeometry *found;
+} JMapGMUnitSearch;
+
+static bool JMapGMVisitUnit(uint32_t item, void *context)
+{
+    JMapGMUnitSearch *search = context;
+    JMapGMGeometry *unit = search->units[item];
+    JMapGMPolygon polygon = unit.packedPolygon;
+    if (!JMapGMPolygonContainsPoint(&polygon, search->point)) return true;
+    search->found = unit;
+    return false;
+}
+
+typedef struct {
+    __unsafe_unretained NSArray<JMapGMLocatorFloor *> *floors;
+    __unsafe_unretained NSMutableArray<JMapGMLocation *> *results;
+    JMapGMPoint point;
+} JMapGMFloorSearch;
+
+static JMapGMLocation *JMapGMLocateOnFloor(JMapGMLocatorFloor *floor, JMapGMPoint point)
+{
+    if (!JMapGMRectContainsPoint(floor.footprint, point)) return nil;
+    JMapGMUnitSearch search = { floor.units, point, nil };
+    JMapGMRTreeQueryPoint(floor.unitTree, point, JMapGMVisitUnit, &search);
+    return [[JMapGMLocation alloc] initWithActiveVenue:floor.activeVenue map:floor.map unit:search.found];
+}
+
+static bool JMapGMVisitFloor(uint32_t item, void *context)
+{
+    JMapGMFloorSearch *search = context;
+    JMapGMLocation *location = JMapGMLocateOnFloor(search->floors[item], search->point);
+    if (location) [search->results addObject:location];
+    return true;
+}
+
+static JMapGMPoint JMapGMPointFromCoordinate(CLLocationCoordinate2D coordinate)
+{
+    JMapGMPoint point = { coordinate.longitude, coordinate.latitude };
+    return point;
+}
+
+@implementation JMapGMLocator
+{
+    NSMutableArray<JMapGMLocatorFloor *> *_floors;
+    NSMapTable<JMapMap *, JMapGMLocatorFloor *> *_floorsByMap;
+    JMapGMRTree *_floorTree;
+}
+
+- (instancetype)init
+{
+    self = [super init];
+    if (self) {
+        _floors = [NSMutableArray array];
+        _floorsByMap = [NSMapTable strongToStrongObjectsMapTable];
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    JMapGMRTreeRelease(_floorTree);
+}
+
+- (void)addMap:(JMapMap *)map fromController:(JMapGMController *)controller
+{
+    if (_floorTree || [_floorsByMap objectForKey:map]) return;
+    JMAPGM_TRACE_SCOPE("locator.addMap");
+
+    JMapGMRect footprint = JMapGMRectNull;
+    for (JMapGMGeometry *shape in [controller jmapgm_allShapesInMap:map]) {
+        footprint = JMapGMRectUnion(footprint, shape.packedBounds);
+    }
+
+    NSArray<JMapGMGeometry *> *units = [controller getUnitsFromMap:map] ?: @[];
+    JMapGMRect *rects = malloc(MAX(units.count, 1) * sizeof(JMapGMRect));
+    for (NSUInteger i = 0; i < units.count; i++) {
+        rects[i] = units[i].packedBounds;
+        footprint = JMapGMRectUnion(footprint, rects[i]);
+    }
+
+    JMapGMLocatorFloor *floor = [JMapGMLocatorFloor new];
+    floor.activeVenue = controller.activeVenue;
+    floor.map = map;
+    floor.units = units;
+    floor.footprint = footprint;
+    floor.unitTree = JMapGMRTreeCreate(rects, units.count, 0);
+    free(rects);
+
+    [_floors addObject:floor];
+    [_floorsByMap setObject:floor forKey:map];
+}
+
+- (void)build
+{
+    if (_floorTree) return;
+    JMAPGM_TRACE_SCOPE("locator.build");
+    JMapGMRect *rects = malloc(MAX(_floors.count, 1) * sizeof(JMapGMRect));
+    for (NSUInteger i = 0; i < _floors.count; i++) {
+        rects[i] = _floors[i].footprint;
+    }
+    _floorTree = JMapGMRTreeCreate(rects, _floors.count, 0);
+    free(rects);
+}
+
+- (NSArray<JMapGMLocation *> *)locateCoordinate:(CLLocationCoordinate2D)coordinate
+{
+    NSMutableArray<JMapGMLocation *> *results = [NSMutableArray array];
+    if (!_floorTree) return results;
+    JMapGMFloorSearch search = { _floors, results, JMapGMPointFromCoordinate(coordinate) };
+    JMapGMRTreeQueryPoint(_floorTree, search.point, JMapGMVisitFloor, &search);
+    return results;
+}
+
+- (JMapGMLocation *)locateCoordinate:(CLLocationCoordinate2D)coordinate onMap:(JMapMap *)map
+{
+    if (!_floorTree) return nil;
+    JMapGMLocatorFloor *floor = [_floorsByMap objectForKey:map];
+    return floor ? JMapGMLocateOnFloor(floor, JMapGMPointFromCoordinate(coordinate)) : nil;
+}
+
+- (NSArray<NSArray<JMapGMLocation *> *> *)locateCoordinates:(const CLLocationCoordinate2D *)coordinates count:(NSUInteger)count
+{
+    JMAPGM_TRACE_SCOPE("locator.batch");
+    JMAPGM_TRACE_COUNT("locator.batch.coordinates", (int64_t)count);
+    // Each slot holds a retained result so the parallel loop never touches a shared array.
+    void **slots = calloc(MAX(count, 1), sizeof(void *));
+    NSUInteger chunks = (count + JMapGMLocatorBatchChunk - 1) / JMapGMLocatorBatchChunk;
+    dispatch_apply(chunks, DISPATCH_APPLY_AUTO, ^(size_t chunk) {
+        NSUInteger end = MIN((chunk + 1) * JMapGMLocatorBatchChunk, count);
+        for (NSUInteger i = chunk * JMapGMLocatorBatchChunk; i < end; i++) {
+            @autoreleasepool {
+                slots[i] = (void *)CFBridgingRetain([self locateCoordinate:coordinates[i]]);
+            }
+        }
+    });
+
+    NSMutableArray<NSArray<JMapGMLocation *> *> *results = [NSMutableArray arrayWithCapacity:count];
+    for (NSUInteger i = 0; i < count; i++) {
+        [results addObject:CFBridgingRelease(slots[i])];
+    }
+    free(slots);
+    return results;
+}
+
+@end
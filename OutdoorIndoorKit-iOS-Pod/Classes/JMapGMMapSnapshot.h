@@ -0,0 +1,132 @@
+//
+//  JMapGMMapSnapshot.h
+//  JMapOutdoorIndoorKit
+//
+//  Copyright © 2026 Jibestream. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import <JMapOutdoorIndoorKit/JMapOutdoorIndoorKit.h>
+#import "JMapGMPropertyTable.h"
+#import "JMapGMSnapshot.h"
+
+/**
+ *  The JMapGMMapSnapshot object
+ *
+ *  An immutable copy of a map's layers: their names in z order, the shapes of each and the units.
+ *  Safe to read from any thread while the map is updated, since updates build a new snapshot
+ *  instead of changing this one. The shapes themselves are shared with the map and should only be
+ *  read.
+ */
+@interface JMapGMMapSnapshot : NSObject
+
+/**
+ *  The version the snapshot was published as, counting from 1, or 0 if it is not published
+ */
+@property (nonatomic, readonly) uint64_t version;
+/**
+ *  Layer names sorted by z index
+ */
+@property (nonatomic, readonly, nonnull) NSArray<NSString *> *sortedLayerNames;
+/**
+ *  The shapes of each layer by layer name
+ */
+@property (nonatomic, readonly, nonnull) NSDictionary<NSString *, NSArray<JMapGMGeometry *> *> *layers;
+/**
+ *  The unit shapes
+ */
+@property (nonatomic, readonly, nonnull) NSArray<JMapGMGeometry *> *units;
+/**
+ *  The property table of every shape, rows ordered by layer. Built on first use; nil if allocation failed.
+ */
+@property (nonatomic, readonly, nullable) JMapGMPropertyTable *propertyTable;
+
+/**
+ *  Build a snapshot. The collections are copied.
+ *
+ *  @param sortedLayerNames Layer names sorted by z index
+ *  @param layers The shapes of each layer by layer name
+ *  @param units The unit shapes
+ */
+- (nonnull instancetype)initWithSortedLayerNames:(nonnull NSArray<NSString *> *)sortedLayerNames
+                                          layers:(nonnull NSDictionary<NSString *, NSArray<JMapGMGeometry *> *> *)layers
+                                           units:(nonnull NSArray<JMapGMGeometry *> *)units;
+
+/**
+ *  The shapes of a layer
+ *
+ *  @param layerName The layer name
+ *  @return The shapes, empty if there is no such layer
+ */
+- (nonnull NSArray<JMapGMGeometry *> *)shapesInLayerWithName:(nonnull NSString *)layerName;
+
+/**
+ *  A new unpublished snapshot with the shapes of one layer replaced, sharing everything else
+ *
+ *  @param layerName The layer, added on top if the snapshot does not have it
+ *  @param shapes The new shapes of the layer
+ *  @return The new snapshot
+ */
+- (nonnull JMapGMMapSnapshot *)snapshotByReplacingShapesInLayer:(nonnull NSString *)layerName withShapes:(nonnull NSArray<JMapGMGeometry *> *)shapes;
+
+@end
+
+/**
+ *  The JMapGMMapSnapshotStore object
+ *
+ *  Publishes the snapshots of one map. Any thread can read the current snapshot without locks,
+ *  including while another thread publishes; a reader keeps the snapshot it got for as long as it
+ *  holds it. Publishing swaps the snapshot atomically, so a reader sees either the old or the new
+ *  layers in full.
+ */
+@interface JMapGMMapSnapshotStore : NSObject
+
+/**
+ *  The latest published snapshot, nil before the first. Lock free; safe from any thread.
+ */
+@property (nonatomic, readonly, nullable) JMapGMMapSnapshot *currentSnapshot;
+/**
+ *  The version of the latest published snapshot, 0 before the first
+ */
+@property (nonatomic, readonly) uint64_t version;
+
+/**
+ *  Publishes a snapshot. Safe from any thread; publishes are serialized.
+ *
+ *  @param snapshot A snapshot not published before
+ *  @return The version of the snapshot, or JMAPGM_SNAPSHOT_NONE if it was published before
+ */
+- (uint64_t)publishSnapshot:(nonnull JMapGMMapSnapshot *)snapshot;
+
+/**
+ *  Derives a snapshot from the current one and publishes it, with no publish in between, so
+ *  concurrent updates are applied one after another rather than lost.
+ *
+ *  @param update Returns the new snapshot from the current one, or nil to publish nothing
+ *  @return The published snapshot, or nil
+ */
+- (nullable JMapGMMapSnapshot *)updateSnapshotWithBlock:(nonnull JMapGMMapSnapshot * _Nullable (^)(JMapGMMapSnapshot * _Nullable current))update;
+
+@end
+
+@interface JMapGMController (Snapshots)
+
+/**
+ *  The snapshot store of a map, created once and cached on the map. The store can be handed to
+ *  background threads. Must be called on the main thread.
+ *
+ *  @param map A map parsed by the controller
+ *  @return The store
+ */
+- (nonnull JMapGMMapSnapshotStore *)snapshotStoreOfMap:(nonnull JMapMap *)map;
+
+/**
+ *  Copies the map's layers into a new snapshot and publishes it, e.g. after adding shapes to the
+ *  map. Must be called on the main thread, where the map's layers are modified.
+ *
+ *  @param map A map parsed by the controller
+ *  @return The published snapshot
+ */
+- (nonnull JMapGMMapSnapshot *)publishSnapshotOfMap:(nonnull JMapMap *)map;
+
+@end
@@ -0,0 +1,173 @@
+//
+//  JMapGMMapSnapshot.m
+//  JMapOutdoorIndoorKit
+//
+//  Copyright © 2026 Jibestream. All rights reserved.
+//
+
+#import "JMapGMMapSnapshot.h"
+#import "JMapGMTrace.h"
+#import <objc/runtime.h>
+#import <sched.h>
+
+static const void *JMapGMMapSnapshotStoreKey = &JMapGMMapSnapshotStoreKey;
+
+// The store holds one reference to each published snapshot until no reader can hold it.
+static void JMapGMMapSnapshotFree(void *snapshot)
+{
+    CFRelease(snapshot);
+}
+
+@interface JMapGMMapSnapshot ()
+@property (nonatomic, readwrite) uint64_t version;
+@end
+
+@implementation JMapGMMapSnapshot
+{
+    JMapGMPropertyTable *_propertyTable;
+}
+
+- (instancetype)initWithSortedLayerNames:(NSArray<NSString *> *)sortedLayerNames
+                                  layers:(NSDictionary<NSString *, NSArray<JMapGMGeometry *> *> *)layers
+                                   units:(NSArray<JMapGMGeometry *> *)units
+{
+    self = [super init];
+    if (self) {
+        _sortedLayerNames = [sortedLayerNames copy];
+        // Copying the dictionary alone would share mutable shape arrays with the map.
+        NSMutableDictionary *copied = [NSMutableDictionary dictionaryWithCapacity:layers.count];
+        [layers enumerateKeysAndObjectsUsingBlock:^(NSString *layerName, NSArray<JMapGMGeometry *> *shapes, BOOL *stop) {
+            copied[layerName] = [shapes copy];
+        }];
+        _layers = [copied copy];
+        _units = [units copy];
+    }
+    return self;
+}
+
+- (NSArray<JMapGMGeometry *> *)shapesInLayerWithName:(NSString *)layerName
+{
+    return _layers[layerName] ?: @[];
+}
+
+- (JMapGMPropertyTable *)propertyTable
+{
+    @synchronized (self) {
+        if (!_propertyTable) {
+            NSMutableArray<JMapGMGeometry *> *shapes = [NSMutableArray array];
+            NSMutableArray<NSString *> *layerNames = [NSMutableArray array];
+            for (NSString *layerName in _sortedLayerNames) {
+                for (id shape in _layers[layerName]) {
+                    if (![shape isKindOfClass:[JMapGMGeometry class]]) continue;
+                    [shapes addObject:shape];
+                    [layerNames addObject:layerName];
+                }
+            }
+            _propertyTable = [[JMapGMPropertyTable alloc] initWithShapes:shapes layerNames:layerNames];
+        }
+        return _propertyTable;
+    }
+}
+
+- (JMapGMMapSnapshot *)snapshotByReplacingShapesInLayer:(NSString *)layerName withShapes:(NSArray<JMapGMGeometry *> *)shapes
+{
+    NSMutableDictionary *layers = [_layers mutableCopy];
+    layers[layerName] = shapes;
+    NSArray *sortedLayerNames = _layers[layerName] ? _sortedLayerNames : [_sortedLayerNames arrayByAddingObject:layerName];
+    return [[JMapGMMapSnapshot alloc] initWithSortedLayerNames:sortedLayerNames layers:layers units:_units];
+}
+
+@end
+
+@implementation JMapGMMapSnapshotStore
+{
+    JMapGMSnapshotStore *_store;
+}
+
+- (instancetype)init
+{
+    self = [super init];
+    if (self) {
+        _store = JMapGMSnapshotStoreCreate(JMapGMMapSnapshotFree);
+        if (!_store) return nil;
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    JMapGMSnapshotStoreRelease(_store);
+}
+
+- (JMapGMMapSnapshot *)currentSnapshot
+{
+    int reader;
+    // Slots only run out with more concurrent reads than JMAPGM_SNAPSHOT_READERS, each a few loads long.
+    while ((reader = JMapGMSnapshotStoreAddReader(_store)) == JMAPGM_SNAPSHOT_NO_READER) sched_yield();
+    // The strong local retains the snapshot before the read ends, so it outlives any later publish.
+    JMapGMMapSnapshot *snapshot = (__bridge JMapGMMapSnapshot *)JMapGMSnapshotStoreBeginRead(_store, reader, NULL);
+    JMapGMSnapshotStoreEndRead(_store, reader);
+    JMapGMSnapshotStoreRemoveReader(_store, reader);
+    return snapshot;
+}
+
+- (uint64_t)version
+{
+    return JMapGMSnapshotStoreGetStats(_store).version;
+}
+
+- (uint64_t)publishSnapshot:(JMapGMMapSnapshot *)snapshot
+{
+    @synchronized (self) {
+        @synchronized (snapshot) {
+            if (snapshot.version != JMAPGM_SNAPSHOT_NONE) return JMAPGM_SNAPSHOT_NONE;
+            // Set before the swap publishes it, and never changed afterwards.
+            snapshot.version = JMapGMSnapshotStoreGetStats(_store).version + 1;
+        }
+        uint64_t version = JMapGMSnapshotStorePublish(_store, (__bridge_retained void *)snapshot);
+        if (version == JMAPGM_SNAPSHOT_NONE) {
+            CFRelease((__bridge CFTypeRef)snapshot);
+            snapshot.version = JMAPGM_SNAPSHOT_NONE;
+        }
+        return version;
+    }
+}
+
+- (JMapGMMapSnapshot *)updateSnapshotWithBlock:(JMapGMMapSnapshot *(^)(JMapGMMapSnapshot *current))update
+{
+    @synchronized (self) {
+        JMapGMMapSnapshot *snapshot = update(self.currentSnapshot);
+        if (!snapshot || [self publishSnapshot:snapshot] == JMAPGM_SNAPSHOT_NONE) return nil;
+        return snapshot;
+    }
+}
+
+@end
+
+@implementation JMapGMController (Snapshots)
+
+- (JMapGMMapSnapshotStore *)snapshotStoreOfMap:(JMapMap *)map
+{
+    JMapGMMapSnapshotStore *store = objc_getAssociatedObject(map, JMapGMMapSnapshotStoreKey);
+    if (!store) {
+        store = [[JMapGMMapSnapshotStore alloc] init];
+        objc_setAssociatedObject(map, JMapGMMapSnapshotStoreKey, store, OBJC_ASSOCIATION_RETAIN);
+    }
+    return store;
+}
+
+- (JMapGMMapSnapshot *)publishSnapshotOfMap:(JMapMap *)map
+{
+    JMAPGM_TRACE_SCOPE("snapshot.copy");
+    NSArray<NSString *> *layerNames = [self getAllLayerNamesInMap:map];
+    NSMutableDictionary<NSString *, NSArray<JMapGMGeometry *> *> *layers = [NSMutableDictionary dictionaryWithCapacity:layerNames.count];
+    for (NSString *layerName in layerNames) {
+        layers[layerName] = [self getShapesInLayerWithName:layerName fromMap:map] ?: @[];
+    }
+    NSArray<JMapGMGeometry *> *units = [self getUnitsFromMap:map] ?: @[];
+    JMapGMMapSnapshot *snapshot = [[JMapGMMapSnapshot alloc] initWithSortedLayerNames:layerNames layers:layers units:units];
+    [[self snapshotStoreOfMap:map] publishSnapshot:snapshot];
+    return snapshot;
+}
+
+@end
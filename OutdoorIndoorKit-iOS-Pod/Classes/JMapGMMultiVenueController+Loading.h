@@ -0,0 +1,33 @@
+//
+//  JMapGMMultiVenueController+Loading.h
+//  JMapOutdoorIndoorKit
+//
+//  Copyright © 2026 Jibestream. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import <JMapOutdoorIndoorKit/JMapOutdoorIndoorKit.h>
+
+/**
+ *  Type definition of the per-venue progress callback.
+ *
+ *  @param activeVenue The JMapActiveVenue whose default map finished showing
+ *  @param error The JMapError returned for this venue, nil on success
+ *  @param completedCount Number of venues finished so far, including this one
+ *  @param totalCount Number of venues requested
+ */
+typedef void(^_Nullable JMapGMVenueProgress)(JMapActiveVenue * _Nonnull activeVenue, JMapError * _Nullable error, NSUInteger completedCount, NSUInteger totalCount);
+
+@interface JMapGMMultiVenueController (Loading)
+
+/**
+ *  Displays default map for each activeVenue, starting every venue at once and reporting each one
+ *  as soon as it is ready.
+ *
+ *  @param activeVenues array of activevenues to show on the map
+ *  @param progress Called on the main queue after each venue finishes showing its default map
+ *  @param completion The completion handler for the API call, called on the main queue. Returns the first JMapError if any of the venues failed to show default map
+ */
+- (void)showDefaultMapsForVenues:(nonnull NSArray<JMapActiveVenue *> *)activeVenues progress:(JMapGMVenueProgress)progress completionHandler:(ErrorCompletion)completion;
+
+@end
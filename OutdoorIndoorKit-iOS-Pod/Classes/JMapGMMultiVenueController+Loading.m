@@ -0,0 +1,42 @@
+//
+//  JMapGMMultiVenueController+Loading.m
+//  JMapOutdoorIndoorKit
+//
+//  Copyright © 2026 Jibestream. All rights reserved.
+//
+
+#import "JMapGMMultiVenueController+Loading.h"
+
+@implementation JMapGMMultiVenueController (Loading)
+
+- (void)showDefaultMapsForVenues:(NSArray<JMapActiveVenue *> *)activeVenues progress:(JMapGMVenueProgress)progress completionHandler:(ErrorCompletion)completion
+{
+    NSArray<JMapActiveVenue *> *venues = [activeVenues copy];
+    if (venues.count == 0) {
+        dispatch_async(dispatch_get_main_queue(), ^{
+            if (completion) completion(nil);
+        });
+        return;
+    }
+
+    // Only touched on the main queue.
+    __block NSUInteger completed = 0;
+    __block JMapError *firstError = nil;
+
+    // Each venue has its own JMapGMController, so every venue starts at once and
+    // none waits on another's overlays; each is reported as soon as it is ready.
+    for (JMapActiveVenue *venue in venues) {
+        JMapGMController *controller = [self getGMControllerByActiveVenue:venue];
+        [controller showDefaultMapWithCompletionHandler:^(JMapError * _Nullable error) {
+            // The framework does not say which thread calls back.
+            dispatch_async(dispatch_get_main_queue(), ^{
+                completed++;
+                if (error && !firstError) firstError = error;
+                if (progress) progress(venue, error, completed, venues.count);
+                if (completed == venues.count && completion) completion(firstError);
+            });
+        }];
+    }
+}
+
+@end
@@ -0,0 +1,148 @@
+//
+//  JMapGMOverlayPreparer.h
+//  JMapOutdoorIndoorKit
+//
+//  Copyright © 2026 Jibestream. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import <JMapOutdoorIndoorKit/JMapOutdoorIndoorKit.h>
+
+/**
+ *  The JMapGMOverlayStyle object
+ *
+ *  Immutable appearance of a prepared overlay, safe to create on any thread.
+ */
+@interface JMapGMOverlayStyle : NSObject
+
+/**
+ *  Fill of polygons, nil for none
+ */
+@property (nonatomic, readonly, nullable) UIColor *fillColor;
+/**
+ *  Stroke of polygon outlines and polylines, nil for none
+ */
+@property (nonatomic, readonly, nullable) UIColor *strokeColor;
+/**
+ *  Stroke width in points
+ */
+@property (nonatomic, readonly) CGFloat strokeWidth;
+/**
+ *  Overlay z index
+ */
+@property (nonatomic, readonly) int zIndex;
+
+/**
+ *  Initialize a style
+ *
+ *  @param fillColor Fill of polygons, nil for none
+ *  @param strokeColor Stroke colour, nil for none
+ *  @param strokeWidth Stroke width in points
+ *  @param zIndex Overlay z index
+ */
+- (nonnull instancetype)initWithFillColor:(nullable UIColor *)fillColor strokeColor:(nullable UIColor *)strokeColor strokeWidth:(CGFloat)strokeWidth zIndex:(int)zIndex;
+
+@end
+
+/**
+ *  The JMapGMPreparedOverlay object
+ *
+ *  One render-ready polygon or polyline: projected, simplified paths and a resolved style.
+ *  Only creating the GMSOverlay remains, which must happen on the main thread.
+ */
+@interface JMapGMPreparedOverlay : NSObject
+
+/**
+ *  The geometry the overlay was prepared from. A multi-part geometry yields one prepared overlay per part.
+ */
+@property (nonatomic, readonly, nonnull) JMapGMGeometry *geometry;
+/**
+ *  The outline of a polygon, or the line of a polyline
+ */
+@property (nonatomic, readonly, nonnull) GMSPath *path;
+/**
+ *  Holes of a polygon, empty for polylines
+ */
+@property (nonatomic, readonly, nonnull) NSArray<GMSPath *> *holes;
+/**
+ *  YES for a polygon, NO for a polyline
+ */
+@property (nonatomic, readonly) BOOL isPolygon;
+/**
+ *  The resolved style
+ */
+@property (nonatomic, readonly, nonnull) JMapGMOverlayStyle *style;
+
+/**
+ *  Create the overlay. Main thread only. The overlay is not added to a map.
+ *
+ *  @return A GMSPolygon or GMSPolyline
+ */
+- (nonnull GMSOverlay *)makeOverlay;
+
+@end
+
+/**
+ *  Resolves the style of a geometry. Called on background queues, so it must be thread safe.
+ *
+ *  @param geometry The geometry being prepared
+ *  @return The style, or nil to skip the geometry
+ */
+typedef JMapGMOverlayStyle *_Nullable (^JMapGMOverlayStyleResolver)(JMapGMGeometry *_Nonnull geometry);
+
+/**
+ *  The JMapGMOverlayPreparer object
+ *
+ *  Moves overlay construction off the main thread. prepareGeometries:completion: converts coordinates,
+ *  simplifies them, builds paths and resolves styles concurrently on background queues.
+ *  attachOverlays:toMapView:completion: then creates and adds the overlays on the main thread
+ *  a few at a time, at most frameBudget per display frame, so large floors do not drop frames.
+ */
+@interface JMapGMOverlayPreparer : NSObject
+
+/**
+ *  Vertices closer than this many metres to the simplified outline are dropped, 0 to keep every vertex.
+ *  Defaults to 0.1.
+ */
+@property (nonatomic) double simplificationTolerance;
+/**
+ *  Main thread time spent attaching overlays per display frame, in seconds. At least one overlay is
+ *  attached per frame. Defaults to 4 ms.
+ */
+@property (nonatomic) CFTimeInterval frameBudget;
+/**
+ *  Whether an attach is in progress
+ */
+@property (nonatomic, readonly) BOOL isAttaching;
+
+/**
+ *  Initialize a preparer
+ *
+ *  @param styleResolver Resolves the style of each geometry on a background queue
+ */
+- (nonnull instancetype)initWithStyleResolver:(nonnull JMapGMOverlayStyleResolver)styleResolver;
+
+/**
+ *  Prepare overlays on background queues. Points and geometries without a style are skipped.
+ *
+ *  @param geometries The geometries to prepare
+ *  @param completion Called on the main queue with the prepared overlays, in geometry order
+ */
+- (void)prepareGeometries:(nonnull NSArray<JMapGMGeometry *> *)geometries completion:(nonnull void (^)(NSArray<JMapGMPreparedOverlay *> *_Nonnull overlays))completion;
+
+/**
+ *  Create prepared overlays and add them to a map view in time-sliced chunks. Must be called on the main thread.
+ *  Starting a new attach cancels the one in progress.
+ *
+ *  @param overlays The prepared overlays
+ *  @param mapView The map view to add them to
+ *  @param completion Called on the main thread with the created overlays once all are attached, or nil
+ */
+- (void)attachOverlays:(nonnull NSArray<JMapGMPreparedOverlay *> *)overlays toMapView:(nonnull GMSMapView *)mapView completion:(nullable void (^)(NSArray<GMSOverlay *> *_Nonnull attached))completion;
+
+/**
+ *  Stop the attach in progress. Overlays already attached stay on the map, and the completion is not called.
+ */
+- (void)cancelAttach;
+
+@end
@@ -0,0 +1,285 @@
+//
+//  JMapGMOverlayPreparer.m
+//  JMapOutdoorIndoorKit
+//
+//  Copyright © 2026 Jibestream. All rights reserved.
+//
+
+#import "JMapGMOverlayPreparer.h"
+#import "JMapGMGeometry+Packed.h"
+#import "JMapGMSimplify.h"
+#import "JMapGMTrace.h"
+#import <QuartzCore/QuartzCore.h>
+
+static const double JMapGMMetresPerDegree = 111320.0;
+
+@implementation JMapGMOverlayStyle
+
+- (instancetype)initWithFillColor:(UIColor *)fillColor strokeColor:(UIColor *)strokeColor strokeWidth:(CGFloat)strokeWidth zIndex:(int)zIndex
+{
+    self = [super init];
+    if (self) {
+        _fillColor = fillColor;
+        _strokeColor = strokeColor;
+        _strokeWidth = strokeWidth;
+        _zIndex = zIndex;
+    }
+    return self;
+}
+
+@end
+
+@implementation JMapGMPreparedOverlay
+
+- (instancetype)initWithGeometry:(JMapGMGeometry *)geometry path:(GMSPath *)path holes:(NSArray<GMSPath *> *)holes isPolygon:(BOOL)isPolygon style:(JMapGMOverlayStyle *)style
+{
+    self = [super init];
+    if (self) {
+        _geometry = geometry;
+        _path = path;
+        _holes = holes;
+        _isPolygon = isPolygon;
+        _style = style;
+    }
+    return self;
+}
+
+- (GMSOverlay *)makeOverlay
+{
+    if (_isPolygon) {
+        GMSPolygon *polygon = [GMSPolygon polygonWithPath:_path];
+        polygon.holes = _holes;
+        polygon.fillColor = _style.fillColor;
+        polygon.strokeColor = _style.strokeColor;
+        polygon.strokeWidth = _style.strokeWidth;
+        polygon.zIndex = _style.zIndex;
+        return polygon;
+    }
+    GMSPolyline *polyline = [GMSPolyline polylineWithPath:_path];
+    polyline.strokeColor = _style.strokeColor ?: [UIColor clearColor];
+    polyline.strokeWidth = _style.strokeWidth;
+    polyline.zIndex = _style.zIndex;
+    return polyline;
+}
+
+@end
+
+#pragma mark - Preparation
+
+/**
+ *  Per-thread state of one preparation pass.
+ */
+typedef struct {
+    __unsafe_unretained JMapGMOverlayStyleResolver resolver;
+    double tolerance;
+    __unsafe_unretained NSMutableData *scratch;
+} JMapGMPrepareContext;
+
+static GMSPath *JMapGMMakePath(const JMapGMPolygon *polygon, size_t ring, BOOL closed, double xScale, JMapGMPrepareContext *context)
+{
+    const JMapGMPoint *points = polygon->points + polygon->ringStarts[ring];
+    size_t count = polygon->ringStarts[ring + 1] - polygon->ringStarts[ring];
+    if (context->tolerance > 0 && count > 3) {
+        if (context->scratch.length < count * sizeof(JMapGMPoint)) context->scratch.length = count * sizeof(JMapGMPoint);
+        JMapGMPoint *simplified = context->scratch.mutableBytes;
+        size_t kept = JMapGMSimplify(points, count, closed, context->tolerance, xScale, simplified);
+        if (kept > 0) {
+            points = simplified;
+            count = kept;
+        }
+    }
+    GMSMutablePath *path = [GMSMutablePath path];
+    for (size_t i = 0; i < count; i++) {
+        [path addCoordinate:CLLocationCoordinate2DMake(points[i].y, points[i].x)];
+    }
+    return [path copy];
+}
+
+static void JMapGMPrepareGeometry(JMapGMGeometry *geometry, JMapGMPrepareContext *context, NSMutableArray<JMapGMPreparedOverlay *> *overlays)
+{
+    NSString *type = geometry.type;
+    BOOL isPolygon = [type isEqualToString:@"Polygon"] || [type isEqualToString:@"MultiPolygon"];
+    BOOL isLine = [type isEqualToString:@"LineString"] || [type isEqualToString:@"MultiLineString"];
+    if (!isPolygon && !isLine) return;
+
+    JMapGMPolygon polygon = geometry.packedPolygon;
+    if (polygon.ringCount == 0) return;
+    JMapGMOverlayStyle *style = context->resolver(geometry);
+    if (!style) return;
+
+    JMapGMRect bounds = geometry.packedBounds;
+    double xScale = cos((bounds.minY + bounds.maxY) * 0.5 * M_PI / 180.0);
+
+    [geometry enumeratePackedPartsUsingBlock:^(size_t ring, size_t rings, BOOL *stop) {
+        GMSPath *path = JMapGMMakePath(&polygon, ring, isPolygon, xScale, context);
+        NSMutableArray<GMSPath *> *holes = [NSMutableArray arrayWithCapacity:rings - 1];
+        for (size_t hole = ring + 1; hole < ring + rings; hole++) {
+            [holes addObject:JMapGMMakePath(&polygon, hole, YES, xScale, context)];
+        }
+        if (path.count < (isPolygon ? 3 : 2)) return;
+        [overlays addObject:[[JMapGMPreparedOverlay alloc] initWithGeometry:geometry path:path holes:holes isPolygon:isPolygon style:style]];
+    }];
+}
+
+#pragma mark - Attach
+
+/**
+ *  Attaches prepared overlays a frame's budget at a time from a display link.
+ */
+@interface JMapGMOverlayAttachJob : NSObject
+@property (nonatomic, copy) void (^completion)(NSArray<GMSOverlay *> *attached);
+- (instancetype)initWithOverlays:(NSArray<JMapGMPreparedOverlay *> *)overlays mapView:(GMSMapView *)mapView budget:(CFTimeInterval)budget;
+- (void)start;
+- (void)invalidate;
+@end
+
+@implementation JMapGMOverlayAttachJob
+{
+    NSArray<JMapGMPreparedOverlay *> *_overlays;
+    __weak GMSMapView *_mapView;
+    CFTimeInterval _budget;
+    NSUInteger _next;
+    NSMutableArray<GMSOverlay *> *_attached;
+    CADisplayLink *_displayLink;
+}
+
+- (instancetype)initWithOverlays:(NSArray<JMapGMPreparedOverlay *> *)overlays mapView:(GMSMapView *)mapView budget:(CFTimeInterval)budget
+{
+    self = [super init];
+    if (self) {
+        _overlays = [overlays copy];
+        _mapView = mapView;
+        _budget = budget;
+        _attached = [NSMutableArray arrayWithCapacity:overlays.count];
+    }
+    return self;
+}
+
+- (void)start
+{
+    // Attach the first chunk right away; the display link retains the job until it is invalidated.
+    [self attachChunk];
+    if (!_completion) return;
+    _displayLink = [CADisplayLink displayLinkWithTarget:self selector:@selector(attachChunk)];
+    [_displayLink addToRunLoop:[NSRunLoop mainRunLoop] forMode:NSRunLoopCommonModes];
+}
+
+- (void)attachChunk
+{
+    GMSMapView *mapView = _mapView;
+    if (!mapView) {
+        [self invalidate];
+        return;
+    }
+    JMAPGM_TRACE_SCOPE("overlay.attach");
+    CFTimeInterval start = CACurrentMediaTime();
+    NSUInteger first = _next;
+    while (_next < _overlays.count) {
+        GMSOverlay *overlay = [_overlays[_next++] makeOverlay];
+        overlay.map = mapView;
+        [_attached addObject:overlay];
+        if (CACurrentMediaTime() - start >= _budget) break;
+    }
+    JMAPGM_TRACE_COUNT("overlay.attached", (int64_t)(_next - first));
+    if (_next < _overlays.count) return;
+
+    void (^completion)(NSArray<GMSOverlay *> *) = _completion;
+    NSArray<GMSOverlay *> *attached = [_attached copy];
+    [self invalidate];
+    if (completion) completion(attached);
+}
+
+- (void)invalidate
+{
+    [_displayLink invalidate];
+    _displayLink = nil;
+    _completion = nil;
+}
+
+@end
+
+@implementation JMapGMOverlayPreparer
+{
+    JMapGMOverlayStyleResolver _styleResolver;
+    JMapGMOverlayAttachJob *_attachJob;
+}
+
+- (instancetype)initWithStyleResolver:(JMapGMOverlayStyleResolver)styleResolver
+{
+    self = [super init];
+    if (self) {
+        _styleResolver = [styleResolver copy];
+        _simplificationTolerance = 0.1;
+        _frameBudget = 0.004;
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    [_attachJob invalidate];
+}
+
+- (void)prepareGeometries:(NSArray<JMapGMGeometry *> *)geometries completion:(void (^)(NSArray<JMapGMPreparedOverlay *> *))completion
+{
+    NSArray<JMapGMGeometry *> *input = [geometries copy];
+    JMapGMOverlayStyleResolver resolver = _styleResolver;
+    double tolerance = MAX(_simplificationTolerance, 0) / JMapGMMetresPerDegree;
+
+    dispatch_async(dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^{
+        JMAPGM_TRACE_SCOPE("overlay.prepare");
+        NSUInteger count = input.count;
+        // Stripes keep each worker on its own output array, concatenated in order afterwards.
+        NSUInteger stripes = MIN(count, [NSProcessInfo processInfo].activeProcessorCount * 4);
+        NSMutableArray<NSMutableArray<JMapGMPreparedOverlay *> *> *results = [NSMutableArray arrayWithCapacity:stripes];
+        for (NSUInteger s = 0; s < stripes; s++) [results addObject:[NSMutableArray array]];
+
+        dispatch_apply(stripes, DISPATCH_APPLY_AUTO, ^(size_t s) {
+            NSMutableData *scratch = [NSMutableData data];
+            JMapGMPrepareContext context = { resolver, tolerance, scratch };
+            NSMutableArray<JMapGMPreparedOverlay *> *overlays = results[s];
+            for (NSUInteger i = count * s / stripes; i < count * (s + 1) / stripes; i++) {
+                @autoreleasepool {
+                    JMapGMPrepareGeometry(input[i], &context, overlays);
+                }
+            }
+        });
+
+        NSMutableArray<JMapGMPreparedOverlay *> *overlays = [NSMutableArray array];
+        for (NSArray *stripe in results) [overlays addObjectsFromArray:stripe];
+        JMAPGM_TRACE_COUNT("overlay.prepared", (int64_t)overlays.count);
+        dispatch_async(dispatch_get_main_queue(), ^{
+            completion(overlays);
+        });
+    });
+}
+
+- (BOOL)isAttaching
+{
+    return _attachJob.completion != nil;
+}
+
+- (void)attachOverlays:(NSArray<JMapGMPreparedOverlay *> *)overlays toMapView:(GMSMapView *)mapView completion:(void (^)(NSArray<GMSOverlay *> *))completion
+{
+    NSAssert([NSThread isMainThread], @"Overlays must be attached on the main thread");
+    [self cancelAttach];
+
+    JMapGMOverlayAttachJob *job = [[JMapGMOverlayAttachJob alloc] initWithOverlays:overlays mapView:mapView budget:_frameBudget];
+    __weak JMapGMOverlayPreparer *weakSelf = self;
+    __weak JMapGMOverlayAttachJob *weakJob = job;
+    job.completion = ^(NSArray<GMSOverlay *> *attached) {
+        JMapGMOverlayPreparer *preparer = weakSelf;
+        if (preparer && preparer->_attachJob == weakJob) preparer->_attachJob = nil;
+        if (completion) completion(attached);
+    };
+    _attachJob = job;
+    [job start];
+}
+
+- (void)cancelAttach
+{
+    [_attachJob invalidate];
+    _attachJob = nil;
+}
+
+@end
@@ -0,0 +1,353 @@
+//
+//  JMapGMPolygon.c
+//  JMapOutdoorIndoorKit
+//
+//  Copyright © 2026 Jibestream. All rights reserved.
+//
+
+#include "JMapGMPolygon.h"
+
+#include <stdlib.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define JMAPGM_SIMD_AVX2 1
+#endif
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define JMAPGM_SIMD_SSE2 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define JMAPGM_SIMD_NEON 1
+#endif
+
+#pragma mark - Bounds
+
+// Both kernels reduce pairs of doubles: (x, y) of a point, or (minX, minY) and (maxX, maxY) of a rect.
+// Pairs that are not numbers are skipped, like the comparisons of the scalar fallback.
+
+JMapGMRect JMapGMPointsGetBounds(const JMapGMPoint *points, size_t count)
+{
+    JMapGMRect rect = JMapGMRectNull;
+    size_t i = 0;
+#if JMAPGM_SIMD_SSE2
+    __m128d lo0 = _mm_set1_pd(INFINITY), lo1 = lo0;
+    __m128d hi0 = _mm_set1_pd(-INFINITY), hi1 = hi0;
+    // Two accumulators hide the latency of min/max.
+    for (; i + 2 <= count; i += 2) {
+        __m128d a = _mm_loadu_pd(&points[i].x), b = _mm_loadu_pd(&points[i + 1].x);
+        lo0 = _mm_min_pd(a, lo0); hi0 = _mm_max_pd(a, hi0);
+        lo1 = _mm_min_pd(b, lo1); hi1 = _mm_max_pd(b, hi1);
+    }
+    _mm_storeu_pd(&rect.minX, _mm_min_pd(lo0, lo1));
+    _mm_storeu_pd(&rect.maxX, _mm_max_pd(hi0, hi1));
+#elif JMAPGM_SIMD_NEON
+    float64x2_t lo0 = vdupq_n_f64(INFINITY), lo1 = lo0;
+    float64x2_t hi0 = vdupq_n_f64(-INFINITY), hi1 = hi0;
+    for (; i + 2 <= count; i += 2) {
+        float64x2_t a = vld1q_f64(&points[i].x), b = vld1q_f64(&points[i + 1].x);
+        lo0 = vminnmq_f64(lo0, a); hi0 = vmaxnmq_f64(hi0, a);
+        lo1 = vminnmq_f64(lo1, b); hi1 = vmaxnmq_f64(hi1, b);
+    }
+    vst1q_f64(&rect.minX, vminnmq_f64(lo0, lo1));
+    vst1q_f64(&rect.maxX, vmaxnmq_f64(hi0, hi1));
+#endif
+    for (; i < count; i++) {
+        JMapGMPoint p = points[i];
+        if (p.x < rect.minX) rect.minX = p.x;
+        if (p.x > rect.maxX) rect.maxX = p.x;
+        if (p.y < rect.minY) rect.minY = p.y;
+        if (p.y > rect.maxY) rect.maxY = p.y;
+    }
+    return rect;
+}
+
+JMapGMRect JMapGMRectsGetUnion(const JMapGMRect *rects, size_t count)
+{
+    JMapGMRect rect = JMapGMRectNull;
+    size_t i = 0;
+#if JMAPGM_SIMD_SSE2
+    __m128d lo0 = _mm_set1_pd(INFINITY), lo1 = lo0;
+    __m128d hi0 = _mm_set1_pd(-INFINITY), hi1 = hi0;
+    for (; i + 2 <= count; i += 2) {
+        lo0 = _mm_min_pd(_mm_loadu_pd(&rects[i].minX), lo0);
+        hi0 = _mm_max_pd(_mm_loadu_pd(&rects[i].maxX), hi0);
+        lo1 = _mm_min_pd(_mm_loadu_pd(&rects[i + 1].minX), lo1);
+        hi1 = _mm_max_pd(_mm_loadu_pd(&rects[i + 1].maxX), hi1);
+    }
+    _mm_storeu_pd(&rect.minX, _mm_min_pd(lo0, lo1));
+    _mm_storeu_pd(&rect.maxX, _mm_max_pd(hi0, hi1));
+#elif JMAPGM_SIMD_NEON
+    float64x2_t lo0 = vdupq_n_f64(INFINITY), lo1 = lo0;
+    float64x2_t hi0 = vdupq_n_f64(-INFINITY), hi1 = hi0;
+    for (; i + 2 <= count; i += 2) {
+        lo0 = vminnmq_f64(lo0, vld1q_f64(&rects[i].minX));
+        hi0 = vmaxnmq_f64(hi0, vld1q_f64(&rects[i].maxX));
+        lo1 = vminnmq_f64(lo1, vld1q_f64(&rects[i + 1].minX));
+        hi1 = vmaxnmq_f64(hi1, vld1q_f64(&rects[i + 1].maxX));
+    }
+    vst1q_f64(&rect.minX, vminnmq_f64(lo0, lo1));
+    vst1q_f64(&rect.maxX, vmaxnmq_f64(hi0, hi1));
+#endif
+    for (; i < count; i++) {
+        rect = JMapGMRectUnion(rect, rects[i]);
+    }
+    return rect;
+}
+
+JMapGMRect JMapGMPolygonGetBounds(const JMapGMPolygon *polygon)
+{
+    if (polygon->ringCount == 0) return JMapGMRectNull;
+    size_t start = polygon->ringStarts[0];
+    return JMapGMPointsGetBounds(polygon->points + start, polygon->ringStarts[polygon->ringCount] - start);
+}
+
+#pragma mark - Containment
+
+// Whether the ray from point towards +x crosses edge a -> b. The crossing test point.x < x(point.y)
+// is multiplied through by a.y - b.y, flipping for negative heights, so that no division is needed.
+static inline bool JMapGMEdgeCrosses(JMapGMPoint point, JMapGMPoint a, JMapGMPoint b)
+{
+    if ((b.y > point.y) == (a.y > point.y)) return false;
+    double dy = a.y - b.y;
+    double lhs = (point.x - b.x) * dy;
+    double rhs = (point.y - b.y) * (a.x - b.x);
+    return dy > 0 ? lhs < rhs : lhs > rhs;
+}
+
+bool JMapGMPolygonContainsPoint(const JMapGMPolygon *polygon, JMapGMPoint point)
+{
+    bool inside = false;
+    for (size_t ring = 0; ring < polygon->ringCount; ring++) {
+        uint32_t start = polygon->ringStarts[ring];
+        uint32_t end = polygon->ringStarts[ring + 1];
+        if (end - start < 3) continue;
+        // Edges run from the previous vertex to the current one, closing the ring implicitly.
+        JMapGMPoint a = polygon->points[end - 1];
+        for (uint32_t i = start; i < end; i++) {
+            JMapGMPoint b = polygon->points[i];
+            inside ^= JMapGMEdgeCrosses(point, a, b);
+            a = b;
+        }
+    }
+    return inside;
+}
+
+#pragma mark - Batch containment
+
+// Crossing-number lanes. Each lane tests one point against one edge with the same expressions, in
+// the same order, as JMapGMEdgeCrosses, so that both agree on every point. Comparison masks
+// are all ones per lane and collapse to one bit per lane.
+
+#if JMAPGM_SIMD_AVX2
+#define JMAPGM_LANES 4
+typedef __m256d JMapGMLane;
+typedef __m256d JMapGMLaneMask;
+#define JMapGMLaneSet(v) _mm256_set1_pd(v)
+#define JMapGMLaneSub(a, b) _mm256_sub_pd(a, b)
+#define JMapGMLaneMul(a, b) _mm256_mul_pd(a, b)
+#define JMapGMLaneGreater(a, b) _mm256_cmp_pd(a, b, _CMP_GT_OQ)
+#define JMapGMLaneLess(a, b) _mm256_cmp_pd(a, b, _CMP_LT_OQ)
+#define JMapGMLaneMaskZero() _mm256_setzero_pd()
+#define JMapGMLaneMaskXor(a, b) _mm256_xor_pd(a, b)
+#define JMapGMLaneMaskAnd(a, b) _mm256_and_pd(a, b)
+#define JMapGMLaneMaskOr(a, b) _mm256_or_pd(a, b)
+#define JMapGMLaneMaskBits(m) ((unsigned)_mm256_movemask_pd(m))
+static inline void JMapGMLaneLoadPoints(const JMapGMPoint *p, JMapGMLane *x, JMapGMLane *y)
+{
+    __m256d a = _mm256_loadu_pd(&p[0].x), b = _mm256_loadu_pd(&p[2].x);
+    // unpack yields lanes 0, 2, 1, 3; the permute restores point order.
+    *x = _mm256_permute4x64_pd(_mm256_unpacklo_pd(a, b), 0xD8);
+    *y = _mm256_permute4x64_pd(_mm256_unpackhi_pd(a, b), 0xD8);
+}
+#elif JMAPGM_SIMD_SSE2
+#define JMAPGM_LANES 2
+typedef __m128d JMapGMLane;
+typedef __m128d JMapGMLaneMask;
+#define JMapGMLaneSet(v) _mm_set1_pd(v)
+#define JMapGMLaneSub(a, b) _mm_sub_pd(a, b)
+#define JMapGMLaneMul(a, b) _mm_mul_pd(a, b)
+#define JMapGMLaneGreater(a, b) _mm_cmpgt_pd(a, b)
+#define JMapGMLaneLess(a, b) _mm_cmplt_pd(a, b)
+#define JMapGMLaneMaskZero() _mm_setzero_pd()
+#define JMapGMLaneMaskXor(a, b) _mm_xor_pd(a, b)
+#define JMapGMLaneMaskAnd(a, b) _mm_and_pd(a, b)
+#define JMapGMLaneMaskOr(a, b) _mm_or_pd(a, b)
+#define JMapGMLaneMaskBits(m) ((unsigned)_mm_movemask_pd(m))
+static inline void JMapGMLaneLoadPoints(const JMapGMPoint *p, JMapGMLane *x, JMapGMLane *y)
+{
+    __m128d a = _mm_loadu_pd(&p[0].x), b = _mm_loadu_pd(&p[1].x);
+    *x = _mm_unpacklo_pd(a, b);
+    *y = _mm_unpackhi_pd(a, b);
+}
+#elif JMAPGM_SIMD_NEON
+#define JMAPGM_LANES 2
+typedef float64x2_t JMapGMLane;
+typedef uint64x2_t JMapGMLaneMask;
+#define JMapGMLaneSet(v) vdupq_n_f64(v)
+#define JMapGMLaneSub(a, b) vsubq_f64(a, b)
+#define JMapGMLaneMul(a, b) vmulq_f64(a, b)
+#define JMapGMLaneGreater(a, b) vcgtq_f64(a, b)
+#define JMapGMLaneLess(a, b) vcltq_f64(a, b)
+#define JMapGMLaneMaskZero() vdupq_n_u64(0)
+#define JMapGMLaneMaskXor(a, b) veorq_u64(a, b)
+#define JMapGMLaneMaskAnd(a, b) vandq_u64(a, b)
+#define JMapGMLaneMaskOr(a, b) vorrq_u64(a, b)
+#define JMapGMLaneMaskBits(m) ((unsigned)((vgetq_lane_u64(m, 0) & 1) | ((vgetq_lane_u64(m, 1) & 1) << 1)))
+static inline void JMapGMLaneLoadPoints(const JMapGMPoint *p, JMapGMLane *x, JMapGMLane *y)
+{
+    float64x2x2_t v = vld2q_f64(&p[0].x);
+    *x = v.val[0];
+    *y = v.val[1];
+}
+#endif
+
+#ifdef JMAPGM_LANES
+// JMapGMEdgeCrosses for each lane; x and y may be points or edge ends broadcast to every lane.
+static inline JMapGMLaneMask JMapGMLaneCrosses(JMapGMLane px, JMapGMLane py, JMapGMLane ax, JMapGMLane ay,
+                                               JMapGMLane bx, JMapGMLane by)
+{
+    JMapGMLaneMask straddles = JMapGMLaneMaskXor(JMapGMLaneGreater(by, py), JMapGMLaneGreater(ay, py));
+    JMapGMLane zero = JMapGMLaneSet(0);
+    JMapGMLane dy = JMapGMLaneSub(ay, by);
+    JMapGMLane lhs = JMapGMLaneMul(JMapGMLaneSub(px, bx), dy);
+    JMapGMLane rhs = JMapGMLaneMul(JMapGMLaneSub(py, by), JMapGMLaneSub(ax, bx));
+    JMapGMLaneMask left = JMapGMLaneMaskOr(JMapGMLaneMaskAnd(JMapGMLaneGreater(dy, zero), JMapGMLaneLess(lhs, rhs)),
+                                           JMapGMLaneMaskAnd(JMapGMLaneLess(dy, zero), JMapGMLaneGreater(lhs, rhs)));
+    return JMapGMLaneMaskAnd(straddles, left);
+}
+#endif
+
+size_t JMapGMPolygonContainsPoints(const JMapGMPolygon *polygon, const JMapGMPoint *points, size_t count, bool *inside)
+{
+    JMapGMRect bounds = JMapGMPolygonGetBounds(polygon);
+    size_t insideCount = 0;
+    size_t i = 0;
+#ifdef JMAPGM_LANES
+    // Blocks of JMAPGM_TILE vectors share each broadcast edge and keep independent chains in flight.
+    enum { JMAPGM_TILE = 4, JMAPGM_BLOCK = JMAPGM_TILE * JMAPGM_LANES };
+    for (; i + JMAPGM_BLOCK <= count; i += JMAPGM_BLOCK) {
+        unsigned candidates = 0;
+        for (unsigned k = 0; k < JMAPGM_BLOCK; k++) {
+            candidates |= (unsigned)JMapGMRectContainsPoint(bounds, points[i + k]) << k;
+        }
+        unsigned bits = 0;
+        // Blocks entirely outside the bounds skip the edge loop.
+        if (candidates) {
+            JMapGMLane px[JMAPGM_TILE], py[JMAPGM_TILE];
+            JMapGMLaneMask parity[JMAPGM_TILE];
+            for (unsigned t = 0; t < JMAPGM_TILE; t++) {
+                JMapGMLaneLoadPoints(points + i + t * JMAPGM_LANES, &px[t], &py[t]);
+                parity[t] = JMapGMLaneMaskZero();
+            }
+            for (size_t ring = 0; ring < polygon->ringCount; ring++) {
+                uint32_t start = polygon->ringStarts[ring];
+                uint32_t end = polygon->ringStarts[ring + 1];
+                if (end - start < 3) continue;
+                JMapGMPoint a = polygon->points[end - 1];
+                for (uint32_t v = start; v < end; v++) {
+                    JMapGMPoint b = polygon->points[v];
+                    JMapGMLane ax = JMapGMLaneSet(a.x), ay = JMapGMLaneSet(a.y);
+                    JMapGMLane bx = JMapGMLaneSet(b.x), by = JMapGMLaneSet(b.y);
+                    for (unsigned t = 0; t < JMAPGM_TILE; t++) {
+                        parity[t] = JMapGMLaneMaskXor(parity[t], JMapGMLaneCrosses(px[t], py[t], ax, ay, bx, by));
+                    }
+                    a = b;
+                }
+            }
+            for (unsigned t = 0; t < JMAPGM_TILE; t++) {
+                bits |= JMapGMLaneMaskBits(parity[t]) << (t * JMAPGM_LANES);
+            }
+            bits &= candidates;
+        }
+        for (unsigned k = 0; k < JMAPGM_BLOCK; k++) {
+            bool in = (bits >> k) & 1;
+            inside[i + k] = in;
+            insideCount += in;
+        }
+    }
+#endif
+    for (; i < count; i++) {
+        inside[i] = JMapGMRectContainsPoint(bounds, points[i]) && JMapGMPolygonContainsPoint(polygon, points[i]);
+        insideCount += inside[i];
+    }
+    return insideCount;
+}
+
+// One point against the edges of one polygon, several consecutive edges at a time.
+static bool JMapGMPolygonContainsPointByEdges(const JMapGMPolygon *polygon, JMapGMPoint point)
+{
+#ifdef JMAPGM_LANES
+    bool inside = false;
+    JMapGMLane px = JMapGMLaneSet(point.x), py = JMapGMLaneSet(point.y);
+    for (size_t ring = 0; ring < polygon->ringCount; ring++) {
+        uint32_t start = polygon->ringStarts[ring];
+        uint32_t end = polygon->ringStarts[ring + 1];
+        if (end - start < 3) continue;
+        const JMapGMPoint *p = polygon->points;
+        // The closing edge, then edges v - 1 -> v in lanes, then a scalar tail.
+        inside ^= JMapGMEdgeCrosses(point, p[end - 1], p[start]);
+        uint32_t v = start + 1;
+        JMapGMLaneMask parity = JMapGMLaneMaskZero();
+        for (; v + JMAPGM_LANES <= end; v += JMAPGM_LANES) {
+            JMapGMLane ax, ay, bx, by;
+            JMapGMLaneLoadPoints(p + v - 1, &ax, &ay);
+            JMapGMLaneLoadPoints(p + v, &bx, &by);
+            parity = JMapGMLaneMaskXor(parity, JMapGMLaneCrosses(px, py, ax, ay, bx, by));
+        }
+        inside ^= __builtin_parity(JMapGMLaneMaskBits(parity));
+        for (; v < end; v++) {
+            inside ^= JMapGMEdgeCrosses(point, p[v - 1], p[v]);
+        }
+    }
+    return inside;
+#else
+    return JMapGMPolygonContainsPoint(polygon, point);
+#endif
+}
+
+size_t JMapGMPolygonsContainingPoint(const JMapGMPolygon *polygons, size_t count, JMapGMPoint point, uint32_t *indices)
+{
+    size_t found = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (JMapGMPolygonContainsPointByEdges(&polygons[i], point)) indices[found++] = (uint32_t)i;
+    }
+    return found;
+}
+
+#pragma mark - Hull
+
+static int JMapGMPointCompare(const void *a, const void *b)
+{
+    const JMapGMPoint *p = a, *q = b;
+    if (p->x != q->x) return p->x < q->x ? -1 : 1;
+    return (p->y > q->y) - (p->y < q->y);
+}
+
+// Twice the signed area of o, a, b: positive for a left turn.
+static inline double JMapGMCross(JMapGMPoint o, JMapGMPoint a, JMapGMPoint b)
+{
+    return (a.x - o.x) * (b.y - o.y) - (a.y - o.y) * (b.x - o.x);
+}
+
+size_t JMapGMPointsGetConvexHull(JMapGMPoint *points, size_t count, JMapGMPoint *hull)
+{
+    if (count < 2) {
+        if (count) hull[0] = points[0];
+        return count;
+    }
+    qsort(points, count, sizeof(JMapGMPoint), JMapGMPointCompare);
+    size_t k = 0;
+    // The lower chain left to right, then the upper chain back, dropping right turns and collinear points.
+    for (size_t i = 0; i < count; i++) {
+        while (k >= 2 && JMapGMCross(hull[k - 2], hull[k - 1], points[i]) <= 0) k--;
+        hull[k++] = points[i];
+    }
+    size_t lower = k + 1;
+    for (size_t i = count - 1; i > 0; i--) {
+        while (k >= lower && JMapGMCross(hull[k - 2], hull[k - 1], points[i - 1]) <= 0) k--;
+        hull[k++] = points[i - 1];
+    }
+    // The last vertex is the first again.
+    return k - 1;
+}
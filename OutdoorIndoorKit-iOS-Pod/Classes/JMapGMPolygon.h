@@ -0,0 +1,88 @@
+//
+//  JMapGMPolygon.h
+//  JMapOutdoorIndoorKit
+//
+//  Copyright © 2026 Jibestream. All rights reserved.
+//
+
+#ifndef JMapGMPolygon_h
+#define JMapGMPolygon_h
+
+#include "JMapGMTypes.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ *  A polygon, or multi-polygon, whose rings are stored back to back in one point buffer.
+ *  Rings may be open or closed. Holes are rings inside another ring (even-odd rule).
+ */
+typedef struct {
+    const JMapGMPoint *points;
+    /** ringCount + 1 offsets into points; ring i spans [ringStarts[i], ringStarts[i + 1]) */
+    const uint32_t *ringStarts;
+    size_t ringCount;
+} JMapGMPolygon;
+
+/**
+ *  Bounds of every vertex of the polygon
+ */
+JMapGMRect JMapGMPolygonGetBounds(const JMapGMPolygon *polygon);
+
+/**
+ *  Bounds of a point buffer, vectorized with SSE2 or NEON where available.
+ *
+ *  @return JMapGMRectNull if count is 0
+ */
+JMapGMRect JMapGMPointsGetBounds(const JMapGMPoint *points, size_t count);
+
+/**
+ *  Union of a rect buffer, such as cached per-shape bounds, vectorized like JMapGMPointsGetBounds.
+ *
+ *  @return JMapGMRectNull if count is 0
+ */
+JMapGMRect JMapGMRectsGetUnion(const JMapGMRect *rects, size_t count);
+
+/**
+ *  Crossing-number point in polygon test.
+ *
+ *  @return true if the point is inside under the even-odd rule
+ */
+bool JMapGMPolygonContainsPoint(const JMapGMPolygon *polygon, JMapGMPoint point);
+
+/**
+ *  Tests many points against one polygon, several points per instruction with AVX2, SSE2 or NEON.
+ *  Agrees with JMapGMPolygonContainsPoint on every point.
+ *
+ *  @param inside Receives count results
+ *  @return The number of points inside
+ */
+size_t JMapGMPolygonContainsPoints(const JMapGMPolygon *polygon, const JMapGMPoint *points, size_t count, bool *inside);
+
+/**
+ *  Tests one point against many candidate polygons, several edges per instruction.
+ *  Agrees with JMapGMPolygonContainsPoint on every polygon.
+ *
+ *  @param indices Receives the indices of the polygons containing the point, up to count
+ *  @return The number of indices written
+ */
+size_t JMapGMPolygonsContainingPoint(const JMapGMPolygon *polygons, size_t count, JMapGMPoint point, uint32_t *indices);
+
+#pragma mark - Hull
+
+/**
+ *  Convex hull with Andrew's monotone chain, e.g. to outline a scatter of points.
+ *
+ *  @param points The points, sorted in place
+ *  @param count The number of points
+ *  @param hull Receives the hull counterclockwise without repeating its first vertex; room for 2 * count points
+ *  @return The number of vertices written; fewer than 3 if the points are collinear
+ */
+size_t JMapGMPointsGetConvexHull(JMapGMPoint *points, size_t count, JMapGMPoint *hull);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* JMapGMPolygon_h */
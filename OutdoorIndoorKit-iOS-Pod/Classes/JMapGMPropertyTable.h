@@ -0,0 +1,129 @@
+//
+//  JMapGMPropertyTable.h
+//  JMapOutdoorIndoorKit
+//
+//  Copyright © 2026 Jibestream. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import <JMapOutdoorIndoorKit/JMapOutdoorIndoorKit.h>
+#import "JMapGMAttributeTable.h"
+#import "JMapGMShapePredicate.h"
+
+/**
+ *  The JMapGMPropertyTable object
+ *
+ *  The properties of a set of shapes stored by column, one row per shape. Keys, layer names and
+ *  string values are interned once per table, numbers and booleans are unboxed, and the per-row
+ *  dictionaries are only rebuilt when asked for. Arrays, dictionaries and nulls nested in properties
+ *  are kept as objects beside the columns. Immutable once built and safe to read from any thread.
+ */
+@interface JMapGMPropertyTable : NSObject
+
+/**
+ *  The shapes, indexed by row
+ */
+@property (nonatomic, readonly, nonnull) NSArray<JMapGMGeometry *> *shapes;
+/**
+ *  The number of rows
+ */
+@property (nonatomic, readonly) NSUInteger rowCount;
+/**
+ *  The columns, for queries that run on the C core. Owned by the table.
+ */
+@property (nonatomic, readonly, nonnull) const JMapGMAttributeTable *attributeTable;
+/**
+ *  The pooled layer name of each row, JMAPGM_ATTRIBUTE_NONE for shapes without a layer. Owned by the table.
+ */
+@property (nonatomic, readonly, nonnull) const uint32_t *layerCodes;
+/**
+ *  Bytes used by the columns and the string pool
+ */
+@property (nonatomic, readonly) NSUInteger memoryUsage;
+
+/**
+ *  Build a table
+ *
+ *  @param shapes The shapes, one row each
+ *  @param layerNames The layer of each shape, parallel to shapes, or nil
+ *  @return The table, or nil if allocation failed
+ */
+- (nullable instancetype)initWithShapes:(nonnull NSArray<JMapGMGeometry *> *)shapes layerNames:(nullable NSArray<NSString *> *)layerNames;
+
+/**
+ *  The row of a shape
+ *
+ *  @param shape A shape of the table, compared by identity
+ *  @return The row, or NSNotFound
+ */
+- (NSUInteger)rowOfShape:(nonnull JMapGMGeometry *)shape;
+
+/**
+ *  The layer name of a row, nil if the shape has none
+ */
+- (nullable NSString *)layerNameOfRow:(NSUInteger)row;
+
+/**
+ *  The properties of a row. The dictionary only holds the table and row until it is first read.
+ */
+- (nonnull NSDictionary<NSString *, id> *)propertiesOfRow:(NSUInteger)row;
+
+/**
+ *  One property of a row, without building the dictionary
+ *
+ *  @return The value, or nil
+ */
+- (nullable id)valueForKey:(nonnull NSString *)key ofRow:(NSUInteger)row;
+
+/**
+ *  The rows whose string property equals a value, e.g. all units whose category is food
+ */
+- (nonnull NSIndexSet *)rowsWhereKey:(nonnull NSString *)key isEqualToString:(nonnull NSString *)value;
+
+/**
+ *  The rows whose number property lies within [minimum, maximum]
+ */
+- (nonnull NSIndexSet *)rowsWhereKey:(nonnull NSString *)key isBetween:(double)minimum and:(double)maximum;
+
+/**
+ *  The shapes of a set of rows
+ */
+- (nonnull NSArray<JMapGMGeometry *> *)shapesAtRows:(nonnull NSIndexSet *)rows;
+
+/**
+ *  The rows matching a predicate. Attribute and layer conditions scan the columns, and spatial
+ *  conditions search an R-tree over the shape bounds built on first use. No shape is touched.
+ *
+ *  @param predicate The predicate
+ *  @return The matching rows
+ */
+- (nonnull NSIndexSet *)rowsMatchingPredicate:(nonnull JMapGMShapePredicate *)predicate;
+
+/**
+ *  The number of rows matching a predicate, without listing them
+ */
+- (NSUInteger)countOfRowsMatchingPredicate:(nonnull JMapGMShapePredicate *)predicate;
+
+@end
+
+@interface JMapGMController (PropertyTable)
+
+/**
+ *  The property table of every shape of a map, cached on the map. A cached map returns it without
+ *  walking its layers, so the cache must be dropped with invalidatePropertyTableOfMap: whenever the
+ *  map's shapes change. Nothing is kept for a map without shapes, e.g. one not parsed yet.
+ *
+ *  @param map A map parsed by the controller
+ *  @return The table, rows ordered by layer, or nil if allocation failed
+ */
+- (nullable JMapGMPropertyTable *)propertyTableOfMap:(nonnull JMapMap *)map;
+
+/**
+ *  Drops the property table cached on a map. Call after parsing the map again or changing its
+ *  shapes or their properties; tracedParseMap: does so itself.
+ *
+ *  @param map A map parsed by the controller
+ */
+- (void)invalidatePropertyTableOfMap:(nonnull JMapMap *)map;
+
+@end
@@ -0,0 +1,371 @@
+//
+//  JMapGMPropertyTable.m
+//  JMapOutdoorIndoorKit
+//
+//  Copyright © 2026 Jibestream. All rights reserved.
+//
+
+#import "JMapGMPropertyTable.h"
+#import "JMapGMGeometry+Packed.h"
+#import "JMapGMTrace.h"
+#import <objc/runtime.h>
+
+static const void *JMapGMPropertyTableKey = &JMapGMPropertyTableKey;
+
+static uint32_t JMapGMIntern(JMapGMAttributeTable *table, NSString *string)
+{
+    const char *bytes = string.UTF8String ?: "";
+    return JMapGMAttributeTableIntern(table, bytes, strlen(bytes));
+}
+
+static BOOL JMapGMIsBoolean(NSNumber *number)
+{
+    return CFGetTypeID((__bridge CFTypeRef)number) == CFBooleanGetTypeID();
+}
+
+@interface JMapGMPropertyTable ()
+- (NSString *)stringForCode:(uint32_t)code;
+- (NSDictionary *)materializePropertiesOfRow:(NSUInteger)row;
+@end
+
+/**
+ *  A row's properties that build the real dictionary on first read.
+ */
+@interface JMapGMLazyProperties : NSDictionary
+- (instancetype)initWithTable:(JMapGMPropertyTable *)table row:(NSUInteger)row;
+@end
+
+@implementation JMapGMLazyProperties
+{
+    JMapGMPropertyTable *_table;
+    NSUInteger _row;
+    NSDictionary *_dictionary;
+}
+
+- (instancetype)initWithTable:(JMapGMPropertyTable *)table row:(NSUInteger)row
+{
+    self = [super init];
+    if (self) {
+        _table = table;
+        _row = row;
+    }
+    return self;
+}
+
+- (NSDictionary *)dictionary
+{
+    @synchronized (self) {
+        if (!_dictionary) _dictionary = [_table materializePropertiesOfRow:_row];
+        return _dictionary;
+    }
+}
+
+- (NSUInteger)count
+{
+    return [self dictionary].count;
+}
+
+- (id)objectForKey:(id)key
+{
+    if (_dictionary || ![key isKindOfClass:[NSString class]]) return [[self dictionary] objectForKey:key];
+    // Single lookups read the columns directly.
+    return [_table valueForKey:key ofRow:_row];
+}
+
+- (NSEnumerator *)keyEnumerator
+{
+    return [[self dictionary] keyEnumerator];
+}
+
+@end
+
+@implementation JMapGMPropertyTable
+{
+    JMapGMAttributeTable *_table;
+    NSMutableData *_layerCodes;
+    NSMapTable<JMapGMGeometry *, NSNumber *> *_rows;
+    /** Row to the properties that are not strings, numbers or booleans */
+    NSDictionary<NSNumber *, NSDictionary *> *_objectValues;
+    /** Decoded strings by code, NSNull until first decoded */
+    NSMutableArray *_strings;
+    /** Shape bounds and their R-tree, built by the first spatial query */
+    NSData *_bounds;
+    JMapGMRTree *_tree;
+}
+
+- (instancetype)initWithShapes:(NSArray<JMapGMGeometry *> *)shapes layerNames:(NSArray<NSString *> *)layerNames
+{
+    self = [super init];
+    if (self) {
+        JMAPGM_TRACE_SCOPE("properties.build");
+        _shapes = [shapes copy];
+        _table = JMapGMAttributeTableCreate();
+        _layerCodes = [NSMutableData dataWithLength:MAX(shapes.count, 1) * sizeof(uint32_t)];
+        _rows = [[NSMapTable alloc] initWithKeyOptions:NSPointerFunctionsStrongMemory | NSPointerFunctionsObjectPointerPersonality
+                                          valueOptions:NSPointerFunctionsStrongMemory
+                                              capacity:shapes.count];
+        if (!_table) return nil;
+
+        NSMutableDictionary<NSNumber *, NSDictionary *> *objectValues = [NSMutableDictionary dictionary];
+        uint32_t *layerCodes = _layerCodes.mutableBytes;
+        __block BOOL failed = NO;
+        [_shapes enumerateObjectsUsingBlock:^(JMapGMGeometry *shape, NSUInteger index, BOOL *stop) {
+            uint32_t row = JMapGMAttributeTableAddRow(_table);
+            if (row == JMAPGM_ATTRIBUTE_NONE) {
+                failed = *stop = YES;
+                return;
+            }
+            [_rows setObject:@(row) forKey:shape];
+            NSString *layerName = index < layerNames.count ? layerNames[index] : nil;
+            layerCodes[row] = layerName ? JMapGMIntern(_table, layerName) : JMAPGM_ATTRIBUTE_NONE;
+
+            NSMutableDictionary *objects = nil;
+            for (NSString *key in shape.properties) {
+                id value = shape.properties[key];
+                if (![key isKindOfClass:[NSString class]]) continue;
+                uint32_t keyCode = JMapGMIntern(_table, key);
+                if ([value isKindOfClass:[NSString class]]) {
+                    JMapGMAttributeTableSetString(_table, row, keyCode, JMapGMIntern(_table, value));
+                } else if ([value isKindOfClass:[NSNumber class]] && !isnan([value doubleValue])) {
+                    JMapGMAttributeType type = JMapGMIsBoolean(value) ? JMapGMAttributeBoolean : JMapGMAttributeNumber;
+                    JMapGMAttributeTableSetNumber(_table, row, keyCode, type, [value doubleValue]);
+                } else {
+                    if (!objects) objects = [NSMutableDictionary dictionary];
+                    objects[key] = value;
+                }
+            }
+            if (objects) objectValues[@(row)] = objects;
+        }];
+        // The table is released by dealloc.
+        if (failed) return nil;
+        _objectValues = objectValues;
+
+        NSUInteger stringCount = JMapGMAttributeTableGetStringCount(_table);
+        _strings = [NSMutableArray arrayWithCapacity:stringCount];
+        for (NSUInteger i = 0; i < stringCount; i++) [_strings addObject:[NSNull null]];
+        JMAPGM_TRACE_COUNT("properties.rows", (int64_t)shapes.count);
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    JMapGMAttributeTableRelease(_table);
+    JMapGMRTreeRelease(_tree);
+}
+
+- (NSUInteger)rowCount
+{
+    return _shapes.count;
+}
+
+- (const JMapGMAttributeTable *)attributeTable
+{
+    return _table;
+}
+
+- (const uint32_t *)layerCodes
+{
+    return _layerCodes.bytes;
+}
+
+- (NSUInteger)memoryUsage
+{
+    return JMapGMAttributeTableGetMemoryUsage(_table) + _layerCodes.length;
+}
+
+- (NSString *)stringForCode:(uint32_t)code
+{
+    if (code == JMAPGM_ATTRIBUTE_NONE) return nil;
+    @synchronized (_strings) {
+        id string = code < _strings.count ? _strings[code] : nil;
+        if (string != [NSNull null]) return string;
+        size_t length = 0;
+        const char *bytes = JMapGMAttributeTableGetString(_table, code, &length);
+        string = [[NSString alloc] initWithBytes:bytes length:length encoding:NSUTF8StringEncoding] ?: @"";
+        _strings[code] = string;
+        return string;
+    }
+}
+
+- (NSUInteger)rowOfShape:(JMapGMGeometry *)shape
+{
+    NSNumber *row = [_rows objectForKey:shape];
+    return row ? row.unsignedIntegerValue : NSNotFound;
+}
+
+- (NSString *)layerNameOfRow:(NSUInteger)row
+{
+    if (row >= _shapes.count) return nil;
+    return [self stringForCode:self.layerCodes[row]];
+}
+
+- (id)valueOfColumn:(uint32_t)column row:(NSUInteger)row
+{
+    switch (JMapGMAttributeTableGetColumnType(_table, column)) {
+        case JMapGMAttributeString:
+            return [self stringForCode:JMapGMAttributeTableGetStringValue(_table, column, (uint32_t)row)];
+        case JMapGMAttributeNumber: {
+            double value = JMapGMAttributeTableGetNumber(_table, column, (uint32_t)row);
+            return isnan(value) ? nil : @(value);
+        }
+        case JMapGMAttributeBoolean: {
+            double value = JMapGMAttributeTableGetNumber(_table, column, (uint32_t)row);
+            return isnan(value) ? nil : @(value != 0);
+        }
+    }
+    return nil;
+}
+
+- (NSDictionary *)materializePropertiesOfRow:(NSUInteger)row
+{
+    NSMutableDictionary *properties = [NSMutableDictionary dictionaryWithDictionary:_objectValues[@(row)] ?: @{}];
+    size_t columnCount = JMapGMAttributeTableGetColumnCount(_table);
+    for (uint32_t column = 0; column < columnCount; column++) {
+        id value = [self valueOfColumn:column row:row];
+        if (value) properties[[self stringForCode:JMapGMAttributeTableGetColumnKey(_table, column)]] = value;
+    }
+    return properties;
+}
+
+- (NSDictionary<NSString *, id> *)propertiesOfRow:(NSUInteger)row
+{
+    if (row >= _shapes.count) return @{};
+    return [[JMapGMLazyProperties alloc] initWithTable:self row:row];
+}
+
+- (id)valueForKey:(NSString *)key ofRow:(NSUInteger)row
+{
+    if (row >= _shapes.count) return nil;
+    uint32_t keyCode = JMapGMAttributeTableFindObjCString(_table, key);
+    if (keyCode == JMAPGM_ATTRIBUTE_NONE) return nil;
+    for (JMapGMAttributeType type = JMapGMAttributeNumber; type <= JMapGMAttributeBoolean; type++) {
+        uint32_t column = JMapGMAttributeTableGetColumn(_table, keyCode, type);
+        id value = column == JMAPGM_ATTRIBUTE_NONE ? nil : [self valueOfColumn:column row:row];
+        if (value) return value;
+    }
+    return _objectValues[@(row)][key];
+}
+
+- (NSIndexSet *)indexSetFromBitmap:(const uint64_t *)bitmap
+{
+    NSMutableIndexSet *rows = [NSMutableIndexSet indexSet];
+    size_t rowCount = _shapes.count;
+    for (size_t w = 0; w < JMapGMBitmapWordCount(rowCount); w++) {
+        for (uint64_t word = bitmap[w]; word; word &= word - 1) {
+            [rows addIndex:w * 64 + (size_t)__builtin_ctzll(word)];
+        }
+    }
+    return rows;
+}
+
+- (NSIndexSet *)rowsWhereKey:(NSString *)key isEqualToString:(NSString *)value
+{
+    JMAPGM_TRACE_SCOPE("properties.match");
+    uint32_t column = JMapGMAttributeTableGetColumn(_table, JMapGMAttributeTableFindObjCString(_table, key), JMapGMAttributeString);
+    uint32_t string = JMapGMAttributeTableFindObjCString(_table, value);
+    if (column == JMAPGM_ATTRIBUTE_NONE || string == JMAPGM_ATTRIBUTE_NONE) return [NSIndexSet indexSet];
+    NSMutableData *bitmap = [NSMutableData dataWithLength:MAX(JMapGMBitmapWordCount(_shapes.count), 1) * sizeof(uint64_t)];
+    JMapGMAttributeTableMatchString(_table, column, string, bitmap.mutableBytes);
+    return [self indexSetFromBitmap:bitmap.bytes];
+}
+
+- (NSIndexSet *)rowsWhereKey:(NSString *)key isBetween:(double)minimum and:(double)maximum
+{
+    JMAPGM_TRACE_SCOPE("properties.match");
+    uint32_t column = JMapGMAttributeTableGetColumn(_table, JMapGMAttributeTableFindObjCString(_table, key), JMapGMAttributeNumber);
+    if (column == JMAPGM_ATTRIBUTE_NONE) return [NSIndexSet indexSet];
+    NSMutableData *bitmap = [NSMutableData dataWithLength:MAX(JMapGMBitmapWordCount(_shapes.count), 1) * sizeof(uint64_t)];
+    JMapGMAttributeTableMatchRange(_table, column, minimum, maximum, bitmap.mutableBytes);
+    return [self indexSetFromBitmap:bitmap.bytes];
+}
+
+- (NSArray<JMapGMGeometry *> *)shapesAtRows:(NSIndexSet *)rows
+{
+    NSMutableArray<JMapGMGeometry *> *shapes = [NSMutableArray arrayWithCapacity:rows.count];
+    [rows enumerateIndexesUsingBlock:^(NSUInteger row, BOOL *stop) {
+        if (row < _shapes.count) [shapes addObject:_shapes[row]];
+    }];
+    return shapes;
+}
+
+#pragma mark - Queries
+
+- (JMapGMShapeSource)shapeSourceWithBounds:(BOOL)withBounds
+{
+    JMapGMShapeSource source = { _table, self.layerCodes, NULL, NULL, _shapes.count };
+    if (!withBounds) return source;
+    @synchronized (self) {
+        if (!_bounds) {
+            JMAPGM_TRACE_SCOPE("properties.index");
+            NSMutableData *bounds = [NSMutableData dataWithLength:MAX(_shapes.count, 1) * sizeof(JMapGMRect)];
+            JMapGMRect *rects = bounds.mutableBytes;
+            [_shapes enumerateObjectsUsingBlock:^(JMapGMGeometry *shape, NSUInteger row, BOOL *stop) {
+                rects[row] = shape.packedBounds;
+            }];
+            _tree = JMapGMRTreeCreate(rects, _shapes.count, 0);
+            _bounds = bounds;
+        }
+    }
+    source.bounds = _bounds.bytes;
+    source.index = _tree;
+    return source;
+}
+
+- (NSMutableData *)evaluatePredicate:(JMapGMShapePredicate *)predicate count:(size_t *)count
+{
+    JMAPGM_TRACE_SCOPE("properties.query");
+    NSMutableData *terms = [NSMutableData data];
+    [predicate appendTermsForTable:_table toData:terms];
+    const JMapGMQueryTerm *term = terms.bytes;
+    size_t termCount = terms.length / sizeof(JMapGMQueryTerm);
+    BOOL spatial = NO;
+    for (size_t i = 0; i < termCount; i++) spatial |= term[i].op == JMapGMQueryWithin || term[i].op == JMapGMQueryNear;
+
+    JMapGMShapeSource source = [self shapeSourceWithBounds:spatial];
+    NSMutableData *bitmap = [NSMutableData dataWithLength:MAX(JMapGMBitmapWordCount(_shapes.count), 1) * sizeof(uint64_t)];
+    *count = JMapGMShapeQueryEvaluate(&source, term, termCount, bitmap.mutableBytes);
+    if (*count == JMAPGM_QUERY_INVALID) return nil;
+    return bitmap;
+}
+
+- (NSIndexSet *)rowsMatchingPredicate:(JMapGMShapePredicate *)predicate
+{
+    size_t count = 0;
+    NSMutableData *bitmap = [self evaluatePredicate:predicate count:&count];
+    return bitmap ? [self indexSetFromBitmap:bitmap.bytes] : [NSIndexSet indexSet];
+}
+
+- (NSUInteger)countOfRowsMatchingPredicate:(JMapGMShapePredicate *)predicate
+{
+    size_t count = 0;
+    return [self evaluatePredicate:predicate count:&count] ? count : 0;
+}
+
+@end
+
+@implementation JMapGMController (PropertyTable)
+
+- (JMapGMPropertyTable *)propertyTableOfMap:(JMapMap *)map
+{
+    JMapGMPropertyTable *table = objc_getAssociatedObject(map, JMapGMPropertyTableKey);
+    if (table) return table;
+
+    NSMutableArray<JMapGMGeometry *> *shapes = [NSMutableArray array];
+    NSMutableArray<NSString *> *layerNames = [NSMutableArray array];
+    [self jmapgm_enumerateShapesInMap:map usingBlock:^(JMapGMGeometry *shape, NSString *layerName, BOOL *stop) {
+        [shapes addObject:shape];
+        [layerNames addObject:layerName];
+    }];
+    table = [[JMapGMPropertyTable alloc] initWithShapes:shapes layerNames:layerNames];
+    // A map not parsed yet has no table to keep.
+    objc_setAssociatedObject(map, JMapGMPropertyTableKey, table.rowCount ? table : nil, OBJC_ASSOCIATION_RETAIN);
+    return table;
+}
+
+- (void)invalidatePropertyTableOfMap:(JMapMap *)map
+{
+    objc_setAssociatedObject(map, JMapGMPropertyTableKey, nil, OBJC_ASSOCIATION_RETAIN);
+}
+
+@end
@@ -0,0 +1,115 @@
+//
+//  JMapGMRenderBatch.h
+//  JMapOutdoorIndoorKit
+//
+//  Copyright © 2026 Jibestream. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import <JMapOutdoorIndoorKit/JMapOutdoorIndoorKit.h>
+
+/**
+ *  The JMapGMRenderBatch object
+ *
+ *  Records styling, visibility and interactivity calls for a JMapGMController and applies only their
+ *  net result on commit. Later calls on the same shape, layer or unit replace earlier ones, and shapes
+ *  ending with the same style are styled in one styleShapes:withStyling: call. Shapes reset during
+ *  the batch are reset before they are styled, so "reset, then style" stays both calls; only
+ *  consecutive styles collapse, assuming a style replaces the one before it. Must be used on the
+ *  main thread.
+ *
+ *  Commit does not keep the order of calls of different kinds. It applies layer visibility first,
+ *  then layer interactivity, then unit contents, then style resets, then styles. The batch is only
+ *  equivalent to the direct calls when those kinds do not affect one another. Calls whose order
+ *  across kinds matters must go to the controller directly, or in separate commits.
+ */
+@interface JMapGMRenderBatch : NSObject
+
+/**
+ *  The controller receiving the calls
+ */
+@property (nonatomic, readonly, weak, nullable) JMapGMController *controller;
+
+/**
+ *  Whether recorded calls are committed automatically on the next main queue turn, so that a burst
+ *  of calls made in one event is applied once. Defaults to NO.
+ */
+@property (nonatomic) BOOL automaticallyCommits;
+
+/**
+ *  The number of calls recorded since the last commit
+ */
+@property (nonatomic, readonly) NSUInteger recordedCount;
+
+/**
+ *  Creates an empty batch.
+ *
+ *  @param controller The controller to apply the calls to
+ */
+- (nonnull instancetype)initWithController:(nonnull JMapGMController *)controller;
+
+/**
+ *  Records styleShapes:withStyling:.
+ */
+- (void)styleShapes:(nonnull NSArray<JMapGMGeometry *> *)shapes withStyling:(nonnull JMapStyle *)style;
+
+/**
+ *  Records resetStyleForShapes:.
+ */
+- (void)resetStyleForShapes:(nonnull NSArray<JMapGMGeometry *> *)shapes;
+
+/**
+ *  Records showLayer:.
+ */
+- (void)showLayer:(nonnull NSString *)name;
+
+/**
+ *  Records hideLayer:.
+ */
+- (void)hideLayer:(nonnull NSString *)name;
+
+/**
+ *  Records enableLayerInteractivityForLayerName:.
+ */
+- (void)enableLayerInteractivityForLayerName:(nonnull NSString *)layerName;
+
+/**
+ *  Records disableLayerInteractivityForLayerName:.
+ */
+- (void)disableLayerInteractivityForLayerName:(nonnull NSString *)layerName;
+
+/**
+ *  Records showUnitContents:.
+ */
+- (void)showUnitContents:(nonnull JMapGMGeometry *)unit;
+
+/**
+ *  Records hideUnitContents:.
+ */
+- (void)hideUnitContents:(nonnull JMapGMGeometry *)unit;
+
+/**
+ *  Applies the net result of the recorded calls to the controller and empties the batch.
+ *
+ *  @return The number of controller calls made
+ */
+- (NSUInteger)commit;
+
+/**
+ *  Drops the recorded calls without applying them.
+ */
+- (void)discard;
+
+@end
+
+@interface JMapGMController (RenderBatch)
+
+/**
+ *  Records the calls made to a batch in a block, then commits them.
+ *
+ *  @param block Makes the calls on the batch passed to it
+ *  @return The number of controller calls made
+ */
+- (NSUInteger)performRenderBatch:(void (^ _Nonnull)(JMapGMRenderBatch * _Nonnull batch))block;
+
+@end
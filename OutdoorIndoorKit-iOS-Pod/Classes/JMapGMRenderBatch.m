@@ -0,0 +1,225 @@
+//
+//  JMapGMRenderBatch.m
+//  JMapOutdoorIndoorKit
+//
+//  Copyright © 2026 Jibestream. All rights reserved.
+//
+
+#import "JMapGMRenderBatch.h"
+#import "JMapGMTrace.h"
+
+/**
+ *  The last state recorded for each key, in order of first appearance.
+ */
+@interface JMapGMRenderState : NSObject
+@property (nonatomic, readonly) NSMutableArray *keys;
+@property (nonatomic, readonly) NSMapTable *values;
+@end
+
+@implementation JMapGMRenderState
+
+- (instancetype)initWithKeyOptions:(NSPointerFunctionsOptions)options
+{
+    self = [super init];
+    if (self) {
+        _keys = [NSMutableArray array];
+        _values = [[NSMapTable alloc] initWithKeyOptions:options valueOptions:NSPointerFunctionsStrongMemory capacity:0];
+    }
+    return self;
+}
+
+- (void)recordValue:(id)value forKey:(id)key
+{
+    if (![_values objectForKey:key]) [_keys addObject:key];
+    [_values setObject:value forKey:key];
+}
+
+- (void)removeAll
+{
+    [_keys removeAllObjects];
+    [_values removeAllObjects];
+}
+
+@end
+
+@implementation JMapGMRenderBatch
+{
+    /** Shape to JMapStyle, or NSNull for a reset; shapes are compared by identity */
+    JMapGMRenderState *_styles;
+    /** Shapes reset at any point in the batch, reset again on commit before any style */
+    NSHashTable<JMapGMGeometry *> *_resetShapes;
+    /** Layer name to @YES for shown */
+    JMapGMRenderState *_layers;
+    /** Layer name to @YES for interactive */
+    JMapGMRenderState *_interactivity;
+    /** Unit to @YES for contents shown; units are compared by identity */
+    JMapGMRenderState *_unitContents;
+    BOOL _commitScheduled;
+}
+
+- (instancetype)initWithController:(JMapGMController *)controller
+{
+    self = [super init];
+    if (self) {
+        _controller = controller;
+        NSPointerFunctionsOptions identity = NSPointerFunctionsStrongMemory | NSPointerFunctionsObjectPointerPersonality;
+        NSPointerFunctionsOptions equality = NSPointerFunctionsStrongMemory | NSPointerFunctionsObjectPersonality;
+        _styles = [[JMapGMRenderState alloc] initWithKeyOptions:identity];
+        _resetShapes = [[NSHashTable alloc] initWithOptions:identity capacity:0];
+        _layers = [[JMapGMRenderState alloc] initWithKeyOptions:equality];
+        _interactivity = [[JMapGMRenderState alloc] initWithKeyOptions:equality];
+        _unitContents = [[JMapGMRenderState alloc] initWithKeyOptions:identity];
+    }
+    return self;
+}
+
+- (void)didRecord:(NSUInteger)count
+{
+    _recordedCount += count;
+    JMAPGM_TRACE_COUNT("render.recorded", (int64_t)count);
+    if (!_automaticallyCommits || _commitScheduled) return;
+    _commitScheduled = YES;
+    __weak JMapGMRenderBatch *weakSelf = self;
+    dispatch_async(dispatch_get_main_queue(), ^{
+        [weakSelf commit];
+    });
+}
+
+#pragma mark - Recording
+
+- (void)styleShapes:(NSArray<JMapGMGeometry *> *)shapes withStyling:(JMapStyle *)style
+{
+    for (JMapGMGeometry *shape in shapes) [_styles recordValue:style forKey:shape];
+    [self didRecord:1];
+}
+
+- (void)resetStyleForShapes:(NSArray<JMapGMGeometry *> *)shapes
+{
+    for (JMapGMGeometry *shape in shapes) {
+        [_styles recordValue:[NSNull null] forKey:shape];
+        [_resetShapes addObject:shape];
+    }
+    [self didRecord:1];
+}
+
+- (void)showLayer:(NSString *)name
+{
+    [_layers recordValue:@YES forKey:name];
+    [self didRecord:1];
+}
+
+- (void)hideLayer:(NSString *)name
+{
+    [_layers recordValue:@NO forKey:name];
+    [self didRecord:1];
+}
+
+- (void)enableLayerInteractivityForLayerName:(NSString *)layerName
+{
+    [_interactivity recordValue:@YES forKey:layerName];
+    [self didRecord:1];
+}
+
+- (void)disableLayerInteractivityForLayerName:(NSString *)layerName
+{
+    [_interactivity recordValue:@NO forKey:layerName];
+    [self didRecord:1];
+}
+
+- (void)showUnitContents:(JMapGMGeometry *)unit
+{
+    [_unitContents recordValue:@YES forKey:unit];
+    [self didRecord:1];
+}
+
+- (void)hideUnitContents:(JMapGMGeometry *)unit
+{
+    [_unitContents recordValue:@NO forKey:unit];
+    [self didRecord:1];
+}
+
+#pragma mark - Commit
+
+- (NSUInteger)commit
+{
+    _commitScheduled = NO;
+    JMapGMController *controller = _controller;
+    if (!controller || _recordedCount == 0) {
+        [self discard];
+        return 0;
+    }
+    JMAPGM_TRACE_SCOPE("render.commit");
+    NSUInteger calls = 0;
+
+    // Kinds are applied in the fixed order documented on the class, not the order they were recorded in.
+    for (NSString *name in _layers.keys) {
+        if ([[_layers.values objectForKey:name] boolValue]) [controller showLayer:name];
+        else [controller hideLayer:name];
+        calls++;
+    }
+    for (NSString *name in _interactivity.keys) {
+        if ([[_interactivity.values objectForKey:name] boolValue]) [controller enableLayerInteractivityForLayerName:name];
+        else [controller disableLayerInteractivityForLayerName:name];
+        calls++;
+    }
+    for (JMapGMGeometry *unit in _unitContents.keys) {
+        if ([[_unitContents.values objectForKey:unit] boolValue]) [controller showUnitContents:unit];
+        else [controller hideUnitContents:unit];
+        calls++;
+    }
+
+    // Every shape reset in the batch is reset first, even if styled afterwards, since a style need
+    // not undo everything a reset does. Shapes are then grouped by their final style, keeping the
+    // order styles were first used in. Only the last style of a shape is applied, which assumes
+    // styleShapes:withStyling: replaces the style a shape had rather than layering on top of it.
+    NSMutableArray *resets = [NSMutableArray array];
+    NSMutableArray<JMapStyle *> *styles = [NSMutableArray array];
+    NSMapTable<JMapStyle *, NSMutableArray *> *shapesByStyle = [NSMapTable strongToStrongObjectsMapTable];
+    for (JMapGMGeometry *shape in _styles.keys) {
+        id style = [_styles.values objectForKey:shape];
+        if ([_resetShapes containsObject:shape]) [resets addObject:shape];
+        if (style == [NSNull null]) continue;
+        NSMutableArray *shapes = [shapesByStyle objectForKey:style];
+        if (!shapes) {
+            shapes = [NSMutableArray array];
+            [shapesByStyle setObject:shapes forKey:style];
+            [styles addObject:style];
+        }
+        [shapes addObject:shape];
+    }
+    if (resets.count) {
+        [controller resetStyleForShapes:resets];
+        calls++;
+    }
+    for (JMapStyle *style in styles) {
+        [controller styleShapes:[shapesByStyle objectForKey:style] withStyling:style];
+        calls++;
+    }
+
+    JMAPGM_TRACE_COUNT("render.calls", (int64_t)calls);
+    [self discard];
+    return calls;
+}
+
+- (void)discard
+{
+    [_styles removeAll];
+    [_resetShapes removeAllObjects];
+    [_layers removeAll];
+    [_interactivity removeAll];
+    [_unitContents removeAll];
+    _recordedCount = 0;
+}
+
+@end
+
+@implementation JMapGMController (RenderBatch)
+
+- (NSUInteger)performRenderBatch:(void (^)(JMapGMRenderBatch *))block
+{
+    JMapGMRenderBatch *batch = [[JMapGMRenderBatch alloc] initWithController:self];
+    block(batch);
+    return [batch commit];
+}
+
+@end
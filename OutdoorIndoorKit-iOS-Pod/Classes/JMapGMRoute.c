@@ -0,0 +1,831 @@
+//
+//  JMapGMRoute.c
+//  JMapOutdoorIndoorKit
+//
+//  Copyright © 2026 Jibestream. All rights reserved.
+//
+
+#include "JMapGMRoute.h"
+#include "JMapGMSpatialIndex.h"
+#include "JMapGMTrace.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+static const double JMapGMMetresPerDegree = 111320.0;
+
+#define JMAPGM_ROUTE_NO_NODE UINT32_MAX
+
+/** The first half width in metres searched around a user for a waypoint to rejoin the route */
+static const double JMapGMRouteEntryRadius = 16.0;
+
+// Length in metres on a projection around the middle of the two points.
+static double JMapGMRouteLength(JMapGMPoint a, JMapGMPoint b)
+{
+    double xScale = cos((a.y + b.y) * 0.5 * M_PI / 180.0);
+    double dx = (b.x - a.x) * xScale * JMapGMMetresPerDegree;
+    double dy = (b.y - a.y) * JMapGMMetresPerDegree;
+    return sqrt(dx * dx + dy * dy);
+}
+
+#pragma mark - Routes
+
+JMapGMRoute *JMapGMRouteCreate(const uint32_t *nodes, const JMapGMPoint *points, const int32_t *floors, const double *costs, size_t count)
+{
+    if (count == 0) return NULL;
+    size_t segmentCount = 1;
+    for (size_t i = 1; i < count; i++) segmentCount += floors[i] != floors[i - 1];
+
+    // Eight byte arrays first, then four byte arrays, so each stays aligned.
+    size_t size = sizeof(JMapGMRoute) + count * sizeof(JMapGMPoint) + segmentCount * sizeof(double) +
+                  count * sizeof(uint32_t) + segmentCount * sizeof(int32_t) + (segmentCount + 1) * sizeof(uint32_t);
+    char *memory = malloc(size);
+    if (!memory) return NULL;
+    JMapGMRoute *route = (JMapGMRoute *)memory;
+    JMapGMPoint *routePoints = (JMapGMPoint *)(memory + sizeof(JMapGMRoute));
+    double *segmentCosts = (double *)(routePoints + count);
+    uint32_t *routeNodes = (uint32_t *)(segmentCosts + segmentCount);
+    int32_t *segmentFloors = (int32_t *)(routeNodes + count);
+    uint32_t *segmentStarts = (uint32_t *)(segmentFloors + segmentCount);
+
+    memcpy(routeNodes, nodes, count * sizeof(uint32_t));
+    memcpy(routePoints, points, count * sizeof(JMapGMPoint));
+    size_t segment = 0;
+    double total = 0;
+    segmentStarts[0] = 0;
+    segmentFloors[0] = floors[0];
+    segmentCosts[0] = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (i > 0 && floors[i] != floors[i - 1]) {
+            segment++;
+            segmentStarts[segment] = (uint32_t)i;
+            segmentFloors[segment] = floors[i];
+            segmentCosts[segment] = 0;
+        }
+        if (i + 1 == count) break;
+        // The edge leaving the last node of a floor is the connector, charged to that floor's segment.
+        double cost = costs ? costs[i] : JMapGMRouteLength(points[i], points[i + 1]);
+        segmentCosts[segment] += cost;
+        total += cost;
+    }
+    segmentStarts[segmentCount] = (uint32_t)count;
+
+    route->nodeCount = count;
+    route->nodes = routeNodes;
+    route->points = routePoints;
+    route->segmentCount = segmentCount;
+    route->segmentFloors = segmentFloors;
+    route->segmentStarts = segmentStarts;
+    route->segmentCosts = segmentCosts;
+    route->cost = total;
+    route->size = size;
+    return route;
+}
+
+void JMapGMRouteRelease(JMapGMRoute *route)
+{
+    free(route);
+}
+
+size_t JMapGMRouteGetSegment(const JMapGMRoute *route, size_t node)
+{
+    size_t low = 0, high = route->segmentCount;
+    while (high - low > 1) {
+        size_t middle = (low + high) / 2;
+        if (route->segmentStarts[middle] <= node) low = middle;
+        else high = middle;
+    }
+    return low;
+}
+
+#pragma mark - Graph
+
+struct JMapGMRouteGraph {
+    size_t nodeCount;
+    size_t edgeCount;
+    JMapGMPoint *points;
+    /** The points in metres around the middle of the venue, for edge lengths and the A* estimate */
+    JMapGMPoint *projected;
+    /** The projection: projected = ((x - origin.x) * xScale, (y - origin.y) * JMapGMMetresPerDegree) */
+    JMapGMPoint origin;
+    double xScale;
+    int32_t *floors;
+    /** The edges of node n are [offsets[n], offsets[n + 1]) */
+    uint32_t *offsets;
+    uint32_t *targets;
+    double *lengths;
+    uint8_t *pathTypes;
+    /** The distinct floors in ascending order, each with an R-tree of its projected points */
+    size_t floorCount;
+    int32_t *floorIds;
+    JMapGMRTree **floorTrees;
+    /** The nodes of floor f are floorNodes[floorOffsets[f], floorOffsets[f + 1]); its tree's items index that run */
+    uint32_t *floorOffsets;
+    uint32_t *floorNodes;
+};
+
+static int JMapGMRouteCompareFloors(const void *a, const void *b)
+{
+    int32_t fa = *(const int32_t *)a, fb = *(const int32_t *)b;
+    return (fa > fb) - (fa < fb);
+}
+
+// The index of a floor in floorIds, or floorCount if no node is on it.
+static size_t JMapGMRouteGraphFindFloor(const JMapGMRouteGraph *graph, int32_t floor)
+{
+    const int32_t *found = graph->floorCount ? bsearch(&floor, graph->floorIds, graph->floorCount, sizeof(int32_t), JMapGMRouteCompareFloors) : NULL;
+    return found ? (size_t)(found - graph->floorIds) : graph->floorCount;
+}
+
+// Groups the nodes by floor and indexes each floor's projected points, for JMapGMRouteTreeFindEntry.
+static bool JMapGMRouteGraphIndexFloors(JMapGMRouteGraph *graph)
+{
+    size_t nodeCount = graph->nodeCount;
+    graph->floorIds = malloc((nodeCount + 1) * sizeof(int32_t));
+    graph->floorNodes = malloc((nodeCount + 1) * sizeof(uint32_t));
+    if (!graph->floorIds || !graph->floorNodes) return false;
+    if (nodeCount) memcpy(graph->floorIds, graph->floors, nodeCount * sizeof(int32_t));
+    qsort(graph->floorIds, nodeCount, sizeof(int32_t), JMapGMRouteCompareFloors);
+    for (size_t i = 0; i < nodeCount; i++) {
+        if (i == 0 || graph->floorIds[i] != graph->floorIds[graph->floorCount - 1]) graph->floorIds[graph->floorCount++] = graph->floorIds[i];
+    }
+
+    graph->floorOffsets = calloc(graph->floorCount + 1, sizeof(uint32_t));
+    graph->floorTrees = calloc(graph->floorCount + 1, sizeof(JMapGMRTree *));
+    JMapGMRect *rects = malloc((nodeCount + 1) * sizeof(JMapGMRect));
+    if (!graph->floorOffsets || !graph->floorTrees || !rects) {
+        free(rects);
+        return false;
+    }
+    for (size_t i = 0; i < nodeCount; i++) graph->floorOffsets[JMapGMRouteGraphFindFloor(graph, graph->floors[i]) + 1]++;
+    for (size_t f = 0; f < graph->floorCount; f++) graph->floorOffsets[f + 1] += graph->floorOffsets[f];
+    for (size_t i = 0; i < nodeCount; i++) {
+        uint32_t slot = graph->floorOffsets[JMapGMRouteGraphFindFloor(graph, graph->floors[i])]++;
+        graph->floorNodes[slot] = (uint32_t)i;
+        rects[slot] = (JMapGMRect){ graph->projected[i].x, graph->projected[i].y, graph->projected[i].x, graph->projected[i].y };
+    }
+    // The fill moved every offset to its floor's end; shift them back to the starts.
+    memmove(graph->floorOffsets + 1, graph->floorOffsets, graph->floorCount * sizeof(uint32_t));
+    graph->floorOffsets[0] = 0;
+
+    bool ok = true;
+    for (size_t f = 0; f < graph->floorCount && ok; f++) {
+        uint32_t first = graph->floorOffsets[f];
+        graph->floorTrees[f] = JMapGMRTreeCreate(rects + first, graph->floorOffsets[f + 1] - first, 0);
+        ok = graph->floorTrees[f] != NULL;
+    }
+    free(rects);
+    return ok;
+}
+
+JMapGMRouteGraph *JMapGMRouteGraphCreate(const JMapGMPoint *points, const int32_t *floors, size_t nodeCount,
+                                         const uint32_t *edgeFrom, const uint32_t *edgeTo, const uint8_t *edgePathTypes, size_t edgeCount)
+{
+    JMAPGM_TRACE_SCOPE("route.graph");
+    // Searches label every node twice, on foot and riding.
+    if (nodeCount >= JMAPGM_ROUTE_NO_NODE / 2 || edgeCount > UINT32_MAX / 2) return NULL;
+    JMapGMRouteGraph *graph = calloc(1, sizeof(JMapGMRouteGraph));
+    if (!graph) return NULL;
+    graph->nodeCount = nodeCount;
+    graph->points = malloc((nodeCount + 1) * sizeof(JMapGMPoint));
+    graph->projected = malloc((nodeCount + 1) * sizeof(JMapGMPoint));
+    graph->floors = malloc((nodeCount + 1) * sizeof(int32_t));
+    graph->offsets = calloc(nodeCount + 1, sizeof(uint32_t));
+    graph->targets = malloc((2 * edgeCount + 1) * sizeof(uint32_t));
+    graph->lengths = malloc((2 * edgeCount + 1) * sizeof(double));
+    graph->pathTypes = malloc(2 * edgeCount + 1);
+    if (!graph->points || !graph->projected || !graph->floors || !graph->offsets || !graph->targets || !graph->lengths || !graph->pathTypes) {
+        JMapGMRouteGraphRelease(graph);
+        return NULL;
+    }
+    if (nodeCount) {
+        memcpy(graph->points, points, nodeCount * sizeof(JMapGMPoint));
+        memcpy(graph->floors, floors, nodeCount * sizeof(int32_t));
+    }
+
+    JMapGMRect bounds = JMapGMRectNull;
+    for (size_t i = 0; i < nodeCount; i++) bounds = JMapGMRectUnion(bounds, (JMapGMRect){ points[i].x, points[i].y, points[i].x, points[i].y });
+    double xScale = nodeCount ? cos((bounds.minY + bounds.maxY) * 0.5 * M_PI / 180.0) * JMapGMMetresPerDegree : 0;
+    graph->origin = nodeCount ? (JMapGMPoint){ bounds.minX, bounds.minY } : (JMapGMPoint){ 0, 0 };
+    graph->xScale = xScale;
+    for (size_t i = 0; i < nodeCount; i++) {
+        graph->projected[i].x = (points[i].x - bounds.minX) * xScale;
+        graph->projected[i].y = (points[i].y - bounds.minY) * JMapGMMetresPerDegree;
+    }
+    if (!JMapGMRouteGraphIndexFloors(graph)) {
+        JMapGMRouteGraphRelease(graph);
+        return NULL;
+    }
+
+    // Counting sort of both directions of every edge by their start.
+    for (size_t e = 0; e < edgeCount; e++) {
+        if (edgeFrom[e] >= nodeCount || edgeTo[e] >= nodeCount || (edgePathTypes && edgePathTypes[e] >= JMAPGM_ROUTE_PATH_TYPES)) continue;
+        graph->offsets[edgeFrom[e]]++;
+        graph->offsets[edgeTo[e]]++;
+    }
+    uint32_t sum = 0;
+    for (size_t i = 0; i <= nodeCount; i++) {
+        uint32_t count = graph->offsets[i];
+        graph->offsets[i] = sum;
+        sum += count;
+    }
+    graph->edgeCount = sum;
+    uint32_t *cursor = malloc((nodeCount + 1) * sizeof(uint32_t));
+    if (!cursor) {
+        JMapGMRouteGraphRelease(graph);
+        return NULL;
+    }
+    memcpy(cursor, graph->offsets, (nodeCount + 1) * sizeof(uint32_t));
+    for (size_t e = 0; e < edgeCount; e++) {
+        uint32_t from = edgeFrom[e], to = edgeTo[e];
+        uint8_t pathType = edgePathTypes ? edgePathTypes[e] : 0;
+        if (from >= nodeCount || to >= nodeCount || pathType >= JMAPGM_ROUTE_PATH_TYPES) continue;
+        double dx = graph->projected[to].x - graph->projected[from].x;
+        double dy = graph->projected[to].y - graph->projected[from].y;
+        double length = sqrt(dx * dx + dy * dy);
+        uint32_t forward = cursor[from]++, backward = cursor[to]++;
+        graph->targets[forward] = to;
+        graph->targets[backward] = from;
+        graph->lengths[forward] = graph->lengths[backward] = length;
+        graph->pathTypes[forward] = graph->pathTypes[backward] = pathType;
+    }
+    free(cursor);
+    return graph;
+}
+
+void JMapGMRouteGraphRelease(JMapGMRouteGraph *graph)
+{
+    if (!graph) return;
+    free(graph->points);
+    free(graph->projected);
+    free(graph->floors);
+    free(graph->offsets);
+    free(graph->targets);
+    free(graph->lengths);
+    free(graph->pathTypes);
+    for (size_t f = 0; graph->floorTrees && f < graph->floorCount; f++) JMapGMRTreeRelease(graph->floorTrees[f]);
+    free(graph->floorIds);
+    free(graph->floorTrees);
+    free(graph->floorOffsets);
+    free(graph->floorNodes);
+    free(graph);
+}
+
+size_t JMapGMRouteGraphGetNodeCount(const JMapGMRouteGraph *graph)
+{
+    return graph->nodeCount;
+}
+
+const JMapGMPoint *JMapGMRouteGraphGetPoints(const JMapGMRouteGraph *graph)
+{
+    return graph->points;
+}
+
+const int32_t *JMapGMRouteGraphGetFloors(const JMapGMRouteGraph *graph)
+{
+    return graph->floors;
+}
+
+size_t JMapGMRouteGraphGetEdgeCount(const JMapGMRouteGraph *graph)
+{
+    return graph->edgeCount;
+}
+
+size_t JMapGMRouteGraphGetMemoryUsage(const JMapGMRouteGraph *graph)
+{
+    // Per node the floor index adds a copy of its floor, its slot in floorNodes and a tree item;
+    // the trees' inner nodes are left out.
+    return sizeof(JMapGMRouteGraph) + graph->nodeCount * (2 * sizeof(JMapGMPoint) + 2 * sizeof(int32_t) + 2 * sizeof(uint32_t) + sizeof(JMapGMRect) + sizeof(uint32_t)) +
+           graph->floorCount * (sizeof(uint32_t) + sizeof(JMapGMRTree *)) + graph->edgeCount * (sizeof(uint32_t) + sizeof(double) + 1);
+}
+
+#pragma mark - Travel time
+
+JMapGMTravelModel JMapGMTravelModelMake(int32_t accessibility)
+{
+    double need = accessibility < 0 ? 0 : accessibility > 100 ? 1 : accessibility / 100.0;
+    JMapGMTravelModel model = { 0 };
+    model.walkingSpeed = 1.3 - 0.4 * need;
+    model.accessibility = accessibility;
+    for (size_t t = 0; t < JMAPGM_ROUTE_PATH_TYPES; t++) model.pathTypes[t] = (JMapGMPathTypeCost){ 1, 0, 0, 100 };
+    model.pathTypes[JMapGMPathTypeElevator] = (JMapGMPathTypeCost){ 1, 5, 30, 100 };
+    model.pathTypes[JMapGMPathTypeStairs] = (JMapGMPathTypeCost){ 1, 15, 0, 0 };
+    model.pathTypes[JMapGMPathTypeEscalator] = (JMapGMPathTypeCost){ 1, 10, 5, 50 };
+    return model;
+}
+
+#pragma mark - Search
+
+typedef struct {
+    double key;
+    uint32_t label;
+} JMapGMRouteHeapEntry;
+
+/** What an edge of one path type costs under the search's model */
+typedef struct {
+    double perMetre;
+    double perFloor;
+    double board;
+    bool allowed;
+} JMapGMRouteEdgeCost;
+
+/**
+ *  Nodes are searched as labels: label 2n is node n on foot, 2n + 1 is node n riding the path type
+ *  in rideTypes, so consecutive edges of a type with a boarding cost board once. A node reached by
+ *  two types that both board keeps the cheaper ride.
+ */
+struct JMapGMRouteSearch {
+    const JMapGMRouteGraph *graph;
+    /** Indexed by path type, which the graph keeps below JMAPGM_ROUTE_PATH_TYPES */
+    JMapGMRouteEdgeCost edgeCosts[JMAPGM_ROUTE_PATH_TYPES];
+    /** The lowest cost per metre of any allowed type, so the A* estimate never exceeds the true cost */
+    double heuristicScale;
+    /** Per label state, valid where the label's stamp equals stamp, so queries need no clearing */
+    uint32_t stamp;
+    uint32_t *seen;
+    uint32_t *closed;
+    double *costs;
+    uint32_t *parents;
+    uint8_t *rideTypes;
+    /** Per node */
+    uint32_t *marked;
+    /** Binary min heap on key; superseded entries are skipped when popped */
+    JMapGMRouteHeapEntry *heap;
+    size_t heapCount;
+    size_t heapCapacity;
+    size_t settled;
+    /** The route being unwound, reused by JMapGMRouteSearchFind */
+    uint32_t *pathNodes;
+    JMapGMPoint *pathPoints;
+    int32_t *pathFloors;
+    double *pathCosts;
+    /** The frontier of JMapGMRouteSearchReach, grown on demand */
+    JMapGMPoint *frontier;
+    int32_t *frontierFloors;
+    size_t frontierCapacity;
+};
+
+JMapGMRouteSearch *JMapGMRouteSearchCreate(const JMapGMRouteGraph *graph)
+{
+    JMapGMRouteSearch *search = calloc(1, sizeof(JMapGMRouteSearch));
+    if (!search) return NULL;
+    size_t count = graph->nodeCount + 1;
+    search->graph = graph;
+    search->seen = calloc(2 * count, sizeof(uint32_t));
+    search->closed = calloc(2 * count, sizeof(uint32_t));
+    search->costs = malloc(2 * count * sizeof(double));
+    search->parents = malloc(2 * count * sizeof(uint32_t));
+    search->rideTypes = malloc(2 * count);
+    search->marked = calloc(count, sizeof(uint32_t));
+    search->heapCapacity = 64;
+    search->heap = malloc(search->heapCapacity * sizeof(JMapGMRouteHeapEntry));
+    search->pathNodes = malloc(count * sizeof(uint32_t));
+    search->pathPoints = malloc(count * sizeof(JMapGMPoint));
+    search->pathFloors = malloc(count * sizeof(int32_t));
+    search->pathCosts = malloc(count * sizeof(double));
+    if (!search->seen || !search->closed || !search->costs || !search->parents || !search->rideTypes || !search->marked || !search->heap ||
+        !search->pathNodes || !search->pathPoints || !search->pathFloors || !search->pathCosts) {
+        JMapGMRouteSearchRelease(search);
+        return NULL;
+    }
+    JMapGMRouteSearchSetModel(search, NULL);
+    return search;
+}
+
+void JMapGMRouteSearchRelease(JMapGMRouteSearch *search)
+{
+    if (!search) return;
+    free(search->seen);
+    free(search->closed);
+    free(search->costs);
+    free(search->parents);
+    free(search->rideTypes);
+    free(search->marked);
+    free(search->heap);
+    free(search->pathNodes);
+    free(search->pathPoints);
+    free(search->pathFloors);
+    free(search->pathCosts);
+    free(search->frontier);
+    free(search->frontierFloors);
+    free(search);
+}
+
+void JMapGMRouteSearchSetModel(JMapGMRouteSearch *search, const JMapGMTravelModel *model)
+{
+    double scale = INFINITY;
+    for (size_t t = 0; t < JMAPGM_ROUTE_PATH_TYPES; t++) {
+        JMapGMRouteEdgeCost cost = { 1, 0, 0, true };
+        if (model) {
+            const JMapGMPathTypeCost *pathType = &model->pathTypes[t];
+            cost.perMetre = pathType->walkFactor / model->walkingSpeed;
+            cost.perFloor = pathType->secondsPerFloor;
+            cost.board = pathType->boardSeconds;
+            cost.allowed = pathType->accessibility >= model->accessibility;
+        }
+        search->edgeCosts[t] = cost;
+        if (cost.allowed && cost.perMetre < scale) scale = cost.perMetre;
+    }
+    search->heuristicScale = isfinite(scale) ? scale : 0;
+}
+
+size_t JMapGMRouteSearchGetSettledCount(const JMapGMRouteSearch *search)
+{
+    return search->settled;
+}
+
+static void JMapGMRouteSearchBegin(JMapGMRouteSearch *search)
+{
+    if (++search->stamp == 0) {
+        size_t count = search->graph->nodeCount + 1;
+        memset(search->seen, 0, 2 * count * sizeof(uint32_t));
+        memset(search->closed, 0, 2 * count * sizeof(uint32_t));
+        memset(search->marked, 0, count * sizeof(uint32_t));
+        search->stamp = 1;
+    }
+    search->heapCount = 0;
+    search->settled = 0;
+}
+
+static bool JMapGMRouteHeapPush(JMapGMRouteSearch *search, double key, uint32_t label)
+{
+    if (search->heapCount == search->heapCapacity) {
+        size_t capacity = search->heapCapacity * 2;
+        JMapGMRouteHeapEntry *heap = realloc(search->heap, capacity * sizeof(JMapGMRouteHeapEntry));
+        if (!heap) return false;
+        search->heap = heap;
+        search->heapCapacity = capacity;
+    }
+    JMapGMRouteHeapEntry *heap = search->heap;
+    size_t i = search->heapCount++;
+    while (i > 0) {
+        size_t parent = (i - 1) / 2;
+        if (heap[parent].key <= key) break;
+        heap[i] = heap[parent];
+        i = parent;
+    }
+    heap[i] = (JMapGMRouteHeapEntry){ key, label };
+    return true;
+}
+
+static JMapGMRouteHeapEntry JMapGMRouteHeapPop(JMapGMRouteSearch *search)
+{
+    JMapGMRouteHeapEntry *heap = search->heap;
+    JMapGMRouteHeapEntry top = heap[0];
+    JMapGMRouteHeapEntry last = heap[--search->heapCount];
+    size_t count = search->heapCount, i = 0;
+    for (;;) {
+        size_t child = 2 * i + 1;
+        if (child >= count) break;
+        if (child + 1 < count && heap[child + 1].key < heap[child].key) child++;
+        if (heap[child].key >= last.key) break;
+        heap[i] = heap[child];
+        i = child;
+    }
+    if (count) heap[i] = last;
+    return top;
+}
+
+static double JMapGMRouteSearchEstimate(const JMapGMRouteSearch *search, uint32_t node, uint32_t target)
+{
+    if (target == JMAPGM_ROUTE_NO_NODE) return 0;
+    const JMapGMRouteGraph *graph = search->graph;
+    double dx = graph->projected[target].x - graph->projected[node].x;
+    double dy = graph->projected[target].y - graph->projected[node].y;
+    return sqrt(dx * dx + dy * dy) * search->heuristicScale;
+}
+
+// The cost of edge e leaving label, and the label it leads to, or INFINITY if its path type is not allowed.
+static inline double JMapGMRouteSearchEdgeCost(const JMapGMRouteSearch *search, uint32_t label, uint32_t e, uint32_t *nextLabel)
+{
+    const JMapGMRouteGraph *graph = search->graph;
+    uint8_t pathType = graph->pathTypes[e];
+    const JMapGMRouteEdgeCost *edgeCost = &search->edgeCosts[pathType];
+    uint32_t next = graph->targets[e];
+    *nextLabel = 2 * next;
+    if (!edgeCost->allowed) return INFINITY;
+    double cost = graph->lengths[e] * edgeCost->perMetre;
+    if (graph->floors[next] != graph->floors[label / 2]) cost += edgeCost->perFloor;
+    if (edgeCost->board > 0) {
+        if (!(label & 1) || search->rideTypes[label] != pathType) cost += edgeCost->board;
+        (*nextLabel)++;
+    }
+    return cost;
+}
+
+/**
+ *  Settles labels from one waypoint in order of cost, until a label of target is settled, or one
+ *  of every marked node is if target is JMAPGM_ROUTE_NO_NODE, or the next costs more than limit,
+ *  or nothing is left. With record, each node is appended to the path buffers as it is first
+ *  settled, and reachCount receives their number. Returns the settled label of target,
+ *  JMAPGM_ROUTE_NO_NODE otherwise, or false in ok if allocation failed.
+ */
+static uint32_t JMapGMRouteSearchRun(JMapGMRouteSearch *search, uint32_t from, uint32_t target, size_t marked, double limit, size_t *reachCount, bool *ok)
+{
+    const JMapGMRouteGraph *graph = search->graph;
+    uint32_t stamp = search->stamp;
+    uint32_t start = 2 * from;
+    search->seen[start] = stamp;
+    search->costs[start] = 0;
+    search->parents[start] = JMAPGM_ROUTE_NO_NODE;
+    *ok = JMapGMRouteHeapPush(search, JMapGMRouteSearchEstimate(search, from, target), start);
+    if (!*ok) return JMAPGM_ROUTE_NO_NODE;
+    while (search->heapCount) {
+        JMapGMRouteHeapEntry top = JMapGMRouteHeapPop(search);
+        uint32_t label = top.label;
+        if (search->closed[label] == stamp) continue;
+        if (top.key > limit) break;
+        search->closed[label] = stamp;
+        search->settled++;
+        uint32_t node = label / 2;
+        double cost = search->costs[label];
+        if (reachCount && search->closed[label ^ 1] != stamp) {
+            search->pathNodes[*reachCount] = node;
+            search->pathCosts[*reachCount] = cost;
+            (*reachCount)++;
+        }
+        if (node == target) return label;
+        if (search->marked[node] == stamp) {
+            search->marked[node] = 0;
+            if (--marked == 0) break;
+        }
+
+        for (uint32_t e = graph->offsets[node]; e < graph->offsets[node + 1]; e++) {
+            uint32_t nextLabel;
+            double nextCost = cost + JMapGMRouteSearchEdgeCost(search, label, e, &nextLabel);
+            if (isinf(nextCost)) continue;
+            if (search->seen[nextLabel] == stamp && nextCost >= search->costs[nextLabel]) continue;
+            search->seen[nextLabel] = stamp;
+            search->costs[nextLabel] = nextCost;
+            search->parents[nextLabel] = label;
+            search->rideTypes[nextLabel] = graph->pathTypes[e];
+            *ok = JMapGMRouteHeapPush(search, nextCost + JMapGMRouteSearchEstimate(search, graph->targets[e], target), nextLabel);
+            if (!*ok) return JMAPGM_ROUTE_NO_NODE;
+        }
+    }
+    return JMAPGM_ROUTE_NO_NODE;
+}
+
+JMapGMRoute *JMapGMRouteSearchFind(JMapGMRouteSearch *search, uint32_t from, uint32_t to)
+{
+    JMAPGM_TRACE_SCOPE("route.find");
+    const JMapGMRouteGraph *graph = search->graph;
+    if (from >= graph->nodeCount || to >= graph->nodeCount) return NULL;
+    JMapGMRouteSearchBegin(search);
+    bool ok;
+    uint32_t goal = JMapGMRouteSearchRun(search, from, to, 0, INFINITY, NULL, &ok);
+    if (goal == JMAPGM_ROUTE_NO_NODE) return NULL;
+
+    // Unwinds the parents into the path buffers from the back. A node appears once, its cheapest label settling first.
+    size_t count = 0;
+    for (uint32_t label = goal; label != JMAPGM_ROUTE_NO_NODE; label = search->parents[label]) count++;
+    size_t i = count;
+    for (uint32_t label = goal, next = JMAPGM_ROUTE_NO_NODE; label != JMAPGM_ROUTE_NO_NODE; next = label, label = search->parents[label]) {
+        uint32_t node = label / 2;
+        i--;
+        search->pathNodes[i] = node;
+        search->pathPoints[i] = graph->points[node];
+        search->pathFloors[i] = graph->floors[node];
+        if (next != JMAPGM_ROUTE_NO_NODE) search->pathCosts[i] = search->costs[next] - search->costs[label];
+    }
+    return JMapGMRouteCreate(search->pathNodes, search->pathPoints, search->pathFloors, search->pathCosts, count);
+}
+
+double JMapGMRouteSearchCost(JMapGMRouteSearch *search, uint32_t from, uint32_t to)
+{
+    const JMapGMRouteGraph *graph = search->graph;
+    if (from >= graph->nodeCount || to >= graph->nodeCount) return INFINITY;
+    JMapGMRouteSearchBegin(search);
+    bool ok;
+    uint32_t goal = JMapGMRouteSearchRun(search, from, to, 0, INFINITY, NULL, &ok);
+    return goal == JMAPGM_ROUTE_NO_NODE ? INFINITY : search->costs[goal];
+}
+
+size_t JMapGMRouteSearchCosts(JMapGMRouteSearch *search, uint32_t from, const uint32_t *targets, size_t count, double *costs)
+{
+    JMAPGM_TRACE_SCOPE("route.costs");
+    const JMapGMRouteGraph *graph = search->graph;
+    JMapGMRouteSearchBegin(search);
+    uint32_t stamp = search->stamp;
+    size_t marked = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (targets[i] >= graph->nodeCount || search->marked[targets[i]] == stamp) continue;
+        search->marked[targets[i]] = stamp;
+        marked++;
+    }
+    bool ok = false;
+    if (from < graph->nodeCount && marked) JMapGMRouteSearchRun(search, from, JMAPGM_ROUTE_NO_NODE, marked, INFINITY, NULL, &ok);
+    size_t reached = 0;
+    for (size_t i = 0; i < count; i++) {
+        costs[i] = INFINITY;
+        if (!ok || targets[i] >= graph->nodeCount) continue;
+        // Either label may have settled; the first to settle is the cheaper.
+        uint32_t label = 2 * targets[i];
+        if (search->closed[label] == stamp) costs[i] = search->costs[label];
+        if (search->closed[label + 1] == stamp && search->costs[label + 1] < costs[i]) costs[i] = search->costs[label + 1];
+        reached += !isinf(costs[i]);
+    }
+    return reached;
+}
+
+JMapGMRouteReach JMapGMRouteSearchReach(JMapGMRouteSearch *search, uint32_t from, double limit)
+{
+    JMAPGM_TRACE_SCOPE("route.reach");
+    const JMapGMRouteGraph *graph = search->graph;
+    JMapGMRouteReach reach = { search->pathNodes, search->pathCosts, 0, search->frontier, search->frontierFloors, 0 };
+    if (from >= graph->nodeCount) return reach;
+    JMapGMRouteSearchBegin(search);
+    bool ok;
+    JMapGMRouteSearchRun(search, from, JMAPGM_ROUTE_NO_NODE, 0, limit, &reach.count, &ok);
+    if (!ok) {
+        reach.count = 0;
+        return reach;
+    }
+
+    // Edges on one floor from a reached node to one beyond the limit end where the cost runs out.
+    uint32_t stamp = search->stamp;
+    for (size_t i = 0; i < reach.count; i++) {
+        uint32_t node = reach.nodes[i];
+        uint32_t label = 2 * node + (search->closed[2 * node] != stamp);
+        for (uint32_t e = graph->offsets[node]; e < graph->offsets[node + 1]; e++) {
+            uint32_t next = graph->targets[e], nextLabel;
+            if (graph->floors[next] != graph->floors[node] || search->closed[2 * next] == stamp || search->closed[2 * next + 1] == stamp) continue;
+            double edgeCost = JMapGMRouteSearchEdgeCost(search, label, e, &nextLabel);
+            if (isinf(edgeCost) || edgeCost <= 0) continue;
+            if (reach.frontierCount == search->frontierCapacity) {
+                size_t capacity = search->frontierCapacity ? search->frontierCapacity * 2 : 64;
+                JMapGMPoint *frontier = realloc(search->frontier, capacity * sizeof(JMapGMPoint));
+                if (frontier) search->frontier = frontier;
+                int32_t *frontierFloors = realloc(search->frontierFloors, capacity * sizeof(int32_t));
+                if (frontierFloors) search->frontierFloors = frontierFloors;
+                if (!frontier || !frontierFloors) break;
+                search->frontierCapacity = capacity;
+            }
+            double t = (limit - reach.costs[i]) / edgeCost;
+            if (t > 1) t = 1;
+            JMapGMPoint a = graph->points[node], b = graph->points[next];
+            search->frontier[reach.frontierCount] = (JMapGMPoint){ a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t };
+            search->frontierFloors[reach.frontierCount] = graph->floors[node];
+            reach.frontierCount++;
+        }
+    }
+    reach.frontier = search->frontier;
+    reach.frontierFloors = search->frontierFloors;
+    return reach;
+}
+
+#pragma mark - Route tree
+
+struct JMapGMRouteTree {
+    const JMapGMRouteGraph *graph;
+    uint32_t destination;
+    /** The cost of walking one metre of corridor, to charge the straight walk to an entry */
+    double perMetre;
+    /** Per label as in the search: the cost to the destination, INFINITY where not reached */
+    double *costs;
+    /** Per label: the next label towards the destination */
+    uint32_t *parents;
+};
+
+JMapGMRouteTree *JMapGMRouteSearchTree(JMapGMRouteSearch *search, uint32_t to)
+{
+    JMAPGM_TRACE_SCOPE("route.tree");
+    const JMapGMRouteGraph *graph = search->graph;
+    if (to >= graph->nodeCount) return NULL;
+    JMapGMRouteTree *tree = calloc(1, sizeof(JMapGMRouteTree));
+    if (!tree) return NULL;
+    size_t labelCount = 2 * graph->nodeCount;
+    tree->graph = graph;
+    tree->destination = to;
+    tree->perMetre = search->edgeCosts[0].perMetre;
+    tree->costs = malloc(labelCount * sizeof(double));
+    tree->parents = malloc(labelCount * sizeof(uint32_t));
+    if (!tree->costs || !tree->parents) {
+        JMapGMRouteTreeRelease(tree);
+        return NULL;
+    }
+
+    // A sweep out of the destination: edges are undirected and a ride boards once whichever end it
+    // is entered from, so the cost of reaching a label is the cost of the route from it.
+    JMapGMRouteSearchBegin(search);
+    bool ok;
+    JMapGMRouteSearchRun(search, to, JMAPGM_ROUTE_NO_NODE, 0, INFINITY, NULL, &ok);
+    if (!ok) {
+        JMapGMRouteTreeRelease(tree);
+        return NULL;
+    }
+    uint32_t stamp = search->stamp;
+    for (size_t label = 0; label < labelCount; label++) {
+        bool settled = search->closed[label] == stamp;
+        tree->costs[label] = settled ? search->costs[label] : INFINITY;
+        tree->parents[label] = settled ? search->parents[label] : JMAPGM_ROUTE_NO_NODE;
+    }
+    return tree;
+}
+
+void JMapGMRouteTreeRelease(JMapGMRouteTree *tree)
+{
+    if (!tree) return;
+    free(tree->costs);
+    free(tree->parents);
+    free(tree);
+}
+
+uint32_t JMapGMRouteTreeGetDestination(const JMapGMRouteTree *tree)
+{
+    return tree->destination;
+}
+
+// The cheaper label of a node; either may start the route, as one on foot boards any ride it takes.
+static uint32_t JMapGMRouteTreeGetLabel(const JMapGMRouteTree *tree, uint32_t node)
+{
+    return tree->costs[2 * node + 1] < tree->costs[2 * node] ? 2 * node + 1 : 2 * node;
+}
+
+double JMapGMRouteTreeGetCost(const JMapGMRouteTree *tree, uint32_t from)
+{
+    if (from >= tree->graph->nodeCount) return INFINITY;
+    return tree->costs[JMapGMRouteTreeGetLabel(tree, from)];
+}
+
+JMapGMRoute *JMapGMRouteTreeFind(const JMapGMRouteTree *tree, uint32_t from)
+{
+    JMAPGM_TRACE_SCOPE("route.tree.find");
+    const JMapGMRouteGraph *graph = tree->graph;
+    if (from >= graph->nodeCount) return NULL;
+    uint32_t start = JMapGMRouteTreeGetLabel(tree, from);
+    if (isinf(tree->costs[start])) return NULL;
+
+    size_t count = 0;
+    for (uint32_t label = start; label != JMAPGM_ROUTE_NO_NODE; label = tree->parents[label]) count++;
+    uint32_t *nodes = malloc(count * sizeof(uint32_t));
+    JMapGMPoint *points = malloc(count * sizeof(JMapGMPoint));
+    int32_t *floors = malloc(count * sizeof(int32_t));
+    double *costs = malloc(count * sizeof(double));
+    JMapGMRoute *route = NULL;
+    if (nodes && points && floors && costs) {
+        size_t i = 0;
+        for (uint32_t label = start; label != JMAPGM_ROUTE_NO_NODE; label = tree->parents[label], i++) {
+            uint32_t node = label / 2, next = tree->parents[label];
+            nodes[i] = node;
+            points[i] = graph->points[node];
+            floors[i] = graph->floors[node];
+            if (next != JMAPGM_ROUTE_NO_NODE) costs[i] = tree->costs[label] - tree->costs[next];
+        }
+        route = JMapGMRouteCreate(nodes, points, floors, costs, count);
+    }
+    free(nodes);
+    free(points);
+    free(floors);
+    free(costs);
+    return route;
+}
+
+typedef struct {
+    const JMapGMRouteTree *tree;
+    const uint32_t *nodes;
+    JMapGMPoint point;
+    uint32_t best;
+    double bestCost;
+} JMapGMRouteEntryQuery;
+
+static bool JMapGMRouteEntryVisit(uint32_t item, void *context)
+{
+    JMapGMRouteEntryQuery *query = context;
+    const JMapGMRouteGraph *graph = query->tree->graph;
+    uint32_t node = query->nodes[item];
+    double routeCost = JMapGMRouteTreeGetCost(query->tree, node);
+    if (routeCost > query->bestCost) return true;
+    double dx = graph->projected[node].x - query->point.x, dy = graph->projected[node].y - query->point.y;
+    double total = routeCost + sqrt(dx * dx + dy * dy) * query->tree->perMetre;
+    // Ties go to the lower node, so the answer does not depend on the order of the tree.
+    if (total < query->bestCost || (total == query->bestCost && node < query->best)) {
+        query->best = node;
+        query->bestCost = total;
+    }
+    return true;
+}
+
+uint32_t JMapGMRouteTreeFindEntry(const JMapGMRouteTree *tree, JMapGMPoint point, int32_t floor, double *cost)
+{
+    JMAPGM_TRACE_SCOPE("route.tree.entry");
+    const JMapGMRouteGraph *graph = tree->graph;
+    JMapGMRouteEntryQuery query = { tree, NULL, { (point.x - graph->origin.x) * graph->xScale, (point.y - graph->origin.y) * JMapGMMetresPerDegree },
+                                    JMAPGM_ROUTE_NO_NODE, INFINITY };
+    size_t f = JMapGMRouteGraphFindFloor(graph, floor);
+    if (f < graph->floorCount) {
+        const JMapGMRTree *floorTree = graph->floorTrees[f];
+        JMapGMRect floorBounds = JMapGMRTreeGetBounds(floorTree);
+        query.nodes = graph->floorNodes + graph->floorOffsets[f];
+        // Widens the square around the user until a waypoint outside it cannot win: it is more than
+        // `radius` away, so it costs more than radius * perMetre however cheap its route.
+        for (double radius = JMapGMRouteEntryRadius;; radius *= 4) {
+            JMapGMRect rect = { query.point.x - radius, query.point.y - radius, query.point.x + radius, query.point.y + radius };
+            JMapGMRTreeQuery(floorTree, rect, JMapGMRouteEntryVisit, &query);
+            if (query.bestCost <= radius * tree->perMetre) break;
+            if (rect.minX <= floorBounds.minX && rect.minY <= floorBounds.minY && rect.maxX >= floorBounds.maxX && rect.maxY >= floorBounds.maxY) break;
+        }
+    }
+    if (cost) *cost = query.bestCost;
+    return query.best;
+}
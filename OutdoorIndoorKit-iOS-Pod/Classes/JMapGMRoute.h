@@ -0,0 +1,297 @@
+//
+//  JMapGMRoute.h
+//  JMapOutdoorIndoorKit
+//
+//  Copyright © 2026 Jibestream. All rights reserved.
+//
+
+#ifndef JMapGMRoute_h
+#define JMapGMRoute_h
+
+#include "JMapGMTypes.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ *  A route as flat buffers in one allocation: the waypoints it passes, their coordinates, and one
+ *  segment per floor visited. Segment s spans nodes [segmentStarts[s], segmentStarts[s + 1]); its
+ *  cost covers the edges between those nodes plus the connector leaving it, so the segment costs
+ *  add up to cost. Coordinates are x = longitude, y = latitude.
+ */
+typedef struct {
+    size_t nodeCount;
+    const uint32_t *nodes;
+    const JMapGMPoint *points;
+    size_t segmentCount;
+    const int32_t *segmentFloors;
+    const uint32_t *segmentStarts;
+    const double *segmentCosts;
+    double cost;
+    /** Bytes of the allocation */
+    size_t size;
+} JMapGMRoute;
+
+/**
+ *  Packs a route, e.g. one precomputed elsewhere.
+ *
+ *  @param nodes The waypoints in order
+ *  @param points The coordinate of each waypoint
+ *  @param floors The floor of each waypoint
+ *  @param costs The cost of each of the count - 1 edges, or NULL for their length in metres
+ *  @param count The number of waypoints, at least 1
+ *  @return The route, or NULL if allocation failed
+ */
+JMapGMRoute *JMapGMRouteCreate(const uint32_t *nodes, const JMapGMPoint *points, const int32_t *floors, const double *costs, size_t count);
+
+/**
+ *  Releases a route.
+ */
+void JMapGMRouteRelease(JMapGMRoute *route);
+
+/**
+ *  The segment holding a node of the route, by binary search over the segment starts
+ */
+size_t JMapGMRouteGetSegment(const JMapGMRoute *route, size_t node);
+
+#pragma mark - Graph
+
+/**
+ *  The walkable network of a venue as an immutable compressed sparse row graph: each waypoint's
+ *  edges are one contiguous run. Edges are undirected and hold their length in metres, measured on
+ *  a projection around the venue, and their path type. Safe to share between threads once created.
+ */
+typedef struct JMapGMRouteGraph JMapGMRouteGraph;
+
+/**
+ *  Builds a graph.
+ *
+ *  @param points The coordinate of each waypoint
+ *  @param floors The floor of each waypoint
+ *  @param nodeCount The number of waypoints
+ *  @param edgeFrom One end of each edge
+ *  @param edgeTo The other end of each edge
+ *  @param edgePathTypes The travel model cost entry of each edge, 0 for corridors, or NULL
+ *  @param edgeCount The number of edges; edges with an end or a cost entry out of range are skipped
+ *  @return The graph, or NULL if allocation failed
+ */
+JMapGMRouteGraph *JMapGMRouteGraphCreate(const JMapGMPoint *points, const int32_t *floors, size_t nodeCount,
+                                         const uint32_t *edgeFrom, const uint32_t *edgeTo, const uint8_t *edgePathTypes, size_t edgeCount);
+
+/**
+ *  Releases a graph. Its searches must be released first.
+ */
+void JMapGMRouteGraphRelease(JMapGMRouteGraph *graph);
+
+size_t JMapGMRouteGraphGetNodeCount(const JMapGMRouteGraph *graph);
+
+/**
+ *  The coordinate of each waypoint, nodeCount of them
+ */
+const JMapGMPoint *JMapGMRouteGraphGetPoints(const JMapGMRouteGraph *graph);
+
+/**
+ *  The floor of each waypoint, nodeCount of them
+ */
+const int32_t *JMapGMRouteGraphGetFloors(const JMapGMRouteGraph *graph);
+
+/**
+ *  The number of directed edges, twice the undirected edges
+ */
+size_t JMapGMRouteGraphGetEdgeCount(const JMapGMRouteGraph *graph);
+
+/**
+ *  Bytes allocated by the graph
+ */
+size_t JMapGMRouteGraphGetMemoryUsage(const JMapGMRouteGraph *graph);
+
+#pragma mark - Travel time
+
+/** Cost entries of a travel model; graph edges of a higher path type are skipped */
+#define JMAPGM_ROUTE_PATH_TYPES 16
+
+/**
+ *  What edges of one path type cost in seconds. The path types of a venue are numbered by the
+ *  venue, so the caller decides which entry of the model each one uses.
+ */
+typedef struct {
+    /** Multiplies the walking time along the edge: 1 to walk, 0.5 on a moving walkway */
+    double walkFactor;
+    /** Seconds per edge that changes floor, e.g. an elevator's travel between two floors */
+    double secondsPerFloor;
+    /** Seconds to board, e.g. the wait for an elevator, charged once per ride over consecutive edges of the type */
+    double boardSeconds;
+    /** The accessibility of the type, 0 - 100 */
+    int32_t accessibility;
+} JMapGMPathTypeCost;
+
+/**
+ *  How long routes take, by cost entry. Entry 0 is the corridor.
+ */
+typedef struct {
+    /** Walking speed in metres per second */
+    double walkingSpeed;
+    /** Only path types at least this accessible are taken, 0 - 100 as for wayfinding */
+    int32_t accessibility;
+    JMapGMPathTypeCost pathTypes[JMAPGM_ROUTE_PATH_TYPES];
+} JMapGMTravelModel;
+
+/**
+ *  Cost entries JMapGMTravelModelMake fills in, for the caller to map a venue's path types onto
+ */
+typedef enum {
+    JMapGMPathTypeCorridor,
+    JMapGMPathTypeElevator,
+    JMapGMPathTypeStairs,
+    JMapGMPathTypeEscalator,
+} JMapGMPathTypeDefault;
+
+/**
+ *  A model of an average pedestrian: 1.3 m/s, slowing to 0.9 m/s as the accessibility asked for
+ *  rises to 100. Elevators wait 30 s and take 5 s a floor, stairs take 15 s a floor and are not
+ *  accessible, escalators take 10 s a floor plus 5 s to step on and have accessibility 50.
+ *
+ *  @param accessibility The accessibility asked for, 0 - 100
+ */
+JMapGMTravelModel JMapGMTravelModelMake(int32_t accessibility);
+
+#pragma mark - Search
+
+/**
+ *  Scratch space for searching a graph, reused from query to query without clearing. Each thread
+ *  searching a graph needs its own. Searches cost metres until given a travel model.
+ */
+typedef struct JMapGMRouteSearch JMapGMRouteSearch;
+
+/**
+ *  Creates a search over a graph, which must outlive it.
+ *
+ *  @return The search, or NULL if allocation failed
+ */
+JMapGMRouteSearch *JMapGMRouteSearchCreate(const JMapGMRouteGraph *graph);
+
+void JMapGMRouteSearchRelease(JMapGMRouteSearch *search);
+
+/**
+ *  Makes later queries cost seconds under a travel model, avoiding path types less accessible than
+ *  it asks for. Each waypoint is searched twice, on foot and riding, so that a ride over several
+ *  floors boards once.
+ *
+ *  @param model The model, or NULL to cost metres again
+ */
+void JMapGMRouteSearchSetModel(JMapGMRouteSearch *search, const JMapGMTravelModel *model);
+
+/**
+ *  Finds the cheapest route between two waypoints with A*, guided by the straight line distance.
+ *  Under a travel model the segment costs are the time spent on each floor, the connector leaving
+ *  it included.
+ *
+ *  @return The route, or NULL if to cannot be reached or allocation failed
+ */
+JMapGMRoute *JMapGMRouteSearchFind(JMapGMRouteSearch *search, uint32_t from, uint32_t to);
+
+/**
+ *  The cost of the cheapest route between two waypoints, without building the route.
+ *
+ *  @return The cost, or INFINITY if to cannot be reached
+ */
+double JMapGMRouteSearchCost(JMapGMRouteSearch *search, uint32_t from, uint32_t to);
+
+/**
+ *  The costs from one waypoint to many, in a single sweep that stops once every target is reached,
+ *  e.g. to sort search results by distance or annotate them with walking times.
+ *
+ *  @param costs Receives the cost of each target, INFINITY for those that cannot be reached
+ *  @return The number of targets reached
+ */
+size_t JMapGMRouteSearchCosts(JMapGMRouteSearch *search, uint32_t from, const uint32_t *targets, size_t count, double *costs);
+
+/**
+ *  What a search can reach within a cost. Owned by the search and valid until its next query.
+ */
+typedef struct {
+    /** The waypoints reached, in order of cost */
+    const uint32_t *nodes;
+    const double *costs;
+    size_t count;
+    /**
+     *  Where the limit falls along edges leaving the reach on one floor, so outlines of the reach
+     *  extend part way along them
+     */
+    const JMapGMPoint *frontier;
+    const int32_t *frontierFloors;
+    size_t frontierCount;
+} JMapGMRouteReach;
+
+/**
+ *  Everything within a cost of one waypoint, e.g. a 5 minute walk under a travel model, in a
+ *  Dijkstra sweep that stops at the limit, so its work grows with the area reached rather than the
+ *  venue. The sweep crosses floors, and venues joined into one graph.
+ *
+ *  @param limit The largest cost reached, in metres or in seconds under a travel model
+ *  @return The reach; empty if from is out of range or allocation failed
+ */
+JMapGMRouteReach JMapGMRouteSearchReach(JMapGMRouteSearch *search, uint32_t from, double limit);
+
+/**
+ *  Waypoint states taken off the queue by the last query, a measure of its work
+ */
+size_t JMapGMRouteSearchGetSettledCount(const JMapGMRouteSearch *search);
+
+#pragma mark - Route tree
+
+/**
+ *  The cheapest routes from every waypoint to one destination, from a single sweep out of the
+ *  destination. Edges cost the same both ways, so when a user leaves their route the route from
+ *  wherever they are is read off the tree, in time proportional to its length, instead of searching
+ *  again. Immutable once built; safe to share between threads. The graph must outlive it.
+ */
+typedef struct JMapGMRouteTree JMapGMRouteTree;
+
+/**
+ *  Builds the tree of routes to a waypoint under the search's travel model, if any.
+ *
+ *  @return The tree, or NULL if to is out of range or allocation failed
+ */
+JMapGMRouteTree *JMapGMRouteSearchTree(JMapGMRouteSearch *search, uint32_t to);
+
+void JMapGMRouteTreeRelease(JMapGMRouteTree *tree);
+
+/**
+ *  The destination of the tree
+ */
+uint32_t JMapGMRouteTreeGetDestination(const JMapGMRouteTree *tree);
+
+/**
+ *  The cost of the cheapest route from a waypoint to the destination.
+ *
+ *  @return The cost, or INFINITY if the destination cannot be reached from it
+ */
+double JMapGMRouteTreeGetCost(const JMapGMRouteTree *tree, uint32_t from);
+
+/**
+ *  The cheapest route from a waypoint to the destination, the same route a search would find.
+ *
+ *  @return The route, or NULL if the destination cannot be reached or allocation failed
+ */
+JMapGMRoute *JMapGMRouteTreeFind(const JMapGMRouteTree *tree, uint32_t from);
+
+/**
+ *  Where a user off the route should rejoin the network: the waypoint on their floor that
+ *  minimizes walking to it in a straight line, at corridor cost, plus its route to the destination.
+ *  Only waypoints around the user are visited, in squares widening from 16 m until none outside
+ *  could cost less. The straight walk ignores walls.
+ *
+ *  @param point The user's coordinate, x = longitude, y = latitude
+ *  @param floor The user's floor
+ *  @param cost Receives the straight walk plus the route cost, or NULL
+ *  @return The waypoint, or UINT32_MAX if no waypoint on the floor reaches the destination
+ */
+uint32_t JMapGMRouteTreeFindEntry(const JMapGMRouteTree *tree, JMapGMPoint point, int32_t floor, double *cost);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* JMapGMRoute_h */
@@ -0,0 +1,284 @@
+//
+//  JMapGMRouteMatcher.c
+//  JMapOutdoorIndoorKit
+//
+//  Copyright © 2026 Jibestream. All rights reserved.
+//
+
+#include "JMapGMRouteMatcher.h"
+
+#include <stdlib.h>
+
+// Grids larger than this coarsen their cells instead.
+static const size_t JMapGMMaxGridCells = 1 << 22;
+
+typedef struct {
+    JMapGMPoint a;
+    JMapGMPoint b;
+    double offset;
+    size_t polyline;
+    int32_t group;
+} JMapGMSegment;
+
+struct JMapGMSegmentIndex {
+    JMapGMSegment *segments;
+    size_t count;
+    size_t capacity;
+    size_t polylines;
+
+    /** The cell size asked for, and the one built: it doubles until the grid fits JMapGMMaxGridCells */
+    double configuredCellSize;
+    double cellSize;
+    JMapGMRect bounds;
+    size_t columns;
+    size_t rows;
+    uint32_t *cellStarts;
+    uint32_t *cellItems;
+};
+
+JMapGMSegmentIndex *JMapGMSegmentIndexCreate(double cellSize)
+{
+    JMapGMSegmentIndex *index = calloc(1, sizeof(JMapGMSegmentIndex));
+    if (!index) return NULL;
+    index->configuredCellSize = index->cellSize = cellSize > 0 ? cellSize : 1;
+    index->bounds = JMapGMRectNull;
+    return index;
+}
+
+void JMapGMSegmentIndexRelease(JMapGMSegmentIndex *index)
+{
+    if (!index) return;
+    free(index->segments);
+    free(index->cellStarts);
+    free(index->cellItems);
+    free(index);
+}
+
+bool JMapGMSegmentIndexAddPolyline(JMapGMSegmentIndex *index, const JMapGMPoint *points, size_t count, int32_t group)
+{
+    if (count < 2) return false;
+    size_t needed = index->count + count - 1;
+    if (needed > UINT32_MAX) return false;
+    if (needed > index->capacity) {
+        size_t capacity = index->capacity ? index->capacity : 64;
+        while (capacity < needed) capacity *= 2;
+        JMapGMSegment *segments = realloc(index->segments, capacity * sizeof(JMapGMSegment));
+        if (!segments) return false;
+        index->segments = segments;
+        index->capacity = capacity;
+    }
+
+    double offset = 0;
+    for (size_t i = 0; i + 1 < count; i++) {
+        JMapGMSegment *segment = &index->segments[index->count++];
+        segment->a = points[i];
+        segment->b = points[i + 1];
+        segment->offset = offset;
+        segment->polyline = index->polylines;
+        segment->group = group;
+        offset += hypot(points[i + 1].x - points[i].x, points[i + 1].y - points[i].y);
+    }
+    index->polylines++;
+    return true;
+}
+
+static JMapGMRect JMapGMSegmentBounds(const JMapGMSegment *segment)
+{
+    JMapGMRect rect = {
+        fmin(segment->a.x, segment->b.x), fmin(segment->a.y, segment->b.y),
+        fmax(segment->a.x, segment->b.x), fmax(segment->a.y, segment->b.y),
+    };
+    return rect;
+}
+
+static size_t JMapGMCellCoordinate(double value, double origin, double cellSize, size_t limit)
+{
+    double cell = floor((value - origin) / cellSize);
+    if (cell < 0) return 0;
+    if (cell >= (double)limit) return limit - 1;
+    return (size_t)cell;
+}
+
+bool JMapGMSegmentIndexBuild(JMapGMSegmentIndex *index)
+{
+    free(index->cellStarts);
+    free(index->cellItems);
+    index->cellStarts = NULL;
+    index->cellItems = NULL;
+    index->columns = index->rows = 0;
+    if (index->count == 0) return true;
+
+    JMapGMRect bounds = JMapGMRectNull;
+    for (size_t i = 0; i < index->count; i++) {
+        bounds = JMapGMRectUnion(bounds, JMapGMSegmentBounds(&index->segments[i]));
+    }
+    index->bounds = bounds;
+
+    double cellSize = index->configuredCellSize;
+    size_t columns, rows;
+    for (;;) {
+        columns = (size_t)((bounds.maxX - bounds.minX) / cellSize) + 1;
+        rows = (size_t)((bounds.maxY - bounds.minY) / cellSize) + 1;
+        if (columns * rows <= JMapGMMaxGridCells) break;
+        cellSize *= 2;
+    }
+    index->cellSize = cellSize;
+    index->columns = columns;
+    index->rows = rows;
+
+    // Two passes: count segments per cell, then fill the compact item array.
+    uint32_t *starts = calloc(columns * rows + 1, sizeof(uint32_t));
+    if (!starts) return false;
+    size_t total = 0;
+    for (size_t i = 0; i < index->count; i++) {
+        JMapGMRect rect = JMapGMSegmentBounds(&index->segments[i]);
+        size_t x0 = JMapGMCellCoordinate(rect.minX, bounds.minX, cellSize, columns);
+        size_t x1 = JMapGMCellCoordinate(rect.maxX, bounds.minX, cellSize, columns);
+        size_t y0 = JMapGMCellCoordinate(rect.minY, bounds.minY, cellSize, rows);
+        size_t y1 = JMapGMCellCoordinate(rect.maxY, bounds.minY, cellSize, rows);
+        for (size_t y = y0; y <= y1; y++) {
+            for (size_t x = x0; x <= x1; x++) {
+                starts[y * columns + x + 1]++;
+                total++;
+            }
+        }
+    }
+    if (total > UINT32_MAX) {
+        free(starts);
+        return false;
+    }
+    for (size_t cell = 0; cell < columns * rows; cell++) {
+        starts[cell + 1] += starts[cell];
+    }
+
+    uint32_t *items = malloc((total ? total : 1) * sizeof(uint32_t));
+    uint32_t *cursor = malloc(columns * rows * sizeof(uint32_t));
+    if (!items || !cursor) {
+        free(starts);
+        free(items);
+        free(cursor);
+        return false;
+    }
+    for (size_t cell = 0; cell < columns * rows; cell++) {
+        cursor[cell] = starts[cell];
+    }
+    for (size_t i = 0; i < index->count; i++) {
+        JMapGMRect rect = JMapGMSegmentBounds(&index->segments[i]);
+        size_t x0 = JMapGMCellCoordinate(rect.minX, bounds.minX, cellSize, columns);
+        size_t x1 = JMapGMCellCoordinate(rect.maxX, bounds.minX, cellSize, columns);
+        size_t y0 = JMapGMCellCoordinate(rect.minY, bounds.minY, cellSize, rows);
+        size_t y1 = JMapGMCellCoordinate(rect.maxY, bounds.minY, cellSize, rows);
+        for (size_t y = y0; y <= y1; y++) {
+            for (size_t x = x0; x <= x1; x++) {
+                items[cursor[y * columns + x]++] = (uint32_t)i;
+            }
+        }
+    }
+    free(cursor);
+
+    index->cellStarts = starts;
+    index->cellItems = items;
+    return true;
+}
+
+size_t JMapGMSegmentIndexGetSegmentCount(const JMapGMSegmentIndex *index)
+{
+    return index->count;
+}
+
+static JMapGMPoint JMapGMProjectOnSegment(const JMapGMSegment *segment, JMapGMPoint point, double *t)
+{
+    double dx = segment->b.x - segment->a.x;
+    double dy = segment->b.y - segment->a.y;
+    double lengthSquared = dx * dx + dy * dy;
+    double u = 0;
+    if (lengthSquared > 0) {
+        u = ((point.x - segment->a.x) * dx + (point.y - segment->a.y) * dy) / lengthSquared;
+        if (u < 0) u = 0;
+        if (u > 1) u = 1;
+    }
+    *t = u;
+    JMapGMPoint projected = { segment->a.x + u * dx, segment->a.y + u * dy };
+    return projected;
+}
+
+bool JMapGMSegmentIndexNearest(const JMapGMSegmentIndex *index, JMapGMPoint point, int32_t group, double maxDistance, JMapGMSnapResult *result)
+{
+    if (group < 0) return JMapGMSegmentIndexNearestInGroups(index, point, INT32_MIN, INT32_MAX, maxDistance, result);
+    return JMapGMSegmentIndexNearestInGroups(index, point, group, group, maxDistance, result);
+}
+
+bool JMapGMSegmentIndexNearestInGroups(const JMapGMSegmentIndex *index, JMapGMPoint point, int32_t firstGroup, int32_t lastGroup, double maxDistance, JMapGMSnapResult *result)
+{
+    if (!index->cellStarts || lastGroup < firstGroup) return false;
+    JMapGMRect query = { point.x - maxDistance, point.y - maxDistance, point.x + maxDistance, point.y + maxDistance };
+    if (!JMapGMRectIntersects(query, index->bounds)) return false;
+
+    const JMapGMRect bounds = index->bounds;
+    size_t x0 = JMapGMCellCoordinate(query.minX, bounds.minX, index->cellSize, index->columns);
+    size_t x1 = JMapGMCellCoordinate(query.maxX, bounds.minX, index->cellSize, index->columns);
+    size_t y0 = JMapGMCellCoordinate(query.minY, bounds.minY, index->cellSize, index->rows);
+    size_t y1 = JMapGMCellCoordinate(query.maxY, bounds.minY, index->cellSize, index->rows);
+
+    double best = maxDistance;
+    bool found = false;
+    for (size_t y = y0; y <= y1; y++) {
+        for (size_t x = x0; x <= x1; x++) {
+            size_t cell = y * index->columns + x;
+            for (uint32_t item = index->cellStarts[cell]; item < index->cellStarts[cell + 1]; item++) {
+                const JMapGMSegment *segment = &index->segments[index->cellItems[item]];
+                if (segment->group < firstGroup || segment->group > lastGroup) continue;
+                double t;
+                JMapGMPoint projected = JMapGMProjectOnSegment(segment, point, &t);
+                double distance = hypot(projected.x - point.x, projected.y - point.y);
+                if (distance > best || (found && distance == best)) continue;
+                best = distance;
+                found = true;
+                result->point = projected;
+                result->distance = distance;
+                result->offset = segment->offset + t * hypot(segment->b.x - segment->a.x, segment->b.y - segment->a.y);
+                result->polyline = segment->polyline;
+                result->segment = index->cellItems[item];
+                result->group = segment->group;
+            }
+        }
+    }
+    return found;
+}
+
+void JMapGMRouteMatcherInit(JMapGMRouteMatcher *matcher, const JMapGMSegmentIndex *index, JMapGMRouteMatcherConfig config)
+{
+    matcher->config = config;
+    matcher->index = index;
+    matcher->offRouteRun = 0;
+    matcher->stats = (JMapGMRouteMatcherStats){ 0 };
+}
+
+JMapGMMatchState JMapGMRouteMatcherMatch(JMapGMRouteMatcher *matcher, JMapGMPoint point, int32_t group, JMapGMSnapResult *result)
+{
+    if (group < 0) return JMapGMRouteMatcherMatchGroups(matcher, point, INT32_MIN, INT32_MAX, result);
+    return JMapGMRouteMatcherMatchGroups(matcher, point, group, group, result);
+}
+
+JMapGMMatchState JMapGMRouteMatcherMatchGroups(JMapGMRouteMatcher *matcher, JMapGMPoint point, int32_t firstGroup, int32_t lastGroup, JMapGMSnapResult *result)
+{
+    const JMapGMRouteMatcherConfig *config = &matcher->config;
+    matcher->stats.fixes++;
+
+    bool near = JMapGMSegmentIndexNearestInGroups(matcher->index, point, firstGroup, lastGroup, config->rerouteDistance, result);
+    if (near) {
+        matcher->offRouteRun = 0;
+        if (result->distance <= config->snapDistance) {
+            matcher->stats.snapped++;
+            return JMapGMMatchStateSnapped;
+        }
+        return JMapGMMatchStateUnmatched;
+    }
+
+    // A single stray fix is usually noise; only a sustained deviation re-routes.
+    matcher->stats.offRoute++;
+    if (++matcher->offRouteRun < config->rerouteCount) return JMapGMMatchStateUnmatched;
+    matcher->offRouteRun = 0;
+    matcher->stats.reroutes++;
+    return JMapGMMatchStateReroute;
+}
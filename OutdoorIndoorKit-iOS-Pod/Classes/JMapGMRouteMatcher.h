@@ -0,0 +1,172 @@
+//
+//  JMapGMRouteMatcher.h
+//  JMapOutdoorIndoorKit
+//
+//  Copyright © 2026 Jibestream. All rights reserved.
+//
+
+#ifndef JMapGMRouteMatcher_h
+#define JMapGMRouteMatcher_h
+
+#include "JMapGMTypes.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ *  Uniform grid over polyline segments for nearest-segment queries.
+ *  Polylines are tagged with a group, typically one per floor.
+ */
+typedef struct JMapGMSegmentIndex JMapGMSegmentIndex;
+
+/**
+ *  Creates an empty index.
+ *
+ *  @param cellSize Grid cell edge length, ideally close to the typical query radius
+ */
+JMapGMSegmentIndex *JMapGMSegmentIndexCreate(double cellSize);
+
+/**
+ *  Releases an index created with JMapGMSegmentIndexCreate.
+ */
+void JMapGMSegmentIndexRelease(JMapGMSegmentIndex *index);
+
+/**
+ *  Adds a polyline. Must be called before JMapGMSegmentIndexBuild.
+ *
+ *  @param points The polyline vertices
+ *  @param count Number of vertices, at least 2
+ *  @param group Caller defined tag used to restrict queries
+ *  @return false if the polyline could not be stored
+ */
+bool JMapGMSegmentIndexAddPolyline(JMapGMSegmentIndex *index, const JMapGMPoint *points, size_t count, int32_t group);
+
+/**
+ *  Builds the grid. Queries are only valid after this call.
+ */
+bool JMapGMSegmentIndexBuild(JMapGMSegmentIndex *index);
+
+/**
+ *  Number of segments in the index
+ */
+size_t JMapGMSegmentIndexGetSegmentCount(const JMapGMSegmentIndex *index);
+
+/**
+ *  Nearest point on the indexed segments
+ */
+typedef struct {
+    /** The projected point on the segment */
+    JMapGMPoint point;
+    /** Distance from the query point */
+    double distance;
+    /** Distance along the polyline from its first vertex to point */
+    double offset;
+    /** Index of the polyline, in insertion order */
+    size_t polyline;
+    /** Index of the segment within all segments */
+    size_t segment;
+    int32_t group;
+} JMapGMSnapResult;
+
+/**
+ *  Finds the nearest segment within a radius.
+ *
+ *  @param point The query point
+ *  @param group Only segments with this group are considered, or -1 for all groups
+ *  @param maxDistance Search radius
+ *  @param result Receives the nearest point
+ *  @return false if no segment lies within maxDistance
+ */
+bool JMapGMSegmentIndexNearest(const JMapGMSegmentIndex *index, JMapGMPoint point, int32_t group, double maxDistance, JMapGMSnapResult *result);
+
+/**
+ *  Finds the nearest segment within a radius among a range of groups, such as all polylines of a floor
+ *  when polylines are numbered floor by floor.
+ *
+ *  @param point The query point
+ *  @param firstGroup The first group considered
+ *  @param lastGroup The last group considered; nothing is found if it is less than firstGroup
+ *  @param maxDistance Search radius
+ *  @param result Receives the nearest point
+ *  @return false if no segment lies within maxDistance
+ */
+bool JMapGMSegmentIndexNearestInGroups(const JMapGMSegmentIndex *index, JMapGMPoint point, int32_t firstGroup, int32_t lastGroup, double maxDistance, JMapGMSnapResult *result);
+
+/**
+ *  Tuning for JMapGMRouteMatcher
+ */
+typedef struct {
+    /** Positions within this distance of the route are snapped onto it */
+    double snapDistance;
+    /** Positions further than this from the route count as off route */
+    double rerouteDistance;
+    /** Consecutive off route positions required before asking for a re-route */
+    unsigned rerouteCount;
+} JMapGMRouteMatcherConfig;
+
+/**
+ *  Outcome of matching one position
+ */
+typedef enum {
+    /** The position was snapped onto the route */
+    JMapGMMatchStateSnapped,
+    /** Not snapped: the position is off the route but has not yet been off long enough to re-route */
+    JMapGMMatchStateUnmatched,
+    /** The position has been off route long enough to re-route */
+    JMapGMMatchStateReroute,
+} JMapGMMatchState;
+
+/**
+ *  Replay statistics of a matcher
+ */
+typedef struct {
+    size_t fixes;
+    size_t snapped;
+    /** Positions beyond rerouteDistance */
+    size_t offRoute;
+    /** Re-routes actually requested */
+    size_t reroutes;
+} JMapGMRouteMatcherStats;
+
+/**
+ *  Snaps positions onto a route or walkable network with re-route hysteresis.
+ *  Not thread safe.
+ */
+typedef struct {
+    JMapGMRouteMatcherConfig config;
+    const JMapGMSegmentIndex *index;
+    unsigned offRouteRun;
+    JMapGMRouteMatcherStats stats;
+} JMapGMRouteMatcher;
+
+/**
+ *  Initializes a matcher over a built index. The index must outlive the matcher.
+ */
+void JMapGMRouteMatcherInit(JMapGMRouteMatcher *matcher, const JMapGMSegmentIndex *index, JMapGMRouteMatcherConfig config);
+
+/**
+ *  Matches one position.
+ *
+ *  @param point The raw position
+ *  @param group The floor group of the position, or -1 for all groups
+ *  @param result Receives the nearest route point when one exists within rerouteDistance
+ */
+JMapGMMatchState JMapGMRouteMatcherMatch(JMapGMRouteMatcher *matcher, JMapGMPoint point, int32_t group, JMapGMSnapResult *result);
+
+/**
+ *  Matches one position against a range of groups. An empty range counts as off route, which is
+ *  what a position on a floor the route does not visit is.
+ *
+ *  @param point The raw position
+ *  @param firstGroup The first group considered
+ *  @param lastGroup The last group considered
+ *  @param result Receives the nearest route point when one exists within rerouteDistance
+ */
+JMapGMMatchState JMapGMRouteMatcherMatchGroups(JMapGMRouteMatcher *matcher, JMapGMPoint point, int32_t firstGroup, int32_t lastGroup, JMapGMSnapResult *result);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* JMapGMRouteMatcher_h */
@@ -0,0 +1,320 @@
+//
+//  JMapGMRouteResult.h
+//  JMapOutdoorIndoorKit
+//
+//  Copyright © 2026 Jibestream. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import <GoogleMaps/GoogleMaps.h>
+#import "JMapGMRoute.h"
+
+/**
+ *  The JMapGMRouteResult object
+ *
+ *  A route as compact buffers: the waypoints it passes, their coordinates, one segment per floor
+ *  and the cost of each. Nothing is drawn until polylines is first read, so distances, floors and
+ *  waypoint sequences can be computed for many routes without allocating a single overlay.
+ *  Immutable apart from the polylines; safe to read from any thread.
+ */
+@interface JMapGMRouteResult : NSObject
+
+/**
+ *  The packed route, owned by the result
+ */
+@property (nonatomic, readonly, nonnull) const JMapGMRoute *route;
+/**
+ *  The total cost: the length in metres for routes found by distance, the time in seconds for
+ *  the fastest routes
+ */
+@property (nonatomic, readonly) double cost;
+/**
+ *  The number of waypoints the route passes, start and end included
+ */
+@property (nonatomic, readonly) NSUInteger waypointCount;
+/**
+ *  The number of segments, one per floor visited in order
+ */
+@property (nonatomic, readonly) NSUInteger segmentCount;
+
+/**
+ *  Wrap a packed route
+ *
+ *  @param route The route, released with the result
+ *  @param waypointIds The waypoint id of each graph node as int64_t, or nil if the nodes are the ids
+ */
+- (nonnull instancetype)initWithRoute:(nonnull JMapGMRoute *)route waypointIds:(nullable NSData *)waypointIds;
+
+- (NSInteger)waypointIdAtIndex:(NSUInteger)index;
+- (CLLocationCoordinate2D)coordinateAtIndex:(NSUInteger)index;
+
+/**
+ *  The floor id of a segment
+ */
+- (NSInteger)floorIdOfSegment:(NSUInteger)segment;
+
+/**
+ *  The waypoints of a segment, as indices into the route
+ */
+- (NSRange)rangeOfSegment:(NSUInteger)segment;
+
+/**
+ *  The cost of a segment, including the connector leaving its floor
+ */
+- (double)costOfSegment:(NSUInteger)segment;
+
+/**
+ *  A new path through the waypoints of a segment
+ */
+- (nonnull GMSPath *)pathOfSegment:(NSUInteger)segment;
+
+/**
+ *  One polyline per segment, as wayfinding returns them. Built on first read and kept; must be
+ *  first read on the main thread.
+ */
+@property (nonatomic, readonly, nonnull) NSArray<GMSPolyline *> *polylines;
+/**
+ *  Whether polylines has been built
+ */
+@property (nonatomic, readonly) BOOL hasPolylines;
+
+/**
+ *  The polylines of the segments on one floor
+ *
+ *  @param floorId The floor id
+ *  @return The polylines, empty if the route does not visit the floor
+ */
+- (nonnull NSArray<GMSPolyline *> *)polylinesOnFloorId:(NSInteger)floorId;
+
+/**
+ *  The segments that differ from those of a previous route to the same destination, e.g. after a
+ *  re-route. Segments are compared from the destination back, by floor and waypoints; the polylines
+ *  drawn for the other segments of the previous route can stay on the map.
+ *
+ *  @param route The route drawn so far
+ *  @return The indices of this route's segments to draw
+ */
+- (nonnull NSIndexSet *)segmentsChangedFromRoute:(nonnull JMapGMRouteResult *)route;
+
+@end
+
+/**
+ *  The JMapGMReachability object
+ *
+ *  Everything within a cost of one waypoint, e.g. a 5 minute walk: the waypoints reached in order
+ *  of cost and, on demand, an outline of the reach on each floor. Computed by one sweep that stops
+ *  at the limit, cheap enough to recompute at each location update. Immutable; safe to read from
+ *  any thread.
+ */
+@interface JMapGMReachability : NSObject
+
+/**
+ *  The largest cost reached, in metres or seconds
+ */
+@property (nonatomic, readonly) double limit;
+/**
+ *  The number of waypoints reached, the start included
+ */
+@property (nonatomic, readonly) NSUInteger waypointCount;
+
+/**
+ *  A waypoint reached, in order of cost
+ */
+- (NSInteger)waypointIdAtIndex:(NSUInteger)index;
+- (double)costAtIndex:(NSUInteger)index;
+
+/**
+ *  The cost to a waypoint
+ *
+ *  @return The cost, or -1 if the waypoint is out of reach
+ */
+- (double)costOfWaypointId:(NSInteger)waypointId;
+
+/**
+ *  The costs to items with one or more waypoints, e.g. destinations by their entrances or units by
+ *  their doors, each at its cheapest waypoint
+ *
+ *  @param waypointIds The waypoint ids of each item
+ *  @return The cost of each item, -1 for those out of reach
+ */
+- (nonnull NSArray<NSNumber *> *)costsOfItemsWithWaypointIds:(nonnull NSArray<NSArray<NSNumber *> *> *)waypointIds;
+
+/**
+ *  The convex outline of the reach on each floor by floor id, through the waypoints reached and
+ *  the points where the limit falls along the paths leaving them. Built on first read; floors
+ *  reached only along a line have none.
+ */
+@property (nonatomic, readonly, nonnull) NSDictionary<NSNumber *, GMSPath *> *outlinesByFloorId;
+
+@end
+
+/**
+ *  The JMapGMRerouter object
+ *
+ *  The cheapest routes from every waypoint to one destination, from a single sweep out of the
+ *  destination. When a user leaves their route, the route from wherever they are is read off it
+ *  without searching again. Built once per destination; immutable and safe to read from any thread.
+ */
+@interface JMapGMRerouter : NSObject
+
+/**
+ *  The destination of every route
+ */
+@property (nonatomic, readonly) NSInteger destinationWaypointId;
+
+/**
+ *  The cost of the cheapest route from a waypoint, in the units of the graph query that built it
+ *
+ *  @return The cost, or -1 if the destination cannot be reached from the waypoint
+ */
+- (double)costFromWaypointId:(NSInteger)waypointId;
+
+/**
+ *  The cheapest route from a waypoint to the destination
+ *
+ *  @return The route, or nil if there is none
+ */
+- (nullable JMapGMRouteResult *)routeFromWaypointId:(NSInteger)waypointId;
+
+/**
+ *  The route for a user who left their route, from the waypoint on their floor where walking to it
+ *  and on to the destination is cheapest. Diff it against the drawn route with
+ *  segmentsChangedFromRoute: to redraw only what changed.
+ *
+ *  @param coordinate The user's location
+ *  @param floorId The floor id of the user's floor
+ *  @return The route, or nil if no waypoint on the floor reaches the destination
+ */
+- (nullable JMapGMRouteResult *)routeFromCoordinate:(CLLocationCoordinate2D)coordinate floorId:(NSInteger)floorId;
+
+@end
+
+/**
+ *  The JMapGMWayfindingGraph object
+ *
+ *  The walkable network of a venue for headless routing: waypoints with their coordinates and
+ *  floors, joined by paths. Routes are found by distance, or by time under a travel model, without
+ *  touching the map. Waypoints and paths are added first; the graph is packed on the first query
+ *  after a change. Queries are safe from any thread and run concurrently.
+ */
+@interface JMapGMWayfindingGraph : NSObject
+
+/**
+ *  The number of waypoints added
+ */
+@property (nonatomic, readonly) NSUInteger waypointCount;
+/**
+ *  How long paths take for the fastest routes and travel times, JMapGMTravelModelMake(0) by default.
+ *  Each path type uses the entry chosen with setCostEntry:forPathTypeId:.
+ *  The accessibility given to each query replaces the model's.
+ */
+@property (atomic) JMapGMTravelModel travelModel;
+
+/**
+ *  Add a waypoint. Adding an id again moves the waypoint.
+ *
+ *  @param waypointId The waypoint id
+ *  @param coordinate The coordinate
+ *  @param floorId The floor id
+ */
+- (void)addWaypointWithId:(NSInteger)waypointId coordinate:(CLLocationCoordinate2D)coordinate floorId:(NSInteger)floorId;
+
+/**
+ *  Choose which entry of the travel model costs paths of a path type. Path type ids are set per
+ *  venue, so only 0, the corridor, has an entry until mapped. Map a path type before adding its paths.
+ *
+ *  @param entry An index into the travel model's pathTypes, e.g. JMapGMPathTypeElevator
+ *  @param pathTypeId The id of a JMapPathType, as for showPathType:atWaypoint:
+ *  @return NO if entry is not below JMAPGM_ROUTE_PATH_TYPES
+ */
+- (BOOL)setCostEntry:(NSUInteger)entry forPathTypeId:(NSInteger)pathTypeId;
+
+/**
+ *  Add a walkable path between two waypoints, in both directions. Paths to waypoints never added are ignored.
+ *
+ *  @param fromWaypointId One end
+ *  @param toWaypointId The other end
+ *  @param pathType The id of the path's JMapPathType, 0 for corridors, mapped with setCostEntry:forPathTypeId:
+ *  @return NO, without adding the path, if its path type has no cost entry
+ */
+- (BOOL)addPathFromWaypointId:(NSInteger)fromWaypointId toWaypointId:(NSInteger)toWaypointId pathType:(NSInteger)pathType;
+
+/**
+ *  The shortest route between two waypoints
+ *
+ *  @return The route, or nil if there is none
+ */
+- (nullable JMapGMRouteResult *)routeFromWaypointId:(NSInteger)fromWaypointId toWaypointId:(NSInteger)toWaypointId;
+
+/**
+ *  The length of the shortest route between two waypoints, without building it
+ *
+ *  @return The length in metres, or -1 if there is no route
+ */
+- (CLLocationDistance)distanceFromWaypointId:(NSInteger)fromWaypointId toWaypointId:(NSInteger)toWaypointId;
+
+/**
+ *  The lengths of the shortest routes from one waypoint to many in one sweep, e.g. to sort search results
+ *
+ *  @param waypointIds The targets
+ *  @return The length in metres to each target, -1 for those without a route
+ */
+- (nonnull NSArray<NSNumber *> *)distancesFromWaypointId:(NSInteger)fromWaypointId toWaypointIds:(nonnull NSArray<NSNumber *> *)waypointIds;
+
+/**
+ *  The quickest route between two waypoints under the travel model, e.g. taking the stairs up one
+ *  floor but the elevator up five
+ *
+ *  @param accessibility Only path types at least this accessible are taken, 0 - 100 as for wayfinding
+ *  @return The route, its costs in seconds, or nil if there is none
+ */
+- (nullable JMapGMRouteResult *)fastestRouteFromWaypointId:(NSInteger)fromWaypointId toWaypointId:(NSInteger)toWaypointId accessibility:(NSInteger)accessibility;
+
+/**
+ *  The travel times of the quickest routes from one waypoint to many in one sweep, e.g. to show an
+ *  ETA next to each search result
+ *
+ *  @param waypointIds The targets
+ *  @param accessibility Only path types at least this accessible are taken, 0 - 100 as for wayfinding
+ *  @return The time in seconds to each target, -1 for those without a route
+ */
+- (nonnull NSArray<NSNumber *> *)travelTimesFromWaypointId:(NSInteger)fromWaypointId toWaypointIds:(nonnull NSArray<NSNumber *> *)waypointIds accessibility:(NSInteger)accessibility;
+
+/**
+ *  Everything within a walking distance of a waypoint, across floors, and venues whose waypoints
+ *  were added to the graph joined by paths
+ *
+ *  @param distance The distance in metres
+ *  @return The reach, or nil if the waypoint was never added
+ */
+- (nullable JMapGMReachability *)reachabilityFromWaypointId:(NSInteger)waypointId withinDistance:(CLLocationDistance)distance;
+
+/**
+ *  Everything within a travel time of a waypoint under the travel model, e.g. 300 seconds for a 5
+ *  minute walk
+ *
+ *  @param seconds The travel time
+ *  @param accessibility Only path types at least this accessible are taken, 0 - 100 as for wayfinding
+ *  @return The reach, or nil if the waypoint was never added
+ */
+- (nullable JMapGMReachability *)reachabilityFromWaypointId:(NSInteger)waypointId withinSeconds:(NSTimeInterval)seconds accessibility:(NSInteger)accessibility;
+
+/**
+ *  Shortest routes to a waypoint from anywhere, for re-routing users who leave their route
+ *
+ *  @param waypointId The destination
+ *  @return The rerouter, its costs in metres, or nil if the waypoint was never added
+ */
+- (nullable JMapGMRerouter *)rerouterToWaypointId:(NSInteger)waypointId;
+
+/**
+ *  Quickest routes to a waypoint from anywhere under the travel model, for re-routing users who
+ *  leave their route
+ *
+ *  @param waypointId The destination
+ *  @param accessibility Only path types at least this accessible are taken, 0 - 100 as for wayfinding
+ *  @return The rerouter, its costs in seconds, or nil if the waypoint was never added
+ */
+- (nullable JMapGMRerouter *)fastestRerouterToWaypointId:(NSInteger)waypointId accessibility:(NSInteger)accessibility;
+
+@end
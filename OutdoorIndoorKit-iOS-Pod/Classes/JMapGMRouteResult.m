@@ -0,0 +1,612 @@
+//
+//  JMapGMRouteResult.m
+//  JMapOutdoorIndoorKit
+//
+//  Copyright © 2026 Jibestream. All rights reserved.
+//
+
+#import "JMapGMRouteResult.h"
+#import "JMapGMPolygon.h"
+#import "JMapGMTrace.h"
+
+@implementation JMapGMRouteResult
+{
+    JMapGMRoute *_route;
+    NSData *_waypointIds;
+    NSArray<GMSPolyline *> *_polylines;
+}
+
+- (instancetype)initWithRoute:(JMapGMRoute *)route waypointIds:(NSData *)waypointIds
+{
+    self = [super init];
+    if (self) {
+        _route = route;
+        _waypointIds = waypointIds;
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    JMapGMRouteRelease(_route);
+}
+
+- (const JMapGMRoute *)route
+{
+    return _route;
+}
+
+- (double)cost
+{
+    return _route->cost;
+}
+
+- (NSUInteger)waypointCount
+{
+    return _route->nodeCount;
+}
+
+- (NSUInteger)segmentCount
+{
+    return _route->segmentCount;
+}
+
+- (NSInteger)waypointIdAtIndex:(NSUInteger)index
+{
+    uint32_t node = _route->nodes[index];
+    if (!_waypointIds) return node;
+    return (NSInteger)((const int64_t *)_waypointIds.bytes)[node];
+}
+
+- (CLLocationCoordinate2D)coordinateAtIndex:(NSUInteger)index
+{
+    JMapGMPoint point = _route->points[index];
+    return CLLocationCoordinate2DMake(point.y, point.x);
+}
+
+- (NSInteger)floorIdOfSegment:(NSUInteger)segment
+{
+    return _route->segmentFloors[segment];
+}
+
+- (NSRange)rangeOfSegment:(NSUInteger)segment
+{
+    uint32_t start = _route->segmentStarts[segment];
+    return NSMakeRange(start, _route->segmentStarts[segment + 1] - start);
+}
+
+- (double)costOfSegment:(NSUInteger)segment
+{
+    return _route->segmentCosts[segment];
+}
+
+- (GMSPath *)pathOfSegment:(NSUInteger)segment
+{
+    NSRange range = [self rangeOfSegment:segment];
+    GMSMutablePath *path = [GMSMutablePath path];
+    for (NSUInteger i = range.location; i < NSMaxRange(range); i++) [path addCoordinate:[self coordinateAtIndex:i]];
+    return path;
+}
+
+- (NSArray<GMSPolyline *> *)polylines
+{
+    @synchronized (self) {
+        if (!_polylines) {
+            JMAPGM_TRACE_SCOPE("route.polylines");
+            NSMutableArray<GMSPolyline *> *polylines = [NSMutableArray arrayWithCapacity:_route->segmentCount];
+            for (NSUInteger s = 0; s < _route->segmentCount; s++) {
+                [polylines addObject:[GMSPolyline polylineWithPath:[self pathOfSegment:s]]];
+            }
+            _polylines = polylines;
+        }
+        return _polylines;
+    }
+}
+
+- (BOOL)hasPolylines
+{
+    @synchronized (self) {
+        return _polylines != nil;
+    }
+}
+
+- (NSArray<GMSPolyline *> *)polylinesOnFloorId:(NSInteger)floorId
+{
+    NSArray<GMSPolyline *> *polylines = self.polylines;
+    NSMutableArray<GMSPolyline *> *onFloor = [NSMutableArray array];
+    for (NSUInteger s = 0; s < _route->segmentCount; s++) {
+        if (_route->segmentFloors[s] == floorId) [onFloor addObject:polylines[s]];
+    }
+    return onFloor;
+}
+
+- (NSIndexSet *)segmentsChangedFromRoute:(JMapGMRouteResult *)route
+{
+    const JMapGMRoute *previous = route.route;
+    NSMutableIndexSet *changed = [NSMutableIndexSet indexSetWithIndexesInRange:NSMakeRange(0, _route->segmentCount)];
+    // Both routes end at the destination, so the segments that survive a re-route are the last ones.
+    for (size_t s = _route->segmentCount, p = previous->segmentCount; s > 0 && p > 0; s--, p--) {
+        size_t start = _route->segmentStarts[s - 1], count = _route->segmentStarts[s] - start;
+        size_t previousStart = previous->segmentStarts[p - 1];
+        if (_route->segmentFloors[s - 1] != previous->segmentFloors[p - 1] || previous->segmentStarts[p] - previousStart != count ||
+            memcmp(&_route->nodes[start], &previous->nodes[previousStart], count * sizeof(uint32_t)) != 0) break;
+        [changed removeIndex:s - 1];
+    }
+    return changed;
+}
+
+@end
+
+/**
+ *  One packing of a wayfinding graph with its idle searches. Queries hold it while they run, so
+ *  packing again after a change never frees a graph that is being searched.
+ */
+@interface JMapGMPackedGraph : NSObject
+@property (nonatomic, readonly) JMapGMRouteGraph *graph;
+/** The waypoint id of each node as int64_t */
+@property (nonatomic, readonly) NSData *waypointIds;
+@property (nonatomic, readonly) NSDictionary<NSNumber *, NSNumber *> *nodes;
+- (JMapGMRouteSearch *)checkOutSearch;
+- (void)checkInSearch:(JMapGMRouteSearch *)search;
+@end
+
+@implementation JMapGMPackedGraph
+{
+    NSMutableArray<NSValue *> *_searches;
+}
+
+- (instancetype)initWithGraph:(JMapGMRouteGraph *)graph waypointIds:(NSData *)waypointIds nodes:(NSDictionary<NSNumber *, NSNumber *> *)nodes
+{
+    self = [super init];
+    if (self) {
+        _graph = graph;
+        _waypointIds = waypointIds;
+        _nodes = nodes;
+        _searches = [NSMutableArray array];
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    for (NSValue *search in _searches) JMapGMRouteSearchRelease(search.pointerValue);
+    JMapGMRouteGraphRelease(_graph);
+}
+
+- (JMapGMRouteSearch *)checkOutSearch
+{
+    @synchronized (_searches) {
+        NSValue *search = _searches.lastObject;
+        if (search) {
+            [_searches removeLastObject];
+            return search.pointerValue;
+        }
+    }
+    return JMapGMRouteSearchCreate(_graph);
+}
+
+- (void)checkInSearch:(JMapGMRouteSearch *)search
+{
+    if (!search) return;
+    @synchronized (_searches) {
+        [_searches addObject:[NSValue valueWithPointer:search]];
+    }
+}
+
+@end
+
+@implementation JMapGMReachability
+{
+    JMapGMPackedGraph *_packed;
+    NSData *_nodes;
+    NSData *_costs;
+    NSData *_frontier;
+    NSData *_frontierFloors;
+    NSDictionary<NSNumber *, NSNumber *> *_costsByNode;
+    NSDictionary<NSNumber *, GMSPath *> *_outlines;
+}
+
+// Copies the reach out of the search, which goes back to the pool.
+- (instancetype)initWithReach:(JMapGMRouteReach)reach limit:(double)limit packedGraph:(JMapGMPackedGraph *)packed
+{
+    self = [super init];
+    if (self) {
+        _limit = limit;
+        _packed = packed;
+        _nodes = [NSData dataWithBytes:reach.nodes length:reach.count * sizeof(uint32_t)];
+        _costs = [NSData dataWithBytes:reach.costs length:reach.count * sizeof(double)];
+        _frontier = [NSData dataWithBytes:reach.frontier length:reach.frontierCount * sizeof(JMapGMPoint)];
+        _frontierFloors = [NSData dataWithBytes:reach.frontierFloors length:reach.frontierCount * sizeof(int32_t)];
+    }
+    return self;
+}
+
+- (NSUInteger)waypointCount
+{
+    return _nodes.length / sizeof(uint32_t);
+}
+
+- (NSInteger)waypointIdAtIndex:(NSUInteger)index
+{
+    uint32_t node = ((const uint32_t *)_nodes.bytes)[index];
+    return (NSInteger)((const int64_t *)_packed.waypointIds.bytes)[node];
+}
+
+- (double)costAtIndex:(NSUInteger)index
+{
+    return ((const double *)_costs.bytes)[index];
+}
+
+// The cost of each node reached, built on first lookup.
+- (NSDictionary<NSNumber *, NSNumber *> *)costsByNode
+{
+    @synchronized (self) {
+        if (!_costsByNode) {
+            NSUInteger count = self.waypointCount;
+            NSMutableDictionary<NSNumber *, NSNumber *> *costs = [NSMutableDictionary dictionaryWithCapacity:count];
+            const uint32_t *nodes = _nodes.bytes;
+            for (NSUInteger i = 0; i < count; i++) costs[@(nodes[i])] = @([self costAtIndex:i]);
+            _costsByNode = costs;
+        }
+        return _costsByNode;
+    }
+}
+
+- (double)costOfWaypointId:(NSInteger)waypointId
+{
+    NSNumber *node = _packed.nodes[@(waypointId)];
+    NSNumber *cost = node ? self.costsByNode[node] : nil;
+    return cost ? cost.doubleValue : -1;
+}
+
+- (NSArray<NSNumber *> *)costsOfItemsWithWaypointIds:(NSArray<NSArray<NSNumber *> *> *)waypointIds
+{
+    NSMutableArray<NSNumber *> *costs = [NSMutableArray arrayWithCapacity:waypointIds.count];
+    for (NSArray<NSNumber *> *itemWaypointIds in waypointIds) {
+        double best = -1;
+        for (NSNumber *waypointId in itemWaypointIds) {
+            double cost = [self costOfWaypointId:waypointId.integerValue];
+            if (cost >= 0 && (best < 0 || cost < best)) best = cost;
+        }
+        [costs addObject:@(best)];
+    }
+    return costs;
+}
+
+- (NSDictionary<NSNumber *, GMSPath *> *)outlinesByFloorId
+{
+    @synchronized (self) {
+        if (_outlines) return _outlines;
+        JMAPGM_TRACE_SCOPE("reach.outlines");
+        const JMapGMPoint *points = JMapGMRouteGraphGetPoints(_packed.graph);
+        const int32_t *floors = JMapGMRouteGraphGetFloors(_packed.graph);
+        NSMutableDictionary<NSNumber *, NSMutableData *> *pointsByFloor = [NSMutableDictionary dictionary];
+        void (^add)(JMapGMPoint, int32_t) = ^(JMapGMPoint point, int32_t floor) {
+            NSMutableData *floorPoints = pointsByFloor[@(floor)];
+            if (!floorPoints) pointsByFloor[@(floor)] = floorPoints = [NSMutableData data];
+            [floorPoints appendBytes:&point length:sizeof(point)];
+        };
+        const uint32_t *nodes = _nodes.bytes;
+        for (NSUInteger i = 0; i < self.waypointCount; i++) add(points[nodes[i]], floors[nodes[i]]);
+        const JMapGMPoint *frontier = _frontier.bytes;
+        const int32_t *frontierFloors = _frontierFloors.bytes;
+        for (NSUInteger i = 0; i < _frontier.length / sizeof(JMapGMPoint); i++) add(frontier[i], frontierFloors[i]);
+
+        NSMutableDictionary<NSNumber *, GMSPath *> *outlines = [NSMutableDictionary dictionaryWithCapacity:pointsByFloor.count];
+        [pointsByFloor enumerateKeysAndObjectsUsingBlock:^(NSNumber *floorId, NSMutableData *floorPoints, BOOL *stop) {
+            size_t count = floorPoints.length / sizeof(JMapGMPoint);
+            NSMutableData *hull = [NSMutableData dataWithLength:2 * count * sizeof(JMapGMPoint)];
+            size_t hullCount = JMapGMPointsGetConvexHull(floorPoints.mutableBytes, count, hull.mutableBytes);
+            if (hullCount < 3) return;
+            GMSMutablePath *path = [GMSMutablePath path];
+            const JMapGMPoint *vertices = hull.bytes;
+            for (size_t i = 0; i < hullCount; i++) [path addCoordinate:CLLocationCoordinate2DMake(vertices[i].y, vertices[i].x)];
+            outlines[floorId] = path;
+        }];
+        _outlines = outlines;
+        return _outlines;
+    }
+}
+
+@end
+
+@implementation JMapGMRerouter
+{
+    JMapGMPackedGraph *_packed;
+    JMapGMRouteTree *_tree;
+}
+
+- (instancetype)initWithTree:(JMapGMRouteTree *)tree packedGraph:(JMapGMPackedGraph *)packed
+{
+    self = [super init];
+    if (self) {
+        _tree = tree;
+        _packed = packed;
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    JMapGMRouteTreeRelease(_tree);
+}
+
+- (NSInteger)destinationWaypointId
+{
+    return (NSInteger)((const int64_t *)_packed.waypointIds.bytes)[JMapGMRouteTreeGetDestination(_tree)];
+}
+
+- (double)costFromWaypointId:(NSInteger)waypointId
+{
+    NSNumber *node = _packed.nodes[@(waypointId)];
+    double cost = node ? JMapGMRouteTreeGetCost(_tree, node.unsignedIntValue) : INFINITY;
+    return isinf(cost) ? -1 : cost;
+}
+
+- (JMapGMRouteResult *)routeFromNode:(uint32_t)node
+{
+    JMapGMRoute *route = JMapGMRouteTreeFind(_tree, node);
+    return route ? [[JMapGMRouteResult alloc] initWithRoute:route waypointIds:_packed.waypointIds] : nil;
+}
+
+- (JMapGMRouteResult *)routeFromWaypointId:(NSInteger)waypointId
+{
+    NSNumber *node = _packed.nodes[@(waypointId)];
+    return node ? [self routeFromNode:node.unsignedIntValue] : nil;
+}
+
+- (JMapGMRouteResult *)routeFromCoordinate:(CLLocationCoordinate2D)coordinate floorId:(NSInteger)floorId
+{
+    JMapGMPoint point = { coordinate.longitude, coordinate.latitude };
+    uint32_t entry = JMapGMRouteTreeFindEntry(_tree, point, (int32_t)floorId, NULL);
+    return entry != UINT32_MAX ? [self routeFromNode:entry] : nil;
+}
+
+@end
+
+typedef struct {
+    int64_t from;
+    int64_t to;
+    /** The travel model cost entry of the path type */
+    uint8_t costEntry;
+} JMapGMWayfindingPath;
+
+@implementation JMapGMWayfindingGraph
+{
+    NSMutableDictionary<NSNumber *, NSNumber *> *_nodes;
+    NSMutableData *_waypointIds;
+    NSMutableData *_points;
+    NSMutableData *_floors;
+    NSMutableData *_paths;
+    NSMutableDictionary<NSNumber *, NSNumber *> *_costEntries;
+    JMapGMPackedGraph *_packed;
+}
+
+- (instancetype)init
+{
+    self = [super init];
+    if (self) {
+        _nodes = [NSMutableDictionary dictionary];
+        _waypointIds = [NSMutableData data];
+        _points = [NSMutableData data];
+        _floors = [NSMutableData data];
+        _paths = [NSMutableData data];
+        _costEntries = [NSMutableDictionary dictionaryWithObject:@(JMapGMPathTypeCorridor) forKey:@0];
+        _travelModel = JMapGMTravelModelMake(0);
+    }
+    return self;
+}
+
+- (NSUInteger)waypointCount
+{
+    @synchronized (self) {
+        return _nodes.count;
+    }
+}
+
+- (void)addWaypointWithId:(NSInteger)waypointId coordinate:(CLLocationCoordinate2D)coordinate floorId:(NSInteger)floorId
+{
+    JMapGMPoint point = { coordinate.longitude, coordinate.latitude };
+    int32_t floor = (int32_t)floorId;
+    @synchronized (self) {
+        NSNumber *node = _nodes[@(waypointId)];
+        if (node) {
+            ((JMapGMPoint *)_points.mutableBytes)[node.unsignedIntValue] = point;
+            ((int32_t *)_floors.mutableBytes)[node.unsignedIntValue] = floor;
+        } else {
+            int64_t identifier = waypointId;
+            _nodes[@(waypointId)] = @(_nodes.count);
+            [_waypointIds appendBytes:&identifier length:sizeof(identifier)];
+            [_points appendBytes:&point length:sizeof(point)];
+            [_floors appendBytes:&floor length:sizeof(floor)];
+        }
+        _packed = nil;
+    }
+}
+
+- (BOOL)setCostEntry:(NSUInteger)entry forPathTypeId:(NSInteger)pathTypeId
+{
+    if (entry >= JMAPGM_ROUTE_PATH_TYPES) return NO;
+    @synchronized (self) {
+        _costEntries[@(pathTypeId)] = @(entry);
+    }
+    return YES;
+}
+
+- (BOOL)addPathFromWaypointId:(NSInteger)fromWaypointId toWaypointId:(NSInteger)toWaypointId pathType:(NSInteger)pathType
+{
+    @synchronized (self) {
+        NSNumber *entry = _costEntries[@(pathType)];
+        if (!entry) return NO;
+        JMapGMWayfindingPath path = { fromWaypointId, toWaypointId, entry.unsignedCharValue };
+        [_paths appendBytes:&path length:sizeof(path)];
+        _packed = nil;
+    }
+    return YES;
+}
+
+// The current packing, packing the graph if it changed since.
+- (JMapGMPackedGraph *)packedGraph
+{
+    @synchronized (self) {
+        if (_packed) return _packed;
+        JMAPGM_TRACE_SCOPE("wayfinding.pack");
+        NSUInteger pathCount = _paths.length / sizeof(JMapGMWayfindingPath);
+        const JMapGMWayfindingPath *paths = _paths.bytes;
+        NSMutableData *from = [NSMutableData dataWithLength:MAX(pathCount, 1) * sizeof(uint32_t)];
+        NSMutableData *to = [NSMutableData dataWithLength:MAX(pathCount, 1) * sizeof(uint32_t)];
+        NSMutableData *pathTypes = [NSMutableData dataWithLength:MAX(pathCount, 1)];
+        size_t edgeCount = 0;
+        for (NSUInteger i = 0; i < pathCount; i++) {
+            NSNumber *a = _nodes[@(paths[i].from)], *b = _nodes[@(paths[i].to)];
+            if (!a || !b) continue;
+            ((uint32_t *)from.mutableBytes)[edgeCount] = a.unsignedIntValue;
+            ((uint32_t *)to.mutableBytes)[edgeCount] = b.unsignedIntValue;
+            ((uint8_t *)pathTypes.mutableBytes)[edgeCount] = paths[i].costEntry;
+            edgeCount++;
+        }
+        JMapGMRouteGraph *graph = JMapGMRouteGraphCreate(_points.bytes, _floors.bytes, _nodes.count, from.bytes, to.bytes, pathTypes.bytes, edgeCount);
+        if (!graph) return nil;
+        _packed = [[JMapGMPackedGraph alloc] initWithGraph:graph waypointIds:[_waypointIds copy] nodes:[_nodes copy]];
+        return _packed;
+    }
+}
+
+// The travel model with the accessibility of one query.
+- (JMapGMTravelModel)travelModelWithAccessibility:(NSInteger)accessibility
+{
+    JMapGMTravelModel model = self.travelModel;
+    model.accessibility = (int32_t)accessibility;
+    return model;
+}
+
+- (JMapGMRouteResult *)routeFromWaypointId:(NSInteger)fromWaypointId toWaypointId:(NSInteger)toWaypointId model:(const JMapGMTravelModel *)model
+{
+    JMapGMPackedGraph *packed = [self packedGraph];
+    NSNumber *from = packed.nodes[@(fromWaypointId)], *to = packed.nodes[@(toWaypointId)];
+    if (!from || !to) return nil;
+    JMapGMRouteSearch *search = [packed checkOutSearch];
+    JMapGMRoute *route = NULL;
+    if (search) {
+        JMapGMRouteSearchSetModel(search, model);
+        route = JMapGMRouteSearchFind(search, from.unsignedIntValue, to.unsignedIntValue);
+    }
+    [packed checkInSearch:search];
+    return route ? [[JMapGMRouteResult alloc] initWithRoute:route waypointIds:packed.waypointIds] : nil;
+}
+
+- (NSArray<NSNumber *> *)costsFromWaypointId:(NSInteger)fromWaypointId toWaypointIds:(NSArray<NSNumber *> *)waypointIds model:(const JMapGMTravelModel *)model
+{
+    JMapGMPackedGraph *packed = [self packedGraph];
+    NSUInteger count = waypointIds.count;
+    NSMutableData *targets = [NSMutableData dataWithLength:MAX(count, 1) * sizeof(uint32_t)];
+    NSMutableData *costs = [NSMutableData dataWithLength:MAX(count, 1) * sizeof(double)];
+    uint32_t *targetNodes = targets.mutableBytes;
+    double *targetCosts = costs.mutableBytes;
+    [waypointIds enumerateObjectsUsingBlock:^(NSNumber *waypointId, NSUInteger i, BOOL *stop) {
+        NSNumber *node = packed.nodes[waypointId];
+        targetNodes[i] = node ? node.unsignedIntValue : UINT32_MAX;
+        targetCosts[i] = INFINITY;
+    }];
+    NSNumber *from = packed.nodes[@(fromWaypointId)];
+    JMapGMRouteSearch *search = from ? [packed checkOutSearch] : NULL;
+    if (search) {
+        JMapGMRouteSearchSetModel(search, model);
+        JMapGMRouteSearchCosts(search, from.unsignedIntValue, targetNodes, count, targetCosts);
+    }
+    [packed checkInSearch:search];
+
+    NSMutableArray<NSNumber *> *results = [NSMutableArray arrayWithCapacity:count];
+    for (NSUInteger i = 0; i < count; i++) [results addObject:@(isinf(targetCosts[i]) ? -1 : targetCosts[i])];
+    return results;
+}
+
+- (JMapGMRouteResult *)routeFromWaypointId:(NSInteger)fromWaypointId toWaypointId:(NSInteger)toWaypointId
+{
+    return [self routeFromWaypointId:fromWaypointId toWaypointId:toWaypointId model:NULL];
+}
+
+- (CLLocationDistance)distanceFromWaypointId:(NSInteger)fromWaypointId toWaypointId:(NSInteger)toWaypointId
+{
+    JMapGMPackedGraph *packed = [self packedGraph];
+    NSNumber *from = packed.nodes[@(fromWaypointId)], *to = packed.nodes[@(toWaypointId)];
+    if (!from || !to) return -1;
+    JMapGMRouteSearch *search = [packed checkOutSearch];
+    double cost = INFINITY;
+    if (search) {
+        JMapGMRouteSearchSetModel(search, NULL);
+        cost = JMapGMRouteSearchCost(search, from.unsignedIntValue, to.unsignedIntValue);
+    }
+    [packed checkInSearch:search];
+    return isinf(cost) ? -1 : cost;
+}
+
+- (NSArray<NSNumber *> *)distancesFromWaypointId:(NSInteger)fromWaypointId toWaypointIds:(NSArray<NSNumber *> *)waypointIds
+{
+    return [self costsFromWaypointId:fromWaypointId toWaypointIds:waypointIds model:NULL];
+}
+
+- (JMapGMRouteResult *)fastestRouteFromWaypointId:(NSInteger)fromWaypointId toWaypointId:(NSInteger)toWaypointId accessibility:(NSInteger)accessibility
+{
+    JMapGMTravelModel model = [self travelModelWithAccessibility:accessibility];
+    return [self routeFromWaypointId:fromWaypointId toWaypointId:toWaypointId model:&model];
+}
+
+- (NSArray<NSNumber *> *)travelTimesFromWaypointId:(NSInteger)fromWaypointId toWaypointIds:(NSArray<NSNumber *> *)waypointIds accessibility:(NSInteger)accessibility
+{
+    JMapGMTravelModel model = [self travelModelWithAccessibility:accessibility];
+    return [self costsFromWaypointId:fromWaypointId toWaypointIds:waypointIds model:&model];
+}
+
+- (JMapGMReachability *)reachabilityFromWaypointId:(NSInteger)waypointId limit:(double)limit model:(const JMapGMTravelModel *)model
+{
+    JMapGMPackedGraph *packed = [self packedGraph];
+    NSNumber *from = packed.nodes[@(waypointId)];
+    if (!from) return nil;
+    JMapGMRouteSearch *search = [packed checkOutSearch];
+    if (!search) return nil;
+    JMapGMRouteSearchSetModel(search, model);
+    JMapGMRouteReach reach = JMapGMRouteSearchReach(search, from.unsignedIntValue, limit);
+    JMapGMReachability *reachability = reach.count ? [[JMapGMReachability alloc] initWithReach:reach limit:limit packedGraph:packed] : nil;
+    [packed checkInSearch:search];
+    return reachability;
+}
+
+- (JMapGMReachability *)reachabilityFromWaypointId:(NSInteger)waypointId withinDistance:(CLLocationDistance)distance
+{
+    return [self reachabilityFromWaypointId:waypointId limit:distance model:NULL];
+}
+
+- (JMapGMReachability *)reachabilityFromWaypointId:(NSInteger)waypointId withinSeconds:(NSTimeInterval)seconds accessibility:(NSInteger)accessibility
+{
+    JMapGMTravelModel model = [self travelModelWithAccessibility:accessibility];
+    return [self reachabilityFromWaypointId:waypointId limit:seconds model:&model];
+}
+
+- (JMapGMRerouter *)rerouterToWaypointId:(NSInteger)waypointId model:(const JMapGMTravelModel *)model
+{
+    JMapGMPackedGraph *packed = [self packedGraph];
+    NSNumber *to = packed.nodes[@(waypointId)];
+    if (!to) return nil;
+    JMapGMRouteSearch *search = [packed checkOutSearch];
+    JMapGMRouteTree *tree = NULL;
+    if (search) {
+        JMapGMRouteSearchSetModel(search, model);
+        tree = JMapGMRouteSearchTree(search, to.unsignedIntValue);
+    }
+    [packed checkInSearch:search];
+    return tree ? [[JMapGMRerouter alloc] initWithTree:tree packedGraph:packed] : nil;
+}
+
+- (JMapGMRerouter *)rerouterToWaypointId:(NSInteger)waypointId
+{
+    return [self rerouterToWaypointId:waypointId model:NULL];
+}
+
+- (JMapGMRerouter *)fastestRerouterToWaypointId:(NSInteger)waypointId accessibility:(NSInteger)accessibility
+{
+    JMapGMTravelModel model = [self travelModelWithAccessibility:accessibility];
+    return [self rerouterToWaypointId:waypointId model:&model];
+}
+
+@end
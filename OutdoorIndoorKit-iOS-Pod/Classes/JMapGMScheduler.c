@@ -0,0 +1,217 @@
+//
+//  JMapGMScheduler.c
+//  JMapOutdoorIndoorKit
+//
+//  Copyright © 2026 Jibestream. All rights reserved.
+//
+
+#include "JMapGMScheduler.h"
+#include "JMapGMTrace.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+    uint64_t id;
+    JMapGMTaskStep step;
+    JMapGMTaskFinish finish;
+    void *context;
+} JMapGMTask;
+
+/**
+ *  The pending tasks of one priority, in order, at tasks[head] to tasks[end - 1].
+ */
+typedef struct {
+    JMapGMTask *tasks;
+    size_t head;
+    size_t end;
+    size_t capacity;
+} JMapGMTaskQueue;
+
+struct JMapGMScheduler {
+    JMapGMSchedulerClock clock;
+    void *clockContext;
+    JMapGMTaskQueue queues[JMAPGM_TASK_PRIORITY_COUNT];
+    uint64_t nextId;
+    /** The task whose step is running, and whether it was cancelled meanwhile */
+    uint64_t running;
+    bool runningCancelled;
+    JMapGMSchedulerStats stats;
+};
+
+static int64_t JMapGMSchedulerDefaultClock(void *context)
+{
+    (void)context;
+    return JMapGMTraceNow();
+}
+
+JMapGMScheduler *JMapGMSchedulerCreate(JMapGMSchedulerClock clock, void *clockContext)
+{
+    JMapGMScheduler *scheduler = calloc(1, sizeof(JMapGMScheduler));
+    if (!scheduler) return NULL;
+    scheduler->clock = clock ? clock : JMapGMSchedulerDefaultClock;
+    scheduler->clockContext = clockContext;
+    scheduler->nextId = 1;
+    return scheduler;
+}
+
+void JMapGMSchedulerRelease(JMapGMScheduler *scheduler)
+{
+    if (!scheduler) return;
+    for (int p = 0; p < JMAPGM_TASK_PRIORITY_COUNT; p++) {
+        JMapGMTaskQueue *queue = &scheduler->queues[p];
+        // Finish callbacks may not touch the scheduler being released.
+        for (size_t i = queue->head; i < queue->end; i++) {
+            if (queue->tasks[i].finish) queue->tasks[i].finish(queue->tasks[i].context, true);
+        }
+        free(queue->tasks);
+    }
+    free(scheduler);
+}
+
+#pragma mark - Queues
+
+static bool JMapGMTaskQueuePush(JMapGMTaskQueue *queue, JMapGMTask task)
+{
+    if (queue->end == queue->capacity) {
+        if (queue->head > 0) {
+            memmove(queue->tasks, queue->tasks + queue->head, (queue->end - queue->head) * sizeof(JMapGMTask));
+            queue->end -= queue->head;
+            queue->head = 0;
+        } else {
+            size_t capacity = queue->capacity ? queue->capacity * 2 : 16;
+            JMapGMTask *tasks = realloc(queue->tasks, capacity * sizeof(JMapGMTask));
+            if (!tasks) return false;
+            queue->tasks = tasks;
+            queue->capacity = capacity;
+        }
+    }
+    queue->tasks[queue->end++] = task;
+    return true;
+}
+
+static JMapGMTask JMapGMTaskQueueRemove(JMapGMTaskQueue *queue, size_t index)
+{
+    JMapGMTask task = queue->tasks[index];
+    if (index == queue->head) {
+        queue->head++;
+    } else {
+        memmove(queue->tasks + index, queue->tasks + index + 1, (queue->end - index - 1) * sizeof(JMapGMTask));
+        queue->end--;
+    }
+    if (queue->head == queue->end) queue->head = queue->end = 0;
+    return task;
+}
+
+static bool JMapGMSchedulerFind(const JMapGMScheduler *scheduler, uint64_t id, int *priority, size_t *index)
+{
+    for (int p = 0; p < JMAPGM_TASK_PRIORITY_COUNT; p++) {
+        const JMapGMTaskQueue *queue = &scheduler->queues[p];
+        for (size_t i = queue->head; i < queue->end; i++) {
+            if (queue->tasks[i].id != id) continue;
+            *priority = p;
+            *index = i;
+            return true;
+        }
+    }
+    return false;
+}
+
+#pragma mark - Tasks
+
+uint64_t JMapGMSchedulerAdd(JMapGMScheduler *scheduler, JMapGMTaskPriority priority, JMapGMTaskStep step, JMapGMTaskFinish finish, void *context)
+{
+    if ((unsigned)priority >= JMAPGM_TASK_PRIORITY_COUNT || !step) return JMAPGM_TASK_NONE;
+    JMapGMTask task = { scheduler->nextId, step, finish, context };
+    if (!JMapGMTaskQueuePush(&scheduler->queues[priority], task)) return JMAPGM_TASK_NONE;
+    return scheduler->nextId++;
+}
+
+bool JMapGMSchedulerCancel(JMapGMScheduler *scheduler, uint64_t task)
+{
+    if (task == JMAPGM_TASK_NONE) return false;
+    if (task == scheduler->running) {
+        if (scheduler->runningCancelled) return false;
+        scheduler->runningCancelled = true;
+        return true;
+    }
+    int priority;
+    size_t index;
+    if (!JMapGMSchedulerFind(scheduler, task, &priority, &index)) return false;
+    JMapGMTask removed = JMapGMTaskQueueRemove(&scheduler->queues[priority], index);
+    scheduler->stats.cancelled++;
+    if (removed.finish) removed.finish(removed.context, true);
+    return true;
+}
+
+bool JMapGMSchedulerSetPriority(JMapGMScheduler *scheduler, uint64_t task, JMapGMTaskPriority priority)
+{
+    if ((unsigned)priority >= JMAPGM_TASK_PRIORITY_COUNT || task == JMAPGM_TASK_NONE) return false;
+    if (task == scheduler->running && scheduler->runningCancelled) return false;
+    int current;
+    size_t index;
+    if (!JMapGMSchedulerFind(scheduler, task, &current, &index)) return false;
+    if ((JMapGMTaskPriority)current == priority) return true;
+    JMapGMTaskQueue *from = &scheduler->queues[current];
+    if (!JMapGMTaskQueuePush(&scheduler->queues[priority], from->tasks[index])) return false;
+    JMapGMTaskQueueRemove(from, index);
+    return true;
+}
+
+size_t JMapGMSchedulerGetPendingCount(const JMapGMScheduler *scheduler)
+{
+    size_t count = 0;
+    for (int p = 0; p < JMAPGM_TASK_PRIORITY_COUNT; p++) count += scheduler->queues[p].end - scheduler->queues[p].head;
+    return count;
+}
+
+#pragma mark - Frames
+
+JMapGMFrameStats JMapGMSchedulerRunFrame(JMapGMScheduler *scheduler, int64_t budget)
+{
+    JMapGMFrameStats frame = { 0 };
+    frame.frame = scheduler->stats.frames++;
+    frame.budget = budget;
+    int64_t start = scheduler->clock(scheduler->clockContext);
+    for (;;) {
+        int priority = 0;
+        while (priority < JMAPGM_TASK_PRIORITY_COUNT && scheduler->queues[priority].head == scheduler->queues[priority].end) priority++;
+        if (priority == JMAPGM_TASK_PRIORITY_COUNT) break;
+
+        // The step may add, cancel or move tasks, so the task is found again by id afterwards.
+        JMapGMTask task = scheduler->queues[priority].tasks[scheduler->queues[priority].head];
+        scheduler->running = task.id;
+        scheduler->runningCancelled = false;
+        bool more = task.step(task.context);
+        bool cancelled = scheduler->runningCancelled;
+        scheduler->running = JMAPGM_TASK_NONE;
+        frame.steps++;
+        frame.stepsByPriority[priority]++;
+
+        if (!more || cancelled) {
+            int current;
+            size_t index;
+            if (JMapGMSchedulerFind(scheduler, task.id, &current, &index)) JMapGMTaskQueueRemove(&scheduler->queues[current], index);
+            if (cancelled) scheduler->stats.cancelled++;
+            else frame.completed++;
+            if (task.finish) task.finish(task.context, cancelled);
+        }
+        if (scheduler->clock(scheduler->clockContext) - start >= budget) break;
+    }
+    frame.elapsed = scheduler->clock(scheduler->clockContext) - start;
+    frame.pending = (uint32_t)JMapGMSchedulerGetPendingCount(scheduler);
+
+    JMapGMSchedulerStats *stats = &scheduler->stats;
+    stats->steps += frame.steps;
+    stats->completed += frame.completed;
+    stats->elapsed += frame.elapsed;
+    if (frame.elapsed > stats->maxElapsed) stats->maxElapsed = frame.elapsed;
+    if (frame.elapsed > budget) stats->overruns++;
+    JMAPGM_TRACE_COUNT("scheduler.steps", (int64_t)frame.steps);
+    return frame;
+}
+
+JMapGMSchedulerStats JMapGMSchedulerGetStats(const JMapGMScheduler *scheduler)
+{
+    return scheduler->stats;
+}
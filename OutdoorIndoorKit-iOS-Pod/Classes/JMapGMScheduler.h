@@ -0,0 +1,149 @@
+//
+//  JMapGMScheduler.h
+//  JMapOutdoorIndoorKit
+//
+//  Copyright © 2026 Jibestream. All rights reserved.
+//
+
+#ifndef JMapGMScheduler_h
+#define JMapGMScheduler_h
+
+#include "JMapGMTypes.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ *  Cooperative frame-budget scheduler. Work is split into tasks that run one short step at a
+ *  time; each frame runs steps, highest priority first, until the frame's budget is spent, and
+ *  unfinished tasks resume on the next frame. Tasks of one priority run in the order they were
+ *  added. Not thread safe; drive it from the thread that owns the work, usually the main thread.
+ */
+typedef struct JMapGMScheduler JMapGMScheduler;
+
+/**
+ *  Task priorities, most urgent first
+ */
+typedef enum {
+    /** Responses to the user, such as highlighting a tapped unit */
+    JMapGMTaskPriorityInteraction,
+    /** Work on the floor being shown */
+    JMapGMTaskPriorityVisible,
+    /** Preparing floors that are not shown */
+    JMapGMTaskPriorityBackground,
+} JMapGMTaskPriority;
+
+#define JMAPGM_TASK_PRIORITY_COUNT 3
+
+/** The id of no task */
+#define JMAPGM_TASK_NONE 0
+
+/**
+ *  Runs one step of a task.
+ *
+ *  @return true if the task has more steps, false when it is done
+ */
+typedef bool (*JMapGMTaskStep)(void *context);
+
+/**
+ *  Called once when a task finishes or is cancelled, to release its context. May be NULL.
+ */
+typedef void (*JMapGMTaskFinish)(void *context, bool cancelled);
+
+/**
+ *  Returns the current time in nanoseconds, for a simulated clock in tests.
+ */
+typedef int64_t (*JMapGMSchedulerClock)(void *context);
+
+/**
+ *  What one frame ran
+ */
+typedef struct {
+    uint64_t frame;
+    /** Nanoseconds allowed and spent */
+    int64_t budget;
+    int64_t elapsed;
+    uint32_t steps;
+    uint32_t stepsByPriority[JMAPGM_TASK_PRIORITY_COUNT];
+    uint32_t completed;
+    /** Tasks left for later frames */
+    uint32_t pending;
+} JMapGMFrameStats;
+
+/**
+ *  Totals since the scheduler was created
+ */
+typedef struct {
+    uint64_t frames;
+    uint64_t steps;
+    uint64_t completed;
+    uint64_t cancelled;
+    /** Frames whose work ran past their budget */
+    uint64_t overruns;
+    int64_t elapsed;
+    int64_t maxElapsed;
+} JMapGMSchedulerStats;
+
+/**
+ *  Creates a scheduler.
+ *
+ *  @param clock The clock, or NULL for JMapGMTraceNow
+ *  @param clockContext Passed to clock
+ *  @return The scheduler, or NULL if allocation failed
+ */
+JMapGMScheduler *JMapGMSchedulerCreate(JMapGMSchedulerClock clock, void *clockContext);
+
+/**
+ *  Releases a scheduler, cancelling its pending tasks.
+ */
+void JMapGMSchedulerRelease(JMapGMScheduler *scheduler);
+
+/**
+ *  Adds a task behind the pending tasks of its priority. May be called from a step.
+ *
+ *  @param step Runs one step; should return within a fraction of a frame
+ *  @param finish Releases the context, or NULL
+ *  @return The task id, or JMAPGM_TASK_NONE if allocation failed, in which case finish is not called
+ */
+uint64_t JMapGMSchedulerAdd(JMapGMScheduler *scheduler, JMapGMTaskPriority priority, JMapGMTaskStep step, JMapGMTaskFinish finish, void *context);
+
+/**
+ *  Cancels a pending task and calls its finish callback. A task cancelling itself from its step
+ *  is finished once the step returns.
+ *
+ *  @return false if the task already finished
+ */
+bool JMapGMSchedulerCancel(JMapGMScheduler *scheduler, uint64_t task);
+
+/**
+ *  Moves a pending task behind the tasks of another priority, e.g. when a background floor is shown.
+ *
+ *  @return false if the task already finished
+ */
+bool JMapGMSchedulerSetPriority(JMapGMScheduler *scheduler, uint64_t task, JMapGMTaskPriority priority);
+
+/**
+ *  The number of pending tasks
+ */
+size_t JMapGMSchedulerGetPendingCount(const JMapGMScheduler *scheduler);
+
+/**
+ *  Runs steps until the budget is spent or no task is pending. At least one step runs if any
+ *  task is pending, so every frame makes progress however small the budget.
+ *
+ *  @param budget Nanoseconds of work allowed this frame
+ *  @return What the frame ran
+ */
+JMapGMFrameStats JMapGMSchedulerRunFrame(JMapGMScheduler *scheduler, int64_t budget);
+
+/**
+ *  Totals since the scheduler was created
+ */
+JMapGMSchedulerStats JMapGMSchedulerGetStats(const JMapGMScheduler *scheduler);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* JMapGMScheduler_h */
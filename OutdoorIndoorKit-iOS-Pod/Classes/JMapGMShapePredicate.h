@@ -0,0 +1,95 @@
+//
+//  JMapGMShapePredicate.h
+//  JMapOutdoorIndoorKit
+//
+//  Copyright © 2026 Jibestream. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import <CoreLocation/CoreLocation.h>
+#import "JMapGMShapeQuery.h"
+
+/**
+ *  Finds a string in the pool of a table without adding it.
+ *
+ *  @return The code of the string, or JMAPGM_ATTRIBUTE_NONE if the pool does not hold it
+ */
+uint32_t JMapGMAttributeTableFindObjCString(const JMapGMAttributeTable * _Nonnull table, NSString * _Nonnull string);
+
+/**
+ *  The JMapGMShapePredicate object
+ *
+ *  An immutable condition on shape layers, properties and extents, combined with and, or and not.
+ *  Evaluated by -[JMapGMPropertyTable rowsMatchingPredicate:] on the columns and R-tree of the table.
+ *
+ *  The food units of the first floor within 20 metres of the user:
+ *
+ *      [[[[JMapGMShapePredicate layerNamed:@"Units"]
+ *          and:[JMapGMShapePredicate key:@"category" isEqualToString:@"Food"]]
+ *          and:[JMapGMShapePredicate key:@"floor" isBetween:1 and:1]]
+ *          and:[JMapGMShapePredicate nearCoordinate:user radius:20]]
+ */
+@interface JMapGMShapePredicate : NSObject
+
+/**
+ *  Shapes of a layer
+ */
++ (nonnull instancetype)layerNamed:(nonnull NSString *)layerName;
+
+/**
+ *  Shapes whose string property equals a value
+ */
++ (nonnull instancetype)key:(nonnull NSString *)key isEqualToString:(nonnull NSString *)value;
+
+/**
+ *  Shapes whose number property lies within [minimum, maximum]
+ */
++ (nonnull instancetype)key:(nonnull NSString *)key isBetween:(double)minimum and:(double)maximum;
+
+/**
+ *  Shapes whose boolean property has a value
+ */
++ (nonnull instancetype)key:(nonnull NSString *)key isBool:(BOOL)value;
+
+/**
+ *  Shapes whose bounds intersect the given bounds
+ */
++ (nonnull instancetype)withinNorthEast:(CLLocationCoordinate2D)northEast southWest:(CLLocationCoordinate2D)southWest;
+
+/**
+ *  Shapes whose bounds come within a distance of a coordinate
+ *
+ *  @param coordinate The lat/lng coordinate
+ *  @param radius The distance in metres
+ */
++ (nonnull instancetype)nearCoordinate:(CLLocationCoordinate2D)coordinate radius:(CLLocationDistance)radius;
+
+/**
+ *  Every shape
+ */
++ (nonnull instancetype)all;
+
+/**
+ *  Shapes matching both predicates
+ */
+- (nonnull JMapGMShapePredicate *)and:(nonnull JMapGMShapePredicate *)predicate;
+
+/**
+ *  Shapes matching either predicate
+ */
+- (nonnull JMapGMShapePredicate *)or:(nonnull JMapGMShapePredicate *)predicate;
+
+/**
+ *  Shapes not matching the predicate
+ */
+- (nonnull JMapGMShapePredicate *)negated;
+
+/**
+ *  Compile to postfix query terms. Keys and values missing from the table compile to terms that match nothing.
+ *
+ *  @param table The columns the terms will run on
+ *  @param terms Receives JMapGMQueryTerm values
+ */
+- (void)appendTermsForTable:(nonnull const JMapGMAttributeTable *)table toData:(nonnull NSMutableData *)terms;
+
+@end
@@ -0,0 +1,128 @@
+//
+//  JMapGMShapePredicate.m
+//  JMapOutdoorIndoorKit
+//
+//  Copyright © 2026 Jibestream. All rights reserved.
+//
+
+#import "JMapGMShapePredicate.h"
+
+uint32_t JMapGMAttributeTableFindObjCString(const JMapGMAttributeTable *table, NSString *string)
+{
+    const char *bytes = string.UTF8String;
+    return bytes ? JMapGMAttributeTableFindString(table, bytes, strlen(bytes)) : JMAPGM_ATTRIBUTE_NONE;
+}
+
+@implementation JMapGMShapePredicate
+{
+    JMapGMQueryOp _op;
+    NSString *_key;
+    NSString *_string;
+    JMapGMAttributeType _type;
+    /** Other fields of the term; column and string are resolved when compiling */
+    JMapGMQueryTerm _term;
+    NSArray<JMapGMShapePredicate *> *_operands;
+}
+
+- (instancetype)initWithOp:(JMapGMQueryOp)op
+{
+    self = [super init];
+    if (self) {
+        _op = op;
+        _term.op = op;
+        _term.column = JMAPGM_ATTRIBUTE_NONE;
+        _term.string = JMAPGM_ATTRIBUTE_NONE;
+    }
+    return self;
+}
+
++ (instancetype)layerNamed:(NSString *)layerName
+{
+    JMapGMShapePredicate *predicate = [[self alloc] initWithOp:JMapGMQueryLayer];
+    predicate->_string = [layerName copy];
+    return predicate;
+}
+
++ (instancetype)key:(NSString *)key isEqualToString:(NSString *)value
+{
+    JMapGMShapePredicate *predicate = [[self alloc] initWithOp:JMapGMQueryEqual];
+    predicate->_key = [key copy];
+    predicate->_string = [value copy];
+    predicate->_type = JMapGMAttributeString;
+    return predicate;
+}
+
++ (instancetype)key:(NSString *)key isBetween:(double)minimum and:(double)maximum
+{
+    JMapGMShapePredicate *predicate = [[self alloc] initWithOp:JMapGMQueryRange];
+    predicate->_key = [key copy];
+    predicate->_type = JMapGMAttributeNumber;
+    predicate->_term.min = minimum;
+    predicate->_term.max = maximum;
+    return predicate;
+}
+
++ (instancetype)key:(NSString *)key isBool:(BOOL)value
+{
+    JMapGMShapePredicate *predicate = [[self alloc] initWithOp:JMapGMQueryRange];
+    predicate->_key = [key copy];
+    predicate->_type = JMapGMAttributeBoolean;
+    predicate->_term.min = predicate->_term.max = value ? 1 : 0;
+    return predicate;
+}
+
++ (instancetype)withinNorthEast:(CLLocationCoordinate2D)northEast southWest:(CLLocationCoordinate2D)southWest
+{
+    JMapGMShapePredicate *predicate = [[self alloc] initWithOp:JMapGMQueryWithin];
+    predicate->_term.rect = (JMapGMRect){ southWest.longitude, southWest.latitude, northEast.longitude, northEast.latitude };
+    return predicate;
+}
+
++ (instancetype)nearCoordinate:(CLLocationCoordinate2D)coordinate radius:(CLLocationDistance)radius
+{
+    JMapGMShapePredicate *predicate = [[self alloc] initWithOp:JMapGMQueryNear];
+    predicate->_term.point = (JMapGMPoint){ coordinate.longitude, coordinate.latitude };
+    predicate->_term.radius = radius;
+    return predicate;
+}
+
++ (instancetype)all
+{
+    return [[self alloc] initWithOp:JMapGMQueryAll];
+}
+
+- (JMapGMShapePredicate *)combinedWith:(JMapGMShapePredicate *)predicate op:(JMapGMQueryOp)op
+{
+    JMapGMShapePredicate *combined = [[JMapGMShapePredicate alloc] initWithOp:op];
+    combined->_operands = predicate ? @[ self, predicate ] : @[ self ];
+    return combined;
+}
+
+- (JMapGMShapePredicate *)and:(JMapGMShapePredicate *)predicate
+{
+    return [self combinedWith:predicate op:JMapGMQueryAnd];
+}
+
+- (JMapGMShapePredicate *)or:(JMapGMShapePredicate *)predicate
+{
+    return [self combinedWith:predicate op:JMapGMQueryOr];
+}
+
+- (JMapGMShapePredicate *)negated
+{
+    return [self combinedWith:nil op:JMapGMQueryNot];
+}
+
+- (void)appendTermsForTable:(const JMapGMAttributeTable *)table toData:(NSMutableData *)terms
+{
+    for (JMapGMShapePredicate *operand in _operands) [operand appendTermsForTable:table toData:terms];
+    JMapGMQueryTerm term = _term;
+    if (_key) {
+        uint32_t key = JMapGMAttributeTableFindObjCString(table, _key);
+        term.column = key == JMAPGM_ATTRIBUTE_NONE ? JMAPGM_ATTRIBUTE_NONE : JMapGMAttributeTableGetColumn(table, key, _type);
+    }
+    if (_string) term.string = JMapGMAttributeTableFindObjCString(table, _string);
+    [terms appendBytes:&term length:sizeof(term)];
+}
+
+@end
@@ -0,0 +1,156 @@
+//
+//  JMapGMShapeQuery.c
+//  JMapOutdoorIndoorKit
+//
+//  Copyright © 2026 Jibestream. All rights reserved.
+//
+
+#include "JMapGMShapeQuery.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const double JMapGMMetresPerDegree = 111320.0;
+
+typedef struct {
+    uint64_t *bitmap;
+    const JMapGMRect *bounds;
+    JMapGMPoint point;
+    double xScale;
+    double limit;
+} JMapGMQuerySpatial;
+
+static void JMapGMBitmapSet(uint64_t *bitmap, uint32_t row)
+{
+    bitmap[row / 64] |= 1ull << (row % 64);
+}
+
+static bool JMapGMQueryVisitWithin(uint32_t item, void *context)
+{
+    JMapGMBitmapSet(((JMapGMQuerySpatial *)context)->bitmap, item);
+    return true;
+}
+
+// Squared distance in latitude degrees from the point to the nearest point of the rect.
+static double JMapGMQueryRectDistanceSquared(const JMapGMQuerySpatial *spatial, JMapGMRect rect)
+{
+    double dx = fmax(fmax(rect.minX - spatial->point.x, spatial->point.x - rect.maxX), 0) * spatial->xScale;
+    double dy = fmax(fmax(rect.minY - spatial->point.y, spatial->point.y - rect.maxY), 0);
+    return dx * dx + dy * dy;
+}
+
+static bool JMapGMQueryVisitNear(uint32_t item, void *context)
+{
+    JMapGMQuerySpatial *spatial = context;
+    if (JMapGMQueryRectDistanceSquared(spatial, spatial->bounds[item]) <= spatial->limit) {
+        JMapGMBitmapSet(spatial->bitmap, item);
+    }
+    return true;
+}
+
+static void JMapGMQuerySpatialTerm(const JMapGMShapeSource *source, const JMapGMQueryTerm *term, uint64_t *bitmap)
+{
+    size_t words = JMapGMBitmapWordCount(source->rowCount);
+    memset(bitmap, 0, words * sizeof(uint64_t));
+    if (!source->bounds) return;
+
+    JMapGMQuerySpatial spatial = { bitmap, source->bounds, term->point, 1, 0 };
+    JMapGMRect rect = term->rect;
+    JMapGMRTreeVisitor visitor = JMapGMQueryVisitWithin;
+    if (term->op == JMapGMQueryNear) {
+        double radius = fmax(term->radius, 0) / JMapGMMetresPerDegree;
+        spatial.xScale = cos(term->point.y * M_PI / 180.0);
+        spatial.limit = radius * radius;
+        double dx = spatial.xScale > 1e-9 ? radius / spatial.xScale : 360;
+        rect = (JMapGMRect){ term->point.x - dx, term->point.y - radius, term->point.x + dx, term->point.y + radius };
+        visitor = JMapGMQueryVisitNear;
+    }
+    if (source->index) {
+        JMapGMRTreeQuery(source->index, rect, visitor, &spatial);
+        return;
+    }
+    for (size_t row = 0; row < source->rowCount; row++) {
+        if (JMapGMRectIntersects(source->bounds[row], rect)) visitor((uint32_t)row, &spatial);
+    }
+}
+
+size_t JMapGMShapeQueryEvaluate(const JMapGMShapeSource *source, const JMapGMQueryTerm *terms, size_t termCount, uint64_t *bitmap)
+{
+    size_t words = JMapGMBitmapWordCount(source->rowCount);
+    // Size the stack for the deepest point of the query rather than its length.
+    size_t depth = 0, maxDepth = 0;
+    for (size_t t = 0; t < termCount; t++) {
+        JMapGMQueryOp op = terms[t].op;
+        size_t operands = op == JMapGMQueryAnd || op == JMapGMQueryOr ? 2 : op == JMapGMQueryNot ? 1 : 0;
+        if (depth < operands) return JMAPGM_QUERY_INVALID;
+        depth = operands ? depth - operands + 1 : depth + 1;
+        if (depth > maxDepth) maxDepth = depth;
+    }
+    if (depth != 1) return JMAPGM_QUERY_INVALID;
+    uint64_t *stack = malloc((words ? words : 1) * maxDepth * sizeof(uint64_t));
+    if (!stack) return JMAPGM_QUERY_INVALID;
+    depth = 0;
+    uint64_t tail = source->rowCount % 64 ? (1ull << (source->rowCount % 64)) - 1 : ~0ull;
+
+    for (size_t t = 0; t < termCount; t++) {
+        const JMapGMQueryTerm *term = &terms[t];
+        uint64_t *top = stack + depth * words;
+        switch (term->op) {
+            case JMapGMQueryLayer:
+                if (source->layers && term->string != JMAPGM_ATTRIBUTE_NONE) JMapGMBitmapMatchCodes(source->layers, source->rowCount, term->string, top);
+                else memset(top, 0, words * sizeof(uint64_t));
+                depth++;
+                break;
+            case JMapGMQueryEqual:
+                JMapGMAttributeTableMatchString(source->attributes, term->column, term->string, top);
+                depth++;
+                break;
+            case JMapGMQueryRange:
+                JMapGMAttributeTableMatchRange(source->attributes, term->column, term->min, term->max, top);
+                depth++;
+                break;
+            case JMapGMQueryWithin:
+            case JMapGMQueryNear:
+                JMapGMQuerySpatialTerm(source, term, top);
+                depth++;
+                break;
+            case JMapGMQueryAll:
+                memset(top, 0xff, words * sizeof(uint64_t));
+                if (words) top[words - 1] = tail;
+                depth++;
+                break;
+            case JMapGMQueryAnd:
+            case JMapGMQueryOr: {
+                uint64_t *right = top - words, *left = right - words;
+                if (term->op == JMapGMQueryAnd) {
+                    for (size_t w = 0; w < words; w++) left[w] &= right[w];
+                } else {
+                    for (size_t w = 0; w < words; w++) left[w] |= right[w];
+                }
+                depth--;
+                break;
+            }
+            case JMapGMQueryNot: {
+                uint64_t *operand = top - words;
+                for (size_t w = 0; w < words; w++) operand[w] = ~operand[w];
+                if (words) operand[words - 1] &= tail;
+                break;
+            }
+            default:
+                goto invalid;
+        }
+    }
+
+    size_t count = 0;
+    for (size_t w = 0; w < words; w++) {
+        bitmap[w] = stack[w];
+        count += (size_t)__builtin_popcountll(stack[w]);
+    }
+    free(stack);
+    return count;
+
+invalid:
+    free(stack);
+    return JMAPGM_QUERY_INVALID;
+}
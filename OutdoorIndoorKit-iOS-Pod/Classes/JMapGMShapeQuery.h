@@ -0,0 +1,89 @@
+//
+//  JMapGMShapeQuery.h
+//  JMapOutdoorIndoorKit
+//
+//  Copyright © 2026 Jibestream. All rights reserved.
+//
+
+#ifndef JMapGMShapeQuery_h
+#define JMapGMShapeQuery_h
+
+#include "JMapGMAttributeTable.h"
+#include "JMapGMSpatialIndex.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ *  The shapes a query runs over, one row each. Coordinates are x = longitude, y = latitude.
+ */
+typedef struct {
+    /** Properties of the rows; its row count is rowCount */
+    const JMapGMAttributeTable *attributes;
+    /** Pooled layer name of each row, or NULL if rows have no layers */
+    const uint32_t *layers;
+    /** Bounds of each row, or NULL if rows have no geometry */
+    const JMapGMRect *bounds;
+    /** R-tree over bounds with rows as items, or NULL to scan bounds */
+    const JMapGMRTree *index;
+    size_t rowCount;
+} JMapGMShapeSource;
+
+typedef enum {
+    /** Rows of the layer named by string */
+    JMapGMQueryLayer,
+    /** Rows whose string column equals string */
+    JMapGMQueryEqual,
+    /** Rows whose number or boolean column lies within [min, max] */
+    JMapGMQueryRange,
+    /** Rows whose bounds intersect rect */
+    JMapGMQueryWithin,
+    /** Rows whose bounds come within radius metres of point */
+    JMapGMQueryNear,
+    /** Every row */
+    JMapGMQueryAll,
+    /** Pops two results and pushes the rows in both */
+    JMapGMQueryAnd,
+    /** Pops two results and pushes the rows in either */
+    JMapGMQueryOr,
+    /** Pops a result and pushes the other rows */
+    JMapGMQueryNot,
+} JMapGMQueryOp;
+
+/**
+ *  One term of a query in postfix order, e.g. Layer, Equal, And for "units whose category is food".
+ *  Only the fields of the op are read.
+ */
+typedef struct {
+    JMapGMQueryOp op;
+    uint32_t column;
+    uint32_t string;
+    double min;
+    double max;
+    JMapGMRect rect;
+    JMapGMPoint point;
+    double radius;
+} JMapGMQueryTerm;
+
+/**
+ *  Returned for a query that does not leave exactly one result, or if allocation failed
+ */
+#define JMAPGM_QUERY_INVALID SIZE_MAX
+
+/**
+ *  Evaluates a query. Attribute and layer terms are vectorized scans of their columns, and spatial
+ *  terms search the R-tree when there is one. Results are combined as bitmaps, so no shape objects
+ *  are touched.
+ *
+ *  @param terms The query in postfix order
+ *  @param bitmap Receives JMapGMBitmapWordCount(source->rowCount) words with the matching rows set
+ *  @return The number of matching rows, or JMAPGM_QUERY_INVALID
+ */
+size_t JMapGMShapeQueryEvaluate(const JMapGMShapeSource *source, const JMapGMQueryTerm *terms, size_t termCount, uint64_t *bitmap);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* JMapGMShapeQuery_h */
@@ -0,0 +1,126 @@
+//
+//  JMapGMSimplify.c
+//  JMapOutdoorIndoorKit
+//
+//  Copyright © 2026 Jibestream. All rights reserved.
+//
+
+#include "JMapGMSimplify.h"
+
+#include <stdlib.h>
+
+// Squared distance from p to segment a-b, with x scaled.
+static double JMapGMSegmentDistanceSquared(JMapGMPoint p, JMapGMPoint a, JMapGMPoint b, double xScale)
+{
+    double ax = a.x * xScale, bx = b.x * xScale, px = p.x * xScale;
+    double dx = bx - ax, dy = b.y - a.y;
+    double length = dx * dx + dy * dy;
+    double t = length > 0 ? ((px - ax) * dx + (p.y - a.y) * dy) / length : 0;
+    if (t < 0) t = 0;
+    if (t > 1) t = 1;
+    double ex = ax + t * dx - px, ey = a.y + t * dy - p.y;
+    return ex * ex + ey * ey;
+}
+
+// Marks the vertices of [first, last] to keep, both ends included.
+static bool JMapGMSimplifyRange(const JMapGMPoint *points, size_t first, size_t last, double tolerance, double xScale, bool *keep)
+{
+    size_t capacity = 64, depth = 0;
+    size_t *stack = malloc(capacity * 2 * sizeof(size_t));
+    if (!stack) return false;
+    keep[first] = keep[last] = true;
+    stack[depth * 2] = first;
+    stack[depth * 2 + 1] = last;
+    depth++;
+    double limit = tolerance * tolerance;
+    while (depth > 0) {
+        depth--;
+        size_t start = stack[depth * 2], end = stack[depth * 2 + 1];
+        double farthest = 0;
+        size_t index = start;
+        for (size_t i = start + 1; i < end; i++) {
+            double distance = JMapGMSegmentDistanceSquared(points[i], points[start], points[end], xScale);
+            if (distance > farthest) {
+                farthest = distance;
+                index = i;
+            }
+        }
+        if (farthest <= limit) continue;
+        keep[index] = true;
+        if (depth + 2 > capacity) {
+            capacity *= 2;
+            size_t *grown = realloc(stack, capacity * 2 * sizeof(size_t));
+            if (!grown) {
+                free(stack);
+                return false;
+            }
+            stack = grown;
+        }
+        stack[depth * 2] = start;
+        stack[depth * 2 + 1] = index;
+        depth++;
+        stack[depth * 2] = index;
+        stack[depth * 2 + 1] = end;
+        depth++;
+    }
+    free(stack);
+    return true;
+}
+
+size_t JMapGMSimplify(const JMapGMPoint *points, size_t count, bool closed, double tolerance, double xScale, JMapGMPoint *output)
+{
+    if (closed && count > 1 && points[0].x == points[count - 1].x && points[0].y == points[count - 1].y) count--;
+    if (count <= (closed ? 3 : 2)) {
+        for (size_t i = 0; i < count; i++) output[i] = points[i];
+        return count;
+    }
+    bool *keep = calloc(count, sizeof(bool));
+    if (!keep) return 0;
+
+    bool simplified;
+    if (closed) {
+        // Split the ring at the vertex farthest from the first, and close it back onto the first.
+        size_t split = 1;
+        double farthest = -1;
+        for (size_t i = 1; i < count; i++) {
+            double dx = (points[i].x - points[0].x) * xScale, dy = points[i].y - points[0].y;
+            if (dx * dx + dy * dy > farthest) {
+                farthest = dx * dx + dy * dy;
+                split = i;
+            }
+        }
+        simplified = JMapGMSimplifyRange(points, 0, split, tolerance, xScale, keep);
+        // The closing half runs split .. count - 1 .. 0; simplify it over a rotated copy.
+        size_t tail = count - split + 1;
+        JMapGMPoint *ring = malloc(tail * sizeof(JMapGMPoint));
+        bool *ringKeep = calloc(tail, sizeof(bool));
+        if (simplified && ring && ringKeep) {
+            for (size_t i = 0; i + 1 < tail; i++) ring[i] = points[split + i];
+            ring[tail - 1] = points[0];
+            simplified = JMapGMSimplifyRange(ring, 0, tail - 1, tolerance, xScale, ringKeep);
+            for (size_t i = 0; i + 1 < tail; i++) keep[split + i] = keep[split + i] || ringKeep[i];
+        } else {
+            simplified = false;
+        }
+        free(ring);
+        free(ringKeep);
+    } else {
+        simplified = JMapGMSimplifyRange(points, 0, count - 1, tolerance, xScale, keep);
+    }
+    if (!simplified) {
+        free(keep);
+        return 0;
+    }
+
+    size_t kept = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (keep[i]) output[kept++] = points[i];
+    }
+    // A ring flattened below a triangle is kept as it was.
+    if (closed && kept < 3) {
+        for (size_t i = 0; i < count; i++) output[i] = points[i];
+        kept = count;
+    }
+    free(keep);
+    return kept;
+}
@@ -0,0 +1,34 @@
+//
+//  JMapGMSimplify.h
+//  JMapOutdoorIndoorKit
+//
+//  Copyright © 2026 Jibestream. All rights reserved.
+//
+
+#ifndef JMapGMSimplify_h
+#define JMapGMSimplify_h
+
+#include "JMapGMTypes.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ *  Simplifies a polyline or ring with Douglas-Peucker, without recursion.
+ *
+ *  @param points The vertices; a ring may repeat its first vertex at the end
+ *  @param count The number of vertices
+ *  @param closed Whether the points form a ring. Rings keep at least 3 vertices, or all of them if they have fewer.
+ *  @param tolerance The largest distance a removed vertex may lie from the result
+ *  @param xScale Factor applied to x before measuring distances, e.g. cos(latitude) for longitude, latitude points
+ *  @param output Receives the kept vertices in order, at most count; may not alias points
+ *  @return The number of vertices written, or 0 if allocation failed
+ */
+size_t JMapGMSimplify(const JMapGMPoint *points, size_t count, bool closed, double tolerance, double xScale, JMapGMPoint *output);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* JMapGMSimplify_h */
@@ -0,0 +1,205 @@
+//
+//  JMapGMSnapshot.c
+//  JMapOutdoorIndoorKit
+//
+//  Copyright © 2026 Jibestream. All rights reserved.
+//
+
+#include "JMapGMSnapshot.h"
+#include "JMapGMTrace.h"
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define JMAPGM_SNAPSHOT_LINE 64
+
+typedef struct JMapGMSnapshotNode {
+    void *snapshot;
+    uint64_t version;
+    /** The epoch the snapshot was replaced in; readers that started earlier may hold it */
+    uint64_t retiredAt;
+    struct JMapGMSnapshotNode *next;
+} JMapGMSnapshotNode;
+
+/**
+ *  One reader, on its own cache line so readers do not contend. epoch is the epoch the current read
+ *  started in, 0 between reads.
+ */
+typedef struct {
+    _Alignas(JMAPGM_SNAPSHOT_LINE) atomic_uint_fast64_t epoch;
+    atomic_bool claimed;
+} JMapGMSnapshotReader;
+
+struct JMapGMSnapshotStore {
+    JMapGMSnapshotReader readers[JMAPGM_SNAPSHOT_READERS];
+    _Alignas(JMAPGM_SNAPSHOT_LINE) _Atomic(JMapGMSnapshotNode *) current;
+    atomic_uint_fast64_t epoch;
+    /** Everything below is guarded by lock */
+    pthread_mutex_t lock;
+    JMapGMSnapshotFree free;
+    uint64_t version;
+    JMapGMSnapshotNode *retired;
+    size_t retiredCount;
+    uint64_t freed;
+};
+
+JMapGMSnapshotStore *JMapGMSnapshotStoreCreate(JMapGMSnapshotFree free)
+{
+    void *memory = NULL;
+    if (posix_memalign(&memory, JMAPGM_SNAPSHOT_LINE, sizeof(JMapGMSnapshotStore)) != 0) return NULL;
+    JMapGMSnapshotStore *store = memory;
+    memset(store, 0, sizeof(JMapGMSnapshotStore));
+    for (size_t i = 0; i < JMAPGM_SNAPSHOT_READERS; i++) {
+        atomic_init(&store->readers[i].epoch, 0);
+        atomic_init(&store->readers[i].claimed, false);
+    }
+    atomic_init(&store->current, NULL);
+    atomic_init(&store->epoch, 1);
+    if (pthread_mutex_init(&store->lock, NULL) != 0) {
+        free(store);
+        return NULL;
+    }
+    store->free = free;
+    return store;
+}
+
+static void JMapGMSnapshotNodeFree(JMapGMSnapshotStore *store, JMapGMSnapshotNode *node)
+{
+    if (store->free && node->snapshot) store->free(node->snapshot);
+    free(node);
+}
+
+void JMapGMSnapshotStoreRelease(JMapGMSnapshotStore *store)
+{
+    if (!store) return;
+    JMapGMSnapshotNode *node = store->retired;
+    while (node) {
+        JMapGMSnapshotNode *next = node->next;
+        JMapGMSnapshotNodeFree(store, node);
+        node = next;
+    }
+    JMapGMSnapshotNode *current = atomic_load(&store->current);
+    if (current) JMapGMSnapshotNodeFree(store, current);
+    pthread_mutex_destroy(&store->lock);
+    free(store);
+}
+
+#pragma mark - Readers
+
+int JMapGMSnapshotStoreAddReader(JMapGMSnapshotStore *store)
+{
+    for (int i = 0; i < JMAPGM_SNAPSHOT_READERS; i++) {
+        if (atomic_load_explicit(&store->readers[i].claimed, memory_order_relaxed)) continue;
+        bool expected = false;
+        if (atomic_compare_exchange_strong(&store->readers[i].claimed, &expected, true)) return i;
+    }
+    return JMAPGM_SNAPSHOT_NO_READER;
+}
+
+void JMapGMSnapshotStoreRemoveReader(JMapGMSnapshotStore *store, int reader)
+{
+    if (reader < 0 || reader >= JMAPGM_SNAPSHOT_READERS) return;
+    atomic_store_explicit(&store->readers[reader].epoch, 0, memory_order_release);
+    atomic_store_explicit(&store->readers[reader].claimed, false, memory_order_release);
+}
+
+const void *JMapGMSnapshotStoreBeginRead(JMapGMSnapshotStore *store, int reader, uint64_t *version)
+{
+    JMapGMSnapshotReader *slot = &store->readers[reader];
+    // Both stores and loads are sequentially consistent: a publish that misses this epoch while
+    // reclaiming must have swapped before the load below, so the load returns the new snapshot.
+    atomic_store(&slot->epoch, atomic_load(&store->epoch));
+    JMapGMSnapshotNode *node = atomic_load(&store->current);
+    if (version) *version = node ? node->version : JMAPGM_SNAPSHOT_NONE;
+    return node ? node->snapshot : NULL;
+}
+
+void JMapGMSnapshotStoreEndRead(JMapGMSnapshotStore *store, int reader)
+{
+    atomic_store_explicit(&store->readers[reader].epoch, 0, memory_order_release);
+}
+
+#pragma mark - Writers
+
+// Unlinks the retired nodes that no reader can hold. Called with the lock held.
+static JMapGMSnapshotNode *JMapGMSnapshotStoreCollect(JMapGMSnapshotStore *store)
+{
+    if (!store->retired) return NULL;
+    uint64_t oldest = UINT64_MAX;
+    for (size_t i = 0; i < JMAPGM_SNAPSHOT_READERS; i++) {
+        uint64_t epoch = atomic_load(&store->readers[i].epoch);
+        if (epoch != 0 && epoch < oldest) oldest = epoch;
+    }
+    // A reader that started in epoch e may hold a node retired at r only if e < r.
+    JMapGMSnapshotNode *collected = NULL;
+    JMapGMSnapshotNode **link = &store->retired;
+    while (*link) {
+        JMapGMSnapshotNode *node = *link;
+        if (node->retiredAt <= oldest) {
+            *link = node->next;
+            node->next = collected;
+            collected = node;
+            store->retiredCount--;
+            store->freed++;
+        } else {
+            link = &node->next;
+        }
+    }
+    return collected;
+}
+
+// Frees collected nodes outside the lock, since freeing a large snapshot can take a while.
+static size_t JMapGMSnapshotStoreFreeCollected(JMapGMSnapshotStore *store, JMapGMSnapshotNode *node)
+{
+    size_t count = 0;
+    while (node) {
+        JMapGMSnapshotNode *next = node->next;
+        JMapGMSnapshotNodeFree(store, node);
+        node = next;
+        count++;
+    }
+    return count;
+}
+
+uint64_t JMapGMSnapshotStorePublish(JMapGMSnapshotStore *store, void *snapshot)
+{
+    JMAPGM_TRACE_SCOPE("snapshot.publish");
+    JMapGMSnapshotNode *node = calloc(1, sizeof(JMapGMSnapshotNode));
+    if (!node) return JMAPGM_SNAPSHOT_NONE;
+    node->snapshot = snapshot;
+
+    pthread_mutex_lock(&store->lock);
+    node->version = ++store->version;
+    JMapGMSnapshotNode *previous = atomic_exchange(&store->current, node);
+    uint64_t epoch = atomic_fetch_add(&store->epoch, 1) + 1;
+    if (previous) {
+        previous->retiredAt = epoch;
+        previous->next = store->retired;
+        store->retired = previous;
+        store->retiredCount++;
+    }
+    JMapGMSnapshotNode *collected = JMapGMSnapshotStoreCollect(store);
+    uint64_t version = node->version;
+    pthread_mutex_unlock(&store->lock);
+
+    JMapGMSnapshotStoreFreeCollected(store, collected);
+    return version;
+}
+
+size_t JMapGMSnapshotStoreReclaim(JMapGMSnapshotStore *store)
+{
+    pthread_mutex_lock(&store->lock);
+    JMapGMSnapshotNode *collected = JMapGMSnapshotStoreCollect(store);
+    pthread_mutex_unlock(&store->lock);
+    return JMapGMSnapshotStoreFreeCollected(store, collected);
+}
+
+JMapGMSnapshotStats JMapGMSnapshotStoreGetStats(JMapGMSnapshotStore *store)
+{
+    pthread_mutex_lock(&store->lock);
+    JMapGMSnapshotStats stats = { store->version, store->retiredCount, store->freed };
+    pthread_mutex_unlock(&store->lock);
+    return stats;
+}
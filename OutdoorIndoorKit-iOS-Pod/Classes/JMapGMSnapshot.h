@@ -0,0 +1,123 @@
+//
+//  JMapGMSnapshot.h
+//  JMapOutdoorIndoorKit
+//
+//  Copyright © 2026 Jibestream. All rights reserved.
+//
+
+#ifndef JMapGMSnapshot_h
+#define JMapGMSnapshot_h
+
+#include "JMapGMTypes.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ *  Publishes immutable snapshots to concurrent readers, read-copy-update style. A writer builds a
+ *  new snapshot aside and swaps it in with one atomic store; readers load the current one without
+ *  locks and never see a snapshot being modified. A replaced snapshot is freed once no reader that
+ *  could have loaded it is still reading, tracked by epochs: each read records the epoch it started
+ *  in, and each publish retires the old snapshot at a new epoch.
+ *
+ *  Reads, publishes and reclaims are safe from any thread. Publishes are serialized by a lock that
+ *  readers never take.
+ */
+typedef struct JMapGMSnapshotStore JMapGMSnapshotStore;
+
+/**
+ *  Frees a snapshot once no reader can hold it. Called on the thread that publishes or reclaims.
+ */
+typedef void (*JMapGMSnapshotFree)(void *snapshot);
+
+/** The number of readers that can read at once */
+#define JMAPGM_SNAPSHOT_READERS 64
+
+/** Returned by JMapGMSnapshotStoreAddReader when every reader slot is taken */
+#define JMAPGM_SNAPSHOT_NO_READER (-1)
+
+/** The version of no snapshot, returned by JMapGMSnapshotStorePublish if allocation failed */
+#define JMAPGM_SNAPSHOT_NONE 0
+
+/**
+ *  Publishing and reclaiming counts
+ */
+typedef struct {
+    /** The version of the current snapshot; versions count publishes from 1 */
+    uint64_t version;
+    /** Replaced snapshots waiting for their readers */
+    size_t retired;
+    /** Replaced snapshots freed so far */
+    uint64_t freed;
+} JMapGMSnapshotStats;
+
+/**
+ *  Creates a store without a snapshot.
+ *
+ *  @param free Frees snapshots, or NULL if the caller owns them
+ *  @return The store, or NULL if allocation failed
+ */
+JMapGMSnapshotStore *JMapGMSnapshotStoreCreate(JMapGMSnapshotFree free);
+
+/**
+ *  Releases a store and frees its snapshots. No reader may be reading.
+ */
+void JMapGMSnapshotStoreRelease(JMapGMSnapshotStore *store);
+
+#pragma mark - Readers
+
+/**
+ *  Claims a reader slot, without locks. A thread that reads often keeps its slot; one that reads
+ *  once claims and removes it around the read.
+ *
+ *  @return The reader, or JMAPGM_SNAPSHOT_NO_READER if JMAPGM_SNAPSHOT_READERS readers are added
+ */
+int JMapGMSnapshotStoreAddReader(JMapGMSnapshotStore *store);
+
+/**
+ *  Gives back a reader slot. The reader must not be reading.
+ */
+void JMapGMSnapshotStoreRemoveReader(JMapGMSnapshotStore *store, int reader);
+
+/**
+ *  Starts a read and returns the current snapshot, which stays valid until JMapGMSnapshotStoreEndRead
+ *  even if another is published meanwhile. Lock free. Reads of one reader do not nest; long reads
+ *  hold back freeing every snapshot replaced during them.
+ *
+ *  @param reader A reader from JMapGMSnapshotStoreAddReader
+ *  @param version Receives the version of the snapshot, JMAPGM_SNAPSHOT_NONE if there is none. May be NULL.
+ *  @return The snapshot, or NULL if none was published
+ */
+const void *JMapGMSnapshotStoreBeginRead(JMapGMSnapshotStore *store, int reader, uint64_t *version);
+
+/**
+ *  Ends a read. The snapshot it returned must not be used afterwards.
+ */
+void JMapGMSnapshotStoreEndRead(JMapGMSnapshotStore *store, int reader);
+
+#pragma mark - Writers
+
+/**
+ *  Replaces the current snapshot. Readers that already started keep the one they loaded, readers
+ *  that start afterwards load the new one. Frees replaced snapshots that no reader holds any more.
+ *
+ *  @param snapshot The new snapshot, owned by the store from now on and never modified again
+ *  @return The version of the snapshot, or JMAPGM_SNAPSHOT_NONE if allocation failed, in which case the store does not own it
+ */
+uint64_t JMapGMSnapshotStorePublish(JMapGMSnapshotStore *store, void *snapshot);
+
+/**
+ *  Frees replaced snapshots that no reader holds any more, e.g. after long reads end without a publish.
+ *
+ *  @return The number freed
+ */
+size_t JMapGMSnapshotStoreReclaim(JMapGMSnapshotStore *store);
+
+JMapGMSnapshotStats JMapGMSnapshotStoreGetStats(JMapGMSnapshotStore *store);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* JMapGMSnapshot_h */
@@ -0,0 +1,168 @@
+//
+//  JMapGMSpatialIndex.c
+//  JMapOutdoorIndoorKit
+//
+//  Copyright © 2026 Jibestream. All rights reserved.
+//
+
+#include "JMapGMSpatialIndex.h"
+
+#include <stdlib.h>
+
+static const size_t JMapGMRTreeDefaultCapacity = 16;
+// Keeps the query stack bounded: depth times fan-out stays well under its size.
+static const size_t JMapGMRTreeMaxCapacity = 32;
+
+// Both nodes and items start with their rectangle, so one sort serves both.
+typedef struct {
+    JMapGMRect rect;
+    uint32_t first;
+    uint32_t count;
+    bool leaf;
+} JMapGMRTreeNode;
+
+typedef struct {
+    JMapGMRect rect;
+    uint32_t id;
+} JMapGMRTreeEntry;
+
+struct JMapGMRTree {
+    JMapGMRTreeNode *nodes;
+    size_t nodeCount;
+    size_t root;
+    JMapGMRTreeEntry *items;
+    size_t itemCount;
+};
+
+static int JMapGMCompareCenterX(const void *a, const void *b)
+{
+    const JMapGMRect *ra = a, *rb = b;
+    double ca = ra->minX + ra->maxX, cb = rb->minX + rb->maxX;
+    return (ca > cb) - (ca < cb);
+}
+
+static int JMapGMCompareCenterY(const void *a, const void *b)
+{
+    const JMapGMRect *ra = a, *rb = b;
+    double ca = ra->minY + ra->maxY, cb = rb->minY + rb->maxY;
+    return (ca > cb) - (ca < cb);
+}
+
+// Orders elements so that every run of `capacity` of them is spatially compact.
+static void JMapGMSortTileRecursive(void *elements, size_t count, size_t size, size_t capacity)
+{
+    size_t groups = (count + capacity - 1) / capacity;
+    size_t slices = (size_t)ceil(sqrt((double)groups));
+    size_t sliceSize = slices * capacity;
+    qsort(elements, count, size, JMapGMCompareCenterX);
+    for (size_t start = 0; start < count; start += sliceSize) {
+        size_t length = count - start < sliceSize ? count - start : sliceSize;
+        qsort((char *)elements + start * size, length, size, JMapGMCompareCenterY);
+    }
+}
+
+JMapGMRTree *JMapGMRTreeCreate(const JMapGMRect *rects, size_t count, size_t nodeCapacity)
+{
+    size_t capacity = nodeCapacity >= 2 ? nodeCapacity : JMapGMRTreeDefaultCapacity;
+    if (capacity > JMapGMRTreeMaxCapacity) capacity = JMapGMRTreeMaxCapacity;
+    JMapGMRTree *tree = calloc(1, sizeof(JMapGMRTree));
+    if (!tree) return NULL;
+
+    tree->items = malloc((count ? count : 1) * sizeof(JMapGMRTreeEntry));
+    if (!tree->items) goto fail;
+    for (size_t i = 0; i < count; i++) {
+        if (JMapGMRectIsNull(rects[i])) continue;
+        tree->items[tree->itemCount].rect = rects[i];
+        tree->items[tree->itemCount].id = (uint32_t)i;
+        tree->itemCount++;
+    }
+    if (tree->itemCount == 0) return tree;
+
+    // Counts the nodes of every level up to the root; with a capacity of 2 the
+    // levels above the leaves can add up to more than the leaves themselves.
+    size_t leafCount = (tree->itemCount + capacity - 1) / capacity;
+    size_t totalCount = leafCount;
+    for (size_t levelSize = leafCount; levelSize > 1; totalCount += levelSize) levelSize = (levelSize + capacity - 1) / capacity;
+    tree->nodes = malloc(totalCount * sizeof(JMapGMRTreeNode));
+    JMapGMRTreeNode *level = malloc(leafCount * sizeof(JMapGMRTreeNode));
+    if (!tree->nodes || !level) {
+        free(level);
+        goto fail;
+    }
+
+    JMapGMSortTileRecursive(tree->items, tree->itemCount, sizeof(JMapGMRTreeEntry), capacity);
+    size_t levelCount = 0;
+    for (size_t start = 0; start < tree->itemCount; start += capacity) {
+        size_t length = tree->itemCount - start < capacity ? tree->itemCount - start : capacity;
+        JMapGMRect rect = JMapGMRectNull;
+        for (size_t i = start; i < start + length; i++) rect = JMapGMRectUnion(rect, tree->items[i].rect);
+        level[levelCount++] = (JMapGMRTreeNode){ rect, (uint32_t)start, (uint32_t)length, true };
+    }
+
+    // Each level is packed, written out, and grouped into the level above,
+    // so siblings are always contiguous in the node array.
+    while (levelCount > 1) {
+        JMapGMSortTileRecursive(level, levelCount, sizeof(JMapGMRTreeNode), capacity);
+        size_t firstChild = tree->nodeCount;
+        for (size_t i = 0; i < levelCount; i++) {
+            tree->nodes[tree->nodeCount++] = level[i];
+        }
+        size_t parents = 0;
+        for (size_t start = 0; start < levelCount; start += capacity) {
+            size_t length = levelCount - start < capacity ? levelCount - start : capacity;
+            JMapGMRect rect = JMapGMRectNull;
+            for (size_t i = start; i < start + length; i++) rect = JMapGMRectUnion(rect, level[i].rect);
+            level[parents++] = (JMapGMRTreeNode){ rect, (uint32_t)(firstChild + start), (uint32_t)length, false };
+        }
+        levelCount = parents;
+    }
+    tree->root = tree->nodeCount;
+    tree->nodes[tree->nodeCount++] = level[0];
+    free(level);
+    return tree;
+
+fail:
+    JMapGMRTreeRelease(tree);
+    return NULL;
+}
+
+void JMapGMRTreeRelease(JMapGMRTree *tree)
+{
+    if (!tree) return;
+    free(tree->nodes);
+    free(tree->items);
+    free(tree);
+}
+
+JMapGMRect JMapGMRTreeGetBounds(const JMapGMRTree *tree)
+{
+    return tree->nodeCount ? tree->nodes[tree->root].rect : JMapGMRectNull;
+}
+
+void JMapGMRTreeQuery(const JMapGMRTree *tree, JMapGMRect rect, JMapGMRTreeVisitor visitor, void *context)
+{
+    if (tree->nodeCount == 0) return;
+
+    uint32_t stack[256];
+    size_t depth = 0;
+    stack[depth++] = (uint32_t)tree->root;
+    while (depth > 0) {
+        const JMapGMRTreeNode *node = &tree->nodes[stack[--depth]];
+        if (!JMapGMRectIntersects(node->rect, rect)) continue;
+        if (node->leaf) {
+            for (uint32_t i = node->first; i < node->first + node->count; i++) {
+                if (JMapGMRectIntersects(tree->items[i].rect, rect) && !visitor(tree->items[i].id, context)) return;
+            }
+        } else {
+            for (uint32_t i = node->first + node->count; i > node->first; i--) {
+                stack[depth++] = i - 1;
+            }
+        }
+    }
+}
+
+void JMapGMRTreeQueryPoint(const JMapGMRTree *tree, JMapGMPoint point, JMapGMRTreeVisitor visitor, void *context)
+{
+    JMapGMRect rect = { point.x, point.y, point.x, point.y };
+    JMapGMRTreeQuery(tree, rect, visitor, context);
+}
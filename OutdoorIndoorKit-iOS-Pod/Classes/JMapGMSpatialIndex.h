@@ -0,0 +1,66 @@
+//
+//  JMapGMSpatialIndex.h
+//  JMapOutdoorIndoorKit
+//
+//  Copyright © 2026 Jibestream. All rights reserved.
+//
+
+#ifndef JMapGMSpatialIndex_h
+#define JMapGMSpatialIndex_h
+
+#include "JMapGMTypes.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ *  Static R-tree over rectangles, bulk loaded with Sort-Tile-Recursive packing.
+ *  Immutable once created, so it can be queried from any number of threads.
+ */
+typedef struct JMapGMRTree JMapGMRTree;
+
+/**
+ *  Visitor called for every item whose rectangle intersects the query.
+ *
+ *  @param item The index of the rectangle passed to JMapGMRTreeCreate
+ *  @param context The context passed to the query
+ *  @return false to stop the query
+ */
+typedef bool (*JMapGMRTreeVisitor)(uint32_t item, void *context);
+
+/**
+ *  Creates a tree. Null rectangles are never reported.
+ *
+ *  @param rects The item rectangles; item ids are their indexes
+ *  @param count Number of rectangles
+ *  @param nodeCapacity Maximum children per node up to 32, 0 for the default of 16
+ *  @return A new tree, or NULL if allocation failed
+ */
+JMapGMRTree *JMapGMRTreeCreate(const JMapGMRect *rects, size_t count, size_t nodeCapacity);
+
+/**
+ *  Releases a tree created with JMapGMRTreeCreate.
+ */
+void JMapGMRTreeRelease(JMapGMRTree *tree);
+
+/**
+ *  Bounds of all items, JMapGMRectNull when empty
+ */
+JMapGMRect JMapGMRTreeGetBounds(const JMapGMRTree *tree);
+
+/**
+ *  Visits every item intersecting a rectangle.
+ */
+void JMapGMRTreeQuery(const JMapGMRTree *tree, JMapGMRect rect, JMapGMRTreeVisitor visitor, void *context);
+
+/**
+ *  Visits every item whose rectangle contains a point.
+ */
+void JMapGMRTreeQueryPoint(const JMapGMRTree *tree, JMapGMPoint point, JMapGMRTreeVisitor visitor, void *context);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* JMapGMSpatialIndex_h */
@@ -0,0 +1,517 @@
+//
+//  JMapGMTextIndex.c
+//  JMapOutdoorIndoorKit
+//
+//  Copyright © 2026 Jibestream. All rights reserved.
+//
+
+#include "JMapGMTextIndex.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+/** Longer tokens are truncated, which also bounds the trie depth */
+#define JMAPGM_TEXT_MAX_TOKEN 48
+/** Query tokens past this many are ignored */
+#define JMAPGM_TEXT_MAX_QUERY_TOKENS 8
+#define JMAPGM_TEXT_NONE UINT32_MAX
+
+const JMapGMTextSearchOptions JMapGMTextSearchOptionsDefault = {
+    .typos = true,
+    .distances = NULL,
+    .distanceCount = 0,
+    .distanceWeight = 0.1f,
+};
+
+typedef struct {
+    uint32_t firstChild;
+    /** Siblings are kept sorted by byte */
+    uint32_t nextSibling;
+    uint32_t token;
+    uint8_t byte;
+} JMapGMTrieNode;
+
+typedef struct {
+    /** Posting list of the documents containing the token */
+    uint32_t *documents;
+    uint32_t count;
+    uint32_t capacity;
+    uint32_t length;
+} JMapGMTextToken;
+
+typedef struct {
+    uint32_t *tokens;
+    uint32_t tokenCount;
+    bool present;
+} JMapGMTextDocument;
+
+struct JMapGMTextIndex {
+    JMapGMTrieNode *nodes;
+    size_t nodeCount;
+    size_t nodeCapacity;
+    JMapGMTextToken *tokens;
+    size_t tokenCount;
+    size_t tokenCapacity;
+    JMapGMTextDocument *documents;
+    size_t documentCapacity;
+    size_t documentCount;
+
+    // Search scratch, per document: the search that last touched it, the query tokens it matched so
+    // far, its best score for the current query token and its running total.
+    uint32_t *generations;
+    uint8_t *matchedCounts;
+    float *tokenBests;
+    float *totals;
+    uint32_t generation;
+    uint32_t *candidates;
+
+    // Search scratch, per token: the tokens matched by the current query token and their scores.
+    uint32_t *hitGenerations;
+    uint32_t *hitSlots;
+    uint32_t hitGeneration;
+    uint32_t *hitTokens;
+    float *hitScores;
+    size_t hitCount;
+    size_t hitCapacity;
+};
+
+JMapGMTextIndex *JMapGMTextIndexCreate(void)
+{
+    JMapGMTextIndex *index = calloc(1, sizeof(JMapGMTextIndex));
+    if (!index) return NULL;
+    index->nodes = malloc(64 * sizeof(JMapGMTrieNode));
+    if (!index->nodes) {
+        free(index);
+        return NULL;
+    }
+    index->nodeCapacity = 64;
+    index->nodes[0] = (JMapGMTrieNode){ JMAPGM_TEXT_NONE, JMAPGM_TEXT_NONE, JMAPGM_TEXT_NONE, 0 };
+    index->nodeCount = 1;
+    return index;
+}
+
+void JMapGMTextIndexRelease(JMapGMTextIndex *index)
+{
+    if (!index) return;
+    for (size_t i = 0; i < index->tokenCount; i++) free(index->tokens[i].documents);
+    for (size_t i = 0; i < index->documentCapacity; i++) free(index->documents[i].tokens);
+    free(index->nodes);
+    free(index->tokens);
+    free(index->documents);
+    free(index->generations);
+    free(index->matchedCounts);
+    free(index->tokenBests);
+    free(index->totals);
+    free(index->candidates);
+    free(index->hitGenerations);
+    free(index->hitSlots);
+    free(index->hitTokens);
+    free(index->hitScores);
+    free(index);
+}
+
+size_t JMapGMTextIndexGetDocumentCount(const JMapGMTextIndex *index)
+{
+    return index->documentCount;
+}
+
+#pragma mark - Tokens
+
+// Reads the next token at *position into token, lowercased. Returns its length, 0 at the end.
+static size_t JMapGMTextNextToken(const char *text, size_t length, size_t *position, char *token)
+{
+    size_t i = *position, count = 0;
+    while (i < length) {
+        uint8_t c = (uint8_t)text[i];
+        bool word = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c >= 0x80;
+        if (!word) {
+            i++;
+            if (count) break;
+            continue;
+        }
+        if (count < JMAPGM_TEXT_MAX_TOKEN) token[count++] = (char)(c >= 'A' && c <= 'Z' ? c + ('a' - 'A') : c);
+        i++;
+    }
+    *position = i;
+    return count;
+}
+
+#define JMAPGM_TEXT_GROW(pointer, capacity, needed, initial, ok)                               \
+    do {                                                                                       \
+        if ((needed) > (capacity)) {                                                           \
+            size_t grown = (capacity) ? (capacity) : (initial);                                \
+            while (grown < (needed)) grown *= 2;                                               \
+            void *resized = realloc((pointer), grown * sizeof(*(pointer)));                    \
+            if (!resized) { ok = false; break; }                                               \
+            (pointer) = resized;                                                               \
+        }                                                                                      \
+    } while (0)
+
+static bool JMapGMTextIndexReserveTokens(JMapGMTextIndex *index, size_t needed)
+{
+    if (needed <= index->tokenCapacity) return true;
+    size_t capacity = index->tokenCapacity ? index->tokenCapacity : 64;
+    while (capacity < needed) capacity *= 2;
+    bool ok = true;
+    JMAPGM_TEXT_GROW(index->tokens, index->tokenCapacity, capacity, 64, ok);
+    JMAPGM_TEXT_GROW(index->hitGenerations, index->tokenCapacity, capacity, 64, ok);
+    JMAPGM_TEXT_GROW(index->hitSlots, index->tokenCapacity, capacity, 64, ok);
+    if (!ok) return false;
+    for (size_t i = index->tokenCapacity; i < capacity; i++) index->hitGenerations[i] = 0;
+    index->tokenCapacity = capacity;
+    return true;
+}
+
+static bool JMapGMTextIndexReserveDocuments(JMapGMTextIndex *index, size_t needed)
+{
+    if (needed <= index->documentCapacity) return true;
+    size_t capacity = index->documentCapacity ? index->documentCapacity : 64;
+    while (capacity < needed) capacity *= 2;
+    bool ok = true;
+    JMAPGM_TEXT_GROW(index->documents, index->documentCapacity, capacity, 64, ok);
+    JMAPGM_TEXT_GROW(index->generations, index->documentCapacity, capacity, 64, ok);
+    JMAPGM_TEXT_GROW(index->matchedCounts, index->documentCapacity, capacity, 64, ok);
+    JMAPGM_TEXT_GROW(index->tokenBests, index->documentCapacity, capacity, 64, ok);
+    JMAPGM_TEXT_GROW(index->totals, index->documentCapacity, capacity, 64, ok);
+    JMAPGM_TEXT_GROW(index->candidates, index->documentCapacity, capacity, 64, ok);
+    if (!ok) return false;
+    for (size_t i = index->documentCapacity; i < capacity; i++) {
+        index->documents[i] = (JMapGMTextDocument){ NULL, 0, false };
+        index->generations[i] = 0;
+    }
+    index->documentCapacity = capacity;
+    return true;
+}
+
+// Finds or adds the trie path of a token. Returns the token, or JMAPGM_TEXT_NONE if allocation failed.
+static uint32_t JMapGMTextIndexInternToken(JMapGMTextIndex *index, const char *text, size_t length)
+{
+    uint32_t node = 0;
+    for (size_t i = 0; i < length; i++) {
+        uint8_t byte = (uint8_t)text[i];
+        uint32_t previous = JMAPGM_TEXT_NONE, child = index->nodes[node].firstChild;
+        while (child != JMAPGM_TEXT_NONE && index->nodes[child].byte < byte) {
+            previous = child;
+            child = index->nodes[child].nextSibling;
+        }
+        if (child != JMAPGM_TEXT_NONE && index->nodes[child].byte == byte) {
+            node = child;
+            continue;
+        }
+        if (index->nodeCount == index->nodeCapacity) {
+            JMapGMTrieNode *grown = realloc(index->nodes, index->nodeCapacity * 2 * sizeof(JMapGMTrieNode));
+            if (!grown) return JMAPGM_TEXT_NONE;
+            index->nodes = grown;
+            index->nodeCapacity *= 2;
+        }
+        uint32_t added = (uint32_t)index->nodeCount++;
+        index->nodes[added] = (JMapGMTrieNode){ JMAPGM_TEXT_NONE, child, JMAPGM_TEXT_NONE, byte };
+        if (previous == JMAPGM_TEXT_NONE) index->nodes[node].firstChild = added;
+        else index->nodes[previous].nextSibling = added;
+        node = added;
+    }
+    if (index->nodes[node].token != JMAPGM_TEXT_NONE) return index->nodes[node].token;
+    if (!JMapGMTextIndexReserveTokens(index, index->tokenCount + 1)) return JMAPGM_TEXT_NONE;
+    uint32_t token = (uint32_t)index->tokenCount++;
+    index->tokens[token] = (JMapGMTextToken){ NULL, 0, 0, (uint32_t)length };
+    index->nodes[node].token = token;
+    return token;
+}
+
+static bool JMapGMTextTokenAddDocument(JMapGMTextToken *token, uint32_t document)
+{
+    if (token->count == token->capacity) {
+        uint32_t capacity = token->capacity ? token->capacity * 2 : 4;
+        uint32_t *documents = realloc(token->documents, capacity * sizeof(uint32_t));
+        if (!documents) return false;
+        token->documents = documents;
+        token->capacity = capacity;
+    }
+    token->documents[token->count++] = document;
+    return true;
+}
+
+static void JMapGMTextTokenRemoveDocument(JMapGMTextToken *token, uint32_t document)
+{
+    for (uint32_t i = 0; i < token->count; i++) {
+        if (token->documents[i] == document) {
+            token->documents[i] = token->documents[--token->count];
+            return;
+        }
+    }
+}
+
+#pragma mark - Documents
+
+void JMapGMTextIndexRemove(JMapGMTextIndex *index, uint32_t document)
+{
+    if (document >= index->documentCapacity || !index->documents[document].present) return;
+    JMapGMTextDocument *entry = &index->documents[document];
+    for (uint32_t i = 0; i < entry->tokenCount; i++) JMapGMTextTokenRemoveDocument(&index->tokens[entry->tokens[i]], document);
+    free(entry->tokens);
+    *entry = (JMapGMTextDocument){ NULL, 0, false };
+    index->documentCount--;
+}
+
+bool JMapGMTextIndexAdd(JMapGMTextIndex *index, uint32_t document, const char *text, size_t length)
+{
+    if (document == JMAPGM_TEXT_NONE) return false;
+    JMapGMTextIndexRemove(index, document);
+    if (!JMapGMTextIndexReserveDocuments(index, (size_t)document + 1)) return false;
+
+    uint32_t *tokens = NULL;
+    uint32_t tokenCount = 0, tokenCapacity = 0;
+    char buffer[JMAPGM_TEXT_MAX_TOKEN];
+    size_t position = 0, tokenLength;
+    while ((tokenLength = JMapGMTextNextToken(text, length, &position, buffer)) > 0) {
+        uint32_t token = JMapGMTextIndexInternToken(index, buffer, tokenLength);
+        if (token == JMAPGM_TEXT_NONE) goto failed;
+        bool repeated = false;
+        for (uint32_t i = 0; i < tokenCount && !repeated; i++) repeated = tokens[i] == token;
+        if (repeated) continue;
+        if (tokenCount == tokenCapacity) {
+            tokenCapacity = tokenCapacity ? tokenCapacity * 2 : 4;
+            uint32_t *grown = realloc(tokens, tokenCapacity * sizeof(uint32_t));
+            if (!grown) goto failed;
+            tokens = grown;
+        }
+        if (!JMapGMTextTokenAddDocument(&index->tokens[token], document)) goto failed;
+        tokens[tokenCount++] = token;
+    }
+    index->documents[document] = (JMapGMTextDocument){ tokens, tokenCount, true };
+    index->documentCount++;
+    return true;
+
+failed:
+    for (uint32_t i = 0; i < tokenCount; i++) JMapGMTextTokenRemoveDocument(&index->tokens[tokens[i]], document);
+    free(tokens);
+    return false;
+}
+
+#pragma mark - Search
+
+typedef struct {
+    JMapGMTextIndex *index;
+    const char *query;
+    size_t length;
+    int maxEdits;
+    bool ok;
+} JMapGMTextWalk;
+
+static void JMapGMTextWalkHit(JMapGMTextWalk *walk, uint32_t token, float score)
+{
+    JMapGMTextIndex *index = walk->index;
+    if (index->hitGenerations[token] == index->hitGeneration) {
+        uint32_t slot = index->hitSlots[token];
+        if (score > index->hitScores[slot]) index->hitScores[slot] = score;
+        return;
+    }
+    if (index->hitCount == index->hitCapacity) {
+        size_t capacity = index->hitCapacity ? index->hitCapacity * 2 : 64;
+        uint32_t *tokens = realloc(index->hitTokens, capacity * sizeof(uint32_t));
+        if (tokens) index->hitTokens = tokens;
+        float *scores = realloc(index->hitScores, capacity * sizeof(float));
+        if (scores) index->hitScores = scores;
+        if (!tokens || !scores) {
+            walk->ok = false;
+            return;
+        }
+        index->hitCapacity = capacity;
+    }
+    index->hitGenerations[token] = index->hitGeneration;
+    index->hitSlots[token] = (uint32_t)index->hitCount;
+    index->hitTokens[index->hitCount] = token;
+    index->hitScores[index->hitCount++] = score;
+}
+
+// A prefix match scores below any whole word match and more the more of the token it covers.
+static float JMapGMTextPrefixScore(const JMapGMTextWalk *walk, uint32_t token, int edits)
+{
+    float coverage = (float)walk->length / (float)walk->index->tokens[token].length;
+    if (coverage > 1) coverage = 1;
+    return 0.6f + 0.3f * coverage - 0.3f * (float)edits;
+}
+
+// Reports every token below node as a prefix match.
+static void JMapGMTextWalkSubtree(JMapGMTextWalk *walk, uint32_t node, int edits)
+{
+    const JMapGMTrieNode *nodes = walk->index->nodes;
+    for (uint32_t child = nodes[node].firstChild; child != JMAPGM_TEXT_NONE; child = nodes[child].nextSibling) {
+        uint32_t token = nodes[child].token;
+        if (token != JMAPGM_TEXT_NONE) JMapGMTextWalkHit(walk, token, JMapGMTextPrefixScore(walk, token, edits));
+        JMapGMTextWalkSubtree(walk, child, edits);
+    }
+}
+
+// Walks the trie below node with one edit distance row per level, counting a swap of adjacent bytes
+// as one edit. above is the row before previous, NULL at the root. bestPrefix is the fewest edits
+// turning the query into any prefix of the path so far.
+static void JMapGMTextWalkNode(JMapGMTextWalk *walk, uint32_t node, const int *above, const int *previous, int bestPrefix)
+{
+    const JMapGMTrieNode *nodes = walk->index->nodes;
+    size_t m = walk->length;
+    int row[JMAPGM_TEXT_MAX_TOKEN + 1];
+    for (uint32_t child = nodes[node].firstChild; child != JMAPGM_TEXT_NONE && walk->ok; child = nodes[child].nextSibling) {
+        uint8_t byte = nodes[child].byte;
+        row[0] = previous[0] + 1;
+        int rowMin = row[0];
+        for (size_t j = 1; j <= m; j++) {
+            int substitute = previous[j - 1] + ((uint8_t)walk->query[j - 1] != byte);
+            int insert = previous[j] + 1, remove = row[j - 1] + 1;
+            int best = substitute < insert ? substitute : insert;
+            row[j] = best < remove ? best : remove;
+            if (above && j > 1 && (uint8_t)walk->query[j - 2] == byte && (uint8_t)walk->query[j - 1] == nodes[node].byte &&
+                above[j - 2] + 1 < row[j]) {
+                row[j] = above[j - 2] + 1;
+            }
+            if (row[j] < rowMin) rowMin = row[j];
+        }
+        int prefix = row[m] < bestPrefix ? row[m] : bestPrefix;
+
+        uint32_t token = nodes[child].token;
+        if (token != JMAPGM_TEXT_NONE) {
+            float score = -INFINITY;
+            if (row[m] <= walk->maxEdits) score = 1.0f - 0.3f * (float)row[m];
+            if (prefix <= walk->maxEdits) {
+                float prefixScore = JMapGMTextPrefixScore(walk, token, prefix);
+                if (prefixScore > score) score = prefixScore;
+            }
+            if (score > -INFINITY) JMapGMTextWalkHit(walk, token, score);
+        }
+        if (rowMin <= walk->maxEdits) JMapGMTextWalkNode(walk, child, previous, row, prefix);
+        else if (prefix <= walk->maxEdits) JMapGMTextWalkSubtree(walk, child, prefix);
+    }
+}
+
+static uint32_t JMapGMTextNextGeneration(uint32_t *generation, uint32_t *stamps, size_t count)
+{
+    if (++*generation == 0) {
+        memset(stamps, 0, count * sizeof(uint32_t));
+        *generation = 1;
+    }
+    return *generation;
+}
+
+typedef struct {
+    JMapGMTextMatch match;
+    uint32_t tokenCount;
+} JMapGMTextRanked;
+
+// Whether a ranks before b.
+static bool JMapGMTextRanksBefore(const JMapGMTextRanked *a, const JMapGMTextRanked *b)
+{
+    if (a->match.score != b->match.score) return a->match.score > b->match.score;
+    if (a->tokenCount != b->tokenCount) return a->tokenCount < b->tokenCount;
+    return a->match.document < b->match.document;
+}
+
+// Restores a heap whose root is the entry ranking last.
+static void JMapGMTextHeapDown(JMapGMTextRanked *heap, size_t count, size_t i)
+{
+    for (;;) {
+        size_t worst = i, left = 2 * i + 1, right = left + 1;
+        if (left < count && JMapGMTextRanksBefore(&heap[worst], &heap[left])) worst = left;
+        if (right < count && JMapGMTextRanksBefore(&heap[worst], &heap[right])) worst = right;
+        if (worst == i) return;
+        JMapGMTextRanked swap = heap[i];
+        heap[i] = heap[worst];
+        heap[worst] = swap;
+        i = worst;
+    }
+}
+
+static void JMapGMTextHeapUp(JMapGMTextRanked *heap, size_t i)
+{
+    while (i > 0) {
+        size_t parent = (i - 1) / 2;
+        if (!JMapGMTextRanksBefore(&heap[parent], &heap[i])) return;
+        JMapGMTextRanked swap = heap[i];
+        heap[i] = heap[parent];
+        heap[parent] = swap;
+        i = parent;
+    }
+}
+
+size_t JMapGMTextIndexSearch(JMapGMTextIndex *index, const char *query, size_t length, const JMapGMTextSearchOptions *options,
+                             JMapGMTextMatch *matches, size_t capacity)
+{
+    if (!options) options = &JMapGMTextSearchOptionsDefault;
+    if (capacity == 0 || index->documentCount == 0) return 0;
+
+    char queryTokens[JMAPGM_TEXT_MAX_QUERY_TOKENS][JMAPGM_TEXT_MAX_TOKEN];
+    size_t queryLengths[JMAPGM_TEXT_MAX_QUERY_TOKENS];
+    size_t queryCount = 0, position = 0, tokenLength;
+    while (queryCount < JMAPGM_TEXT_MAX_QUERY_TOKENS &&
+           (tokenLength = JMapGMTextNextToken(query, length, &position, queryTokens[queryCount])) > 0) {
+        queryLengths[queryCount++] = tokenLength;
+    }
+    if (queryCount == 0) return 0;
+
+    uint32_t generation = JMapGMTextNextGeneration(&index->generation, index->generations, index->documentCapacity);
+    size_t candidateCount = 0;
+    for (size_t q = 0; q < queryCount; q++) {
+        JMapGMTextNextGeneration(&index->hitGeneration, index->hitGenerations, index->tokenCapacity);
+        index->hitCount = 0;
+        JMapGMTextWalk walk = { index, queryTokens[q], queryLengths[q], 0, true };
+        if (options->typos) walk.maxEdits = queryLengths[q] >= 8 ? 2 : queryLengths[q] >= 4 ? 1 : 0;
+        int root[JMAPGM_TEXT_MAX_TOKEN + 1];
+        for (size_t j = 0; j <= walk.length; j++) root[j] = (int)j;
+        JMapGMTextWalkNode(&walk, 0, NULL, root, (int)walk.length);
+        if (!walk.ok) return 0;
+
+        // A document keeps the best score of its tokens for this query token, and stays a
+        // candidate only while it has matched every query token so far.
+        for (size_t h = 0; h < index->hitCount; h++) {
+            const JMapGMTextToken *token = &index->tokens[index->hitTokens[h]];
+            float score = index->hitScores[h];
+            for (uint32_t p = 0; p < token->count; p++) {
+                uint32_t document = token->documents[p];
+                if (index->generations[document] != generation) {
+                    if (q > 0) continue;
+                    index->generations[document] = generation;
+                    index->matchedCounts[document] = 0;
+                    index->totals[document] = 0;
+                    index->candidates[candidateCount++] = document;
+                }
+                uint8_t matched = index->matchedCounts[document];
+                if (matched == q) {
+                    index->matchedCounts[document] = (uint8_t)(q + 1);
+                    index->tokenBests[document] = score;
+                    index->totals[document] += score;
+                } else if (matched == q + 1 && score > index->tokenBests[document]) {
+                    index->totals[document] += score - index->tokenBests[document];
+                    index->tokenBests[document] = score;
+                }
+            }
+        }
+    }
+
+    JMapGMTextRanked *heap = malloc(capacity * sizeof(JMapGMTextRanked));
+    if (!heap) return 0;
+    size_t count = 0;
+    for (size_t c = 0; c < candidateCount; c++) {
+        uint32_t document = index->candidates[c];
+        if (index->matchedCounts[document] != queryCount) continue;
+        float score = index->totals[document] / (float)queryCount;
+        if (options->distances && document < options->distanceCount && !isnan(options->distances[document])) {
+            score -= options->distanceWeight * options->distances[document] / 100.0f;
+        }
+        JMapGMTextRanked ranked = { { document, score }, index->documents[document].tokenCount };
+        if (count < capacity) {
+            heap[count] = ranked;
+            JMapGMTextHeapUp(heap, count++);
+        } else if (JMapGMTextRanksBefore(&ranked, &heap[0])) {
+            heap[0] = ranked;
+            JMapGMTextHeapDown(heap, count, 0);
+        }
+    }
+    // Pop the last ranked entry into the end until the heap is empty.
+    for (size_t end = count; end > 0; end--) {
+        matches[end - 1] = heap[0].match;
+        heap[0] = heap[end - 1];
+        JMapGMTextHeapDown(heap, end - 1, 0);
+    }
+    free(heap);
+    return count;
+}
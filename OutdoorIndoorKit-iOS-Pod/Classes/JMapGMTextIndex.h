@@ -0,0 +1,96 @@
+//
+//  JMapGMTextIndex.h
+//  JMapOutdoorIndoorKit
+//
+//  Copyright © 2026 Jibestream. All rights reserved.
+//
+
+#ifndef JMapGMTextIndex_h
+#define JMapGMTextIndex_h
+
+#include "JMapGMTypes.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ *  Search-as-you-type index over short texts such as destination names. Texts are split into
+ *  tokens on anything but ASCII letters, digits and non-ASCII bytes, lowercased, and stored in a
+ *  prefix trie with a posting list per token. Every query token must match a token of a document,
+ *  as a whole word, a prefix, or within a small edit distance. Documents can be added and removed
+ *  at any time. Not thread safe; searches reuse scratch buffers of the index.
+ */
+typedef struct JMapGMTextIndex JMapGMTextIndex;
+
+/**
+ *  A document found by a search. Higher scores rank first; a query matched exactly as whole words
+ *  scores 1 before distance.
+ */
+typedef struct {
+    uint32_t document;
+    float score;
+} JMapGMTextMatch;
+
+typedef struct {
+    /** Whether query tokens of 4 or more bytes may match with one edit, and of 8 or more with two */
+    bool typos;
+    /** Walking distance to each document in metres, indexed by document; NaN for unknown. May be NULL. */
+    const float *distances;
+    size_t distanceCount;
+    /** Score taken off per 100 metres of distance */
+    float distanceWeight;
+} JMapGMTextSearchOptions;
+
+/**
+ *  Typos on, no distances
+ */
+extern const JMapGMTextSearchOptions JMapGMTextSearchOptionsDefault;
+
+/**
+ *  Creates an empty index.
+ *
+ *  @return The index, or NULL if allocation failed
+ */
+JMapGMTextIndex *JMapGMTextIndexCreate(void);
+
+/**
+ *  Releases an index.
+ */
+void JMapGMTextIndexRelease(JMapGMTextIndex *index);
+
+/**
+ *  Adds a document, replacing its text if it is already indexed.
+ *
+ *  @param document A dense index chosen by the caller
+ *  @param text UTF-8 text, lowercased for ASCII only; fold other scripts before adding
+ *  @return false if allocation failed, in which case the document is not indexed
+ */
+bool JMapGMTextIndexAdd(JMapGMTextIndex *index, uint32_t document, const char *text, size_t length);
+
+/**
+ *  Removes a document. Its tokens stay in the trie for reuse.
+ */
+void JMapGMTextIndexRemove(JMapGMTextIndex *index, uint32_t document);
+
+/**
+ *  The number of indexed documents
+ */
+size_t JMapGMTextIndexGetDocumentCount(const JMapGMTextIndex *index);
+
+/**
+ *  Finds the best matching documents.
+ *
+ *  @param query The text typed so far
+ *  @param options The options, or NULL for JMapGMTextSearchOptionsDefault
+ *  @param matches Receives up to capacity matches, best first; ties go to shorter texts, then lower documents
+ *  @return The number of matches written, 0 for an empty query or if allocation failed
+ */
+size_t JMapGMTextIndexSearch(JMapGMTextIndex *index, const char *query, size_t length, const JMapGMTextSearchOptions *options,
+                             JMapGMTextMatch *matches, size_t capacity);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* JMapGMTextIndex_h */
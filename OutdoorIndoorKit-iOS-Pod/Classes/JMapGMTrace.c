@@ -0,0 +1,255 @@
+//
+//  JMapGMTrace.c
+//  JMapOutdoorIndoorKit
+//
+//  Copyright © 2026 Jibestream. All rights reserved.
+//
+
+#include "JMapGMTrace.h"
+
+#include <stdarg.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define JMAPGM_TRACE_SLOTS 256
+
+typedef struct {
+    _Atomic(const char *) name;
+    atomic_bool timer;
+    atomic_uint_fast64_t count;
+    atomic_int_fast64_t total;
+    atomic_int_fast64_t max;
+    atomic_uint_fast64_t histogram[JMAPGM_TRACE_HISTOGRAM_BUCKETS];
+} JMapGMTraceSlot;
+
+typedef struct {
+    const char *name;
+    int64_t start;
+    int64_t end;
+    uint32_t thread;
+} JMapGMTraceEvent;
+
+static atomic_bool JMapGMTraceEnabled;
+static JMapGMTraceSlot JMapGMTraceSlots[JMAPGM_TRACE_SLOTS];
+
+static _Atomic(JMapGMTraceEvent *) JMapGMTraceEvents;
+static size_t JMapGMTraceEventCapacity = 1 << 16;
+static atomic_size_t JMapGMTraceEventCount;
+static int64_t JMapGMTraceOrigin;
+
+static atomic_uint JMapGMTraceNextThread;
+static _Thread_local uint32_t JMapGMTraceThread;
+
+void JMapGMTraceSetEnabled(bool enabled)
+{
+    if (enabled && !atomic_load(&JMapGMTraceEvents)) {
+        // Allocated on first use so a never enabled tracer costs no memory.
+        atomic_store(&JMapGMTraceEvents, calloc(JMapGMTraceEventCapacity, sizeof(JMapGMTraceEvent)));
+    }
+    if (enabled && !JMapGMTraceOrigin) JMapGMTraceOrigin = JMapGMTraceNow();
+    atomic_store_explicit(&JMapGMTraceEnabled, enabled, memory_order_relaxed);
+}
+
+bool JMapGMTraceIsEnabled(void)
+{
+    return atomic_load_explicit(&JMapGMTraceEnabled, memory_order_relaxed);
+}
+
+void JMapGMTraceSetEventCapacity(size_t capacity)
+{
+    bool enabled = JMapGMTraceIsEnabled();
+    atomic_store(&JMapGMTraceEnabled, false);
+    free(atomic_exchange(&JMapGMTraceEvents, NULL));
+    JMapGMTraceEventCapacity = capacity;
+    JMapGMTraceReset();
+    JMapGMTraceSetEnabled(enabled);
+}
+
+void JMapGMTraceReset(void)
+{
+    for (size_t i = 0; i < JMAPGM_TRACE_SLOTS; i++) {
+        JMapGMTraceSlot *slot = &JMapGMTraceSlots[i];
+        atomic_store(&slot->count, 0);
+        atomic_store(&slot->total, 0);
+        atomic_store(&slot->max, 0);
+        for (size_t b = 0; b < JMAPGM_TRACE_HISTOGRAM_BUCKETS; b++) atomic_store(&slot->histogram[b], 0);
+        atomic_store(&slot->timer, false);
+        atomic_store(&slot->name, NULL);
+    }
+    JMapGMTraceEvent *events = atomic_load(&JMapGMTraceEvents);
+    if (events) memset(events, 0, JMapGMTraceEventCapacity * sizeof(JMapGMTraceEvent));
+    atomic_store(&JMapGMTraceEventCount, 0);
+    JMapGMTraceOrigin = JMapGMTraceNow();
+}
+
+int64_t JMapGMTraceNow(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (int64_t)now.tv_sec * 1000000000 + now.tv_nsec;
+}
+
+static JMapGMTraceSlot *JMapGMTraceSlotForName(const char *name)
+{
+    size_t hash = ((uintptr_t)name >> 3) * 2654435761u;
+    for (size_t probe = 0; probe < JMAPGM_TRACE_SLOTS; probe++) {
+        JMapGMTraceSlot *slot = &JMapGMTraceSlots[(hash + probe) % JMAPGM_TRACE_SLOTS];
+        const char *current = atomic_load_explicit(&slot->name, memory_order_acquire);
+        if (current == name) return slot;
+        if (current == NULL) {
+            const char *expected = NULL;
+            if (atomic_compare_exchange_strong(&slot->name, &expected, name) || expected == name) return slot;
+        }
+    }
+    return NULL;
+}
+
+static uint32_t JMapGMTraceCurrentThread(void)
+{
+    if (!JMapGMTraceThread) JMapGMTraceThread = atomic_fetch_add(&JMapGMTraceNextThread, 1) + 1;
+    return JMapGMTraceThread;
+}
+
+void JMapGMTraceRecord(const char *name, int64_t start, int64_t end)
+{
+    int64_t duration = end - start;
+    JMapGMTraceSlot *slot = JMapGMTraceSlotForName(name);
+    if (slot) {
+        atomic_store_explicit(&slot->timer, true, memory_order_relaxed);
+        atomic_fetch_add_explicit(&slot->count, 1, memory_order_relaxed);
+        atomic_fetch_add_explicit(&slot->total, duration, memory_order_relaxed);
+        int_fast64_t max = atomic_load_explicit(&slot->max, memory_order_relaxed);
+        while (duration > max && !atomic_compare_exchange_weak(&slot->max, &max, duration)) {}
+
+        size_t bucket = 0;
+        for (int64_t micros = duration / 1000; micros > 0 && bucket + 1 < JMAPGM_TRACE_HISTOGRAM_BUCKETS; micros >>= 1) bucket++;
+        atomic_fetch_add_explicit(&slot->histogram[bucket], 1, memory_order_relaxed);
+    }
+
+    JMapGMTraceEvent *events = atomic_load_explicit(&JMapGMTraceEvents, memory_order_acquire);
+    if (!events) return;
+    size_t index = atomic_fetch_add_explicit(&JMapGMTraceEventCount, 1, memory_order_relaxed);
+    if (index >= JMapGMTraceEventCapacity) return;
+    JMapGMTraceEvent event = { name, start, end, JMapGMTraceCurrentThread() };
+    events[index] = event;
+}
+
+void JMapGMTraceCount(const char *name, int64_t delta)
+{
+    JMapGMTraceSlot *slot = JMapGMTraceSlotForName(name);
+    if (!slot) return;
+    atomic_fetch_add_explicit(&slot->count, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&slot->total, delta, memory_order_relaxed);
+}
+
+size_t JMapGMTraceCopyStats(JMapGMTraceStat *stats, size_t capacity)
+{
+    size_t found = 0;
+    for (size_t i = 0; i < JMAPGM_TRACE_SLOTS; i++) {
+        JMapGMTraceSlot *slot = &JMapGMTraceSlots[i];
+        const char *name = atomic_load(&slot->name);
+        if (!name) continue;
+        if (stats && found < capacity) {
+            JMapGMTraceStat *stat = &stats[found];
+            stat->name = name;
+            stat->timer = atomic_load(&slot->timer);
+            stat->count = atomic_load(&slot->count);
+            stat->total = atomic_load(&slot->total);
+            stat->max = atomic_load(&slot->max);
+            for (size_t b = 0; b < JMAPGM_TRACE_HISTOGRAM_BUCKETS; b++) stat->histogram[b] = atomic_load(&slot->histogram[b]);
+        }
+        found++;
+    }
+    return found;
+}
+
+typedef struct {
+    char *bytes;
+    size_t length;
+    size_t capacity;
+    bool failed;
+} JMapGMTraceBuffer;
+
+static void JMapGMTraceAppend(JMapGMTraceBuffer *buffer, const char *format, ...)
+{
+    if (buffer->failed) return;
+    for (;;) {
+        va_list arguments;
+        va_start(arguments, format);
+        size_t available = buffer->capacity - buffer->length;
+        int written = vsnprintf(buffer->bytes + buffer->length, available, format, arguments);
+        va_end(arguments);
+        if (written < 0) {
+            buffer->failed = true;
+            return;
+        }
+        if ((size_t)written < available) {
+            buffer->length += (size_t)written;
+            return;
+        }
+        size_t capacity = buffer->capacity * 2 + (size_t)written;
+        char *bytes = realloc(buffer->bytes, capacity);
+        if (!bytes) {
+            buffer->failed = true;
+            return;
+        }
+        buffer->bytes = bytes;
+        buffer->capacity = capacity;
+    }
+}
+
+static void JMapGMTraceAppendName(JMapGMTraceBuffer *buffer, const char *name)
+{
+    JMapGMTraceAppend(buffer, "\"");
+    for (const char *c = name; *c; c++) {
+        if (*c == '"' || *c == '\\') JMapGMTraceAppend(buffer, "\\%c", *c);
+        else if ((unsigned char)*c < 0x20) JMapGMTraceAppend(buffer, "\\u%04x", *c);
+        else JMapGMTraceAppend(buffer, "%c", *c);
+    }
+    JMapGMTraceAppend(buffer, "\"");
+}
+
+char *JMapGMTraceCopyChromeJSON(size_t *length)
+{
+    JMapGMTraceBuffer buffer = { malloc(4096), 0, 4096, false };
+    if (!buffer.bytes) return NULL;
+
+    JMapGMTraceAppend(&buffer, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+    bool first = true;
+    JMapGMTraceEvent *events = atomic_load(&JMapGMTraceEvents);
+    size_t eventCount = atomic_load(&JMapGMTraceEventCount);
+    if (eventCount > JMapGMTraceEventCapacity) eventCount = JMapGMTraceEventCapacity;
+    for (size_t i = 0; events && i < eventCount; i++) {
+        const JMapGMTraceEvent *event = &events[i];
+        if (!event->name) continue;
+        JMapGMTraceAppend(&buffer, first ? "{\"name\":" : ",{\"name\":");
+        JMapGMTraceAppendName(&buffer, event->name);
+        JMapGMTraceAppend(&buffer, ",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                          event->thread, (event->start - JMapGMTraceOrigin) / 1000.0, (event->end - event->start) / 1000.0);
+        first = false;
+    }
+
+    // Counters are emitted once, at the time of export.
+    double now = (JMapGMTraceNow() - JMapGMTraceOrigin) / 1000.0;
+    for (size_t i = 0; i < JMAPGM_TRACE_SLOTS; i++) {
+        JMapGMTraceSlot *slot = &JMapGMTraceSlots[i];
+        const char *name = atomic_load(&slot->name);
+        if (!name || atomic_load(&slot->timer)) continue;
+        JMapGMTraceAppend(&buffer, first ? "{\"name\":" : ",{\"name\":");
+        JMapGMTraceAppendName(&buffer, name);
+        JMapGMTraceAppend(&buffer, ",\"ph\":\"C\",\"pid\":1,\"tid\":0,\"ts\":%.3f,\"args\":{\"value\":%lld}}",
+                          now, (long long)atomic_load(&slot->total));
+        first = false;
+    }
+    JMapGMTraceAppend(&buffer, "]}");
+
+    if (buffer.failed) {
+        free(buffer.bytes);
+        return NULL;
+    }
+    if (length) *length = buffer.length;
+    return buffer.bytes;
+}
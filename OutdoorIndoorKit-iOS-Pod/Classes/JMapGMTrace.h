@@ -0,0 +1,141 @@
+//
+//  JMapGMTrace.h
+//  JMapOutdoorIndoorKit
+//
+//  Copyright © 2026 Jibestream. All rights reserved.
+//
+
+#ifndef JMapGMTrace_h
+#define JMapGMTrace_h
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ *  Lightweight process wide tracing: scoped timers, counters and duration histograms.
+ *
+ *  Names must be string literals or otherwise live for the whole process; they are
+ *  compared by address. While tracing is disabled every call reduces to one relaxed
+ *  atomic load.
+ */
+
+/** Number of log2 buckets in a duration histogram; bucket i counts durations below 2^i microseconds */
+#define JMAPGM_TRACE_HISTOGRAM_BUCKETS 24
+
+/**
+ *  Aggregated statistics for one timer or counter name
+ */
+typedef struct {
+    const char *name;
+    /** true for timers, false for counters */
+    bool timer;
+    /** Number of samples, or of counter increments */
+    uint64_t count;
+    /** Total duration in nanoseconds, or counter total */
+    int64_t total;
+    /** Longest duration in nanoseconds, 0 for counters */
+    int64_t max;
+    uint64_t histogram[JMAPGM_TRACE_HISTOGRAM_BUCKETS];
+} JMapGMTraceStat;
+
+/**
+ *  Enables or disables recording. Already recorded data is kept.
+ */
+void JMapGMTraceSetEnabled(bool enabled);
+
+/**
+ *  Whether recording is enabled
+ */
+bool JMapGMTraceIsEnabled(void);
+
+/**
+ *  Sets how many timed events are kept for trace export, and clears all data. Defaults to 65536.
+ *  Call while no traced work is running.
+ */
+void JMapGMTraceSetEventCapacity(size_t capacity);
+
+/**
+ *  Clears all recorded events and statistics. Call while no traced work is running.
+ */
+void JMapGMTraceReset(void);
+
+/**
+ *  Monotonic time in nanoseconds
+ */
+int64_t JMapGMTraceNow(void);
+
+/**
+ *  Records a completed timed event.
+ *
+ *  @param name The event name
+ *  @param start The start time from JMapGMTraceNow
+ *  @param end The end time from JMapGMTraceNow
+ */
+void JMapGMTraceRecord(const char *name, int64_t start, int64_t end);
+
+/**
+ *  Adds to a named counter.
+ */
+void JMapGMTraceCount(const char *name, int64_t delta);
+
+/**
+ *  Copies the statistics of every name seen since the last reset.
+ *
+ *  @param stats Receives up to capacity entries, may be NULL to query the count
+ *  @return The number of names available
+ */
+size_t JMapGMTraceCopyStats(JMapGMTraceStat *stats, size_t capacity);
+
+/**
+ *  Exports the recorded events and counters as Chrome trace-event JSON,
+ *  loadable in chrome://tracing or Perfetto.
+ *
+ *  @param length Receives the string length, may be NULL
+ *  @return A NUL terminated string to free with free(), or NULL on allocation failure
+ */
+char *JMapGMTraceCopyChromeJSON(size_t *length);
+
+/**
+ *  A running scope timer, see JMAPGM_TRACE_SCOPE
+ */
+typedef struct {
+    const char *name;
+    int64_t start;
+} JMapGMTraceScope;
+
+static inline JMapGMTraceScope JMapGMTraceScopeBegin(const char *name)
+{
+    JMapGMTraceScope scope = { name, JMapGMTraceIsEnabled() ? JMapGMTraceNow() : 0 };
+    return scope;
+}
+
+static inline void JMapGMTraceScopeEnd(JMapGMTraceScope *scope)
+{
+    if (scope->start) JMapGMTraceRecord(scope->name, scope->start, JMapGMTraceNow());
+}
+
+#define JMAPGM_TRACE_CONCAT_(a, b) a##b
+#define JMAPGM_TRACE_CONCAT(a, b) JMAPGM_TRACE_CONCAT_(a, b)
+
+/**
+ *  Times the rest of the enclosing scope under the given name.
+ */
+#define JMAPGM_TRACE_SCOPE(name) \
+    JMapGMTraceScope JMAPGM_TRACE_CONCAT(jmapgm_trace_scope_, __LINE__) __attribute__((cleanup(JMapGMTraceScopeEnd), unused)) = JMapGMTraceScopeBegin(name)
+
+/**
+ *  Adds to a counter only while tracing is enabled.
+ */
+#define JMAPGM_TRACE_COUNT(name, delta) \
+    do { if (JMapGMTraceIsEnabled()) JMapGMTraceCount((name), (delta)); } while (0)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* JMapGMTrace_h */
@@ -0,0 +1,104 @@
+//
+//  JMapGMTracer.h
+//  JMapOutdoorIndoorKit
+//
+//  Copyright © 2026 Jibestream. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import <JMapOutdoorIndoorKit/JMapOutdoorIndoorKit.h>
+#import "JMapGMTrace.h"
+
+/**
+ *  Key for the number of samples in a statistics entry
+ */
+extern NSString * _Nonnull const JMapGMTraceCountKey;
+/**
+ *  Key for the total in milliseconds for timers, or the counter total
+ */
+extern NSString * _Nonnull const JMapGMTraceTotalKey;
+/**
+ *  Key for the longest duration in milliseconds, timers only
+ */
+extern NSString * _Nonnull const JMapGMTraceMaxKey;
+/**
+ *  Key for the duration in milliseconds of the last call, in lastCallStatisticsOf:
+ */
+extern NSString * _Nonnull const JMapGMTraceDurationKey;
+
+/**
+ *  The JMapGMTracer object
+ *
+ *  Objective-C access to the JMapGMTrace timers and counters.
+ */
+@interface JMapGMTracer : NSObject
+
+/**
+ *  Whether tracing is recording. Disabled by default.
+ */
+@property (class, nonatomic, getter=isEnabled) BOOL enabled;
+
+/**
+ *  Clears all recorded events and statistics.
+ */
++ (void)reset;
+
+/**
+ *  The recorded events as Chrome trace-event JSON, loadable in chrome://tracing or Perfetto.
+ */
++ (nullable NSData *)chromeTraceData;
+
+/**
+ *  Statistics per timer or counter name, with JMapGMTraceCountKey, JMapGMTraceTotalKey and JMapGMTraceMaxKey entries.
+ */
++ (nonnull NSDictionary<NSString *, NSDictionary<NSString *, NSNumber *> *> *)statistics;
+
+/**
+ *  The figures of the last traced call of an operation, e.g. @"showMap": its JMapGMTraceDurationKey
+ *  and each counter it recorded, such as @"showMap.overlays", for that call alone.
+ *
+ *  @param name The operation, as named by the traced methods
+ *  @return The figures, or nil if the operation was not traced since the last reset
+ */
++ (nullable NSDictionary<NSString *, NSNumber *> *)lastCallStatisticsOf:(nonnull NSString *)name;
+
+@end
+
+@interface JMapGMController (Tracing)
+
+/**
+ *  Parses a map, recording "parseMap" time and the "parseMap.shapes" counter. Also drops the
+ *  bounds and property table the pod cached on the map, which parsing makes stale.
+ *
+ *  @param map The JMapMap object to be parsed.
+ */
+- (void)tracedParseMap:(nonnull JMapMap *)map;
+
+/**
+ *  Shows a map, recording "showMap" time until completion and the "showMap.overlays" counter, the
+ *  number of overlays the call created.
+ *
+ *  @param map The JMapMap object to be rendered and displayed.
+ *  @param completion The completion handler for the API call.
+ */
+- (void)tracedShowMap:(nonnull JMapMap *)map completionHandler:(ErrorCompletion)completion;
+
+/**
+ *  Styles shapes, recording "styleShapes" time and the "styleShapes.shapes" counter.
+ *
+ *  @param shapes An array of JMapGMGeometry shapes to be styled.
+ *  @param style A JMapStyle object that defines the style.
+ */
+- (void)tracedStyleShapes:(nonnull NSArray<JMapGMGeometry *> *)shapes withStyling:(nonnull JMapStyle *)style;
+
+/**
+ *  Wayfinds between two waypoints, recording "wayfind" time and the "wayfind.polylines" and "wayfind.vertices" counters.
+ *
+ *  @param waypointStart The origin waypoint object to start the wayfinding from.
+ *  @param waypointEnd The destination waypoint object to end the wayfinding path.
+ *  @param accessibility A NSInteger value between 0-100 to indicate accessibility level; 0 - Not accessible, 100 - Accessible path.
+ *  @return An array of GMSPolyline objects to indicate wayfinding paths across all floors.
+ */
+- (nonnull NSArray<GMSPolyline *> *)tracedWayfindBetweenWaypoint:(nonnull JMapWaypoint *)waypointStart andWaypoint:(nonnull JMapWaypoint *)waypointEnd withAccessibility:(NSInteger)accessibility;
+
+@end
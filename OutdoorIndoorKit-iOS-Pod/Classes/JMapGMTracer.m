@@ -0,0 +1,181 @@
+//
+//  JMapGMTracer.m
+//  JMapOutdoorIndoorKit
+//
+//  Copyright © 2026 Jibestream. All rights reserved.
+//
+
+#import "JMapGMTracer.h"
+#import "JMapGMController+Bounds.h"
+#import "JMapGMGeometry+Packed.h"
+#import "JMapGMPropertyTable.h"
+
+NSString * const JMapGMTraceCountKey = @"count";
+NSString * const JMapGMTraceTotalKey = @"total";
+NSString * const JMapGMTraceMaxKey = @"max";
+NSString * const JMapGMTraceDurationKey = @"duration";
+
+// The figures of the last traced call of each operation.
+static NSMutableDictionary<NSString *, NSDictionary<NSString *, NSNumber *> *> *JMapGMTraceLastCalls;
+
+/**
+ *  A counter of one traced call. The name must be a string literal: the trace core keeps names by
+ *  pointer for the life of the process.
+ */
+typedef struct {
+    const char *name;
+    int64_t value;
+} JMapGMTraceCallCounter;
+
+// Records the duration and counters of one traced call, replacing the figures of the previous call.
+static void JMapGMTraceRecordCall(const char *name, int64_t start, int64_t end, const JMapGMTraceCallCounter *counters, size_t count)
+{
+    JMapGMTraceRecord(name, start, end);
+    NSMutableDictionary<NSString *, NSNumber *> *call = [NSMutableDictionary dictionaryWithCapacity:count + 1];
+    call[JMapGMTraceDurationKey] = @((double)(end - start) / 1e6);
+    for (size_t i = 0; i < count; i++) {
+        JMapGMTraceCount(counters[i].name, counters[i].value);
+        call[@(counters[i].name)] = @(counters[i].value);
+    }
+    @synchronized ([JMapGMTracer class]) {
+        if (!JMapGMTraceLastCalls) JMapGMTraceLastCalls = [NSMutableDictionary dictionary];
+        JMapGMTraceLastCalls[@(name)] = call;
+    }
+}
+
+@implementation JMapGMTracer
+
++ (BOOL)isEnabled
+{
+    return JMapGMTraceIsEnabled();
+}
+
++ (void)setEnabled:(BOOL)enabled
+{
+    JMapGMTraceSetEnabled(enabled);
+}
+
++ (void)reset
+{
+    JMapGMTraceReset();
+    @synchronized ([JMapGMTracer class]) {
+        [JMapGMTraceLastCalls removeAllObjects];
+    }
+}
+
++ (NSData *)chromeTraceData
+{
+    size_t length = 0;
+    char *json = JMapGMTraceCopyChromeJSON(&length);
+    if (!json) return nil;
+    return [NSData dataWithBytesNoCopy:json length:length freeWhenDone:YES];
+}
+
++ (NSDictionary<NSString *, NSDictionary<NSString *, NSNumber *> *> *)statistics
+{
+    size_t count = JMapGMTraceCopyStats(NULL, 0);
+    JMapGMTraceStat *stats = calloc(MAX(count, 1), sizeof(JMapGMTraceStat));
+    count = MIN(JMapGMTraceCopyStats(stats, count), count);
+
+    NSMutableDictionary *statistics = [NSMutableDictionary dictionaryWithCapacity:count];
+    for (size_t i = 0; i < count; i++) {
+        JMapGMTraceStat *stat = &stats[i];
+        BOOL timer = stat->timer;
+        statistics[@(stat->name)] = @{
+            JMapGMTraceCountKey: @(stat->count),
+            JMapGMTraceTotalKey: timer ? @(stat->total / 1e6) : @(stat->total),
+            JMapGMTraceMaxKey: @(stat->max / 1e6),
+        };
+    }
+    free(stats);
+    return statistics;
+}
+
++ (NSDictionary<NSString *, NSNumber *> *)lastCallStatisticsOf:(NSString *)name
+{
+    @synchronized ([JMapGMTracer class]) {
+        return JMapGMTraceLastCalls[name];
+    }
+}
+
+@end
+
+@implementation JMapGMController (Tracing)
+
+// Parsing replaces the map's shapes, so nothing cached from the old ones may be returned.
+- (void)jmapgm_invalidateCachesOfMap:(JMapMap *)map
+{
+    [self invalidateBoundsOfMap:map];
+    [self invalidatePropertyTableOfMap:map];
+}
+
+- (NSUInteger)shapeCountInMap:(JMapMap *)map withOverlayOnly:(BOOL)overlayOnly
+{
+    __block NSUInteger count = 0;
+    [self jmapgm_enumerateShapesInMap:map usingBlock:^(JMapGMGeometry *shape, NSString *layerName, BOOL *stop) {
+        if (!overlayOnly || shape.shapeOverlay) count++;
+    }];
+    return count;
+}
+
+- (void)tracedParseMap:(JMapMap *)map
+{
+    if (!JMapGMTraceIsEnabled()) {
+        [self parseMap:map];
+        [self jmapgm_invalidateCachesOfMap:map];
+        return;
+    }
+    int64_t start = JMapGMTraceNow();
+    [self parseMap:map];
+    int64_t end = JMapGMTraceNow();
+    [self jmapgm_invalidateCachesOfMap:map];
+    // Counted once the call is timed, since walking the layers is not part of it.
+    JMapGMTraceCallCounter counters[] = { { "parseMap.shapes", (int64_t)[self shapeCountInMap:map withOverlayOnly:NO] } };
+    JMapGMTraceRecordCall("parseMap", start, end, counters, 1);
+}
+
+- (void)tracedShowMap:(JMapMap *)map completionHandler:(ErrorCompletion)completion
+{
+    if (!JMapGMTraceIsEnabled()) {
+        [self showMap:map completionHandler:completion];
+        return;
+    }
+    // Overlays the map already had, so only those this call creates are counted.
+    NSUInteger overlaysBefore = [self shapeCountInMap:map withOverlayOnly:YES];
+    int64_t start = JMapGMTraceNow();
+    [self showMap:map completionHandler:^(JMapError * _Nullable error) {
+        int64_t end = JMapGMTraceNow();
+        NSUInteger overlays = [self shapeCountInMap:map withOverlayOnly:YES];
+        JMapGMTraceCallCounter counters[] = { { "showMap.overlays", overlays > overlaysBefore ? (int64_t)(overlays - overlaysBefore) : 0 } };
+        JMapGMTraceRecordCall("showMap", start, end, counters, 1);
+        if (completion) completion(error);
+    }];
+}
+
+- (void)tracedStyleShapes:(NSArray<JMapGMGeometry *> *)shapes withStyling:(JMapStyle *)style
+{
+    if (!JMapGMTraceIsEnabled()) {
+        [self styleShapes:shapes withStyling:style];
+        return;
+    }
+    int64_t start = JMapGMTraceNow();
+    [self styleShapes:shapes withStyling:style];
+    int64_t end = JMapGMTraceNow();
+    JMapGMTraceCallCounter counters[] = { { "styleShapes.shapes", (int64_t)shapes.count } };
+    JMapGMTraceRecordCall("styleShapes", start, end, counters, 1);
+}
+
+- (NSArray<GMSPolyline *> *)tracedWayfindBetweenWaypoint:(JMapWaypoint *)waypointStart andWaypoint:(JMapWaypoint *)waypointEnd withAccessibility:(NSInteger)accessibility
+{
+    if (!JMapGMTraceIsEnabled()) return [self wayfindBetweenWaypoint:waypointStart andWaypoint:waypointEnd withAccessibility:accessibility];
+    int64_t start = JMapGMTraceNow();
+    NSArray<GMSPolyline *> *polylines = [self wayfindBetweenWaypoint:waypointStart andWaypoint:waypointEnd withAccessibility:accessibility];
+    int64_t end = JMapGMTraceNow();
+    NSUInteger vertices = 0;
+    for (GMSPolyline *polyline in polylines) vertices += polyline.path.count;
+    JMapGMTraceCallCounter counters[] = { { "wayfind.polylines", (int64_t)polylines.count }, { "wayfind.vertices", (int64_t)vertices } };
+    JMapGMTraceRecordCall("wayfind", start, end, counters, 2);
+    return polylines;
+}
+
+@end
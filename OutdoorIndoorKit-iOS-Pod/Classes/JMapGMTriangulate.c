@@ -0,0 +1,607 @@
+//
+//  JMapGMTriangulate.c
+//  JMapOutdoorIndoorKit
+//
+//  Copyright © 2026 Jibestream. All rights reserved.
+//
+
+#include "JMapGMTriangulate.h"
+
+#include <stdlib.h>
+
+/** Rings with more points than this are hashed along a z-order curve */
+#define JMAPGM_EAR_HASH_THRESHOLD 80
+/** Nodes per block allocated for splits once the initial block is used up */
+#define JMAPGM_EAR_BLOCK_SIZE 256
+
+typedef struct JMapGMEarNode JMapGMEarNode;
+
+/**
+ *  A vertex of the ring being clipped, linked in ring order and, when hashed, in z-order.
+ */
+struct JMapGMEarNode {
+    uint32_t i;
+    double x;
+    double y;
+    uint32_t z;
+    JMapGMEarNode *prev;
+    JMapGMEarNode *next;
+    JMapGMEarNode *prevZ;
+    JMapGMEarNode *nextZ;
+    /** A hole of a single point, bridged but never filtered away */
+    bool steiner;
+};
+
+typedef struct JMapGMEarBlock {
+    struct JMapGMEarBlock *next;
+    size_t count;
+    size_t capacity;
+    JMapGMEarNode nodes[];
+} JMapGMEarBlock;
+
+typedef struct {
+    JMapGMEarBlock *blocks;
+    bool failed;
+    uint32_t *indices;
+    size_t count;
+    size_t capacity;
+    double minX;
+    double minY;
+    /** 0 when the ring is not hashed */
+    double invSize;
+} JMapGMEarcut;
+
+#pragma mark - Nodes
+
+static JMapGMEarBlock *JMapGMEarBlockCreate(size_t capacity, JMapGMEarBlock *next)
+{
+    JMapGMEarBlock *block = malloc(sizeof(JMapGMEarBlock) + capacity * sizeof(JMapGMEarNode));
+    if (!block) return NULL;
+    block->next = next;
+    block->count = 0;
+    block->capacity = capacity;
+    return block;
+}
+
+static JMapGMEarNode *JMapGMEarNodeCreate(JMapGMEarcut *earcut, uint32_t i, double x, double y)
+{
+    JMapGMEarBlock *block = earcut->blocks;
+    if (block->count == block->capacity) {
+        block = JMapGMEarBlockCreate(JMAPGM_EAR_BLOCK_SIZE, block);
+        if (!block) {
+            earcut->failed = true;
+            return NULL;
+        }
+        earcut->blocks = block;
+    }
+    JMapGMEarNode *node = &block->nodes[block->count++];
+    *node = (JMapGMEarNode){ i, x, y, 0, NULL, NULL, NULL, NULL, false };
+    return node;
+}
+
+// Links a new node after last, or starts a ring if last is NULL.
+static JMapGMEarNode *JMapGMEarInsert(JMapGMEarcut *earcut, uint32_t i, JMapGMPoint point, JMapGMEarNode *last)
+{
+    JMapGMEarNode *node = JMapGMEarNodeCreate(earcut, i, point.x, point.y);
+    if (!node) return NULL;
+    if (!last) {
+        node->prev = node;
+        node->next = node;
+    } else {
+        node->next = last->next;
+        node->prev = last;
+        last->next->prev = node;
+        last->next = node;
+    }
+    return node;
+}
+
+static void JMapGMEarRemove(JMapGMEarNode *node)
+{
+    node->next->prev = node->prev;
+    node->prev->next = node->next;
+    if (node->prevZ) node->prevZ->nextZ = node->nextZ;
+    if (node->nextZ) node->nextZ->prevZ = node->prevZ;
+}
+
+#pragma mark - Geometry
+
+// Twice the signed area of the triangle, negative when p, q, r turn left.
+static inline double JMapGMEarArea(const JMapGMEarNode *p, const JMapGMEarNode *q, const JMapGMEarNode *r)
+{
+    return (q->y - p->y) * (r->x - q->x) - (q->x - p->x) * (r->y - q->y);
+}
+
+static inline bool JMapGMEarEquals(const JMapGMEarNode *a, const JMapGMEarNode *b)
+{
+    return a->x == b->x && a->y == b->y;
+}
+
+static inline bool JMapGMEarPointInTriangle(double ax, double ay, double bx, double by, double cx, double cy, double px, double py)
+{
+    return (cx - px) * (ay - py) >= (ax - px) * (cy - py) &&
+           (ax - px) * (by - py) >= (bx - px) * (ay - py) &&
+           (bx - px) * (cy - py) >= (cx - px) * (by - py);
+}
+
+static inline int JMapGMEarSign(double value)
+{
+    return (value > 0) - (value < 0);
+}
+
+// Whether q lies within the bounds of segment pr, given the three are collinear.
+static inline bool JMapGMEarOnSegment(const JMapGMEarNode *p, const JMapGMEarNode *q, const JMapGMEarNode *r)
+{
+    return q->x <= fmax(p->x, r->x) && q->x >= fmin(p->x, r->x) && q->y <= fmax(p->y, r->y) && q->y >= fmin(p->y, r->y);
+}
+
+static bool JMapGMEarIntersects(const JMapGMEarNode *p1, const JMapGMEarNode *q1, const JMapGMEarNode *p2, const JMapGMEarNode *q2)
+{
+    int o1 = JMapGMEarSign(JMapGMEarArea(p1, q1, p2));
+    int o2 = JMapGMEarSign(JMapGMEarArea(p1, q1, q2));
+    int o3 = JMapGMEarSign(JMapGMEarArea(p2, q2, p1));
+    int o4 = JMapGMEarSign(JMapGMEarArea(p2, q2, q1));
+    if (o1 != o2 && o3 != o4) return true;
+    if (o1 == 0 && JMapGMEarOnSegment(p1, p2, q1)) return true;
+    if (o2 == 0 && JMapGMEarOnSegment(p1, q2, q1)) return true;
+    if (o3 == 0 && JMapGMEarOnSegment(p2, p1, q2)) return true;
+    if (o4 == 0 && JMapGMEarOnSegment(p2, q1, q2)) return true;
+    return false;
+}
+
+// Whether the diagonal ab crosses an edge of the ring not touching a or b.
+static bool JMapGMEarIntersectsRing(const JMapGMEarNode *a, const JMapGMEarNode *b)
+{
+    const JMapGMEarNode *p = a;
+    do {
+        if (p->i != a->i && p->next->i != a->i && p->i != b->i && p->next->i != b->i && JMapGMEarIntersects(p, p->next, a, b)) return true;
+        p = p->next;
+    } while (p != a);
+    return false;
+}
+
+// Whether the diagonal ab leaves a towards the inside of the ring.
+static bool JMapGMEarLocallyInside(const JMapGMEarNode *a, const JMapGMEarNode *b)
+{
+    if (JMapGMEarArea(a->prev, a, a->next) < 0) return JMapGMEarArea(a, b, a->next) >= 0 && JMapGMEarArea(a, a->prev, b) >= 0;
+    return JMapGMEarArea(a, b, a->prev) < 0 || JMapGMEarArea(a, a->next, b) < 0;
+}
+
+// Whether the midpoint of the diagonal ab is inside the ring.
+static bool JMapGMEarMiddleInside(const JMapGMEarNode *a, const JMapGMEarNode *b)
+{
+    const JMapGMEarNode *p = a;
+    bool inside = false;
+    double px = (a->x + b->x) / 2, py = (a->y + b->y) / 2;
+    do {
+        if (((p->y > py) != (p->next->y > py)) && p->next->y != p->y &&
+            px < (p->next->x - p->x) * (py - p->y) / (p->next->y - p->y) + p->x) {
+            inside = !inside;
+        }
+        p = p->next;
+    } while (p != a);
+    return inside;
+}
+
+static bool JMapGMEarIsValidDiagonal(const JMapGMEarNode *a, const JMapGMEarNode *b)
+{
+    if (a->next->i == b->i || a->prev->i == b->i || JMapGMEarIntersectsRing(a, b)) return false;
+    if (JMapGMEarLocallyInside(a, b) && JMapGMEarLocallyInside(b, a) && JMapGMEarMiddleInside(a, b) &&
+        (JMapGMEarArea(a->prev, a, b->prev) != 0 || JMapGMEarArea(a, b->prev, b) != 0)) {
+        return true;
+    }
+    // A zero length diagonal between two convex copies of one point.
+    return JMapGMEarEquals(a, b) && JMapGMEarArea(a->prev, a, a->next) > 0 && JMapGMEarArea(b->prev, b, b->next) > 0;
+}
+
+#pragma mark - Rings
+
+static double JMapGMEarRingArea(const JMapGMPoint *points, uint32_t start, uint32_t end)
+{
+    double sum = 0;
+    for (uint32_t i = start, j = end - 1; i < end; j = i++) {
+        sum += (points[j].x - points[i].x) * (points[i].y + points[j].y);
+    }
+    return sum;
+}
+
+// Links a ring in the given winding, dropping a closing copy of the first point.
+static JMapGMEarNode *JMapGMEarLinkRing(JMapGMEarcut *earcut, const JMapGMPoint *points, uint32_t start, uint32_t end, bool clockwise)
+{
+    if (start >= end) return NULL;
+    JMapGMEarNode *last = NULL;
+    if (clockwise == (JMapGMEarRingArea(points, start, end) > 0)) {
+        for (uint32_t i = start; i < end; i++) {
+            if (!(last = JMapGMEarInsert(earcut, i, points[i], last))) return NULL;
+        }
+    } else {
+        for (uint32_t i = end; i-- > start;) {
+            if (!(last = JMapGMEarInsert(earcut, i, points[i], last))) return NULL;
+        }
+    }
+    if (last && JMapGMEarEquals(last, last->next)) {
+        JMapGMEarRemove(last);
+        last = last->next;
+    }
+    return last;
+}
+
+// Removes duplicate and collinear points between start and end. Returns a node still in the ring.
+static JMapGMEarNode *JMapGMEarFilter(JMapGMEarNode *start, JMapGMEarNode *end)
+{
+    if (!start) return start;
+    if (!end) end = start;
+    JMapGMEarNode *p = start;
+    bool again;
+    do {
+        again = false;
+        if (!p->steiner && (JMapGMEarEquals(p, p->next) || JMapGMEarArea(p->prev, p, p->next) == 0)) {
+            JMapGMEarRemove(p);
+            p = end = p->prev;
+            if (p == p->next) break;
+            again = true;
+        } else {
+            p = p->next;
+        }
+    } while (again || p != end);
+    return end;
+}
+
+// Cuts the ring along ab into two, duplicating a and b. Returns the copy of b, in the second ring.
+static JMapGMEarNode *JMapGMEarSplit(JMapGMEarcut *earcut, JMapGMEarNode *a, JMapGMEarNode *b)
+{
+    JMapGMEarNode *a2 = JMapGMEarNodeCreate(earcut, a->i, a->x, a->y);
+    JMapGMEarNode *b2 = JMapGMEarNodeCreate(earcut, b->i, b->x, b->y);
+    if (!a2 || !b2) return NULL;
+    JMapGMEarNode *an = a->next, *bp = b->prev;
+    a->next = b;
+    b->prev = a;
+    a2->next = an;
+    an->prev = a2;
+    b2->next = a2;
+    a2->prev = b2;
+    bp->next = b2;
+    b2->prev = bp;
+    return b2;
+}
+
+#pragma mark - Holes
+
+static JMapGMEarNode *JMapGMEarLeftmost(JMapGMEarNode *start)
+{
+    JMapGMEarNode *p = start, *leftmost = start;
+    do {
+        if (p->x < leftmost->x || (p->x == leftmost->x && p->y < leftmost->y)) leftmost = p;
+        p = p->next;
+    } while (p != start);
+    return leftmost;
+}
+
+static bool JMapGMEarSectorContainsSector(const JMapGMEarNode *m, const JMapGMEarNode *p)
+{
+    return JMapGMEarArea(m->prev, m, p->prev) < 0 && JMapGMEarArea(p->next, m, m->next) < 0;
+}
+
+// Finds a point of the outline that the leftmost point of a hole can see, by casting a ray left.
+static JMapGMEarNode *JMapGMEarFindBridge(JMapGMEarNode *hole, JMapGMEarNode *outer)
+{
+    JMapGMEarNode *p = outer, *m = NULL;
+    double hx = hole->x, hy = hole->y, qx = -INFINITY;
+    do {
+        if (hy <= p->y && hy >= p->next->y && p->next->y != p->y) {
+            double x = p->x + (hy - p->y) * (p->next->x - p->x) / (p->next->y - p->y);
+            if (x <= hx && x > qx) {
+                qx = x;
+                m = p->x < p->next->x ? p : p->next;
+                if (x == hx) return m;
+            }
+        }
+        p = p->next;
+    } while (p != outer);
+    if (!m) return NULL;
+
+    // Prefer an outline point inside the triangle of the hole point, the ray hit and m with the
+    // smallest angle to the ray, so the bridge crosses nothing.
+    JMapGMEarNode *stop = m;
+    double mx = m->x, my = m->y, tanMin = INFINITY;
+    p = m;
+    do {
+        if (hx >= p->x && p->x >= mx && hx != p->x &&
+            JMapGMEarPointInTriangle(hy < my ? hx : qx, hy, mx, my, hy < my ? qx : hx, hy, p->x, p->y)) {
+            double tan = fabs(hy - p->y) / (hx - p->x);
+            if (JMapGMEarLocallyInside(p, hole) &&
+                (tan < tanMin || (tan == tanMin && (p->x > m->x || (p->x == m->x && JMapGMEarSectorContainsSector(m, p)))))) {
+                m = p;
+                tanMin = tan;
+            }
+        }
+        p = p->next;
+    } while (p != stop);
+    return m;
+}
+
+static int JMapGMEarCompareX(const void *a, const void *b)
+{
+    const JMapGMEarNode *p = *(JMapGMEarNode *const *)a, *q = *(JMapGMEarNode *const *)b;
+    return (p->x > q->x) - (p->x < q->x);
+}
+
+// Joins every hole to the outline with a zero width bridge, leftmost holes first.
+static JMapGMEarNode *JMapGMEarEliminateHoles(JMapGMEarcut *earcut, const JMapGMPolygon *polygon, size_t firstHole, size_t holeCount,
+                                              JMapGMEarNode *outer)
+{
+    JMapGMEarNode **queue = malloc(holeCount * sizeof(JMapGMEarNode *));
+    if (!queue) {
+        earcut->failed = true;
+        return outer;
+    }
+    size_t queued = 0;
+    for (size_t h = 0; h < holeCount; h++) {
+        uint32_t start = polygon->ringStarts[firstHole + h], end = polygon->ringStarts[firstHole + h + 1];
+        JMapGMEarNode *list = JMapGMEarLinkRing(earcut, polygon->points, start, end, false);
+        if (earcut->failed) break;
+        if (!list) continue;
+        if (list == list->next) list->steiner = true;
+        queue[queued++] = JMapGMEarLeftmost(list);
+    }
+    qsort(queue, queued, sizeof(JMapGMEarNode *), JMapGMEarCompareX);
+    for (size_t h = 0; h < queued && !earcut->failed; h++) {
+        JMapGMEarNode *bridge = JMapGMEarFindBridge(queue[h], outer);
+        if (!bridge) continue;
+        JMapGMEarNode *reverse = JMapGMEarSplit(earcut, bridge, queue[h]);
+        if (!reverse) break;
+        JMapGMEarFilter(reverse, reverse->next);
+        outer = JMapGMEarFilter(bridge, bridge->next);
+    }
+    free(queue);
+    return outer;
+}
+
+#pragma mark - Z-order
+
+// Interleaves the bits of x and y scaled to 15 bits each. Hole points outside the outline are clamped.
+static uint32_t JMapGMEarZOrder(double px, double py, double minX, double minY, double invSize)
+{
+    uint32_t x = (uint32_t)fmin(fmax((px - minX) * invSize, 0), 32767);
+    uint32_t y = (uint32_t)fmin(fmax((py - minY) * invSize, 0), 32767);
+    x = (x | (x << 8)) & 0x00FF00FF;
+    x = (x | (x << 4)) & 0x0F0F0F0F;
+    x = (x | (x << 2)) & 0x33333333;
+    x = (x | (x << 1)) & 0x55555555;
+    y = (y | (y << 8)) & 0x00FF00FF;
+    y = (y | (y << 4)) & 0x0F0F0F0F;
+    y = (y | (y << 2)) & 0x33333333;
+    y = (y | (y << 1)) & 0x55555555;
+    return x | (y << 1);
+}
+
+// Merge sorts the z links by z, without recursion.
+static JMapGMEarNode *JMapGMEarSortZ(JMapGMEarNode *list)
+{
+    size_t inSize = 1, merges;
+    do {
+        JMapGMEarNode *p = list, *tail = NULL;
+        list = NULL;
+        merges = 0;
+        while (p) {
+            merges++;
+            JMapGMEarNode *q = p;
+            size_t pSize = 0, qSize = inSize;
+            for (size_t i = 0; i < inSize && q; i++) {
+                pSize++;
+                q = q->nextZ;
+            }
+            while (pSize > 0 || (qSize > 0 && q)) {
+                JMapGMEarNode *e;
+                if (pSize != 0 && (qSize == 0 || !q || p->z <= q->z)) {
+                    e = p;
+                    p = p->nextZ;
+                    pSize--;
+                } else {
+                    e = q;
+                    q = q->nextZ;
+                    qSize--;
+                }
+                if (tail) tail->nextZ = e;
+                else list = e;
+                e->prevZ = tail;
+                tail = e;
+            }
+            p = q;
+        }
+        tail->nextZ = NULL;
+        inSize *= 2;
+    } while (merges > 1);
+    return list;
+}
+
+static void JMapGMEarIndexCurve(JMapGMEarcut *earcut, JMapGMEarNode *start)
+{
+    JMapGMEarNode *p = start;
+    do {
+        if (p->z == 0) p->z = JMapGMEarZOrder(p->x, p->y, earcut->minX, earcut->minY, earcut->invSize);
+        p->prevZ = p->prev;
+        p->nextZ = p->next;
+        p = p->next;
+    } while (p != start);
+    p->prevZ->nextZ = NULL;
+    p->prevZ = NULL;
+    JMapGMEarSortZ(p);
+}
+
+#pragma mark - Ears
+
+// Whether no other point lies in the convex triangle prev, ear, next.
+static bool JMapGMEarIsEar(const JMapGMEarNode *ear)
+{
+    const JMapGMEarNode *a = ear->prev, *b = ear, *c = ear->next;
+    if (JMapGMEarArea(a, b, c) >= 0) return false;
+    double x0 = fmin(a->x, fmin(b->x, c->x)), y0 = fmin(a->y, fmin(b->y, c->y));
+    double x1 = fmax(a->x, fmax(b->x, c->x)), y1 = fmax(a->y, fmax(b->y, c->y));
+    for (const JMapGMEarNode *p = c->next; p != a; p = p->next) {
+        if (p->x >= x0 && p->x <= x1 && p->y >= y0 && p->y <= y1 &&
+            JMapGMEarPointInTriangle(a->x, a->y, b->x, b->y, c->x, c->y, p->x, p->y) && JMapGMEarArea(p->prev, p, p->next) >= 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static inline bool JMapGMEarBlocks(const JMapGMEarNode *p, const JMapGMEarNode *a, const JMapGMEarNode *b, const JMapGMEarNode *c,
+                                   double x0, double y0, double x1, double y1)
+{
+    return p->x >= x0 && p->x <= x1 && p->y >= y0 && p->y <= y1 && p != a && p != c &&
+           JMapGMEarPointInTriangle(a->x, a->y, b->x, b->y, c->x, c->y, p->x, p->y) && JMapGMEarArea(p->prev, p, p->next) >= 0;
+}
+
+// JMapGMEarIsEar visiting only the points whose z-order falls within the triangle's bounds.
+static bool JMapGMEarIsEarHashed(const JMapGMEarcut *earcut, const JMapGMEarNode *ear)
+{
+    const JMapGMEarNode *a = ear->prev, *b = ear, *c = ear->next;
+    if (JMapGMEarArea(a, b, c) >= 0) return false;
+    double x0 = fmin(a->x, fmin(b->x, c->x)), y0 = fmin(a->y, fmin(b->y, c->y));
+    double x1 = fmax(a->x, fmax(b->x, c->x)), y1 = fmax(a->y, fmax(b->y, c->y));
+    uint32_t minZ = JMapGMEarZOrder(x0, y0, earcut->minX, earcut->minY, earcut->invSize);
+    uint32_t maxZ = JMapGMEarZOrder(x1, y1, earcut->minX, earcut->minY, earcut->invSize);
+    const JMapGMEarNode *p = ear->prevZ, *n = ear->nextZ;
+    while (p && p->z >= minZ && n && n->z <= maxZ) {
+        if (JMapGMEarBlocks(p, a, b, c, x0, y0, x1, y1)) return false;
+        p = p->prevZ;
+        if (JMapGMEarBlocks(n, a, b, c, x0, y0, x1, y1)) return false;
+        n = n->nextZ;
+    }
+    for (; p && p->z >= minZ; p = p->prevZ) {
+        if (JMapGMEarBlocks(p, a, b, c, x0, y0, x1, y1)) return false;
+    }
+    for (; n && n->z <= maxZ; n = n->nextZ) {
+        if (JMapGMEarBlocks(n, a, b, c, x0, y0, x1, y1)) return false;
+    }
+    return true;
+}
+
+static void JMapGMEarEmit(JMapGMEarcut *earcut, const JMapGMEarNode *a, const JMapGMEarNode *b, const JMapGMEarNode *c)
+{
+    if (earcut->count + 3 > earcut->capacity) return;
+    earcut->indices[earcut->count++] = a->i;
+    earcut->indices[earcut->count++] = b->i;
+    earcut->indices[earcut->count++] = c->i;
+}
+
+// Clips the ears of two consecutive edges that cross, left by a self-intersecting ring.
+static JMapGMEarNode *JMapGMEarCureIntersections(JMapGMEarcut *earcut, JMapGMEarNode *start)
+{
+    JMapGMEarNode *p = start;
+    do {
+        JMapGMEarNode *a = p->prev, *b = p->next->next;
+        if (!JMapGMEarEquals(a, b) && JMapGMEarIntersects(a, p, p->next, b) && JMapGMEarLocallyInside(a, b) && JMapGMEarLocallyInside(b, a)) {
+            JMapGMEarEmit(earcut, a, p, b);
+            JMapGMEarRemove(p);
+            JMapGMEarRemove(p->next);
+            p = start = b;
+        }
+        p = p->next;
+    } while (p != start);
+    return JMapGMEarFilter(p, NULL);
+}
+
+static void JMapGMEarcutRing(JMapGMEarcut *earcut, JMapGMEarNode *ear, int pass);
+
+// Splits a ring with no ears left along a valid diagonal and clips both halves.
+static void JMapGMEarSplitRing(JMapGMEarcut *earcut, JMapGMEarNode *start)
+{
+    JMapGMEarNode *a = start;
+    do {
+        for (JMapGMEarNode *b = a->next->next; b != a->prev; b = b->next) {
+            if (a->i == b->i || !JMapGMEarIsValidDiagonal(a, b)) continue;
+            JMapGMEarNode *c = JMapGMEarSplit(earcut, a, b);
+            if (!c) return;
+            a = JMapGMEarFilter(a, a->next);
+            c = JMapGMEarFilter(c, c->next);
+            JMapGMEarcutRing(earcut, a, 0);
+            JMapGMEarcutRing(earcut, c, 0);
+            return;
+        }
+        a = a->next;
+    } while (a != start);
+}
+
+// Clips ears until one triangle is left. When a full lap finds none, retries after filtering
+// degenerate points, then after curing local self-intersections, then by splitting the ring.
+static void JMapGMEarcutRing(JMapGMEarcut *earcut, JMapGMEarNode *ear, int pass)
+{
+    if (!ear || earcut->failed) return;
+    if (pass == 0 && earcut->invSize != 0) JMapGMEarIndexCurve(earcut, ear);
+    JMapGMEarNode *stop = ear;
+    while (ear->prev != ear->next) {
+        JMapGMEarNode *prev = ear->prev, *next = ear->next;
+        if (earcut->invSize != 0 ? JMapGMEarIsEarHashed(earcut, ear) : JMapGMEarIsEar(ear)) {
+            JMapGMEarEmit(earcut, prev, ear, next);
+            JMapGMEarRemove(ear);
+            ear = next->next;
+            stop = next->next;
+            continue;
+        }
+        ear = next;
+        if (ear == stop) {
+            if (pass == 0) JMapGMEarcutRing(earcut, JMapGMEarFilter(ear, NULL), 1);
+            else if (pass == 1) JMapGMEarcutRing(earcut, JMapGMEarCureIntersections(earcut, JMapGMEarFilter(ear, NULL)), 2);
+            else JMapGMEarSplitRing(earcut, ear);
+            break;
+        }
+    }
+}
+
+#pragma mark - Public
+
+size_t JMapGMTriangulate(const JMapGMPolygon *polygon, size_t firstRing, size_t ringCount, uint32_t *indices)
+{
+    if (ringCount == 0) return 0;
+    uint32_t start = polygon->ringStarts[firstRing], end = polygon->ringStarts[firstRing + 1];
+    uint32_t last = polygon->ringStarts[firstRing + ringCount];
+    size_t pointCount = last - start;
+    JMapGMEarcut earcut = { 0 };
+    earcut.indices = indices;
+    earcut.capacity = JMapGMTriangulationCapacity(pointCount, ringCount);
+    // Rings and hole bridges fit in the first block; only splits need more.
+    earcut.blocks = JMapGMEarBlockCreate(pointCount + 2 * ringCount, NULL);
+    if (!earcut.blocks) return JMAPGM_TRIANGULATE_FAILED;
+
+    JMapGMEarNode *outer = JMapGMEarLinkRing(&earcut, polygon->points, start, end, true);
+    if (outer && outer->next != outer->prev) {
+        if (ringCount > 1) outer = JMapGMEarEliminateHoles(&earcut, polygon, firstRing + 1, ringCount - 1, outer);
+        if (pointCount > JMAPGM_EAR_HASH_THRESHOLD) {
+            JMapGMRect bounds = JMapGMPointsGetBounds(polygon->points + start, end - start);
+            earcut.minX = bounds.minX;
+            earcut.minY = bounds.minY;
+            double size = fmax(bounds.maxX - bounds.minX, bounds.maxY - bounds.minY);
+            earcut.invSize = size != 0 ? 32767 / size : 0;
+        }
+        JMapGMEarcutRing(&earcut, outer, 0);
+    }
+
+    while (earcut.blocks) {
+        JMapGMEarBlock *next = earcut.blocks->next;
+        free(earcut.blocks);
+        earcut.blocks = next;
+    }
+    return earcut.failed ? JMAPGM_TRIANGULATE_FAILED : earcut.count;
+}
+
+double JMapGMTriangulationDeviation(const JMapGMPolygon *polygon, size_t firstRing, size_t ringCount, const uint32_t *indices, size_t count)
+{
+    double polygonArea = 0;
+    for (size_t r = firstRing; r < firstRing + ringCount; r++) {
+        uint32_t start = polygon->ringStarts[r], end = polygon->ringStarts[r + 1];
+        if (start == end) continue;
+        double area = fabs(JMapGMEarRingArea(polygon->points, start, end));
+        polygonArea += r == firstRing ? area : -area;
+    }
+    double trianglesArea = 0;
+    const JMapGMPoint *points = polygon->points;
+    for (size_t i = 0; i + 2 < count; i += 3) {
+        JMapGMPoint a = points[indices[i]], b = points[indices[i + 1]], c = points[indices[i + 2]];
+        trianglesArea += fabs((a.x - c.x) * (b.y - a.y) - (a.x - b.x) * (c.y - a.y));
+    }
+    if (polygonArea == 0 && trianglesArea == 0) return 0;
+    return fabs((trianglesArea - polygonArea) / polygonArea);
+}
@@ -0,0 +1,62 @@
+//
+//  JMapGMTriangulate.h
+//  JMapOutdoorIndoorKit
+//
+//  Copyright © 2026 Jibestream. All rights reserved.
+//
+
+#ifndef JMapGMTriangulate_h
+#define JMapGMTriangulate_h
+
+#include "JMapGMPolygon.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Returned by JMapGMTriangulate when allocation failed */
+#define JMAPGM_TRIANGULATE_FAILED SIZE_MAX
+
+/**
+ *  A triangle index buffer, three indices into the points of a JMapGMPolygon per triangle
+ */
+typedef struct {
+    const uint32_t *indices;
+    size_t count;
+} JMapGMTriangles;
+
+/**
+ *  The number of indices JMapGMTriangulate may write for a polygon of pointCount points in ringCount rings
+ */
+static inline size_t JMapGMTriangulationCapacity(size_t pointCount, size_t ringCount)
+{
+    return 3 * (pointCount + 2 * ringCount);
+}
+
+/**
+ *  Triangulates one polygon, an outline followed by its holes, by ear clipping. Holes are bridged
+ *  into the outline, and rings over 80 points are hashed along a z-order curve so each ear test
+ *  only visits nearby points. Duplicate and collinear points, zero area rings, touching holes and
+ *  self-intersections are tolerated; the latter are cut through rather than failing.
+ *
+ *  @param polygon The packed rings
+ *  @param firstRing The outline
+ *  @param ringCount The outline plus its holes
+ *  @param indices Receives three indices into polygon->points per triangle, up to JMapGMTriangulationCapacity
+ *  @return The number of indices written, or JMAPGM_TRIANGULATE_FAILED if allocation failed
+ */
+size_t JMapGMTriangulate(const JMapGMPolygon *polygon, size_t firstRing, size_t ringCount, uint32_t *indices);
+
+/**
+ *  How far the area of a triangulation strays from the area of the polygon it covers, relative to
+ *  the latter. 0 for an exact triangulation, including of a polygon without area.
+ *
+ *  @param indices Triangles from JMapGMTriangulate of the same rings
+ */
+double JMapGMTriangulationDeviation(const JMapGMPolygon *polygon, size_t firstRing, size_t ringCount, const uint32_t *indices, size_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* JMapGMTriangulate_h */
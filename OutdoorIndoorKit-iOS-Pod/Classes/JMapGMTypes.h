@@ -0,0 +1,65 @@
+//
+//  JMapGMTypes.h
+//  JMapOutdoorIndoorKit
+//
+//  Copyright © 2026 Jibestream. All rights reserved.
+//
+
+#ifndef JMapGMTypes_h
+#define JMapGMTypes_h
+
+#include <math.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ *  A point in a planar coordinate space, either map x,y or projected meters
+ */
+typedef struct {
+    double x;
+    double y;
+} JMapGMPoint;
+
+/**
+ *  An axis aligned rectangle, empty when minX > maxX
+ */
+typedef struct {
+    double minX;
+    double minY;
+    double maxX;
+    double maxY;
+} JMapGMRect;
+
+/**
+ *  The empty rectangle, the identity for JMapGMRectUnion
+ */
+static const JMapGMRect JMapGMRectNull = { INFINITY, INFINITY, -INFINITY, -INFINITY };
+
+static inline bool JMapGMRectIsNull(JMapGMRect rect)
+{
+    return rect.minX > rect.maxX || rect.minY > rect.maxY;
+}
+
+static inline JMapGMRect JMapGMRectUnion(JMapGMRect a, JMapGMRect b)
+{
+    JMapGMRect rect = {
+        a.minX < b.minX ? a.minX : b.minX,
+        a.minY < b.minY ? a.minY : b.minY,
+        a.maxX > b.maxX ? a.maxX : b.maxX,
+        a.maxY > b.maxY ? a.maxY : b.maxY,
+    };
+    return rect;
+}
+
+static inline bool JMapGMRectIntersects(JMapGMRect a, JMapGMRect b)
+{
+    return a.minX <= b.maxX && b.minX <= a.maxX && a.minY <= b.maxY && b.minY <= a.maxY;
+}
+
+static inline bool JMapGMRectContainsPoint(JMapGMRect rect, JMapGMPoint point)
+{
+    return point.x >= rect.minX && point.x <= rect.maxX && point.y >= rect.minY && point.y <= rect.maxY;
+}
+
+#endif /* JMapGMTypes_h */
@@ -0,0 +1,334 @@
+//
+//  JMapGMVisibilityIndex.c
+//  JMapOutdoorIndoorKit
+//
+//  Copyright © 2026 Jibestream. All rights reserved.
+//
+
+#include "JMapGMVisibilityIndex.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+struct JMapGMVisibilityIndex {
+    size_t count;
+    uint32_t typeCount;
+    /** typeCount + 1 offsets; the instances of type t are [typeStarts[t], typeStarts[t + 1]) */
+    uint32_t *typeStarts;
+    /** The waypoint of each instance, ascending within a type */
+    uint32_t *waypoints;
+    size_t words;
+    uint64_t *visible;
+    uint64_t *appliedVisible;
+    uint32_t *styles;
+    uint32_t *appliedStyles;
+    bool dirty;
+};
+
+#pragma mark - Bitsets
+
+static inline bool JMapGMBitGet(const uint64_t *bits, size_t i)
+{
+    return (bits[i >> 6] >> (i & 63)) & 1;
+}
+
+static inline void JMapGMBitSet(uint64_t *bits, size_t i, bool value)
+{
+    uint64_t mask = 1ull << (i & 63);
+    if (value) bits[i >> 6] |= mask;
+    else bits[i >> 6] &= ~mask;
+}
+
+// Mask of the bits of word w that fall in [start, end).
+static inline uint64_t JMapGMBitRangeMask(size_t w, size_t start, size_t end)
+{
+    uint64_t mask = ~0ull;
+    if (w == start >> 6) mask &= ~0ull << (start & 63);
+    if (w == (end - 1) >> 6 && (end & 63)) mask &= ~0ull >> (64 - (end & 63));
+    return mask;
+}
+
+static void JMapGMBitSetRange(uint64_t *bits, size_t start, size_t end, bool value)
+{
+    if (start >= end) return;
+    for (size_t w = start >> 6; w <= (end - 1) >> 6; w++) {
+        uint64_t mask = JMapGMBitRangeMask(w, start, end);
+        bits[w] = value ? bits[w] | mask : bits[w] & ~mask;
+    }
+}
+
+// Population count of bits in [start, end), of a alone or of a ^ b.
+static size_t JMapGMBitCountRange(const uint64_t *a, const uint64_t *b, size_t start, size_t end)
+{
+    size_t count = 0;
+    if (start >= end) return 0;
+    for (size_t w = start >> 6; w <= (end - 1) >> 6; w++) {
+        uint64_t word = b ? a[w] ^ b[w] : a[w];
+        count += (size_t)__builtin_popcountll(word & JMapGMBitRangeMask(w, start, end));
+    }
+    return count;
+}
+
+#pragma mark - Creation
+
+static int JMapGMCompareKeys(const void *a, const void *b)
+{
+    uint64_t ka = *(const uint64_t *)a, kb = *(const uint64_t *)b;
+    return (ka > kb) - (ka < kb);
+}
+
+JMapGMVisibilityIndex *JMapGMVisibilityIndexCreate(const uint32_t *types, const uint32_t *waypoints, size_t count, bool visible)
+{
+    JMapGMVisibilityIndex *index = calloc(1, sizeof(JMapGMVisibilityIndex));
+    uint64_t *keys = malloc((count + 1) * sizeof(uint64_t));
+    if (!index || !keys) goto fail;
+
+    uint32_t typeCount = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (types[i] == JMAPGM_VISIBILITY_ALL || waypoints[i] == JMAPGM_VISIBILITY_ALL) continue;
+        keys[index->count++] = (uint64_t)types[i] << 32 | waypoints[i];
+        if (types[i] >= typeCount) typeCount = types[i] + 1;
+    }
+    qsort(keys, index->count, sizeof(uint64_t), JMapGMCompareKeys);
+    size_t unique = 0;
+    for (size_t i = 0; i < index->count; i++) {
+        if (unique == 0 || keys[i] != keys[unique - 1]) keys[unique++] = keys[i];
+    }
+    index->count = unique;
+    index->typeCount = typeCount;
+    index->words = (unique + 63) / 64;
+
+    index->typeStarts = calloc((size_t)typeCount + 1, sizeof(uint32_t));
+    index->waypoints = malloc((unique + 1) * sizeof(uint32_t));
+    index->visible = calloc(index->words + 1, sizeof(uint64_t));
+    index->appliedVisible = calloc(index->words + 1, sizeof(uint64_t));
+    index->styles = calloc(unique + 1, sizeof(uint32_t));
+    index->appliedStyles = calloc(unique + 1, sizeof(uint32_t));
+    if (!index->typeStarts || !index->waypoints || !index->visible || !index->appliedVisible ||
+        !index->styles || !index->appliedStyles) goto fail;
+
+    for (size_t i = 0; i < unique; i++) {
+        index->waypoints[i] = (uint32_t)keys[i];
+        index->typeStarts[(keys[i] >> 32) + 1]++;
+    }
+    for (uint32_t t = 0; t < typeCount; t++) {
+        index->typeStarts[t + 1] += index->typeStarts[t];
+    }
+    JMapGMBitSetRange(index->visible, 0, unique, visible);
+    JMapGMBitSetRange(index->appliedVisible, 0, unique, visible);
+    free(keys);
+    return index;
+
+fail:
+    free(keys);
+    JMapGMVisibilityIndexRelease(index);
+    return NULL;
+}
+
+void JMapGMVisibilityIndexRelease(JMapGMVisibilityIndex *index)
+{
+    if (!index) return;
+    free(index->typeStarts);
+    free(index->waypoints);
+    free(index->visible);
+    free(index->appliedVisible);
+    free(index->styles);
+    free(index->appliedStyles);
+    free(index);
+}
+
+size_t JMapGMVisibilityIndexGetCount(const JMapGMVisibilityIndex *index)
+{
+    return index->count;
+}
+
+#pragma mark - Changes
+
+// The instance of (type, waypoint), or SIZE_MAX.
+static size_t JMapGMVisibilityIndexFind(const JMapGMVisibilityIndex *index, uint32_t type, uint32_t waypoint)
+{
+    if (type >= index->typeCount) return SIZE_MAX;
+    size_t low = index->typeStarts[type], high = index->typeStarts[type + 1];
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        if (index->waypoints[middle] < waypoint) low = middle + 1;
+        else high = middle;
+    }
+    return low < index->typeStarts[type + 1] && index->waypoints[low] == waypoint ? low : SIZE_MAX;
+}
+
+// Calls apply for every matching instance range; single instances are ranges of one.
+typedef void (*JMapGMVisibilityApply)(JMapGMVisibilityIndex *index, size_t start, size_t end, uint32_t value);
+
+static size_t JMapGMVisibilityIndexMatch(JMapGMVisibilityIndex *index, uint32_t type, uint32_t waypoint,
+                                         JMapGMVisibilityApply apply, uint32_t value)
+{
+    size_t matched = 0;
+    uint32_t firstType = type == JMAPGM_VISIBILITY_ALL ? 0 : type;
+    uint32_t lastType = type == JMAPGM_VISIBILITY_ALL ? index->typeCount : (type < index->typeCount ? type + 1 : type);
+    if (type == JMAPGM_VISIBILITY_ALL && waypoint == JMAPGM_VISIBILITY_ALL) {
+        apply(index, 0, index->count, value);
+        matched = index->count;
+    } else {
+        for (uint32_t t = firstType; t < lastType; t++) {
+            size_t start = index->typeStarts[t], end = index->typeStarts[t + 1];
+            if (waypoint != JMAPGM_VISIBILITY_ALL) {
+                start = JMapGMVisibilityIndexFind(index, t, waypoint);
+                if (start == SIZE_MAX) continue;
+                end = start + 1;
+            }
+            apply(index, start, end, value);
+            matched += end - start;
+        }
+    }
+    if (matched) index->dirty = true;
+    return matched;
+}
+
+static void JMapGMVisibilityApplyVisible(JMapGMVisibilityIndex *index, size_t start, size_t end, uint32_t value)
+{
+    JMapGMBitSetRange(index->visible, start, end, value != 0);
+}
+
+static void JMapGMVisibilityApplyStyle(JMapGMVisibilityIndex *index, size_t start, size_t end, uint32_t value)
+{
+    for (size_t i = start; i < end; i++) index->styles[i] = value;
+}
+
+size_t JMapGMVisibilityIndexSetVisible(JMapGMVisibilityIndex *index, uint32_t type, uint32_t waypoint, bool visible)
+{
+    return JMapGMVisibilityIndexMatch(index, type, waypoint, JMapGMVisibilityApplyVisible, visible);
+}
+
+size_t JMapGMVisibilityIndexSetStyle(JMapGMVisibilityIndex *index, uint32_t type, uint32_t waypoint, uint32_t style)
+{
+    return JMapGMVisibilityIndexMatch(index, type, waypoint, JMapGMVisibilityApplyStyle, style);
+}
+
+bool JMapGMVisibilityIndexIsVisible(const JMapGMVisibilityIndex *index, uint32_t type, uint32_t waypoint)
+{
+    size_t i = JMapGMVisibilityIndexFind(index, type, waypoint);
+    return i != SIZE_MAX && JMapGMBitGet(index->visible, i);
+}
+
+uint32_t JMapGMVisibilityIndexGetStyle(const JMapGMVisibilityIndex *index, uint32_t type, uint32_t waypoint)
+{
+    size_t i = JMapGMVisibilityIndexFind(index, type, waypoint);
+    return i != SIZE_MAX ? index->styles[i] : JMAPGM_VISIBILITY_DEFAULT_STYLE;
+}
+
+bool JMapGMVisibilityIndexHasChanges(const JMapGMVisibilityIndex *index)
+{
+    if (!index->dirty) return false;
+    if (JMapGMBitCountRange(index->visible, index->appliedVisible, 0, index->count)) return true;
+    return memcmp(index->styles, index->appliedStyles, index->count * sizeof(uint32_t)) != 0;
+}
+
+#pragma mark - Commit
+
+typedef struct {
+    JMapGMVisibilityVisitor visitor;
+    void *context;
+    size_t count;
+} JMapGMVisibilityEmitter;
+
+static void JMapGMVisibilityEmit(JMapGMVisibilityEmitter *emitter, JMapGMVisibilityAction action,
+                                 uint32_t type, uint32_t waypoint, uint32_t style)
+{
+    JMapGMVisibilityChange change = { action, type, waypoint, style };
+    emitter->visitor(&change, emitter->context);
+    emitter->count++;
+}
+
+// A group is committed with one call when every instance ends in the same state and more than one
+// changed; otherwise each changed instance gets its own call.
+
+static void JMapGMVisibilityCommitVisible(JMapGMVisibilityIndex *index, JMapGMVisibilityEmitter *emitter)
+{
+    size_t changed = JMapGMBitCountRange(index->visible, index->appliedVisible, 0, index->count);
+    if (changed == 0) return;
+    size_t shown = JMapGMBitCountRange(index->visible, NULL, 0, index->count);
+    uint32_t changedTypes = 0;
+    for (uint32_t t = 0; t < index->typeCount && changedTypes < 2; t++) {
+        changedTypes += JMapGMBitCountRange(index->visible, index->appliedVisible, index->typeStarts[t], index->typeStarts[t + 1]) > 0;
+    }
+    if ((shown == 0 || shown == index->count) && changedTypes > 1) {
+        JMapGMVisibilityEmit(emitter, shown ? JMapGMVisibilityShow : JMapGMVisibilityHide,
+                             JMAPGM_VISIBILITY_ALL, JMAPGM_VISIBILITY_ALL, 0);
+        return;
+    }
+    for (uint32_t t = 0; t < index->typeCount; t++) {
+        size_t start = index->typeStarts[t], end = index->typeStarts[t + 1];
+        size_t typeChanged = JMapGMBitCountRange(index->visible, index->appliedVisible, start, end);
+        if (typeChanged == 0) continue;
+        size_t typeShown = JMapGMBitCountRange(index->visible, NULL, start, end);
+        if ((typeShown == 0 || typeShown == end - start) && typeChanged > 1) {
+            JMapGMVisibilityEmit(emitter, typeShown ? JMapGMVisibilityShow : JMapGMVisibilityHide, t, JMAPGM_VISIBILITY_ALL, 0);
+            continue;
+        }
+        for (size_t i = start; i < end; i++) {
+            bool visible = JMapGMBitGet(index->visible, i);
+            if (visible == JMapGMBitGet(index->appliedVisible, i)) continue;
+            JMapGMVisibilityEmit(emitter, visible ? JMapGMVisibilityShow : JMapGMVisibilityHide, t, index->waypoints[i], 0);
+        }
+    }
+}
+
+// The number of changed styles in [start, end), and whether they all end equal to *uniform.
+static size_t JMapGMVisibilityStyleChanges(const JMapGMVisibilityIndex *index, size_t start, size_t end, bool *uniform)
+{
+    size_t changed = 0;
+    *uniform = true;
+    for (size_t i = start; i < end; i++) {
+        changed += index->styles[i] != index->appliedStyles[i];
+        *uniform = *uniform && index->styles[i] == index->styles[start];
+    }
+    return changed;
+}
+
+static void JMapGMVisibilityEmitStyle(JMapGMVisibilityEmitter *emitter, uint32_t type, uint32_t waypoint, uint32_t style)
+{
+    JMapGMVisibilityEmit(emitter, style == JMAPGM_VISIBILITY_DEFAULT_STYLE ? JMapGMVisibilityResetStyle : JMapGMVisibilityStyle,
+                         type, waypoint, style);
+}
+
+static void JMapGMVisibilityCommitStyles(JMapGMVisibilityIndex *index, JMapGMVisibilityEmitter *emitter)
+{
+    bool uniform;
+    size_t changed = JMapGMVisibilityStyleChanges(index, 0, index->count, &uniform);
+    if (changed == 0) return;
+    uint32_t changedTypes = 0;
+    for (uint32_t t = 0; t < index->typeCount && changedTypes < 2; t++) {
+        bool typeUniform;
+        changedTypes += JMapGMVisibilityStyleChanges(index, index->typeStarts[t], index->typeStarts[t + 1], &typeUniform) > 0;
+    }
+    if (uniform && changedTypes > 1) {
+        JMapGMVisibilityEmitStyle(emitter, JMAPGM_VISIBILITY_ALL, JMAPGM_VISIBILITY_ALL, index->styles[0]);
+        return;
+    }
+    for (uint32_t t = 0; t < index->typeCount; t++) {
+        size_t start = index->typeStarts[t], end = index->typeStarts[t + 1];
+        bool typeUniform;
+        size_t typeChanged = JMapGMVisibilityStyleChanges(index, start, end, &typeUniform);
+        if (typeChanged == 0) continue;
+        if (typeUniform && typeChanged > 1) {
+            JMapGMVisibilityEmitStyle(emitter, t, JMAPGM_VISIBILITY_ALL, index->styles[start]);
+            continue;
+        }
+        for (size_t i = start; i < end; i++) {
+            if (index->styles[i] != index->appliedStyles[i]) JMapGMVisibilityEmitStyle(emitter, t, index->waypoints[i], index->styles[i]);
+        }
+    }
+}
+
+size_t JMapGMVisibilityIndexCommit(JMapGMVisibilityIndex *index, JMapGMVisibilityVisitor visitor, void *context)
+{
+    if (!index->dirty) return 0;
+    JMapGMVisibilityEmitter emitter = { visitor, context, 0 };
+    JMapGMVisibilityCommitVisible(index, &emitter);
+    JMapGMVisibilityCommitStyles(index, &emitter);
+    memcpy(index->appliedVisible, index->visible, index->words * sizeof(uint64_t));
+    memcpy(index->appliedStyles, index->styles, index->count * sizeof(uint32_t));
+    index->dirty = false;
+    return emitter.count;
+}
@@ -0,0 +1,122 @@
+//
+//  JMapGMVisibilityIndex.h
+//  JMapOutdoorIndoorKit
+//
+//  Copyright © 2026 Jibestream. All rights reserved.
+//
+
+#ifndef JMapGMVisibilityIndex_h
+#define JMapGMVisibilityIndex_h
+
+#include "JMapGMTypes.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ *  Visibility and style of icon instances keyed by (type, waypoint), such as amenities or path types.
+ *  Changes only update bitsets; JMapGMVisibilityIndexCommit then reports the net difference from the
+ *  last commit as the fewest show, hide and style calls, collapsing whole types or the whole index
+ *  into one call when they end up in the same state. Not thread safe.
+ */
+typedef struct JMapGMVisibilityIndex JMapGMVisibilityIndex;
+
+/**
+ *  Matches every type or every waypoint
+ */
+#define JMAPGM_VISIBILITY_ALL UINT32_MAX
+
+/**
+ *  Style of an instance that has not been styled
+ */
+#define JMAPGM_VISIBILITY_DEFAULT_STYLE 0
+
+typedef enum {
+    JMapGMVisibilityShow,
+    JMapGMVisibilityHide,
+    /** Apply style, which is never JMAPGM_VISIBILITY_DEFAULT_STYLE */
+    JMapGMVisibilityStyle,
+    JMapGMVisibilityResetStyle,
+} JMapGMVisibilityAction;
+
+/**
+ *  One call to make on the map. type and waypoint are JMAPGM_VISIBILITY_ALL when the call covers
+ *  every type or every waypoint of the type.
+ */
+typedef struct {
+    JMapGMVisibilityAction action;
+    uint32_t type;
+    uint32_t waypoint;
+    uint32_t style;
+} JMapGMVisibilityChange;
+
+typedef void (*JMapGMVisibilityVisitor)(const JMapGMVisibilityChange *change, void *context);
+
+/**
+ *  Creates an index. Duplicate pairs are merged.
+ *
+ *  @param types The type of each instance, dense indexes chosen by the caller
+ *  @param waypoints The waypoint of each instance, dense indexes chosen by the caller
+ *  @param count The number of instances
+ *  @param visible Whether the instances are currently shown, with the default style
+ *  @return A new index, or NULL if allocation failed
+ */
+JMapGMVisibilityIndex *JMapGMVisibilityIndexCreate(const uint32_t *types, const uint32_t *waypoints, size_t count, bool visible);
+
+/**
+ *  Releases an index created with JMapGMVisibilityIndexCreate.
+ */
+void JMapGMVisibilityIndexRelease(JMapGMVisibilityIndex *index);
+
+/**
+ *  The number of distinct instances
+ */
+size_t JMapGMVisibilityIndexGetCount(const JMapGMVisibilityIndex *index);
+
+/**
+ *  Shows or hides instances.
+ *
+ *  @param type A type, or JMAPGM_VISIBILITY_ALL
+ *  @param waypoint A waypoint, or JMAPGM_VISIBILITY_ALL
+ *  @return The number of instances matched
+ */
+size_t JMapGMVisibilityIndexSetVisible(JMapGMVisibilityIndex *index, uint32_t type, uint32_t waypoint, bool visible);
+
+/**
+ *  Styles instances, or resets them with JMAPGM_VISIBILITY_DEFAULT_STYLE.
+ *
+ *  @param type A type, or JMAPGM_VISIBILITY_ALL
+ *  @param waypoint A waypoint, or JMAPGM_VISIBILITY_ALL
+ *  @param style A caller chosen style identifier
+ *  @return The number of instances matched
+ */
+size_t JMapGMVisibilityIndexSetStyle(JMapGMVisibilityIndex *index, uint32_t type, uint32_t waypoint, uint32_t style);
+
+/**
+ *  Whether an instance will be visible after the next commit, false if it does not exist
+ */
+bool JMapGMVisibilityIndexIsVisible(const JMapGMVisibilityIndex *index, uint32_t type, uint32_t waypoint);
+
+/**
+ *  The style an instance will have after the next commit, JMAPGM_VISIBILITY_DEFAULT_STYLE if it does not exist
+ */
+uint32_t JMapGMVisibilityIndexGetStyle(const JMapGMVisibilityIndex *index, uint32_t type, uint32_t waypoint);
+
+/**
+ *  Whether there are changes since the last commit
+ */
+bool JMapGMVisibilityIndexHasChanges(const JMapGMVisibilityIndex *index);
+
+/**
+ *  Reports the changes since the last commit, visibility first, and marks them applied.
+ *
+ *  @return The number of changes reported
+ */
+size_t JMapGMVisibilityIndexCommit(JMapGMVisibilityIndex *index, JMapGMVisibilityVisitor visitor, void *context);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* JMapGMVisibilityIndex_h */
@@ -0,0 +1,63 @@
+//
+//  JMapGMSyntheticShapes.h
+//  JMapOutdoorIndoorKit
+//
+//  Copyright © 2026 Jibestream. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import <JMapOutdoorIndoorKit/JMapOutdoorIndoorKit.h>
+#import "JMapGMSyntheticVenue.h"
+
+/**
+ *  Layer name of the generated unit polygons
+ */
+extern NSString * _Nonnull const JMapGMSyntheticUnitLayer;
+/**
+ *  Layer name of the generated amenity points
+ */
+extern NSString * _Nonnull const JMapGMSyntheticAmenityLayer;
+
+/**
+ *  The JMapGMSyntheticShapes object
+ *
+ *  Generates synthetic venues with JMapGMSyntheticVenueGenerate and emits them as the geometry
+ *  dictionaries accepted by JMapGMGeometry initWithDictionary:, with "type", "coordinates" in
+ *  lat,long and "properties". Used to load test the kit at venue sizes no real map reaches.
+ *
+ *  Unit properties are "unit", "venue", "building", "level" and "waypoint", plus "destination",
+ *  "name" and "category" for units occupied by a destination. Amenity properties are "amenity"
+ *  and "waypoint".
+ */
+@interface JMapGMSyntheticShapes : NSObject
+
+/**
+ *  The generated data, valid for the lifetime of the receiver
+ */
+@property (nonatomic, readonly, nonnull) const JMapGMSyntheticVenue *venue;
+
+/**
+ *  Generates venues.
+ *
+ *  @param config The configuration, or NULL for JMapGMSyntheticConfigDefault
+ *  @return The shapes, or nil if the configuration is too large to generate
+ */
+- (nullable instancetype)initWithConfig:(const JMapGMSyntheticConfig * _Nullable)config;
+
+/**
+ *  The unit and amenity dictionaries of one floor.
+ *
+ *  @param floor The floor index, across all venues and buildings
+ *  @return The dictionaries, units first
+ */
+- (nonnull NSArray<NSDictionary *> *)dictionariesForFloor:(NSUInteger)floor;
+
+/**
+ *  The geometries of one floor by layer name, JMapGMSyntheticUnitLayer and JMapGMSyntheticAmenityLayer.
+ *
+ *  @param floor The floor index, across all venues and buildings
+ *  @return The geometries created from dictionariesForFloor:
+ */
+- (nonnull NSDictionary<NSString *, NSArray<JMapGMGeometry *> *> *)geometriesForFloor:(NSUInteger)floor;
+
+@end
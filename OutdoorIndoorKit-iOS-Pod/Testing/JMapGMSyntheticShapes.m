@@ -0,0 +1,109 @@
+//
+//  JMapGMSyntheticShapes.m
+//  JMapOutdoorIndoorKit
+//
+//  Copyright © 2026 Jibestream. All rights reserved.
+//
+
+#import "JMapGMSyntheticShapes.h"
+
+NSString * const JMapGMSyntheticUnitLayer = @"Units";
+NSString * const JMapGMSyntheticAmenityLayer = @"Amenities";
+
+static NSArray *JMapGMSyntheticPosition(JMapGMPoint point)
+{
+    // JMapGMGeometry coordinates are ordered lat,long.
+    return @[ @(point.y), @(point.x) ];
+}
+
+@implementation JMapGMSyntheticShapes
+{
+    JMapGMSyntheticVenue _venue;
+}
+
+- (instancetype)initWithConfig:(const JMapGMSyntheticConfig *)config
+{
+    self = [super init];
+    if (self) {
+        if (!JMapGMSyntheticVenueGenerate(&_venue, config)) return nil;
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    JMapGMSyntheticVenueFree(&_venue);
+}
+
+- (const JMapGMSyntheticVenue *)venue
+{
+    return &_venue;
+}
+
+- (NSDictionary *)unitDictionary:(uint32_t)unit destination:(NSInteger)destination
+{
+    uint32_t start = _venue.unitStarts[unit], end = _venue.unitStarts[unit + 1];
+    NSMutableArray *ring = [NSMutableArray arrayWithCapacity:end - start + 1];
+    for (uint32_t i = start; i < end; i++) {
+        [ring addObject:JMapGMSyntheticPosition(_venue.unitPoints[i])];
+    }
+    // GeoJSON rings are closed.
+    [ring addObject:ring.firstObject];
+
+    uint32_t floor = _venue.unitFloors[unit];
+    NSMutableDictionary *properties = [@{
+        @"unit": @(unit),
+        @"venue": @(_venue.floorVenues[floor]),
+        @"building": @(_venue.floorBuildings[floor]),
+        @"level": @(_venue.floorLevels[floor]),
+    } mutableCopy];
+    if (_venue.unitWaypoints[unit] != UINT32_MAX) properties[@"waypoint"] = @(_venue.unitWaypoints[unit]);
+    if (destination >= 0) {
+        properties[@"destination"] = @(destination);
+        properties[@"name"] = @(JMapGMSyntheticVenueGetDestinationName(&_venue, destination));
+        properties[@"category"] = @(JMapGMSyntheticCategories[_venue.destinationCategories[destination]]);
+    }
+    return @{ @"type": @"Polygon", @"coordinates": @[ ring ], @"properties": properties };
+}
+
+- (NSDictionary *)amenityDictionary:(size_t)amenity
+{
+    uint32_t waypoint = _venue.amenityWaypoints[amenity];
+    return @{
+        @"type": @"Point",
+        @"coordinates": JMapGMSyntheticPosition(_venue.waypoints[waypoint]),
+        @"properties": @{ @"amenity": @(_venue.amenityTypes[amenity]), @"waypoint": @(waypoint) },
+    };
+}
+
+- (NSArray<NSDictionary *> *)dictionariesForFloor:(NSUInteger)floor
+{
+    if (floor >= _venue.floorCount) return @[];
+    const JMapGMSyntheticConfig *c = &_venue.config;
+    NSMutableArray *dictionaries = [NSMutableArray arrayWithCapacity:c->unitsPerFloor + c->amenitiesPerFloor];
+
+    // Units, amenities and destinations of a floor are contiguous, in floor order.
+    size_t firstDestination = floor * c->destinationsPerFloor;
+    size_t destination = firstDestination;
+    for (size_t unit = floor * c->unitsPerFloor; unit < (floor + 1) * c->unitsPerFloor; unit++) {
+        BOOL occupied = destination < firstDestination + c->destinationsPerFloor && _venue.destinationUnits[destination] == unit;
+        [dictionaries addObject:[self unitDictionary:(uint32_t)unit destination:occupied ? (NSInteger)destination++ : -1]];
+    }
+    for (size_t amenity = floor * c->amenitiesPerFloor; amenity < (floor + 1) * c->amenitiesPerFloor; amenity++) {
+        [dictionaries addObject:[self amenityDictionary:amenity]];
+    }
+    return dictionaries;
+}
+
+- (NSDictionary<NSString *, NSArray<JMapGMGeometry *> *> *)geometriesForFloor:(NSUInteger)floor
+{
+    NSMutableArray *units = [NSMutableArray array];
+    NSMutableArray *amenities = [NSMutableArray array];
+    for (NSDictionary *dictionary in [self dictionariesForFloor:floor]) {
+        JMapGMGeometry *geometry = [[JMapGMGeometry alloc] initWithDictionary:dictionary];
+        [[dictionary[@"type"] isEqualToString:@"Point"] ? amenities : units addObject:geometry];
+    }
+    return @{ JMapGMSyntheticUnitLayer: units, JMapGMSyntheticAmenityLayer: amenities };
+}
+
+@end
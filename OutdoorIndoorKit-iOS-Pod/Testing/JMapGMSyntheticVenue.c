@@ -0,0 +1,260 @@
+//
+//  JMapGMSyntheticVenue.c
+//  JMapOutdoorIndoorKit
+//
+//  Copyright © 2026 Jibestream. All rights reserved.
+//
+
+#include "JMapGMSyntheticVenue.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+const JMapGMSyntheticConfig JMapGMSyntheticConfigDefault = {
+    .venues = 1,
+    .buildingsPerVenue = 1,
+    .floors = 3,
+    .unitsPerFloor = 200,
+    .verticesPerUnit = 8,
+    .waypointsPerFloor = 400,
+    .connectorsPerFloor = 4,
+    .pathTypes = 3,
+    .amenitiesPerFloor = 20,
+    .amenityTypes = 8,
+    .destinationsPerFloor = 120,
+    .seed = 1,
+};
+
+const char *const JMapGMSyntheticCategories[] = {
+    "Food", "Fashion", "Electronics", "Services", "Health", "Entertainment", "Home", "Sports",
+};
+const size_t JMapGMSyntheticCategoryCount = sizeof(JMapGMSyntheticCategories) / sizeof(JMapGMSyntheticCategories[0]);
+
+static const char *const JMapGMSyntheticAdjectives[] = {
+    "Golden", "Urban", "Northern", "Blue", "Maple", "Royal", "Little", "Grand",
+    "Silver", "Green", "Harbour", "Union", "Bright", "Crystal", "Lakeside", "Modern",
+};
+
+static const char *const JMapGMSyntheticNouns[] = {
+    "Bistro", "Outfitters", "Pharmacy", "Cafe", "Books", "Optical", "Jewellers", "Kitchen",
+    "Cinema", "Market", "Studio", "Bakery", "Gallery", "Fitness", "Electronics", "Shoes",
+    "Boutique", "Salon", "Bank", "Toys", "Florist", "Deli", "Clinic", "Games",
+};
+
+#define JMAPGM_SYNTHETIC_COUNT(array) (sizeof(array) / sizeof((array)[0]))
+#define JMAPGM_SYNTHETIC_MAX_NAME 48
+
+// Venues are placed around downtown Toronto, roughly 11m per unit cell.
+static const JMapGMPoint JMapGMSyntheticOrigin = { -79.3832, 43.6532 };
+static const double JMapGMSyntheticCellSize = 1e-4;
+// Venues are about 500m apart so that they never overlap.
+static const double JMapGMSyntheticVenueGap = 5e-3;
+
+uint64_t JMapGMSyntheticRandom(uint64_t *state)
+{
+    // splitmix64
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+double JMapGMSyntheticRandomUnit(uint64_t *state)
+{
+    return (JMapGMSyntheticRandom(state) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+static uint32_t JMapGMGridSide(uint32_t count)
+{
+    uint32_t side = (uint32_t)ceil(sqrt((double)count));
+    return side ? side : 1;
+}
+
+static bool JMapGMSyntheticVenueAllocate(JMapGMSyntheticVenue *venue, size_t floors, size_t units, size_t points,
+                                         size_t waypoints, size_t edges, size_t amenities, size_t destinations)
+{
+    // One extra element each so that empty configurations still get valid buffers.
+    venue->floorVenues = malloc((floors + 1) * sizeof(uint32_t));
+    venue->floorBuildings = malloc((floors + 1) * sizeof(uint32_t));
+    venue->floorLevels = malloc((floors + 1) * sizeof(uint32_t));
+    venue->unitPoints = malloc((points + 1) * sizeof(JMapGMPoint));
+    venue->unitStarts = malloc((units + 1) * sizeof(uint32_t));
+    venue->unitFloors = malloc((units + 1) * sizeof(uint32_t));
+    venue->unitWaypoints = malloc((units + 1) * sizeof(uint32_t));
+    venue->waypoints = malloc((waypoints + 1) * sizeof(JMapGMPoint));
+    venue->waypointFloors = malloc((waypoints + 1) * sizeof(uint32_t));
+    venue->edgeFrom = malloc((edges + 1) * sizeof(uint32_t));
+    venue->edgeTo = malloc((edges + 1) * sizeof(uint32_t));
+    venue->edgePathTypes = malloc((edges + 1) * sizeof(uint8_t));
+    venue->amenityTypes = malloc((amenities + 1) * sizeof(uint32_t));
+    venue->amenityWaypoints = malloc((amenities + 1) * sizeof(uint32_t));
+    venue->destinationUnits = malloc((destinations + 1) * sizeof(uint32_t));
+    venue->destinationCategories = malloc((destinations + 1) * sizeof(uint32_t));
+    venue->destinationNameStarts = malloc((destinations + 1) * sizeof(uint32_t));
+    venue->destinationNames = malloc(destinations * JMAPGM_SYNTHETIC_MAX_NAME + 1);
+    return venue->floorVenues && venue->floorBuildings && venue->floorLevels && venue->unitPoints &&
+           venue->unitStarts && venue->unitFloors && venue->unitWaypoints && venue->waypoints &&
+           venue->waypointFloors && venue->edgeFrom && venue->edgeTo && venue->edgePathTypes &&
+           venue->amenityTypes && venue->amenityWaypoints && venue->destinationUnits &&
+           venue->destinationCategories && venue->destinationNameStarts && venue->destinationNames;
+}
+
+static void JMapGMSyntheticVenueAddEdge(JMapGMSyntheticVenue *venue, uint32_t from, uint32_t to, uint8_t pathType)
+{
+    venue->edgeFrom[venue->edgeCount] = from;
+    venue->edgeTo[venue->edgeCount] = to;
+    venue->edgePathTypes[venue->edgeCount++] = pathType;
+}
+
+bool JMapGMSyntheticVenueGenerate(JMapGMSyntheticVenue *venue, const JMapGMSyntheticConfig *config)
+{
+    memset(venue, 0, sizeof(*venue));
+    JMapGMSyntheticConfig c = config ? *config : JMapGMSyntheticConfigDefault;
+    if (c.venues == 0) c.venues = 1;
+    if (c.buildingsPerVenue == 0) c.buildingsPerVenue = 1;
+    if (c.floors == 0) c.floors = 1;
+    if (c.verticesPerUnit < 3) c.verticesPerUnit = 3;
+    if (c.pathTypes == 0) c.pathTypes = 1;
+    if (c.pathTypes > UINT8_MAX) c.pathTypes = UINT8_MAX;
+    if (c.amenityTypes == 0) c.amenityTypes = 1;
+    if (c.destinationsPerFloor > c.unitsPerFloor) c.destinationsPerFloor = c.unitsPerFloor;
+    if (c.amenitiesPerFloor && !c.waypointsPerFloor) c.amenitiesPerFloor = 0;
+    venue->config = c;
+
+    size_t buildings = (size_t)c.venues * c.buildingsPerVenue;
+    size_t floors = buildings * c.floors;
+    size_t units = floors * c.unitsPerFloor;
+    size_t points = units * c.verticesPerUnit;
+    size_t waypoints = floors * c.waypointsPerFloor;
+    uint32_t connectors = c.connectorsPerFloor < c.waypointsPerFloor ? c.connectorsPerFloor : c.waypointsPerFloor;
+    size_t edges = waypoints * 2 + buildings * (c.floors - 1) * connectors;
+    size_t amenities = floors * c.amenitiesPerFloor;
+    size_t destinations = floors * c.destinationsPerFloor;
+    if (floors > UINT32_MAX || units > UINT32_MAX || points > UINT32_MAX || waypoints > UINT32_MAX ||
+        destinations * JMAPGM_SYNTHETIC_MAX_NAME > UINT32_MAX) {
+        return false;
+    }
+    if (!JMapGMSyntheticVenueAllocate(venue, floors, units, points, waypoints, edges, amenities, destinations)) {
+        JMapGMSyntheticVenueFree(venue);
+        return false;
+    }
+
+    venue->floorCount = floors;
+    uint64_t random = c.seed;
+    uint32_t unitSide = JMapGMGridSide(c.unitsPerFloor);
+    uint32_t waypointSide = JMapGMGridSide(c.waypointsPerFloor);
+    double extent = unitSide * JMapGMSyntheticCellSize;
+    double spacing = extent / waypointSide;
+    double buildingStride = extent * 1.25;
+    double venueStride = buildingStride * c.buildingsPerVenue + JMapGMSyntheticVenueGap;
+    size_t point = 0;
+    size_t nameLength = 0;
+    venue->unitStarts[0] = 0;
+
+    for (uint32_t floor = 0; floor < floors; floor++) {
+        uint32_t building = floor / c.floors;
+        uint32_t level = floor % c.floors;
+        venue->floorVenues[floor] = building / c.buildingsPerVenue;
+        venue->floorBuildings[floor] = building % c.buildingsPerVenue;
+        venue->floorLevels[floor] = level;
+        // Buildings of a venue sit side by side along x, venues are stacked along y.
+        JMapGMPoint origin = {
+            JMapGMSyntheticOrigin.x + venue->floorBuildings[floor] * buildingStride,
+            JMapGMSyntheticOrigin.y + venue->floorVenues[floor] * venueStride,
+        };
+        uint32_t firstUnit = (uint32_t)venue->unitCount;
+        uint32_t firstWaypoint = (uint32_t)venue->waypointCount;
+
+        // Units: star shaped outlines on a grid, each linked to the corridor waypoint under its centre.
+        for (uint32_t i = 0; i < c.unitsPerFloor; i++) {
+            double lx = ((i % unitSide) + 0.5) * JMapGMSyntheticCellSize;
+            double ly = ((i / unitSide) + 0.5) * JMapGMSyntheticCellSize;
+            double phase = JMapGMSyntheticRandomUnit(&random) * 2 * M_PI;
+            for (uint32_t v = 0; v < c.verticesPerUnit; v++) {
+                double angle = phase + 2 * M_PI * v / c.verticesPerUnit;
+                double radius = JMapGMSyntheticCellSize * (0.3 + 0.15 * JMapGMSyntheticRandomUnit(&random));
+                venue->unitPoints[point].x = origin.x + lx + radius * cos(angle);
+                venue->unitPoints[point].y = origin.y + ly + radius * sin(angle);
+                point++;
+            }
+            uint32_t door = UINT32_MAX;
+            if (c.waypointsPerFloor) {
+                uint32_t column = (uint32_t)(lx / spacing), row = (uint32_t)(ly / spacing);
+                if (column >= waypointSide) column = waypointSide - 1;
+                door = row * waypointSide + column;
+                if (door >= c.waypointsPerFloor) door = c.waypointsPerFloor - 1;
+                door += firstWaypoint;
+            }
+            venue->unitFloors[venue->unitCount] = floor;
+            venue->unitWaypoints[venue->unitCount] = door;
+            venue->unitStarts[++venue->unitCount] = (uint32_t)point;
+        }
+
+        // Waypoints: a corridor grid spanning the floor, linked to right and lower neighbours.
+        for (uint32_t i = 0; i < c.waypointsPerFloor; i++) {
+            uint32_t index = firstWaypoint + i;
+            venue->waypoints[index].x = origin.x + ((i % waypointSide) + 0.5) * spacing;
+            venue->waypoints[index].y = origin.y + ((i / waypointSide) + 0.5) * spacing;
+            venue->waypointFloors[index] = floor;
+            if ((i + 1) % waypointSide != 0 && i + 1 < c.waypointsPerFloor) {
+                JMapGMSyntheticVenueAddEdge(venue, index, index + 1, JMAPGM_SYNTHETIC_CORRIDOR);
+            }
+            if (i + waypointSide < c.waypointsPerFloor) {
+                JMapGMSyntheticVenueAddEdge(venue, index, index + waypointSide, JMAPGM_SYNTHETIC_CORRIDOR);
+            }
+        }
+        venue->waypointCount += c.waypointsPerFloor;
+
+        // Connectors to the level above, cycling through the path types.
+        if (level + 1 < c.floors) {
+            for (uint32_t k = 0; k < connectors; k++) {
+                uint32_t i = (uint32_t)((uint64_t)k * c.waypointsPerFloor / connectors);
+                JMapGMSyntheticVenueAddEdge(venue, firstWaypoint + i, firstWaypoint + c.waypointsPerFloor + i,
+                                            (uint8_t)(1 + k % c.pathTypes));
+            }
+        }
+
+        for (uint32_t i = 0; i < c.amenitiesPerFloor; i++) {
+            venue->amenityTypes[venue->amenityCount] = (uint32_t)(JMapGMSyntheticRandom(&random) % c.amenityTypes);
+            venue->amenityWaypoints[venue->amenityCount++] =
+                firstWaypoint + (uint32_t)(JMapGMSyntheticRandom(&random) % c.waypointsPerFloor);
+        }
+
+        // Destinations occupy evenly spread units; names repeat across floors and venues like real chains.
+        for (uint32_t k = 0; k < c.destinationsPerFloor; k++) {
+            size_t d = venue->destinationCount++;
+            venue->destinationUnits[d] = firstUnit + (uint32_t)((uint64_t)k * c.unitsPerFloor / c.destinationsPerFloor);
+            venue->destinationCategories[d] = (uint32_t)(JMapGMSyntheticRandom(&random) % JMapGMSyntheticCategoryCount);
+            const char *adjective = JMapGMSyntheticAdjectives[JMapGMSyntheticRandom(&random) % JMAPGM_SYNTHETIC_COUNT(JMapGMSyntheticAdjectives)];
+            const char *noun = JMapGMSyntheticNouns[JMapGMSyntheticRandom(&random) % JMAPGM_SYNTHETIC_COUNT(JMapGMSyntheticNouns)];
+            venue->destinationNameStarts[d] = (uint32_t)nameLength;
+            int length = snprintf(venue->destinationNames + nameLength, JMAPGM_SYNTHETIC_MAX_NAME, "%s %s", adjective, noun);
+            nameLength += (size_t)length + 1;
+        }
+    }
+    return true;
+}
+
+void JMapGMSyntheticVenueFree(JMapGMSyntheticVenue *venue)
+{
+    free(venue->floorVenues);
+    free(venue->floorBuildings);
+    free(venue->floorLevels);
+    free(venue->unitPoints);
+    free(venue->unitStarts);
+    free(venue->unitFloors);
+    free(venue->unitWaypoints);
+    free(venue->waypoints);
+    free(venue->waypointFloors);
+    free(venue->edgeFrom);
+    free(venue->edgeTo);
+    free(venue->edgePathTypes);
+    free(venue->amenityTypes);
+    free(venue->amenityWaypoints);
+    free(venue->destinationUnits);
+    free(venue->destinationCategories);
+    free(venue->destinationNameStarts);
+    free(venue->destinationNames);
+    memset(venue, 0, sizeof(*venue));
+}
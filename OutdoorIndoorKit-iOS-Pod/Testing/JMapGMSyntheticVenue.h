@@ -0,0 +1,145 @@
+//
+//  JMapGMSyntheticVenue.h
+//  JMapOutdoorIndoorKit
+//
+//  Copyright © 2026 Jibestream. All rights reserved.
+//
+
+#ifndef JMapGMSyntheticVenue_h
+#define JMapGMSyntheticVenue_h
+
+#include "JMapGMPolygon.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ *  Size and shape of generated venues. The same configuration and seed always
+ *  produce the same data, so it can be shared by benchmarks, tests and load tests.
+ */
+typedef struct {
+    uint32_t venues;
+    uint32_t buildingsPerVenue;
+    /** Floors per building */
+    uint32_t floors;
+    uint32_t unitsPerFloor;
+    /** Vertices of each unit outline, at least 3 */
+    uint32_t verticesPerUnit;
+    /** Waypoints per floor, laid out as a corridor grid */
+    uint32_t waypointsPerFloor;
+    /** Vertical connectors linking every pair of adjacent floors of a building */
+    uint32_t connectorsPerFloor;
+    /** Number of connector path types (elevator, stairs, escalator, ...), at least 1 */
+    uint32_t pathTypes;
+    uint32_t amenitiesPerFloor;
+    uint32_t amenityTypes;
+    /** Destinations per floor, each occupying one unit; at most unitsPerFloor */
+    uint32_t destinationsPerFloor;
+    uint64_t seed;
+} JMapGMSyntheticConfig;
+
+/**
+ *  A small default venue: one building of 3 floors of 200 units
+ */
+extern const JMapGMSyntheticConfig JMapGMSyntheticConfigDefault;
+
+/**
+ *  Path type of corridor edges; connector edges use 1 through pathTypes
+ */
+#define JMAPGM_SYNTHETIC_CORRIDOR 0
+
+/**
+ *  Generated venues in flat buffers. Coordinates are x = longitude, y = latitude.
+ *  Floors are numbered across all venues and buildings.
+ */
+typedef struct {
+    JMapGMSyntheticConfig config;
+
+    size_t floorCount;
+    uint32_t *floorVenues;
+    uint32_t *floorBuildings;
+    /** Level of the floor within its building, from 0 */
+    uint32_t *floorLevels;
+
+    /** Unit outlines; unit i spans [unitStarts[i], unitStarts[i + 1]) of unitPoints */
+    size_t unitCount;
+    JMapGMPoint *unitPoints;
+    uint32_t *unitStarts;
+    uint32_t *unitFloors;
+    /** The waypoint at the door of each unit */
+    uint32_t *unitWaypoints;
+
+    size_t waypointCount;
+    JMapGMPoint *waypoints;
+    uint32_t *waypointFloors;
+
+    /** Undirected corridor and connector edges between waypoints */
+    size_t edgeCount;
+    uint32_t *edgeFrom;
+    uint32_t *edgeTo;
+    uint8_t *edgePathTypes;
+
+    size_t amenityCount;
+    uint32_t *amenityTypes;
+    uint32_t *amenityWaypoints;
+
+    /** Destination i occupies unit destinationUnits[i] and is named destinationNames + destinationNameStarts[i] */
+    size_t destinationCount;
+    uint32_t *destinationUnits;
+    uint32_t *destinationCategories;
+    uint32_t *destinationNameStarts;
+    char *destinationNames;
+} JMapGMSyntheticVenue;
+
+/**
+ *  Generates venues.
+ *
+ *  @param config The configuration, or NULL for JMapGMSyntheticConfigDefault
+ *  @return false if allocation failed or the sizes overflow, in which case venue is left empty
+ */
+bool JMapGMSyntheticVenueGenerate(JMapGMSyntheticVenue *venue, const JMapGMSyntheticConfig *config);
+
+/**
+ *  Releases the buffers of generated venues.
+ */
+void JMapGMSyntheticVenueFree(JMapGMSyntheticVenue *venue);
+
+/**
+ *  The outline of one unit as a single ring polygon.
+ */
+static inline JMapGMPolygon JMapGMSyntheticVenueGetUnit(const JMapGMSyntheticVenue *venue, size_t unit)
+{
+    JMapGMPolygon polygon = { venue->unitPoints, &venue->unitStarts[unit], 1 };
+    return polygon;
+}
+
+/**
+ *  The NUL terminated name of one destination.
+ */
+static inline const char *JMapGMSyntheticVenueGetDestinationName(const JMapGMSyntheticVenue *venue, size_t destination)
+{
+    return venue->destinationNames + venue->destinationNameStarts[destination];
+}
+
+/**
+ *  Names of the destination categories, indexed by destinationCategories
+ */
+extern const char *const JMapGMSyntheticCategories[];
+extern const size_t JMapGMSyntheticCategoryCount;
+
+/**
+ *  Deterministic 64-bit generator shared by the synthetic data and benchmarks.
+ */
+uint64_t JMapGMSyntheticRandom(uint64_t *state);
+
+/**
+ *  Uniform double in [0, 1).
+ */
+double JMapGMSyntheticRandomUnit(uint64_t *state);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* JMapGMSyntheticVenue_h */